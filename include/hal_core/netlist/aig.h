@@ -0,0 +1,343 @@
+//  MIT License
+//
+//  Copyright (c) 2019 Ruhr University Bochum, Chair for Embedded Security. All Rights reserved.
+//  Copyright (c) 2021 Max Planck Institute for Security and Privacy. All Rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+
+#pragma once
+
+#include "hal_core/defines.h"
+#include "hal_core/netlist/boolean_function.h"
+
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace hal
+{
+    class Gate;
+
+    /**
+     * And-inverter graph (AIG) that represents combinational logic using only two-input AND nodes and complemented edges.
+     *
+     * Edges are encoded as literals, i.e., twice the index of the node they point to plus one if the edge is complemented.
+     * Node 0 is the constant ZERO, hence literal 0 is constant ZERO and literal 1 is constant ONE.
+     * Structural hashing and constant propagation are applied whenever a node is created, so that no two AND nodes have the same inputs.
+     * AND nodes are always created after their inputs, hence node indices are a topological order.
+     *
+     * @ingroup netlist
+     */
+    class NETLIST_API AIG
+    {
+    public:
+        /**
+         * Literal that is returned on error.
+         */
+        static constexpr u32 INVALID_LITERAL = 0xFFFFFFFF;
+
+        /**
+         * Construct an empty AIG that only contains the constant node.
+         */
+        AIG();
+
+        /**
+         * Build an AIG from the Boolean functions of a set of combinational gates.
+         * Every net that is driven by the Boolean function of one of the gates becomes an output of the AIG, all other nets that are read by the gates become inputs.
+         * Hence, outputs of sequential gates and of gates with undefined or missing Boolean functions are treated as inputs.
+         * All inputs and outputs are named by the ID of their net, just like the variables of netlist_utils::get_subgraph_function.
+         *
+         * @param[in] gates - The gates.
+         * @returns The AIG or an empty AIG if the gates contain a nullptr or a combinational loop.
+         */
+        static AIG from_gates(const std::vector<const Gate*>& gates);
+
+        /**
+         * Get the literal of a constant.
+         *
+         * @param[in] value - The constant value.
+         * @returns The literal.
+         */
+        static u32 get_constant(bool value);
+
+        /**
+         * Negate a literal.
+         *
+         * @param[in] literal - The literal.
+         * @returns The negated literal.
+         */
+        static u32 negate(u32 literal);
+
+        /**
+         * Get the index of the node a literal points to.
+         *
+         * @param[in] literal - The literal.
+         * @returns The node index.
+         */
+        static u32 get_node(u32 literal);
+
+        /**
+         * Check whether a literal is complemented.
+         *
+         * @param[in] literal - The literal.
+         * @returns True if the literal is complemented, false otherwise.
+         */
+        static bool is_complemented(u32 literal);
+
+        /**
+         * Add an input to the AIG.
+         * If an input of the same name already exists, its literal is returned.
+         *
+         * @param[in] name - The name of the input.
+         * @returns The literal of the input.
+         */
+        u32 add_input(const std::string& name);
+
+        /**
+         * Get the literal of an input.
+         *
+         * @param[in] name - The name of the input.
+         * @returns The literal of the input or INVALID_LITERAL if there is no such input.
+         */
+        u32 get_input(const std::string& name) const;
+
+        /**
+         * Get the names of all inputs in the order they were added.
+         *
+         * @returns The input names.
+         */
+        const std::vector<std::string>& get_input_names() const;
+
+        /**
+         * Add an AND node, unless the result is a constant, one of the inputs, or an existing node with the same inputs.
+         *
+         * @param[in] a - The literal of the first input.
+         * @param[in] b - The literal of the second input.
+         * @returns The literal of the result or INVALID_LITERAL on error.
+         */
+        u32 add_and(u32 a, u32 b);
+
+        /**
+         * Add an OR, which is represented as a negated AND of the negated inputs.
+         *
+         * @param[in] a - The literal of the first input.
+         * @param[in] b - The literal of the second input.
+         * @returns The literal of the result or INVALID_LITERAL on error.
+         */
+        u32 add_or(u32 a, u32 b);
+
+        /**
+         * Add an XOR, which is represented by three AND nodes.
+         *
+         * @param[in] a - The literal of the first input.
+         * @param[in] b - The literal of the second input.
+         * @returns The literal of the result or INVALID_LITERAL on error.
+         */
+        u32 add_xor(u32 a, u32 b);
+
+        /**
+         * Add a multiplexer, which is represented by three AND nodes.
+         *
+         * @param[in] select - The literal of the select input.
+         * @param[in] if_one - The literal that is selected if the select input is ONE.
+         * @param[in] if_zero - The literal that is selected if the select input is ZERO.
+         * @returns The literal of the result or INVALID_LITERAL on error.
+         */
+        u32 add_mux(u32 select, u32 if_one, u32 if_zero);
+
+        /**
+         * Add the logic of a Boolean function.
+         * Variables that are contained in the given map are replaced by the respective literal, all others refer to inputs of the same name, which are created if necessary.
+         *
+         * @param[in] function - The Boolean function.
+         * @param[in] variable_literals - An optional map from variable names to literals.
+         * @returns The literal of the result or INVALID_LITERAL if the function is empty or contains undefined values.
+         */
+        u32 add_boolean_function(const BooleanFunction& function, const std::unordered_map<std::string, u32>& variable_literals = {});
+
+        /**
+         * Add an output to the AIG or redirect an existing output of the same name.
+         *
+         * @param[in] name - The name of the output.
+         * @param[in] literal - The literal that drives the output.
+         * @returns True on success, false otherwise.
+         */
+        bool add_output(const std::string& name, u32 literal);
+
+        /**
+         * Get the literal that drives an output.
+         *
+         * @param[in] name - The name of the output.
+         * @returns The literal or INVALID_LITERAL if there is no such output.
+         */
+        u32 get_output(const std::string& name) const;
+
+        /**
+         * Get all outputs as pairs of name and literal in the order they were added.
+         *
+         * @returns The outputs.
+         */
+        const std::vector<std::pair<std::string, u32>>& get_outputs() const;
+
+        /**
+         * Get the number of nodes including the constant node and all inputs.
+         *
+         * @returns The number of nodes.
+         */
+        u32 get_node_count() const;
+
+        /**
+         * Get the number of AND nodes.
+         *
+         * @returns The number of AND nodes.
+         */
+        u32 get_and_count() const;
+
+        /**
+         * Check whether a node is an AND node.
+         *
+         * @param[in] node - The node index.
+         * @returns True if the node is an AND node, false otherwise.
+         */
+        bool is_and(u32 node) const;
+
+        /**
+         * Check whether a node is an input.
+         *
+         * @param[in] node - The node index.
+         * @returns True if the node is an input, false otherwise.
+         */
+        bool is_input(u32 node) const;
+
+        /**
+         * Get the literals of both inputs of an AND node.
+         *
+         * @param[in] node - The node index.
+         * @returns The pair of input literals or a pair of INVALID_LITERAL if the node is not an AND node.
+         */
+        std::pair<u32, u32> get_fan_in(u32 node) const;
+
+        /**
+         * Get the level of a node, i.e., the number of AND nodes on the longest path from any input to the node.
+         *
+         * @param[in] node - The node index.
+         * @returns The level.
+         */
+        u32 get_level(u32 node) const;
+
+        /**
+         * Get the maximum level of all outputs.
+         *
+         * @returns The depth of the AIG.
+         */
+        u32 get_depth() const;
+
+        /**
+         * Convert the logic behind a literal into a Boolean function.
+         *
+         * WARNING: Shared nodes are duplicated, hence the size of the result may be exponential in the number of nodes.
+         *
+         * @param[in] literal - The literal.
+         * @returns The Boolean function or an empty function on error.
+         */
+        BooleanFunction to_boolean_function(u32 literal) const;
+
+        /**
+         * Convert the logic behind a literal into a z3 bit-vector expression of width 1.
+         * Inputs are converted into bit-vector constants of the same name, just like in BooleanFunction::to_z3.
+         *
+         * @param[in] context - The z3 context.
+         * @param[in] literal - The literal.
+         * @returns The z3 expression.
+         */
+        z3::expr to_z3(z3::context& context, u32 literal) const;
+
+        /**
+         * Simulate 64 input patterns at once.
+         * Bit i of each input word belongs to pattern i, inputs without a word are ZERO.
+         *
+         * @param[in] input_words - A map from input names to their 64 values.
+         * @returns One word per node, the value of a literal is obtained via get_value().
+         */
+        std::vector<u64> simulate(const std::unordered_map<std::string, u64>& input_words) const;
+
+        /**
+         * Get the simulated value of a literal.
+         *
+         * @param[in] node_words - The result of simulate().
+         * @param[in] literal - The literal.
+         * @returns The 64 values of the literal.
+         */
+        static u64 get_value(const std::vector<u64>& node_words, u32 literal);
+
+        /**
+         * Get a copy of the AIG that only contains the nodes that are required by its outputs.
+         * All inputs are kept.
+         *
+         * @returns The cleaned up AIG.
+         */
+        AIG cleanup() const;
+
+        /**
+         * Get a copy of the AIG in which the given inputs are fixed to constants, which are then propagated through the graph.
+         * The inputs are kept and are no longer referenced.
+         *
+         * @param[in] input_values - A map from input names to constant values.
+         * @returns The simplified AIG.
+         */
+        AIG propagate_constants(const std::unordered_map<std::string, bool>& input_values) const;
+
+        /**
+         * Get a copy of the AIG in which chains of AND nodes are rebuilt as balanced trees to reduce the depth.
+         * Nodes with more than one fan-out are not duplicated.
+         *
+         * @returns The balanced AIG.
+         */
+        AIG balance() const;
+
+        /**
+         * Get a copy of the AIG in which the logic cone of each node is replaced by an irredundant sum-of-products of its cut whenever this requires fewer AND nodes than the logic that is exclusively used by the node.
+         *
+         * @param[in] max_cut_size - The maximum number of leaves of each cut, at most 6.
+         * @returns The refactored AIG.
+         */
+        AIG refactor(u32 max_cut_size = 6) const;
+
+    private:
+        // for the constant node and inputs, fan_in_0 is INVALID_LITERAL and fan_in_1 is the index of the input name
+        struct Node
+        {
+            u32 fan_in_0;
+            u32 fan_in_1;
+            u32 level;
+        };
+
+        bool check_literal(u32 literal) const;
+        std::vector<u32> get_fan_out_counts() const;
+        AIG copy_inputs() const;
+
+        std::vector<Node> m_nodes;
+        std::unordered_map<u64, u32> m_strash;
+        std::vector<std::string> m_input_names;
+        std::unordered_map<std::string, u32> m_input_literals;
+        std::vector<std::pair<std::string, u32>> m_outputs;
+        std::unordered_map<std::string, u32> m_output_indices;
+    };
+}    // namespace hal
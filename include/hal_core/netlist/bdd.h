@@ -0,0 +1,484 @@
+//  MIT License
+//
+//  Copyright (c) 2019 Ruhr University Bochum, Chair for Embedded Security. All Rights reserved.
+//  Copyright (c) 2021 Max Planck Institute for Security and Privacy. All Rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+
+#pragma once
+
+#include "hal_core/defines.h"
+#include "hal_core/netlist/boolean_function.h"
+
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace hal
+{
+    class BDDManager;
+
+    /**
+     * Handle to a reduced ordered binary decision diagram (ROBDD) that is owned by a BDDManager.
+     *
+     * Since ROBDDs are canonical for a fixed variable order, two handles of the same manager represent equivalent functions if and only if they are equal.
+     * A handle keeps its diagram alive during garbage collection and stays valid across variable reordering.
+     * The manager must outlive all of its handles.
+     *
+     * @ingroup netlist
+     */
+    class NETLIST_API BDD
+    {
+    public:
+        /**
+         * Construct an invalid BDD that does not belong to any manager.
+         */
+        BDD();
+
+        BDD(const BDD& other);
+        BDD(BDD&& other) noexcept;
+        BDD& operator=(const BDD& other);
+        BDD& operator=(BDD&& other) noexcept;
+        ~BDD();
+
+        /**
+         * Check whether the BDD belongs to a manager.
+         *
+         * @returns True if the BDD is valid, false otherwise.
+         */
+        bool is_valid() const;
+
+        /**
+         * Check whether the BDD is the constant ZERO.
+         *
+         * @returns True if the BDD is constant ZERO, false otherwise.
+         */
+        bool is_constant_zero() const;
+
+        /**
+         * Check whether the BDD is the constant ONE.
+         *
+         * @returns True if the BDD is constant ONE, false otherwise.
+         */
+        bool is_constant_one() const;
+
+        /**
+         * Get the manager that owns the BDD.
+         *
+         * @returns The manager or a nullptr if the BDD is invalid.
+         */
+        BDDManager* get_manager() const;
+
+        /**
+         * Get the number of nodes of the BDD including the terminal nodes.
+         *
+         * @returns The number of nodes.
+         */
+        u32 get_node_count() const;
+
+        /**
+         * Check whether two BDDs represent the same function.
+         *
+         * @param[in] other - The BDD to compare against.
+         * @returns True if both BDDs are equivalent, false otherwise.
+         */
+        bool operator==(const BDD& other) const;
+
+        /**
+         * Check whether two BDDs represent different functions.
+         *
+         * @param[in] other - The BDD to compare against.
+         * @returns True if both BDDs are not equivalent, false otherwise.
+         */
+        bool operator!=(const BDD& other) const;
+
+        /**
+         * Combine two BDDs using an AND operator.
+         *
+         * @param[in] other - The BDD to combine with.
+         * @returns The combined BDD.
+         */
+        BDD operator&(const BDD& other) const;
+
+        /**
+         * Combine two BDDs using an OR operator.
+         *
+         * @param[in] other - The BDD to combine with.
+         * @returns The combined BDD.
+         */
+        BDD operator|(const BDD& other) const;
+
+        /**
+         * Combine two BDDs using an XOR operator.
+         *
+         * @param[in] other - The BDD to combine with.
+         * @returns The combined BDD.
+         */
+        BDD operator^(const BDD& other) const;
+
+        /**
+         * Combine two BDDs using an AND operator in-place.
+         *
+         * @param[in] other - The BDD to combine with.
+         * @returns The combined BDD.
+         */
+        BDD& operator&=(const BDD& other);
+
+        /**
+         * Combine two BDDs using an OR operator in-place.
+         *
+         * @param[in] other - The BDD to combine with.
+         * @returns The combined BDD.
+         */
+        BDD& operator|=(const BDD& other);
+
+        /**
+         * Combine two BDDs using an XOR operator in-place.
+         *
+         * @param[in] other - The BDD to combine with.
+         * @returns The combined BDD.
+         */
+        BDD& operator^=(const BDD& other);
+
+        /**
+         * Negate the BDD.
+         *
+         * @returns The negated BDD.
+         */
+        BDD operator~() const;
+
+    private:
+        friend class BDDManager;
+
+        BDD(BDDManager* manager, u32 node);
+
+        BDDManager* m_manager = nullptr;
+        u32 m_node            = 0;
+    };
+
+    /**
+     * Manager for reduced ordered binary decision diagrams (ROBDDs).
+     *
+     * All nodes are stored in per-variable unique tables, which guarantees that each function is represented by exactly one node.
+     * Results of the recursive operations are memoized in a computed table.
+     * Nodes that are no longer referenced by any BDD handle are reclaimed by a garbage collector and the variable order can be optimized using sifting.
+     *
+     * @ingroup netlist
+     */
+    class NETLIST_API BDDManager
+    {
+    public:
+        /**
+         * Construct a new BDD manager.
+         *
+         * @param[in] computed_table_size - The number of entries of the computed table, rounded up to a power of two.
+         */
+        BDDManager(u32 computed_table_size = 1 << 18);
+
+        BDDManager(const BDDManager&) = delete;
+        BDDManager& operator=(const BDDManager&) = delete;
+
+        /**
+         * Get the BDD of a constant.
+         *
+         * @param[in] value - The constant value.
+         * @returns The constant BDD.
+         */
+        BDD get_constant(bool value);
+
+        /**
+         * Get the BDD of a single variable.
+         * If the variable is not yet known to the manager, it is appended to the end of the variable order.
+         *
+         * @param[in] name - The name of the variable.
+         * @returns The BDD of the variable.
+         */
+        BDD get_variable(const std::string& name);
+
+        /**
+         * Get the number of variables known to the manager.
+         *
+         * @returns The number of variables.
+         */
+        u32 get_variable_count() const;
+
+        /**
+         * Get the current variable order from the topmost to the bottommost variable.
+         *
+         * @returns The variable names in order.
+         */
+        std::vector<std::string> get_variable_order() const;
+
+        /**
+         * Set the variable order.
+         * Variables that are not yet known are created, known variables that are not part of the given order keep their relative order below the given ones.
+         * All existing BDDs remain valid.
+         *
+         * @param[in] order - The variable names from the topmost to the bottommost variable.
+         */
+        void set_variable_order(const std::vector<std::string>& order);
+
+        /**
+         * Compute the if-then-else operation `(f & g) | (~f & h)`.
+         *
+         * @param[in] f - The condition.
+         * @param[in] g - The BDD selected if the condition is ONE.
+         * @param[in] h - The BDD selected if the condition is ZERO.
+         * @returns The resulting BDD.
+         */
+        BDD ite(const BDD& f, const BDD& g, const BDD& h);
+
+        /**
+         * Get the cofactor of a BDD with respect to a single variable.
+         *
+         * @param[in] f - The BDD.
+         * @param[in] variable - The name of the variable.
+         * @param[in] value - The value the variable is fixed to.
+         * @returns The cofactor.
+         */
+        BDD get_cofactor(const BDD& f, const std::string& variable, bool value);
+
+        /**
+         * Existentially quantify a variable, i.e., compute the disjunction of both of its cofactors.
+         *
+         * @param[in] f - The BDD.
+         * @param[in] variable - The name of the variable.
+         * @returns The quantified BDD.
+         */
+        BDD exists(const BDD& f, const std::string& variable);
+
+        /**
+         * Get the names of all variables a BDD depends on, ordered by the current variable order.
+         *
+         * @param[in] f - The BDD.
+         * @returns The support variables.
+         */
+        std::vector<std::string> get_support(const BDD& f) const;
+
+        /**
+         * Get the number of satisfying assignments of a BDD.
+         * The count is computed over `num_variables` variables, which must be at least the size of the support of the BDD.
+         *
+         * @param[in] f - The BDD.
+         * @param[in] num_variables - The number of variables of the input space.
+         * @returns The number of satisfying assignments or -1 on error.
+         */
+        double get_sat_count(const BDD& f, u32 num_variables) const;
+
+        /**
+         * Get the fraction of all input assignments that satisfy a BDD.
+         *
+         * @param[in] f - The BDD.
+         * @returns The fraction of satisfying assignments within [0, 1].
+         */
+        double get_sat_probability(const BDD& f) const;
+
+        /**
+         * Get the exact Boolean influence of a variable, i.e., the probability that flipping the variable changes the output under a uniformly random input.
+         *
+         * @param[in] f - The BDD.
+         * @param[in] variable - The name of the variable.
+         * @returns The Boolean influence within [0, 1] or -1 on error, e.g., for an unknown variable or if the node limit is exceeded.
+         */
+        double get_boolean_influence(const BDD& f, const std::string& variable);
+
+        /**
+         * Get the exact Boolean influence of every variable in the support of a BDD.
+         * Variables whose influence cannot be computed are left out.
+         *
+         * @param[in] f - The BDD.
+         * @returns A map from variable names to their Boolean influence.
+         */
+        std::map<std::string, double> get_boolean_influences(const BDD& f);
+
+        /**
+         * Get a disjoint sum-of-products cover of a BDD that contains one product term for each path to the ONE terminal.
+         * Each product term assigns ZERO, ONE, or X (don't care) to the given variables in order.
+         *
+         * @param[in] f - The BDD.
+         * @param[in] variables - The variables of the product terms, which must include the support of the BDD.
+         * @param[in] max_cubes - The maximum number of product terms, 0 for no limit.
+         * @returns The product terms or an empty vector if the BDD is constant ZERO, on error, or if the cover exceeds max_cubes.
+         */
+        std::vector<std::vector<BooleanFunction::Value>> get_cover(const BDD& f, const std::vector<std::string>& variables, u32 max_cubes = 0) const;
+
+        /**
+         * Get a sum-of-products cover of a BDD using an Espresso-style heuristic.
+         * The initial cover, by default the disjoint cover of get_cover(), is first expanded into prime implicants and made irredundant.
+         * Afterwards, reduce, expand, and irredundant steps are iterated as long as the number of product terms or literals decreases.
+         * All implication checks are done on the BDD, hence the OFF-set is never enumerated.
+         * Each product term assigns ZERO, ONE, or X (don't care) to the given variables in order.
+         *
+         * @param[in] f - The BDD.
+         * @param[in] variables - The variables of the product terms, which must include the support of the BDD.
+         * @param[in] effort - The maximum number of reduce-expand-irredundant iterations.
+         * @param[in] max_cubes - The maximum number of product terms of the initial cover, 0 for no limit.
+         * @param[in] time_budget_ms - The time in milliseconds after which the current cover is returned without further improvements, 0 for no limit.
+         * @param[in] initial_cover - An existing cover of exactly the function of the BDD to start from, e.g., a sum-of-products representation it was built from. If empty, the cover of get_cover() is used.
+         * @returns The product terms or an empty vector if the BDD is constant ZERO, on error, or if the initial cover exceeds max_cubes.
+         */
+        std::vector<std::vector<BooleanFunction::Value>> get_minimized_cover(const BDD& f,
+                                                                             const std::vector<std::string>& variables,
+                                                                             u32 effort                                                            = 2,
+                                                                             u32 max_cubes                                                         = 0,
+                                                                             u32 time_budget_ms                                                    = 0,
+                                                                             const std::vector<std::vector<BooleanFunction::Value>>& initial_cover = {}) const;
+
+        /**
+         * Convert a BDD into a Boolean function by Shannon expansion at each node.
+         *
+         * WARNING: The size of the result grows with the number of paths through the BDD, which may be exponential in the number of nodes.
+         *
+         * @param[in] f - The BDD.
+         * @returns The Boolean function.
+         */
+        BooleanFunction to_boolean_function(const BDD& f) const;
+
+        /**
+         * Get the number of nodes that are currently allocated by the manager including dead ones, excluding the two terminal nodes.
+         *
+         * @returns The number of allocated nodes.
+         */
+        u32 get_node_count() const;
+
+        /**
+         * Reclaim all nodes that are no longer referenced by any BDD and clear the computed table.
+         *
+         * @returns The number of reclaimed nodes.
+         */
+        u32 collect_garbage();
+
+        /**
+         * Optimize the variable order using Rudell's sifting algorithm in order to reduce the number of nodes.
+         * All existing BDDs remain valid.
+         *
+         * @returns The number of nodes after reordering.
+         */
+        u32 reorder();
+
+        /**
+         * Enable or disable automatic reordering.
+         * If enabled, sifting is triggered before an operation whenever the number of nodes exceeds a threshold, which is doubled after each run.
+         *
+         * @param[in] enable - True to enable automatic reordering, false to disable it.
+         * @param[in] threshold - The initial number of nodes that triggers reordering.
+         */
+        void set_auto_reorder(bool enable, u32 threshold = 4096);
+
+        /**
+         * Limit the number of nodes of the manager.
+         * Operations that would exceed the limit are aborted and return an invalid BDD, which allows callers to bail out of exponential blow-ups.
+         *
+         * @param[in] max_nodes - The maximum number of nodes, 0 for no limit.
+         */
+        void set_node_limit(u32 max_nodes);
+
+    private:
+        friend class BDD;
+
+        static constexpr u32 INVALID_NODE = ~0u;
+        static constexpr u32 TERMINAL_VAR = ~0u;
+
+        enum Operation : u32
+        {
+            OP_AND,
+            OP_OR,
+            OP_XOR,
+            OP_NOT,
+            OP_ITE,
+            OP_RESTRICT,
+        };
+
+        struct Node
+        {
+            u32 var;
+            u32 low;
+            u32 high;
+            u32 ref;
+            u32 next;
+        };
+
+        struct Subtable
+        {
+            std::vector<u32> buckets;
+            u32 size = 0;
+        };
+
+        struct CacheEntry
+        {
+            u32 op = INVALID_NODE;
+            u32 f;
+            u32 g;
+            u32 h;
+            u32 result;
+        };
+
+        std::vector<Node> m_nodes;
+        std::vector<u32> m_free_nodes;
+        u32 m_node_count = 0;
+        u32 m_dead_count = 0;
+
+        std::vector<Subtable> m_subtables;
+        std::vector<u32> m_var_to_level;
+        std::vector<u32> m_level_to_var;
+        std::vector<std::string> m_var_names;
+        std::unordered_map<std::string, u32> m_name_to_var;
+
+        std::vector<CacheEntry> m_computed_table;
+
+        u32 m_gc_threshold;
+        bool m_auto_reorder     = false;
+        u32 m_reorder_threshold = 4096;
+        u32 m_node_limit        = 0;
+        bool m_limit_exceeded   = false;
+
+        void ref(u32 node);
+        void deref(u32 node);
+        void deref_and_free(u32 node);
+
+        u32 level_of(u32 node) const;
+        u32 make_node(u32 var, u32 low, u32 high);
+        void insert_node(u32 node);
+        void unlink_node(u32 node);
+        void free_node(u32 node);
+
+        bool lookup_cache(u32 op, u32 f, u32 g, u32 h, u32& result) const;
+        void insert_cache(u32 op, u32 f, u32 g, u32 h, u32 result);
+        void clear_cache();
+
+        void prepare_operation();
+        BDD finish_operation(u32 node);
+        bool check_handle(const BDD& f) const;
+        u32 find_variable(const std::string& name) const;
+        u32 create_variable(const std::string& name);
+
+        u32 apply_binary(Operation op, u32 f, u32 g);
+        u32 apply_not(u32 f);
+        u32 apply_ite(u32 f, u32 g, u32 h);
+        u32 apply_restrict(u32 f, u32 var, bool value);
+
+        double sat_probability(u32 node, std::unordered_map<u32, double>& cache) const;
+        bool map_variables(const BDD& f, const std::vector<std::string>& variables, std::vector<u32>& position_of_var) const;
+        bool enumerate_paths(u32 node, const std::vector<u32>& position_of_var, std::vector<u8>& cube, std::vector<std::vector<u8>>& cubes, u32 max_cubes) const;
+
+        void swap_adjacent_levels(u32 level);
+        void sift_variable(u32 var);
+    };
+}    // namespace hal
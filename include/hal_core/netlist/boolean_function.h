@@ -36,6 +36,10 @@
 
 namespace hal
 {
+    class AIG;
+    class BDD;
+    class BDDManager;
+
     /**
      * Boolean function class.
      *
@@ -161,15 +165,19 @@ namespace hal
          * Supported operators are  NOT ("!", "'"), AND ("&", "*", " "), OR ("|", "+"), XOR ("^") and brackets ("(", ")").
          * Operator precedence is ! > & > ^ > |.
          *
-         * Since, for example, '(' is interpreted as a new term, but might also be an intended part of a variable, a vector of known variable names can be supplied, which are extracted before parsing.
+         * Operands that directly follow each other are combined using AND.
+         *
+         * Since, for example, '(' is interpreted as a new term, but might also be an intended part of a variable, a vector of known variable names can be supplied.
+         * Wherever one of them occurs in the expression, the longest matching name is treated as a variable.
          *
-         * If there is an error during bracket matching, X is returned for that part.
+         * If the expression cannot be parsed, the error and its position are logged and X is returned.
+         * Successfully parsed functions are cached process-wide, hence parsing the same expression again is cheap.
          *
          * @param[in] expression - String containing a Boolean function.
          * @param[in] variable_names - List of variable names.
          * @returns The Boolean function extracted from the string.
          */
-        static BooleanFunction from_string(std::string expression, const std::vector<std::string>& variable_names = {});
+        static BooleanFunction from_string(const std::string& expression, const std::vector<std::string>& variable_names = {});
 
         /**
          * Get the boolean function as a string.
@@ -293,12 +301,55 @@ namespace hal
         std::vector<std::vector<std::pair<std::string, bool>>> get_dnf_clauses() const;
 
         /**
-         * Optimizes the Boolean function by first converting it to disjunctive normal form (DNF) and then applying the Quine-McCluskey algorithm.
+         * Settings that control the effort of optimize().
+         */
+        struct OptimizationSettings
+        {
+            /**
+             * Functions that depend on at most this many variables are minimized exactly using the Quine-McCluskey algorithm.
+             */
+            u32 exact_variable_limit = 8;
+
+            /**
+             * The maximum number of reduce-expand-irredundant iterations of the heuristic minimization of larger functions.
+             */
+            u32 effort = 2;
+
+            /**
+             * The maximum number of product terms of the sum-of-products representation, 0 for no limit.
+             */
+            u32 max_terms = 4096;
+
+            /**
+             * The maximum number of BDD nodes used during optimization, 0 for no limit.
+             */
+            u32 max_bdd_nodes = 1 << 20;
+
+            /**
+             * The time in milliseconds after which the heuristic minimization returns its current result, 0 for no limit.
+             */
+            u32 time_budget_ms = 1000;
+        };
+
+        /**
+         * Optimizes the Boolean function into a minimized sum-of-products representation using the default optimization settings.
+         * Functions with few variables are minimized exactly using the Quine-McCluskey algorithm, larger functions are minimized by an Espresso-style heuristic on their BDD.
+         * If a limit is exceeded, the function is only simplified by removing constants.
          *
          * @returns The optimized Boolean function.
          */
         BooleanFunction optimize() const;
 
+        /**
+         * Optimizes the Boolean function into a minimized sum-of-products representation.
+         * Functions with few variables are minimized exactly using the Quine-McCluskey algorithm, larger functions are minimized by an Espresso-style heuristic on their BDD.
+         * If a limit is exceeded, the function is only simplified by removing constants.
+         *
+         * @param[in] settings - The optimization settings.
+         * @returns The optimized Boolean function.
+         */
+        BooleanFunction optimize(const OptimizationSettings& settings) const;
+
         /**
          * Removes constant values whenever possible.
          * 
@@ -330,6 +381,17 @@ namespace hal
          */
         z3::expr to_z3(z3::context& context) const;
 
+        /**
+         * Get the reduced ordered binary decision diagram (ROBDD) of the Boolean function.
+         * Variables that are not yet known to the manager are appended to its variable order in alphabetical order.
+         *
+         * Returns an invalid BDD if the Boolean function is empty or contains undefined values.
+         *
+         * @param[in,out] manager - The BDD manager.
+         * @returns The BDD representation of the Boolean function.
+         */
+        BDD to_bdd(BDDManager& manager) const;
+
     protected:
         enum class operation
         {
@@ -340,8 +402,6 @@ namespace hal
         static std::string to_string(const operation& op);
         friend std::ostream& operator<<(std::ostream& os, const operation& op);
 
-        static BooleanFunction from_string_internal(std::string expression, const std::vector<std::string>& variable_names);
-
         /*
         * Constructor for a function of the form "term1 op term2 op term3 op ..."
         * Empty terms behaves like constant X.
@@ -369,11 +429,24 @@ namespace hal
         // merges nested expressions of the same operands
         static std::vector<std::vector<Value>> qmc(std::vector<std::vector<Value>> terms);
 
+        // computes all prime implicants of a function given by the ON-set bits of its truth table, where bit i of an input refers to variable i
+        static std::vector<std::vector<Value>> get_prime_implicants(const std::vector<bool>& on_set, u32 num_variables);
+
         // helper to allow for substitution with reduced amount of copies
         static void substitute_helper(BooleanFunction& f, const std::string& v, const BooleanFunction& s);
 
         z3::expr to_z3_internal(z3::context& context, const std::unordered_map<std::string, z3::expr>& input2expr) const;
 
+        BDD to_bdd_internal(BDDManager& manager) const;
+
+        friend class AIG;
+        u32 to_aig_internal(AIG& aig, const std::unordered_map<std::string, u32>& variable_literals) const;
+
+        bool contains_undefined_values() const;
+
+        // checks whether the function evaluates to the given constant for all inputs
+        bool is_constant_value(Value value) const;
+
         bool m_invert;
 
         enum class content_type
@@ -65,6 +65,29 @@ namespace hal
          */
         CORE_API BooleanFunction get_subgraph_function(const Net* net, const std::vector<const Gate*>& subgraph_gates);
 
+        /**
+         * Get the combined Boolean functions of multiple nets, considering an entire subgraph.<br>
+         * Logic that is shared between the nets is only composed once, hence this is much faster than determining the function of each net separately.<br>
+         * The variables of the resulting Boolean functions are the net IDs of the nets that influence the outputs.
+         *
+         * @param[in] nets - The nets for which to generate the Boolean functions.
+         * @param[in] subgraph_gates - The gates making up the subgraph to consider.
+         * @param[inout] cache - Cache to speed up computations. The cache is filled by this function.
+         * @returns The combined Boolean functions in the order of the given nets, with an empty function for each net that caused an error.
+         */
+        CORE_API std::vector<BooleanFunction> get_subgraph_functions(const std::vector<const Net*>& nets, const std::vector<const Gate*>& subgraph_gates, std::unordered_map<u32, BooleanFunction>& cache);
+
+        /**
+         * Get the combined Boolean functions of multiple nets, considering an entire subgraph.<br>
+         * Logic that is shared between the nets is only composed once, hence this is much faster than determining the function of each net separately.<br>
+         * The variables of the resulting Boolean functions are the net IDs of the nets that influence the outputs.
+         *
+         * @param[in] nets - The nets for which to generate the Boolean functions.
+         * @param[in] subgraph_gates - The gates making up the subgraph to consider.
+         * @returns The combined Boolean functions in the order of the given nets, with an empty function for each net that caused an error.
+         */
+        CORE_API std::vector<BooleanFunction> get_subgraph_functions(const std::vector<const Net*>& nets, const std::vector<const Gate*>& subgraph_gates);
+
         /**
          * Get a deep copy of an entire netlist including all of its gates, nets, modules, and groupings.
          *
@@ -24,6 +24,8 @@
 #pragma once
 
 #include "hal_core/defines.h"
+#include "hal_core/netlist/aig.h"
+#include "hal_core/netlist/bdd.h"
 #include "hal_core/netlist/boolean_function.h"
 #include "hal_core/netlist/gate.h"
 #include "hal_core/netlist/gate_library/gate_library.h"
@@ -226,6 +228,20 @@ namespace hal
      */
     void boolean_function_init(py::module& m);
 
+    /**
+     * Initializes Python bindings for the HAL BDD and BDD manager in a python module.
+     *
+     * @param[in] m - the python module
+     */
+    void bdd_init(py::module& m);
+
+    /**
+     * Initializes Python bindings for the HAL AIG in a python module.
+     *
+     * @param[in] m - the python module
+     */
+    void aig_init(py::module& m);
+
     /**
      * @}
      */
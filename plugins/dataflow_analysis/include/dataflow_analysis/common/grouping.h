@@ -26,16 +26,85 @@
 #include "dataflow_analysis/common/netlist_abstraction.h"
 #include "hal_core/defines.h"
 
+#include <atomic>
+#include <memory>
+#include <mutex>
 #include <set>
 #include <shared_mutex>
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
 namespace hal
 {
     namespace dataflow
     {
+        /* 128-bit hash of the partition of a grouping */
+        using GroupingHash = std::pair<u64, u64>;
+
+        struct GroupingHashHasher
+        {
+            std::size_t operator()(const GroupingHash& hash) const
+            {
+                return hash.first;
+            }
+        };
+
+        /* gates of a single group, copies share the underlying set until one of them is modified */
+        class GroupGates
+        {
+        public:
+            using const_iterator = std::unordered_set<u32>::const_iterator;
+
+            GroupGates() = default;
+            GroupGates(std::unordered_set<u32> gates);
+
+            /* copies share the set, neither the copy nor the original modify it in place afterwards */
+            GroupGates(const GroupGates& other);
+            GroupGates(GroupGates&& other) noexcept;
+            GroupGates& operator=(const GroupGates& other);
+            GroupGates& operator=(GroupGates&& other) noexcept;
+
+            const_iterator begin() const;
+            const_iterator end() const;
+            const_iterator find(u32 gate) const;
+            u32 size() const;
+            bool empty() const;
+
+            void insert(u32 gate);
+
+            template<typename Iterator>
+            void insert(Iterator first, Iterator last)
+            {
+                mutable_gates().insert(first, last);
+            }
+
+            /* adds all gates of other, an empty group shares the set of other without copying it */
+            void unite(const GroupGates& other);
+
+            /* order-independent hash of the gates, computed once for each shared set */
+            const GroupingHash& get_hash() const;
+
+        private:
+            friend struct Grouping;
+
+            struct Data
+            {
+                std::unordered_set<u32> gates;
+                std::once_flag hash_flag;
+                GroupingHash hash;
+                std::atomic<bool> hashed{false};
+            };
+
+            std::shared_ptr<Data> m_data;
+
+            // only a set that was created by this handle and never handed out is modified in place
+            mutable std::atomic<bool> m_owned{false};
+
+            std::unordered_set<u32>& mutable_gates();
+        };
+
         struct Grouping
         {
             Grouping(const NetlistAbstraction& na);
@@ -46,12 +115,15 @@ namespace hal
 
             std::unordered_map<u32, std::vector<u32>> group_control_fingerprint_map;
 
-            std::unordered_map<u32, std::unordered_set<u32>> gates_of_group;
+            std::unordered_map<u32, GroupGates> gates_of_group;
             std::unordered_map<u32, u32> parent_group_of_gate;
 
             bool operator==(const Grouping& other) const;
             bool operator!=(const Grouping& other) const;
 
+            /* canonical hash of the partition, independent of group ids and iteration order, equal groupings have equal hashes */
+            const GroupingHash& get_hash() const;
+
             std::unordered_set<u32> get_clock_signals_of_group(u32 group_id);
             std::unordered_set<u32> get_control_signals_of_group(u32 group_id);
             std::unordered_set<u32> get_reset_signals_of_group(u32 group_id);
@@ -72,11 +144,14 @@ namespace hal
                 std::unordered_map<u32, std::unordered_set<u32>> suc_cache;
                 std::unordered_map<u32, std::unordered_set<u32>> pred_cache;
                 std::set<std::set<u32>> comparison_cache;
+                bool comparison_cache_valid = false;
+                GroupingHash hash_cache;
+                bool hash_cache_valid = false;
             } cache;
 
             const std::set<std::set<u32>>& get_comparison_data() const;
 
-            std::unordered_set<u32> get_signals_of_group(u32 group_id, const std::unordered_map<u32, std::unordered_set<u32>>& signals);
+            std::unordered_set<u32> get_signals_of_group(u32 group_id, const GateTable& signals);
         };
     }    // namespace dataflow
 }    // namespace hal
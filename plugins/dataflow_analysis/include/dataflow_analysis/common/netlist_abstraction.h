@@ -25,8 +25,6 @@
 
 #include "hal_core/defines.h"
 
-#include <unordered_map>
-#include <unordered_set>
 #include <vector>
 
 namespace hal
@@ -39,12 +37,79 @@ namespace hal
     {
         struct Grouping;
 
+        /* index of a gate that is not a sequential gate of the netlist abstraction */
+        constexpr u32 INVALID_GATE_INDEX = 0xFFFFFFFF;
+
+        /* compressed sparse row table, holds a sorted and duplicate-free list of values per sequential gate index */
+        struct GateTable
+        {
+            struct Row
+            {
+                const u32* first;
+                const u32* last;
+
+                const u32* begin() const
+                {
+                    return first;
+                }
+
+                const u32* end() const
+                {
+                    return last;
+                }
+
+                u32 size() const
+                {
+                    return last - first;
+                }
+
+                bool empty() const
+                {
+                    return first == last;
+                }
+
+                bool contains(u32 value) const;
+            };
+
+            std::vector<u32> offsets;
+            std::vector<u32> values;
+
+            /* replaces the content with the given rows, rows are sorted and deduplicated in place */
+            void assign(std::vector<std::vector<u32>>& rows);
+
+            /* returns an empty row for indices outside the table, e.g., INVALID_GATE_INDEX */
+            Row operator[](u32 index) const;
+        };
+
         struct NetlistAbstraction
         {
             NetlistAbstraction(Netlist* nl_arg);
 
             std::shared_ptr<Grouping> create_initial_grouping() const;
 
+            /* dense index of a sequential gate, i.e., its position in all_sequential_gates, or INVALID_GATE_INDEX */
+            u32 get_index(u32 gate_id) const
+            {
+                return gate_id < gate_index.size() ? gate_index[gate_id] : INVALID_GATE_INDEX;
+            }
+
+            const std::vector<u32>& get_fingerprint(u32 gate_id) const;
+
+            GateTable::Row get_successors(u32 gate_id) const
+            {
+                return successors[get_index(gate_id)];
+            }
+
+            GateTable::Row get_predecessors(u32 gate_id) const
+            {
+                return predecessors[get_index(gate_id)];
+            }
+
+            GateTable::Row get_register_stages(u32 gate_id) const
+            {
+                return register_stages[get_index(gate_id)];
+            }
+
             // netlist
             Netlist* nl;
 
@@ -54,17 +119,18 @@ namespace hal
             // all ffs
             std::vector<Gate*> all_sequential_gates;
 
-            /* pre_processed_data */
-            std::unordered_map<u32, std::vector<u32>> gate_to_fingerprint;
-            std::unordered_map<u32, std::unordered_set<u32>> gate_to_clock_signals;
-            std::unordered_map<u32, std::unordered_set<u32>> gate_to_enable_signals;
-            std::unordered_map<u32, std::unordered_set<u32>> gate_to_reset_signals;
-            std::unordered_map<u32, std::unordered_set<u32>> gate_to_set_signals;
-            std::unordered_map<u32, std::unordered_set<u32>> gate_to_register_stages;
-            std::unordered_map<u32, std::unordered_set<u32>> gate_to_predecessors;
-            std::unordered_map<u32, std::unordered_set<u32>> gate_to_successors;
-            std::unordered_map<u32, std::vector<std::vector<u32>>> gate_to_output_shape;
-            std::unordered_map<u32, std::vector<std::vector<u32>>> gate_to_input_shape;
+            // gate id -> index into all_sequential_gates
+            std::vector<u32> gate_index;
+
+            /* pre_processed_data, indexed by the dense sequential gate index */
+            std::vector<std::vector<u32>> fingerprints;
+            GateTable clock_signals;
+            GateTable enable_signals;
+            GateTable reset_signals;
+            GateTable set_signals;
+            GateTable register_stages;
+            GateTable predecessors;    // gate ids
+            GateTable successors;      // gate ids
         };
     }    // namespace dataflow
 }    // namespace hal
\ No newline at end of file
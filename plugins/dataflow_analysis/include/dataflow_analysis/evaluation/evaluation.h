@@ -33,9 +33,14 @@ namespace hal
 {
     namespace dataflow
     {
+        namespace utils
+        {
+            class thread_pool;
+        }
+
         namespace evaluation
         {
-            evaluation::Result run(const Configuration& config, Context& ctx, const std::shared_ptr<Grouping>& initial_grouping, const processing::Result& result);
+            evaluation::Result run(const Configuration& config, Context& ctx, const std::shared_ptr<Grouping>& initial_grouping, const processing::Result& result, utils::thread_pool& pool);
         }    // namespace evaluation
     }        // namespace dataflow
 }
\ No newline at end of file
@@ -23,6 +23,7 @@
 
 #pragma once
 
+#include "dataflow_analysis/utils/thread_pool.h"
 #include "hal_core/plugin_system/plugin_interface_cli.h"
 
 #include <vector>
@@ -63,6 +64,33 @@ namespace hal
         /** interface implementation: i_cli */
         bool handle_cli_call(Netlist* nl, ProgramArguments& args) override;
 
+        /**
+         * Stop the worker threads of the dataflow analysis before the plugin is unloaded.
+         */
+        void on_unload() override;
+
+        /**
+         * Set the number of threads used by the dataflow analysis.
+         * A value of 0 uses the number of hardware threads, values above 1024 are rejected and the previous value is kept.
+         *
+         * @param[in] num_threads - The number of threads.
+         * @returns True on success, false otherwise.
+         */
+        bool set_num_threads(u32 num_threads);
+
+        /**
+         * Get the number of threads used by the dataflow analysis.
+         *
+         * @returns The number of threads, 0 if the number of hardware threads is used.
+         */
+        u32 get_num_threads() const;
+
         std::vector<std::vector<Gate*>> execute(Netlist* nl, std::string path, const std::vector<u32> sizes, bool draw_graph);
+
+    private:
+        u32 m_num_threads = 0;
+
+        // the pool is shared by pre-processing, processing, and evaluation
+        dataflow::utils::thread_pool m_thread_pool;
     };
 }    // namespace hal
\ No newline at end of file
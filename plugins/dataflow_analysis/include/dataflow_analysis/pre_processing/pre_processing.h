@@ -31,9 +31,14 @@ namespace hal
 
     namespace dataflow
     {
+        namespace utils
+        {
+            class thread_pool;
+        }
+
         namespace pre_processing
         {
-            NetlistAbstraction run(Netlist* netlist);
+            NetlistAbstraction run(Netlist* netlist, utils::thread_pool& pool);
         }    // namespace pre_processing
     }        // namespace dataflow
 }    // namespace hal
\ No newline at end of file
@@ -29,12 +29,17 @@ namespace hal
 {
     namespace dataflow
     {
+        namespace utils
+        {
+            class thread_pool;
+        }
+
         namespace processing
         {
             struct Configuration
             {
                 u32 pass_layers;
-                u32 num_threads;
+                utils::thread_pool* thread_pool;
             };
 
         }    // namespace processing
@@ -29,6 +29,7 @@
 
 #include <map>
 #include <shared_mutex>
+#include <unordered_map>
 
 namespace hal
 {
@@ -40,14 +41,14 @@ namespace hal
 
         namespace processing
         {
+            using GroupingLookup = std::unordered_multimap<GroupingHash, std::shared_ptr<Grouping>, GroupingHashHasher>;
+
             struct Context
             {
                 /* pass process */
-                bool done;
                 bool end_reached;
                 u32 phase;
 
-                u32 pass_counter;
                 u32 finished_passes;
                 u32 num_iterations;
 
@@ -60,8 +61,10 @@ namespace hal
                 std::vector<std::tuple<std::shared_ptr<Grouping>, pass_id, std::shared_ptr<Grouping>>> new_unique_groupings;
                 std::vector<std::tuple<std::shared_ptr<Grouping>, pass_id, std::shared_ptr<Grouping>>> new_recurring_results;
 
-                /* progress printing */
-                std::mutex progress_mutex;
+                /* unique groupings of previous layers by hash, only modified between layers */
+                GroupingLookup unique_grouping_lookup;
+                /* unique groupings of the current layer by hash, guarded by result_mutex */
+                GroupingLookup new_unique_grouping_lookup;
 
                 /* result */
                 std::mutex result_mutex;
@@ -129,7 +129,11 @@ namespace hal
             u32 get_terminal_width()
             {
                 struct winsize size;
-                ioctl(STDERR_FILENO, TIOCGWINSZ, &size);
+                if (ioctl(STDERR_FILENO, TIOCGWINSZ, &size) != 0 || size.ws_col == 0)
+                {
+                    // not a terminal, e.g., when running in a test or with redirected output
+                    return 80;
+                }
                 return size.ws_col;
             }
 
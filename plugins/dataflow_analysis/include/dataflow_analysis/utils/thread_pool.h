@@ -0,0 +1,113 @@
+//  MIT License
+//
+//  Copyright (c) 2019 Ruhr University Bochum, Chair for Embedded Security. All Rights reserved.
+//  Copyright (c) 2021 Max Planck Institute for Security and Privacy. All Rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+
+
+#pragma once
+
+#include "hal_core/defines.h"
+
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace hal
+{
+    namespace dataflow
+    {
+        namespace utils
+        {
+            /*
+             * Persistent pool of worker threads that is shared by all stages of a dataflow analysis.
+             * A new pool has no worker threads, loops are executed by the calling thread until the number of threads is set.
+             *
+             * The index range of a parallel loop is split into one range per thread.
+             * Every thread takes chunks from the front of its own range, each chunk being a quarter of what is left, so the chunks get smaller towards the end.
+             * Once its own range is exhausted, a thread steals the back half of the largest remaining range of another thread.
+             * Hence, expensive iterations do not leave other threads idle.
+             */
+            class thread_pool
+            {
+            public:
+                thread_pool() = default;
+                ~thread_pool();
+
+                thread_pool(const thread_pool&) = delete;
+                thread_pool& operator=(const thread_pool&) = delete;
+
+                /*
+                 * Set the number of threads working on a parallel loop, including the calling thread.
+                 * A value of 0 uses the number of hardware threads.
+                 */
+                void set_num_threads(u32 num_threads);
+
+                u32 get_num_threads() const;
+
+                /*
+                 * Stop all worker threads, loops are executed by the calling thread only until the number of threads is set again.
+                 */
+                void stop();
+
+                /*
+                 * Execute func(i) for all i in [begin, end) and return once all iterations are done.
+                 * Nested calls from within an iteration are executed sequentially by the calling thread.
+                 */
+                void parallel_for(u32 begin, u32 end, const std::function<void(u32)>& func);
+
+            private:
+                struct work_range
+                {
+                    std::mutex mutex;
+                    u32 begin;
+                    u32 end;
+                };
+
+                void stop_workers();
+                void worker_loop(u32 thread_idx);
+                void work_on_job(u32 thread_idx);
+                bool take_chunk(u32 thread_idx, u32& chunk_begin, u32& chunk_end);
+
+                std::vector<std::thread> m_workers;
+                u32 m_num_threads = 1;
+
+                // job state, guarded by m_mutex
+                std::mutex m_mutex;
+                std::condition_variable m_job_available;
+                std::condition_variable m_job_finished;
+                bool m_shutdown      = false;
+                bool m_job_open      = false;
+                u64 m_job_generation = 0;
+                u32 m_active_workers = 0;
+
+                // the current loop body and one work range per thread, the ranges have their own locks
+                const std::function<void(u32)>* m_job = nullptr;
+                std::vector<std::unique_ptr<work_range>> m_ranges;
+
+                // parallel loops are not reentrant, concurrent calls from different threads are serialized
+                std::mutex m_job_mutex;
+            };
+        }    // namespace utils
+    }        // namespace dataflow
+}    // namespace hal
@@ -42,6 +42,26 @@ namespace hal
                 :returns: Plugin version.
                 :rtype: str
                 )")
+            .def_property("num_threads", &plugin_dataflow::get_num_threads, &plugin_dataflow::set_num_threads, R"(
+                The number of threads used by the dataflow analysis, 0 if the number of hardware threads is used.
+                Values above 1024 are rejected and the previous value is kept.
+
+                :type: int
+                )")
+            .def("set_num_threads", &plugin_dataflow::set_num_threads, py::arg("num_threads"), R"(
+                Set the number of threads used by the dataflow analysis.
+                A value of 0 uses the number of hardware threads, values above 1024 are rejected and the previous value is kept.
+
+                :param int num_threads: The number of threads.
+                :returns: True on success, False otherwise.
+                :rtype: bool
+                )")
+            .def("get_num_threads", &plugin_dataflow::get_num_threads, R"(
+                Get the number of threads used by the dataflow analysis.
+
+                :returns: The number of threads, 0 if the number of hardware threads is used.
+                :rtype: int
+                )")
             // .def("get_cli_options", &plugin_dataflow::get_cli_options)
             // .def("handle_cli_call", &plugin_dataflow::handle_cli_call)
             .def("execute", &plugin_dataflow::execute, py::arg("netlist"), py::arg("output_path"), py::arg("sizes"), py::arg("draw_graph"), R"(
@@ -5,10 +5,152 @@
 #include "hal_core/netlist/netlist.h"
 #include "hal_core/utilities/log.h"
 
+#include <algorithm>
+
 namespace hal
 {
     namespace dataflow
     {
+        namespace
+        {
+            const std::unordered_set<u32> empty_gates;
+
+            // finalizer of splitmix64
+            u64 mix(u64 x)
+            {
+                x ^= x >> 30;
+                x *= 0xbf58476d1ce4e5b9ull;
+                x ^= x >> 27;
+                x *= 0x94d049bb133111ebull;
+                x ^= x >> 31;
+                return x;
+            }
+
+            // summing up mixed values makes the hash independent of the order of gates and groups
+            GroupingHash hash_group(const std::unordered_set<u32>& gates)
+            {
+                GroupingHash sum = {gates.size(), gates.size()};
+                for (u32 gate : gates)
+                {
+                    sum.first += mix(gate + 0x9e3779b97f4a7c15ull);
+                    sum.second += mix(gate + 0xd1b54a32d192ed03ull);
+                }
+                return {mix(sum.first), mix(sum.second ^ 0x8cb92ba72f3d8dd7ull)};
+            }
+        }    // namespace
+
+        GroupGates::GroupGates(std::unordered_set<u32> gates) : m_data(std::make_shared<Data>()), m_owned(true)
+        {
+            m_data->gates = std::move(gates);
+        }
+
+        GroupGates::GroupGates(const GroupGates& other) : m_data(other.m_data)
+        {
+            other.m_owned.store(false, std::memory_order_relaxed);
+        }
+
+        GroupGates::GroupGates(GroupGates&& other) noexcept : m_data(std::move(other.m_data)), m_owned(other.m_owned.load(std::memory_order_relaxed))
+        {
+            other.m_owned.store(false, std::memory_order_relaxed);
+        }
+
+        GroupGates& GroupGates::operator=(const GroupGates& other)
+        {
+            if (this != &other)
+            {
+                m_data = other.m_data;
+                m_owned.store(false, std::memory_order_relaxed);
+                other.m_owned.store(false, std::memory_order_relaxed);
+            }
+            return *this;
+        }
+
+        GroupGates& GroupGates::operator=(GroupGates&& other) noexcept
+        {
+            if (this != &other)
+            {
+                m_data = std::move(other.m_data);
+                m_owned.store(other.m_owned.load(std::memory_order_relaxed), std::memory_order_relaxed);
+                other.m_owned.store(false, std::memory_order_relaxed);
+            }
+            return *this;
+        }
+
+        GroupGates::const_iterator GroupGates::begin() const
+        {
+            return m_data ? m_data->gates.begin() : empty_gates.begin();
+        }
+
+        GroupGates::const_iterator GroupGates::end() const
+        {
+            return m_data ? m_data->gates.end() : empty_gates.end();
+        }
+
+        GroupGates::const_iterator GroupGates::find(u32 gate) const
+        {
+            return m_data ? m_data->gates.find(gate) : empty_gates.end();
+        }
+
+        u32 GroupGates::size() const
+        {
+            return m_data ? m_data->gates.size() : 0;
+        }
+
+        bool GroupGates::empty() const
+        {
+            return size() == 0;
+        }
+
+        void GroupGates::insert(u32 gate)
+        {
+            mutable_gates().insert(gate);
+        }
+
+        void GroupGates::unite(const GroupGates& other)
+        {
+            if (empty())
+            {
+                m_data = other.m_data;
+                m_owned.store(false, std::memory_order_relaxed);
+                other.m_owned.store(false, std::memory_order_relaxed);
+            }
+            else if (!other.empty())
+            {
+                mutable_gates().insert(other.begin(), other.end());
+            }
+        }
+
+        const GroupingHash& GroupGates::get_hash() const
+        {
+            static const GroupingHash empty_hash = hash_group(empty_gates);
+            if (!m_data)
+            {
+                return empty_hash;
+            }
+
+            std::call_once(m_data->hash_flag, [this] {
+                m_data->hash   = hash_group(m_data->gates);
+                m_data->hashed.store(true, std::memory_order_release);
+            });
+            return m_data->hash;
+        }
+
+        std::unordered_set<u32>& GroupGates::mutable_gates()
+        {
+            // a set that came from another handle or was already hashed is never modified in place
+            if (!m_data || !m_owned.load(std::memory_order_relaxed) || m_data->hashed.load(std::memory_order_acquire))
+            {
+                auto data = std::make_shared<Data>();
+                if (m_data)
+                {
+                    data->gates = m_data->gates;
+                }
+                m_data = std::move(data);
+                m_owned.store(true, std::memory_order_relaxed);
+            }
+            return m_data->gates;
+        }
+
         Grouping::Grouping(const NetlistAbstraction& na) : netlist_abstr(na)
         {
         }
@@ -22,16 +164,59 @@ namespace hal
 
         const std::set<std::set<u32>>& Grouping::get_comparison_data() const
         {
-            if (cache.comparison_cache.empty())
+            {
+                std::shared_lock lock(cache.mutex);
+                if (cache.comparison_cache_valid)
+                {
+                    return cache.comparison_cache;
+                }
+            }
+            std::unique_lock lock(cache.mutex);
+
+            // check again, since another thread might have gotten the unique lock first
+            if (!cache.comparison_cache_valid)
             {
                 for (const auto& it : gates_of_group)
                 {
                     cache.comparison_cache.emplace(it.second.begin(), it.second.end());
                 }
+                cache.comparison_cache_valid = true;
             }
             return cache.comparison_cache;
         }
 
+        const GroupingHash& Grouping::get_hash() const
+        {
+            {
+                std::shared_lock lock(cache.mutex);
+                if (cache.hash_cache_valid)
+                {
+                    return cache.hash_cache;
+                }
+            }
+            std::unique_lock lock(cache.mutex);
+
+            // check again, since another thread might have gotten the unique lock first
+            if (!cache.hash_cache_valid)
+            {
+                // empty groups are skipped, just like they collapse in the comparison data
+                GroupingHash hash = {0, 0};
+                for (const auto& it : gates_of_group)
+                {
+                    if (it.second.empty())
+                    {
+                        continue;
+                    }
+                    const auto& group_hash = it.second.get_hash();
+                    hash.first += group_hash.first;
+                    hash.second += group_hash.second;
+                }
+                cache.hash_cache       = hash;
+                cache.hash_cache_valid = true;
+            }
+            return cache.hash_cache;
+        }
+
         bool Grouping::operator==(const Grouping& other) const
         {
             if (gates_of_group.size() != other.gates_of_group.size())
@@ -39,6 +224,40 @@ namespace hal
                 return false;
             }
 
+            if (get_hash() != other.get_hash())
+            {
+                return false;
+            }
+
+            // groupings derived from one another share the sets of all groups that were left untouched
+            std::unordered_set<const void*> other_sets;
+            for (const auto& it : other.gates_of_group)
+            {
+                if (!it.second.empty())
+                {
+                    other_sets.insert(it.second.m_data.get());
+                }
+            }
+            bool all_shared = true;
+            u32 shared_sets = 0;
+            for (const auto& it : gates_of_group)
+            {
+                if (it.second.empty())
+                {
+                    continue;
+                }
+                if (other_sets.find(it.second.m_data.get()) == other_sets.end())
+                {
+                    all_shared = false;
+                    break;
+                }
+                ++shared_sets;
+            }
+            if (all_shared && shared_sets == other_sets.size())
+            {
+                return true;
+            }
+
             return get_comparison_data() == other.get_comparison_data();
         }
 
@@ -49,33 +268,37 @@ namespace hal
 
         std::unordered_set<u32> Grouping::get_clock_signals_of_group(u32 id)
         {
-            return get_signals_of_group(id, netlist_abstr.gate_to_clock_signals);
+            return get_signals_of_group(id, netlist_abstr.clock_signals);
         }
 
         std::unordered_set<u32> Grouping::get_control_signals_of_group(u32 id)
         {
-            return get_signals_of_group(id, netlist_abstr.gate_to_enable_signals);
+            return get_signals_of_group(id, netlist_abstr.enable_signals);
         }
 
         std::unordered_set<u32> Grouping::get_reset_signals_of_group(u32 id)
         {
-            return get_signals_of_group(id, netlist_abstr.gate_to_reset_signals);
+            return get_signals_of_group(id, netlist_abstr.reset_signals);
         }
 
         std::unordered_set<u32> Grouping::get_set_signals_of_group(u32 id)
         {
-            return get_signals_of_group(id, netlist_abstr.gate_to_set_signals);
+            return get_signals_of_group(id, netlist_abstr.set_signals);
         }
 
-        std::unordered_set<u32> Grouping::get_signals_of_group(u32 id, const std::unordered_map<u32, std::unordered_set<u32>>& signals)
+        std::unordered_set<u32> Grouping::get_signals_of_group(u32 id, const GateTable& signals)
         {
             std::unordered_set<u32> res;
 
+            // gates of a group mostly share their control signals, so identical rows are only inserted once
+            GateTable::Row previous = {nullptr, nullptr};
             for (auto gate : gates_of_group.at(id))
             {
-                if (auto it = signals.find(gate); it != signals.end())
+                auto row = signals[netlist_abstr.get_index(gate)];
+                if (!std::equal(row.begin(), row.end(), previous.begin(), previous.end()))
                 {
-                    res.insert(it->second.begin(), it->second.end());
+                    res.insert(row.begin(), row.end());
+                    previous = row;
                 }
             }
 
@@ -88,10 +311,9 @@ namespace hal
             for (auto gate : this->gates_of_group.at(id))
             {
                 // check if gate has register_stages
-                auto it = netlist_abstr.gate_to_register_stages.find(gate);
-                if (it != netlist_abstr.gate_to_register_stages.end())
+                auto gate_rs = netlist_abstr.get_register_stages(gate);
+                if (!gate_rs.empty())
                 {
-                    auto gate_rs = std::set<u32>(it->second.begin(), it->second.end());
                     if (intersect.empty())
                     {
                         intersect.insert(intersect.end(), gate_rs.begin(), gate_rs.end());
@@ -136,7 +358,7 @@ namespace hal
             std::unordered_set<u32> successors;
             for (auto gate : gates_of_group.at(id))
             {
-                for (auto gate_id : netlist_abstr.gate_to_successors.at(gate))
+                for (auto gate_id : netlist_abstr.get_successors(gate))
                 {
                     successors.insert(parent_group_of_gate.at(gate_id));
                 }
@@ -167,7 +389,7 @@ namespace hal
             std::unordered_set<u32> predecessors;
             for (auto gate : gates_of_group.at(id))
             {
-                for (auto gate_id : netlist_abstr.gate_to_predecessors.at(gate))
+                for (auto gate_id : netlist_abstr.get_predecessors(gate))
                 {
                     predecessors.insert(parent_group_of_gate.at(gate_id));
                 }
@@ -6,14 +6,52 @@
 #include "hal_core/plugin_system/plugin_manager.h"
 #include "hal_core/utilities/log.h"
 
+#include <algorithm>
+
 namespace hal
 {
     namespace dataflow
     {
+        bool GateTable::Row::contains(u32 value) const
+        {
+            return std::binary_search(first, last, value);
+        }
+
+        void GateTable::assign(std::vector<std::vector<u32>>& rows)
+        {
+            offsets.clear();
+            values.clear();
+
+            offsets.reserve(rows.size() + 1);
+            offsets.push_back(0);
+            for (auto& row : rows)
+            {
+                std::sort(row.begin(), row.end());
+                row.erase(std::unique(row.begin(), row.end()), row.end());
+                values.insert(values.end(), row.begin(), row.end());
+                offsets.push_back(values.size());
+            }
+            values.shrink_to_fit();
+        }
+
+        GateTable::Row GateTable::operator[](u32 index) const
+        {
+            if (offsets.empty() || index >= offsets.size() - 1)
+            {
+                return {nullptr, nullptr};
+            }
+            return {values.data() + offsets[index], values.data() + offsets[index + 1]};
+        }
+
         NetlistAbstraction::NetlistAbstraction(Netlist* nl_arg) : nl(nl_arg)
         {
         }
 
+        const std::vector<u32>& NetlistAbstraction::get_fingerprint(u32 gate_id) const
+        {
+            return fingerprints.at(get_index(gate_id));
+        }
+
         std::shared_ptr<Grouping> NetlistAbstraction::create_initial_grouping() const
         {
             /* create state */
@@ -26,7 +64,7 @@ namespace hal
             {
                 u32 new_group_id = ++new_id_counter;
 
-                new_state->group_control_fingerprint_map[new_group_id] = this->gate_to_fingerprint.at(gate->get_id());
+                new_state->group_control_fingerprint_map[new_group_id] = this->get_fingerprint(gate->get_id());
 
                 new_state->gates_of_group[new_group_id].insert(gate->get_id());
                 new_state->parent_group_of_gate[gate->get_id()] = new_group_id;
@@ -99,7 +99,7 @@ namespace hal
             {
                 std::unordered_set<u32> unordered_gates(group_sg.begin(), group_sg.end());
                 auto gate_id     = *group_sg.begin();
-                const auto& fingerprint = netlist_abstr.gate_to_fingerprint.at(gate_id);
+                const auto& fingerprint = netlist_abstr.get_fingerprint(gate_id);
                 sorted_results[fingerprint][group_votes].push_back(unordered_gates);
             }
 
@@ -108,7 +108,7 @@ namespace hal
             {
                 // get the control signals of the current control_group
                 auto gate_id     = *control_group.begin();
-                const auto& fingerprint = netlist_abstr.gate_to_fingerprint.at(gate_id);
+                const auto& fingerprint = netlist_abstr.get_fingerprint(gate_id);
 
                 // get all groups from all result states with the same control singals
                 const auto& result_groups = sorted_results.at(fingerprint);
@@ -164,7 +164,7 @@ namespace hal
 
                             std::unordered_set<u32> new_single_group;
 
-                            const auto& reg_stages = netlist_abstr.gate_to_register_stages.at(gate);
+                            const auto& reg_stages = netlist_abstr.get_register_stages(gate);
                             std::set<u32> register_stage_intersect(reg_stages.begin(), reg_stages.end());
 
                             const auto& type = netlist_abstr.nl->get_gate_by_id(gate)->get_type();
@@ -178,7 +178,7 @@ namespace hal
                                 const auto& test_type = netlist_abstr.nl->get_gate_by_id(gate)->get_type();
                                 if (type == test_type)
                                 {
-                                    const auto& test_reg_stages = netlist_abstr.gate_to_register_stages.at(test_gate);
+                                    const auto& test_reg_stages = netlist_abstr.get_register_stages(test_gate);
                                     std::set<u32> sorted_test_reg_stages(test_reg_stages.begin(), test_reg_stages.end());
 
                                     std::set<u32> new_intersect;
@@ -218,7 +218,7 @@ namespace hal
             {
                 u32 new_group_id = ++id_counter;
 
-                output->group_control_fingerprint_map[new_group_id] = netlist_abstr.gate_to_fingerprint.at(*group.begin());
+                output->group_control_fingerprint_map[new_group_id] = netlist_abstr.get_fingerprint(*group.begin());
 
                 output->gates_of_group.emplace(new_group_id, group);
                 for (const auto& sg : group)
@@ -233,7 +233,7 @@ namespace hal
         }
         */
 
-                std::shared_ptr<Grouping> generate_output(const Configuration& config, const std::shared_ptr<Grouping>& initial_grouping, const scoring& scores)
+                std::shared_ptr<Grouping> generate_output(const Configuration& config, const std::shared_ptr<Grouping>& initial_grouping, const scoring& scores, utils::thread_pool& pool)
                 {
                     measure_block_time("majority voting");
                     auto& netlist_abstr = initial_grouping->netlist_abstr;
@@ -353,7 +353,7 @@ namespace hal
                         // scan the first few groups
                         std::vector<float> badness_score_of_group(num_scanned_groups, 0.0f);
 
-                        utils::parallel_for_each(0, num_scanned_groups, [&](u32 scanned_group_idx) {
+                        utils::parallel_for_each(pool, 0, num_scanned_groups, [&](u32 scanned_group_idx) {
                             auto& scanned_group = *sorted_results[scanned_group_idx].group;
                             // get all unassigned gates that are not in this group
                             std::vector<u32> unaffected_gates;
@@ -405,7 +405,7 @@ namespace hal
                         {
                             u32 new_group_id = ++id_counter;
 
-                            output->group_control_fingerprint_map[new_group_id] = netlist_abstr.gate_to_fingerprint.at(*best_group.begin());
+                            output->group_control_fingerprint_map[new_group_id] = netlist_abstr.get_fingerprint(*best_group.begin());
 
                             output->gates_of_group[new_group_id].insert(best_group.begin(), best_group.end());
                             for (const auto& sg : best_group)
@@ -433,7 +433,7 @@ namespace hal
                     {
                         u32 new_group_id = ++id_counter;
 
-                        output->group_control_fingerprint_map[new_group_id] = netlist_abstr.gate_to_fingerprint.at(g);
+                        output->group_control_fingerprint_map[new_group_id] = netlist_abstr.get_fingerprint(g);
 
                         output->gates_of_group[new_group_id].insert(g);
                         output->parent_group_of_gate[g] = new_group_id;
@@ -443,7 +443,7 @@ namespace hal
 
             }    // namespace
 
-            evaluation::Result run(const Configuration& config, Context& ctx, const std::shared_ptr<Grouping>& initial_grouping, const processing::Result& result)
+            evaluation::Result run(const Configuration& config, Context& ctx, const std::shared_ptr<Grouping>& initial_grouping, const processing::Result& result, utils::thread_pool& pool)
             {
                 evaluation::Result output;
                 output.is_final_result = false;
@@ -483,7 +483,7 @@ namespace hal
         return output;
         */
 
-                output.merged_result = generate_output(config, initial_grouping, scores);
+                output.merged_result = generate_output(config, initial_grouping, scores, pool);
 
                 if (std::any_of(ctx.partial_results.begin(), ctx.partial_results.end(), [&](auto& seen) { return *seen == *output.merged_result; }))
                 {
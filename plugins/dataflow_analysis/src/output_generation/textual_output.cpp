@@ -49,9 +49,9 @@ namespace hal
                         auto type          = "type: " + state->netlist_abstr.nl->get_gate_by_id(single_ff)->get_type()->get_name() + ", ";
                         auto id            = "id: " + std::to_string(state->netlist_abstr.nl->get_gate_by_id(single_ff)->get_id()) + ", ";
                         std::string stages = "RS: ";
-                        if (auto it = state->netlist_abstr.gate_to_register_stages.find(single_ff); it != state->netlist_abstr.gate_to_register_stages.end())
+                        if (auto gate_rs = state->netlist_abstr.get_register_stages(single_ff); !gate_rs.empty())
                         {
-                            stages += "{" + utils::join(", ", std::set<u32>(it->second.begin(), it->second.end())) + "}";
+                            stages += "{" + utils::join(", ", gate_rs) + "}";
                         }
 
                         std::vector<std::string> data = {name, type, id, stages};
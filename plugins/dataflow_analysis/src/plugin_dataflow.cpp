@@ -14,6 +14,7 @@
 #include "dataflow_analysis/pre_processing/pre_processing.h"
 #include "dataflow_analysis/processing/passes/group_by_control_signals.h"
 #include "dataflow_analysis/processing/processing.h"
+#include "dataflow_analysis/utils/thread_pool.h"
 #include "dataflow_analysis/utils/timing_utils.h"
 #include "hal_core/netlist/gate.h"
 #include "hal_core/netlist/netlist.h"
@@ -21,17 +22,24 @@
 #include "hal_core/plugin_system/plugin_manager.h"
 #include "hal_core/utilities/log.h"
 
+#include <algorithm>
 #include <chrono>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <limits>
 #include <sstream>
 #include <sys/stat.h>
 #include <sys/types.h>
-#include <thread>
 
 namespace hal
 {
+    namespace
+    {
+        // upper bound for the number of threads, larger values are most likely typos
+        const u32 MAX_THREADS = 1024;
+    }    // namespace
+
     extern std::unique_ptr<BasePluginInterface> create_plugin_instance()
     {
         return std::make_unique<plugin_dataflow>();
@@ -57,6 +65,8 @@ namespace hal
 
         description.add("--sizes", "(optional) sizes which should be prioritized", {""});
 
+        description.add("--threads", "(optional) number of threads, defaults to the number of hardware threads", {""});
+
         return description;
     }
 
@@ -89,6 +99,35 @@ namespace hal
             }
         }
 
+        if (args.is_option_set("--threads"))
+        {
+            std::string threads = args.get_parameter("--threads");
+            u32 num_threads     = 0;
+            try
+            {
+                size_t end          = 0;
+                unsigned long value = std::stoul(threads, &end);
+                if (end == threads.size() && threads.find('-') == std::string::npos)
+                {
+                    // values that do not fit are rejected by set_num_threads
+                    num_threads = std::min<unsigned long>(value, std::numeric_limits<u32>::max());
+                }
+            }
+            catch (const std::exception&)
+            {
+            }
+
+            if (num_threads == 0)
+            {
+                log_error("dataflow", "invalid number of threads '{}', expected a value between 1 and {}", threads, MAX_THREADS);
+                return false;
+            }
+            if (!set_num_threads(num_threads))
+            {
+                return false;
+            }
+        }
+
         if (execute(nl, path, sizes, false).empty())
         {
             return false;
@@ -97,6 +136,27 @@ namespace hal
         return true;
     }
 
+    void plugin_dataflow::on_unload()
+    {
+        m_thread_pool.stop();
+    }
+
+    bool plugin_dataflow::set_num_threads(u32 num_threads)
+    {
+        if (num_threads > MAX_THREADS)
+        {
+            log_error("dataflow", "invalid number of threads {}, expected a value between 1 and {} or 0 for the number of hardware threads", num_threads, MAX_THREADS);
+            return false;
+        }
+        m_num_threads = num_threads;
+        return true;
+    }
+
+    u32 plugin_dataflow::get_num_threads() const
+    {
+        return m_num_threads;
+    }
+
     std::vector<std::vector<Gate*>> plugin_dataflow::execute(Netlist* nl, std::string output_path, const std::vector<u32> sizes, bool draw_graph)
     {
         log("--- starting dataflow analysis ---");
@@ -157,7 +217,9 @@ namespace hal
 
         dataflow::processing::Configuration config;
         config.pass_layers = 2;
-        config.num_threads = std::thread::hardware_concurrency();
+        config.thread_pool = &m_thread_pool;
+
+        m_thread_pool.set_num_threads(m_num_threads);
 
         dataflow::evaluation::Context eval_ctx;
 
@@ -171,7 +233,7 @@ namespace hal
         }
 
         auto nl_copy       = netlist_utils::copy_netlist(nl);
-        auto netlist_abstr = dataflow::pre_processing::run(nl_copy.get());
+        auto netlist_abstr = dataflow::pre_processing::run(nl_copy.get(), m_thread_pool);
 
         auto initial_grouping = netlist_abstr.create_initial_grouping();
         std::shared_ptr<dataflow::Grouping> final_grouping;
@@ -193,7 +255,7 @@ namespace hal
             begin_time = std::chrono::high_resolution_clock::now();
 
             auto processing_result = dataflow::processing::run(config, initial_grouping);
-            auto eval_result       = dataflow::evaluation::run(eval_config, eval_ctx, initial_grouping, processing_result);
+            auto eval_result       = dataflow::evaluation::run(eval_config, eval_ctx, initial_grouping, processing_result, m_thread_pool);
 
             total_time += (double)std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - begin_time).count() / 1000;
 
@@ -27,8 +27,8 @@ namespace hal
                     std::queue<Gate*> gate_queue;
 
                     // loop to itself? if not return
-                    auto successors_of_start_gate = netlist_abstr.gate_to_successors.at(sg->get_id());
-                    if (successors_of_start_gate.find(sg->get_id()) == successors_of_start_gate.end())
+                    auto successors_of_start_gate = netlist_abstr.get_successors(sg->get_id());
+                    if (!successors_of_start_gate.contains(sg->get_id()))
                     {
                         return std::vector<Gate*>();
                     }
@@ -39,8 +39,8 @@ namespace hal
                     for (const auto successor_of_start_gate : successors_of_start_gate)
                     {
                         // first check: check if all form loop
-                        auto successors_of_successor = netlist_abstr.gate_to_successors.at(successor_of_start_gate);
-                        if (successors_of_successor.find(successor_of_start_gate) != successors_of_successor.end())
+                        auto successors_of_successor = netlist_abstr.get_successors(successor_of_start_gate);
+                        if (successors_of_successor.contains(successor_of_start_gate))
                         {
                             filtered_successors.emplace(successor_of_start_gate);
                         }
@@ -66,7 +66,7 @@ namespace hal
                     for (const auto successor_of_start_gate : filtered_successors)
                     {
                         auto gate_to_check           = netlist_abstr.nl->get_gate_by_id(successor_of_start_gate);
-                        auto successors_of_successor = netlist_abstr.gate_to_successors.at(successor_of_start_gate);
+                        auto successors_of_successor = netlist_abstr.get_successors(successor_of_start_gate);
                     }
                     for (const auto successor_of_start_gate : filtered_successors)
                     {
@@ -15,6 +15,7 @@
 #include <algorithm>
 #include <chrono>
 #include <deque>
+#include <mutex>
 #include <queue>
 
 namespace hal
@@ -63,7 +64,7 @@ namespace hal
                     return std::tuple(variables, f.get_truth_table(variables, true));
                 }
 
-                void merge_duplicated_logic_cones(NetlistAbstraction& netlist_abstr)
+                void merge_duplicated_logic_cones(NetlistAbstraction& netlist_abstr, utils::thread_pool& pool)
                 {
                     measure_block_time("merge duplicated logic cones");
 
@@ -87,7 +88,7 @@ namespace hal
                             characteristic_of_gate[gate] = {};
                         }
 
-                        utils::parallel_for_each(all_combinational_gates, [&characteristic_of_gate](auto& g) { characteristic_of_gate.at(g) = compute_merge_characteristic_of_gate(g); });
+                        utils::parallel_for_each(pool, all_combinational_gates, [&characteristic_of_gate](auto& g) { characteristic_of_gate.at(g) = compute_merge_characteristic_of_gate(g); });
                     }
 
                     log_info("dataflow", "merging gates...");
@@ -168,6 +169,17 @@ namespace hal
                     log_info("dataflow", "identifying sequential gates");
                     netlist_abstr.all_sequential_gates = netlist_abstr.nl->get_gates([&](auto g) { return g->get_type()->has_property(GateTypeProperty::ff); });
                     std::sort(netlist_abstr.all_sequential_gates.begin(), netlist_abstr.all_sequential_gates.end());
+
+                    u32 max_id = 0;
+                    for (auto sg : netlist_abstr.all_sequential_gates)
+                    {
+                        max_id = std::max(max_id, sg->get_id());
+                    }
+                    netlist_abstr.gate_index.assign(netlist_abstr.all_sequential_gates.empty() ? 0 : max_id + 1, INVALID_GATE_INDEX);
+                    for (u32 i = 0; i < netlist_abstr.all_sequential_gates.size(); ++i)
+                    {
+                        netlist_abstr.gate_index[netlist_abstr.all_sequential_gates[i]->get_id()] = i;
+                    }
                     log_info("dataflow", "  #gates: {}", netlist_abstr.nl->get_gates().size());
                     log_info("dataflow", "  #sequential gates: {}", netlist_abstr.all_sequential_gates.size());
                 }
@@ -176,84 +188,114 @@ namespace hal
                 {
                     auto begin_time = std::chrono::high_resolution_clock::now();
                     log_info("dataflow", "identifying control signals");
-                    for (auto sg : netlist_abstr.all_sequential_gates)
+
+                    u32 num_gates = netlist_abstr.all_sequential_gates.size();
+                    std::vector<std::vector<u32>> clock_signals(num_gates);
+                    std::vector<std::vector<u32>> enable_signals(num_gates);
+                    std::vector<std::vector<u32>> reset_signals(num_gates);
+                    std::vector<std::vector<u32>> set_signals(num_gates);
+                    netlist_abstr.fingerprints.assign(num_gates, {});
+
+                    for (u32 i = 0; i < num_gates; ++i)
                     {
-                        std::vector<u32> fingerprint;
-                        auto id = sg->get_id();
-                        sg->get_name();
+                        auto sg           = netlist_abstr.all_sequential_gates[i];
+                        auto& fingerprint = netlist_abstr.fingerprints[i];
 
                         for (auto net : netlist_utils::get_nets_at_pins(sg, sg->get_type()->get_pins_of_type(PinType::clock), true))
                         {
-                            netlist_abstr.gate_to_clock_signals[id].insert(net->get_id());
+                            clock_signals[i].push_back(net->get_id());
                             fingerprint.push_back(net->get_id());
                         }
 
                         for (auto net : netlist_utils::get_nets_at_pins(sg, sg->get_type()->get_pins_of_type(PinType::enable), true))
                         {
-                            netlist_abstr.gate_to_enable_signals[id].insert(net->get_id());
+                            enable_signals[i].push_back(net->get_id());
                             fingerprint.push_back(net->get_id());
                         }
 
                         for (auto net : netlist_utils::get_nets_at_pins(sg, sg->get_type()->get_pins_of_type(PinType::reset), true))
                         {
-                            netlist_abstr.gate_to_reset_signals[id].insert(net->get_id());
+                            reset_signals[i].push_back(net->get_id());
                             fingerprint.push_back(net->get_id());
                         }
 
                         for (auto net : netlist_utils::get_nets_at_pins(sg, sg->get_type()->get_pins_of_type(PinType::set), true))
                         {
-                            netlist_abstr.gate_to_set_signals[id].insert(net->get_id());
+                            set_signals[i].push_back(net->get_id());
                             fingerprint.push_back(net->get_id());
                         }
-
-                        netlist_abstr.gate_to_fingerprint[id] = fingerprint;
                     }
 
+                    netlist_abstr.clock_signals.assign(clock_signals);
+                    netlist_abstr.enable_signals.assign(enable_signals);
+                    netlist_abstr.reset_signals.assign(reset_signals);
+                    netlist_abstr.set_signals.assign(set_signals);
+
                     log_info("dataflow", "  done after {:3.2f}s", seconds_since(begin_time));
                 }
 
                 /* get all successor/predecessor FFs of all FFs */
-                void identify_all_succesors_predecessors_ffs_of_all_ffs(NetlistAbstraction& netlist_abstr)
+                void identify_all_succesors_predecessors_ffs_of_all_ffs(NetlistAbstraction& netlist_abstr, utils::thread_pool& pool)
                 {
                     log_info("dataflow", "identifying successors and predecessors of sequential gates...");
                     measure_block_time("identifying successors and predecessors of sequential gates") progress_printer progress_bar;
-                    float cnt = 0;
 
-                    std::unordered_map<u32, std::vector<Gate*>> cache;
+                    // the gates are split into fixed chunks with one cache each, so the result does not depend on the number of threads
+                    const u32 chunk_size = 256;
 
-                    for (const auto& single_ff : netlist_abstr.all_sequential_gates)
-                    {
-                        cnt++;
-                        progress_bar.print_progress(cnt / netlist_abstr.all_sequential_gates.size());
-                        // create sets even if there are no successors
-                        if (netlist_abstr.gate_to_successors.find(single_ff->get_id()) == netlist_abstr.gate_to_successors.end())
-                        {
-                            netlist_abstr.gate_to_successors[single_ff->get_id()] = std::unordered_set<u32>();
-                        }
-                        if (netlist_abstr.gate_to_predecessors.find(single_ff->get_id()) == netlist_abstr.gate_to_predecessors.end())
+                    // rows exist even if there are no successors
+                    u32 num_gates  = netlist_abstr.all_sequential_gates.size();
+                    u32 num_chunks = (num_gates + chunk_size - 1) / chunk_size;
+                    std::vector<std::vector<u32>> successors(num_gates);
+                    std::vector<std::vector<u32>> predecessors(num_gates);
+
+                    std::mutex progress_mutex;
+                    u32 finished_gates = 0;
+                    utils::parallel_for_each(pool, 0, num_chunks, [&](u32 chunk) {
+                        std::unordered_map<u32, std::vector<Gate*>> cache;
+                        u32 end = std::min(num_gates, (chunk + 1) * chunk_size);
+                        for (u32 i = chunk * chunk_size; i < end; ++i)
                         {
-                            netlist_abstr.gate_to_predecessors[single_ff->get_id()] = std::unordered_set<u32>();
+                            for (const auto& suc : netlist_utils::get_next_sequential_gates(netlist_abstr.all_sequential_gates[i], true, cache))
+                            {
+                                successors[i].push_back(suc->get_id());
+                            }
                         }
-                        for (const auto& suc : netlist_utils::get_next_sequential_gates(single_ff, true, cache))
+
+                        std::lock_guard guard(progress_mutex);
+                        finished_gates += end - chunk * chunk_size;
+                        progress_bar.print_progress((float)finished_gates / num_gates);
+                    });
+
+                    // predecessors are filled in the order of the gates, as if computed sequentially
+                    for (u32 i = 0; i < num_gates; ++i)
+                    {
+                        u32 gate_id = netlist_abstr.all_sequential_gates[i]->get_id();
+                        for (u32 suc_id : successors[i])
                         {
-                            netlist_abstr.gate_to_successors[single_ff->get_id()].insert(suc->get_id());
-                            netlist_abstr.gate_to_predecessors[suc->get_id()].insert(single_ff->get_id());
+                            if (auto suc_index = netlist_abstr.get_index(suc_id); suc_index != INVALID_GATE_INDEX)
+                            {
+                                predecessors[suc_index].push_back(gate_id);
+                            }
                         }
                     }
+
+                    netlist_abstr.successors.assign(successors);
+                    netlist_abstr.predecessors.assign(predecessors);
                     progress_bar.clear();
                 }
             }    // namespace
 
-            NetlistAbstraction run(Netlist* netlist)
+            NetlistAbstraction run(Netlist* netlist, utils::thread_pool& pool)
             {
                 log_info("dataflow", "pre-processing netlist...");
                 measure_block_time("pre-processing");
                 NetlistAbstraction netlist_abstr(netlist);
                 //remove_buffers(netlist_abstr);
                 identify_all_sequential_gates(netlist_abstr);
-                //merge_duplicated_logic_cones(netlist_abstr);
+                //merge_duplicated_logic_cones(netlist_abstr, pool);
                 identify_all_control_signals(netlist_abstr);
-                identify_all_succesors_predecessors_ffs_of_all_ffs(netlist_abstr);
+                identify_all_succesors_predecessors_ffs_of_all_ffs(netlist_abstr, pool);
                 //identify_counters(netlist_abstr);
                 //identify_register_stages(netlist_abstr);
                 return netlist_abstr;
@@ -28,55 +28,52 @@ namespace hal
                 struct stage_context
                 {
                     std::string name;
-                    const std::unordered_map<u32, std::unordered_set<u32>>& connections;
+                    const GateTable& connections;
                     std::vector<std::vector<u32>> stages;
                 };
 
-                std::vector<stage_context> directional_stages = {{"forward", netlist_abstr.gate_to_successors, {}}, {"backward", netlist_abstr.gate_to_predecessors, {}}};
+                std::vector<stage_context> directional_stages = {{"forward", netlist_abstr.successors, {}}, {"backward", netlist_abstr.predecessors, {}}};
 
                 for (auto& ctx : directional_stages)
                 {
                     log_info("dataflow", "directional register stages: {}", ctx.name);
 
-                    std::unordered_set<u32> unassigned_gates;
-                    for (const auto& g : netlist_abstr.all_sequential_gates)
-                    {
-                        unassigned_gates.insert(g->get_id());
-                    }
+                    u32 num_gates = netlist_abstr.all_sequential_gates.size();
+                    std::vector<bool> unassigned_gates(num_gates, true);
 
                     {
                         measure_block_time(ctx.name + " analysis");
                         progress_printer progress_bar;
                         float cnt = 0;
-                        std::unordered_map<u32, u32> stage_index_of_gate;
+                        std::vector<u32> stage_index_of_gate(num_gates, INVALID_GATE_INDEX);
 
-                        for (const auto& sequential_gate : netlist_abstr.all_sequential_gates)
+                        for (u32 current = 0; current < num_gates; ++current)
                         {
                             cnt++;
-                            progress_bar.print_progress(cnt / netlist_abstr.all_sequential_gates.size());
+                            progress_bar.print_progress(cnt / num_gates);
 
-                            auto current = sequential_gate->get_id();
+                            auto connected_gates = ctx.connections[current];
 
                             std::unordered_set<u32> next_stages;
 
-                            if (!ctx.connections.at(current).empty())
+                            if (!connected_gates.empty())
                             {
-                                for (auto suc : ctx.connections.at(current))
+                                for (auto suc : connected_gates)
                                 {
-                                    if (auto it = stage_index_of_gate.find(suc); it != stage_index_of_gate.end())
+                                    if (auto stage_index = stage_index_of_gate[netlist_abstr.get_index(suc)]; stage_index != INVALID_GATE_INDEX)
                                     {
-                                        next_stages.insert(it->second);
+                                        next_stages.insert(stage_index);
                                     }
                                 }
 
                                 // no stages
                                 if (next_stages.empty())
                                 {
-                                    ctx.stages.emplace_back(ctx.connections.at(current).begin(), ctx.connections.at(current).end());
+                                    ctx.stages.emplace_back(connected_gates.begin(), connected_gates.end());
                                     auto new_stage_id = ctx.stages.size() - 1;
-                                    for (auto g : ctx.connections.at(current))
+                                    for (auto g : connected_gates)
                                     {
-                                        stage_index_of_gate[g] = new_stage_id;
+                                        stage_index_of_gate[netlist_abstr.get_index(g)] = new_stage_id;
                                     }
                                 }
 
@@ -91,7 +88,7 @@ namespace hal
                                         auto& stage_to_merge = ctx.stages[*it];
                                         for (auto g : stage_to_merge)
                                         {
-                                            stage_index_of_gate[g] = merge_stage_index;
+                                            stage_index_of_gate[netlist_abstr.get_index(g)] = merge_stage_index;
                                         }
                                         ctx.stages[merge_stage_index].insert(ctx.stages[merge_stage_index].end(), stage_to_merge.begin(), stage_to_merge.end());
                                         stage_to_merge.clear();
@@ -101,21 +98,17 @@ namespace hal
                                 // only one stage? directly or after merging
                                 if (next_stages.size() == 1)
                                 {
-                                    auto stage_index      = *(next_stages.begin());
-                                    auto& connected_gates = ctx.connections.at(current);
+                                    auto stage_index = *(next_stages.begin());
                                     ctx.stages[stage_index].insert(ctx.stages[stage_index].end(), connected_gates.begin(), connected_gates.end());
                                     for (auto g : connected_gates)
                                     {
-                                        stage_index_of_gate[g] = stage_index;
+                                        stage_index_of_gate[netlist_abstr.get_index(g)] = stage_index;
                                     }
                                 }
 
-                                for (auto g : ctx.connections.at(current))
+                                for (auto g : connected_gates)
                                 {
-                                    if (auto it = unassigned_gates.find(g); it != unassigned_gates.end())
-                                    {
-                                        unassigned_gates.erase(it);
-                                    }
+                                    unassigned_gates[netlist_abstr.get_index(g)] = false;
                                 }
                             }
                         }
@@ -145,11 +138,11 @@ namespace hal
                             std::unordered_map<u32, std::vector<u32>> move_out_reasons;
                             for (auto g : ctx.stages[i])
                             {
-                                for (auto next : ctx.connections.at(g))
+                                for (auto next : ctx.connections[netlist_abstr.get_index(g)])
                                 {
                                     if (next != g)
                                     {
-                                        if (std::binary_search(ctx.stages[i].begin(), ctx.stages[i].end(), next) && ctx.connections.at(next).find(g) == ctx.connections.at(next).end())
+                                        if (std::binary_search(ctx.stages[i].begin(), ctx.stages[i].end(), next) && !ctx.connections[netlist_abstr.get_index(next)].contains(g))
                                         {
                                             move_out_reasons[next].push_back(g);
                                         }
@@ -215,9 +208,12 @@ namespace hal
                         progress_bar.clear();
                     }
 
-                    for (const auto& g : unassigned_gates)
+                    for (u32 i = 0; i < num_gates; ++i)
                     {
-                        ctx.stages.push_back({g});
+                        if (unassigned_gates[i])
+                        {
+                            ctx.stages.push_back({netlist_abstr.all_sequential_gates[i]->get_id()});
+                        }
                     }
                 }
 
@@ -263,6 +259,7 @@ namespace hal
                 }
 
                 std::vector<std::vector<u32>> final_stages;
+                std::vector<std::vector<u32>> stages_of_gate(netlist_abstr.all_sequential_gates.size());
 
                 {
                     log_info("dataflow", "sorting gates into final stages...");
@@ -274,12 +271,11 @@ namespace hal
                         final_stages.insert(final_stages.end(), directional_stages[i].stages.begin(), directional_stages[i].stages.end());
                     }
 
-                    netlist_abstr.gate_to_register_stages.clear();
                     for (u32 s = 0; s < final_stages.size(); ++s)
                     {
                         for (auto g : final_stages[s])
                         {
-                            netlist_abstr.gate_to_register_stages[g].insert(s);
+                            stages_of_gate[netlist_abstr.get_index(g)].push_back(s);
                         }
                     }
                 }
@@ -294,15 +290,12 @@ namespace hal
                     float cnt = 0;
                     std::vector<std::unordered_set<u32>> spread_stages;
                     std::set<std::vector<u32>> seen;
-                    for (auto& [g, stages] : netlist_abstr.gate_to_register_stages)
+                    for (const auto& stages_vec : stages_of_gate)
                     {
-                        progress_bar.print_progress(++cnt / netlist_abstr.gate_to_register_stages.size());
+                        progress_bar.print_progress(++cnt / stages_of_gate.size());
 
-                        if (stages.size() > 1)
+                        if (stages_vec.size() > 1)
                         {
-                            // collect current multi stage in vector for fast iteration + low memory
-                            auto stages_vec = std::vector<u32>(stages.begin(), stages.end());
-
                             // seen this multi stage before? skip!
                             if (seen.find(stages_vec) != seen.end())
                             {
@@ -318,12 +311,12 @@ namespace hal
                             if (it != spread_stages.end())
                             {
                                 // extend multi stage
-                                it->insert(stages.begin(), stages.end());
+                                it->insert(stages_vec.begin(), stages_vec.end());
                             }
                             else
                             {
                                 // register new multi stage
-                                spread_stages.emplace_back(stages.begin(), stages.end());
+                                spread_stages.emplace_back(stages_vec.begin(), stages_vec.end());
                             }
                         }
                     }
@@ -336,19 +329,21 @@ namespace hal
                     cnt = 0;
                     for (const auto& combine : spread_stages)
                     {
-                        progress_bar.print_progress(++cnt / netlist_abstr.gate_to_register_stages.size());
+                        progress_bar.print_progress(++cnt / stages_of_gate.size());
 
                         for (auto stage_id : combine)
                         {
                             for (auto gate_id : final_stages[stage_id])
                             {
-                                netlist_abstr.gate_to_register_stages[gate_id] = combine;
+                                stages_of_gate[netlist_abstr.get_index(gate_id)].assign(combine.begin(), combine.end());
                             }
                         }
                     }
                     progress_bar.clear();
                 }
 
+                netlist_abstr.register_stages.assign(stages_of_gate);
+
                 log_info("dataflow", "found {} stages", final_stages.size());
             }
 
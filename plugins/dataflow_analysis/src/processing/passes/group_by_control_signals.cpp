@@ -83,10 +83,10 @@ namespace hal
 
                     for (const auto& old_group : groups_to_merge)
                     {
-                        auto gates                                             = state->gates_of_group.at(old_group);
-                        new_state->group_control_fingerprint_map[new_group_id] = new_state->netlist_abstr.gate_to_fingerprint.at(*gates.begin());
+                        const auto& gates                                      = state->gates_of_group.at(old_group);
+                        new_state->group_control_fingerprint_map[new_group_id] = new_state->netlist_abstr.get_fingerprint(*gates.begin());
 
-                        new_state->gates_of_group[new_group_id].insert(gates.begin(), gates.end());
+                        new_state->gates_of_group[new_group_id].unite(gates);
                         for (const auto& sg : gates)
                         {
                             new_state->parent_group_of_gate[sg] = new_group_id;
@@ -139,10 +139,10 @@ namespace hal
 
                     for (const auto& old_group : groups_to_merge)
                     {
-                        auto gates                                             = state->gates_of_group.at(old_group);
-                        new_state->group_control_fingerprint_map[new_group_id] = new_state->netlist_abstr.gate_to_fingerprint.at(*gates.begin());
+                        const auto& gates                                      = state->gates_of_group.at(old_group);
+                        new_state->group_control_fingerprint_map[new_group_id] = new_state->netlist_abstr.get_fingerprint(*gates.begin());
 
-                        new_state->gates_of_group[new_group_id].insert(gates.begin(), gates.end());
+                        new_state->gates_of_group[new_group_id].unite(gates);
                         for (const auto& g : gates)
                         {
                             new_state->parent_group_of_gate[g] = new_group_id;
@@ -22,9 +22,9 @@ namespace hal
                     {
                         u32 new_group_id = ++id_counter;
 
-                        new_state->group_control_fingerprint_map[new_group_id] = new_state->netlist_abstr.gate_to_fingerprint.at(*gates.begin());
+                        new_state->group_control_fingerprint_map[new_group_id] = new_state->netlist_abstr.get_fingerprint(*gates.begin());
 
-                        new_state->gates_of_group[new_group_id].insert(gates.begin(), gates.end());
+                        new_state->gates_of_group[new_group_id].unite(gates);
                         for (const auto& sg : gates)
                         {
                             new_state->parent_group_of_gate[sg] = new_group_id;
@@ -33,9 +33,10 @@ namespace hal
                         /* iterate through same sized groups */
                         for (const auto& group_id : it->second)
                         {
+                            const auto& gates = state->gates_of_group.at(group_id);
                             std::unordered_set<u32> new_group;
 
-                            for (auto gate_id : state->gates_of_group.at(group_id))
+                            for (auto gate_id : gates)
                             {
                                 if (merged_gates.find(gate_id) == merged_gates.end())
                                 {
@@ -48,9 +49,17 @@ namespace hal
                             {
                                 u32 new_group_id = ++id_counter;
 
-                                new_state->group_control_fingerprint_map[new_group_id] = new_state->netlist_abstr.gate_to_fingerprint.at(*new_group.begin());
+                                new_state->group_control_fingerprint_map[new_group_id] = new_state->netlist_abstr.get_fingerprint(*new_group.begin());
 
-                                new_state->gates_of_group[new_group_id].insert(new_group.begin(), new_group.end());
+                                if (new_group.size() == gates.size())
+                                {
+                                    // no duplicates removed, keep sharing the gates
+                                    new_state->gates_of_group[new_group_id].unite(gates);
+                                }
+                                else
+                                {
+                                    new_state->gates_of_group[new_group_id].insert(new_group.begin(), new_group.end());
+                                }
                                 for (const auto& sg : new_group)
                                 {
                                     new_state->parent_group_of_gate[sg] = new_group_id;
@@ -73,9 +82,10 @@ namespace hal
                         /* iterate through same sized groups */
                         for (const auto& group_id : it->second)
                         {
+                            const auto& gates = state->gates_of_group.at(group_id);
                             std::unordered_set<u32> new_group;
 
-                            for (auto gate_id : state->gates_of_group.at(group_id))
+                            for (auto gate_id : gates)
                             {
                                 if (merged_gates.find(gate_id) == merged_gates.end())
                                 {
@@ -88,9 +98,17 @@ namespace hal
                             {
                                 u32 new_group_id = ++id_counter;
 
-                                new_state->group_control_fingerprint_map[new_group_id] = new_state->netlist_abstr.gate_to_fingerprint.at(*new_group.begin());
+                                new_state->group_control_fingerprint_map[new_group_id] = new_state->netlist_abstr.get_fingerprint(*new_group.begin());
 
-                                new_state->gates_of_group[new_group_id].insert(new_group.begin(), new_group.end());
+                                if (new_group.size() == gates.size())
+                                {
+                                    // no duplicates removed, keep sharing the gates
+                                    new_state->gates_of_group[new_group_id].unite(gates);
+                                }
+                                else
+                                {
+                                    new_state->gates_of_group[new_group_id].insert(new_group.begin(), new_group.end());
+                                }
                                 for (const auto& sg : new_group)
                                 {
                                     new_state->parent_group_of_gate[sg] = new_group_id;
@@ -107,7 +125,7 @@ namespace hal
                         {
                             u32 new_group_id = ++id_counter;
 
-                            new_state->group_control_fingerprint_map[new_group_id] = new_state->netlist_abstr.gate_to_fingerprint.at(gate_id);
+                            new_state->group_control_fingerprint_map[new_group_id] = new_state->netlist_abstr.get_fingerprint(gate_id);
 
                             new_state->gates_of_group[new_group_id].insert(gate_id);
                             new_state->parent_group_of_gate[gate_id] = new_group_id;
@@ -5,6 +5,7 @@
 
 #include <map>
 #include <set>
+#include <vector>
 
 namespace hal
 {
@@ -12,6 +13,15 @@ namespace hal
     {
         namespace split_by_successors_predecessors
         {
+            namespace
+            {
+                struct NewGroup
+                {
+                    u32 first_gate;
+                    u32 id;
+                };
+            }    // namespace
+
             std::shared_ptr<Grouping> process(const std::shared_ptr<Grouping>& state, bool successors)
             {
                 auto new_state = std::make_shared<Grouping>(state->netlist_abstr);
@@ -19,39 +29,54 @@ namespace hal
                 u32 id_counter = -1;
                 for (const auto& [group_id, gates] : state->gates_of_group)
                 {
-                    std::map<std::set<u32>, std::unordered_set<u32>> characteristics_map;
+                    // collect the characteristics first, the gates are only copied if the group is actually split
+                    std::map<std::set<u32>, NewGroup> new_groups;
+                    std::vector<NewGroup*> new_group_of_gate;
+                    new_group_of_gate.reserve(gates.size());
                     for (auto gate : gates)
                     {
                         std::set<u32> characteristics_of_gate;
                         if (successors)
                         {
-                            for (auto gate_successors : state->netlist_abstr.gate_to_successors.at(gate))
+                            for (auto gate_successors : state->netlist_abstr.get_successors(gate))
                             {
                                 characteristics_of_gate.insert(state->parent_group_of_gate.at(gate_successors));
                             }
                         }
                         else
                         {
-                            for (auto gate_predecessors : state->netlist_abstr.gate_to_predecessors.at(gate))
+                            for (auto gate_predecessors : state->netlist_abstr.get_predecessors(gate))
                             {
                                 characteristics_of_gate.insert(state->parent_group_of_gate.at(gate_predecessors));
                             }
                         }
-                        characteristics_map[characteristics_of_gate].insert(gate);
+                        new_group_of_gate.push_back(&new_groups.emplace(std::move(characteristics_of_gate), NewGroup{gate, 0}).first->second);
                     }
 
                     /* merge gates */
-                    for (auto gates_to_merge : characteristics_map)
+                    for (auto& [characteristics, new_group] : new_groups)
                     {
-                        u32 new_group_id = ++id_counter;
+                        new_group.id = ++id_counter;
 
-                        new_state->group_control_fingerprint_map[new_group_id] = new_state->netlist_abstr.gate_to_fingerprint.at(*gates_to_merge.second.begin());
+                        new_state->group_control_fingerprint_map[new_group.id] = new_state->netlist_abstr.get_fingerprint(new_group.first_gate);
 
-                        new_state->gates_of_group[new_group_id].insert(gates_to_merge.second.begin(), gates_to_merge.second.end());
-                        for (const auto& sg : gates_to_merge.second)
+                        auto& new_gates = new_state->gates_of_group[new_group.id];
+                        if (new_groups.size() == 1)
+                        {
+                            // group is not split, keep sharing its gates
+                            new_gates.unite(gates);
+                        }
+                    }
+
+                    u32 gate_idx = 0;
+                    for (auto gate : gates)
+                    {
+                        u32 new_group_id = new_group_of_gate[gate_idx++]->id;
+                        if (new_groups.size() > 1)
                         {
-                            new_state->parent_group_of_gate[sg] = new_group_id;
+                            new_state->gates_of_group.at(new_group_id).insert(gate);
                         }
+                        new_state->parent_group_of_gate[gate] = new_group_id;
                     }
                 }
 
@@ -7,6 +7,7 @@
 #include "dataflow_analysis/processing/pass_collection.h"
 #include "dataflow_analysis/processing/result.h"
 #include "dataflow_analysis/utils/progress_printer.h"
+#include "dataflow_analysis/utils/thread_pool.h"
 #include "dataflow_analysis/utils/timing_utils.h"
 #include "hal_core/netlist/gate.h"
 #include "hal_core/netlist/netlist.h"
@@ -14,7 +15,6 @@
 
 #include <iomanip>
 #include <iostream>
-#include <thread>
 
 namespace hal
 {
@@ -26,92 +26,62 @@ namespace hal
             {
                 progress_printer m_progress_printer;
 
-                void process_pass_configuration(const Configuration& config, Context& ctx)
+                std::shared_ptr<Grouping> find_duplicate(const GroupingLookup& lookup, const std::shared_ptr<Grouping>& grouping)
                 {
-                    u32 num_passes = ctx.current_passes.size();
-
-                    while (true)
+                    auto [begin, end] = lookup.equal_range(grouping->get_hash());
+                    for (auto it = begin; it != end; ++it)
                     {
-                        u32 start_id;
-                        u32 end_id;
-
-                        // fetch next work package
+                        if (*it->second == *grouping)
                         {
-                            std::lock_guard<std::mutex> guard(ctx.progress_mutex);
-
-                            if (ctx.done)
-                            {
-                                break;
-                            }
-
-                            // adaptive workload:
-                            // every thread gets between 1 and 20 passes, depending on the number of remaining passes
-                            // this improves cpu utilization and reduces number of mutex locks
-                            start_id             = ctx.pass_counter;
-                            u32 remaining_passes = num_passes - start_id;
+                            return it->second;
+                        }
+                    }
+                    return nullptr;
+                }
 
-                            u32 work = 20;
+                void process_pass_configuration(Context& ctx, u32 current_id)
+                {
+                    const auto& [current_state, current_pass] = ctx.current_passes[current_id];
 
-                            if (remaining_passes < config.num_threads * work / 2)
-                            {
-                                work = std::max(1u, remaining_passes / config.num_threads);
-                            }
+                    if (auto it = ctx.pass_outcome.find({current_state, current_pass.id}); it != ctx.pass_outcome.end())
+                    {
+                        // early exit, outcome is already known
+                        std::lock_guard guard(ctx.result_mutex);
+                        ctx.new_recurring_results.emplace_back(current_state, current_pass.id, it->second);
+                        ctx.finished_passes++;
+                        m_progress_printer.print_progress((float)ctx.finished_passes / ctx.current_passes.size(),
+                                                          std::to_string(ctx.finished_passes) + "\\" + std::to_string(ctx.current_passes.size()) + " ("
+                                                              + std::to_string(ctx.new_unique_groupings.size()) + " new results)");
+                        return;
+                    }
 
-                            end_id = std::min(start_id + work, (u32)num_passes);
+                    // process work
+                    auto new_state = current_pass.function(current_state);
 
-                            ctx.pass_counter = end_id;
-                            if (ctx.pass_counter >= num_passes)
-                            {
-                                ctx.done = true;
-                            }
+                    // aggregate result
+                    // the results of previous layers are not modified while processing, so they can be searched without locking
+                    std::shared_ptr<Grouping> duplicate = find_duplicate(ctx.unique_grouping_lookup, new_state);
+                    {
+                        std::lock_guard guard(ctx.result_mutex);
+                        if (duplicate == nullptr)
+                        {
+                            // same result of a different pass in this layer
+                            duplicate = find_duplicate(ctx.new_unique_grouping_lookup, new_state);
                         }
-
-                        for (u32 current_id = start_id; current_id < end_id; ++current_id)
+                        if (duplicate == nullptr)
                         {
-                            const auto& [current_state, current_pass] = ctx.current_passes[current_id];
-
-                            if (auto it = ctx.pass_outcome.find({current_state, current_pass.id}); it != ctx.pass_outcome.end())
-                            {
-                                // early exit, outcome is already known
-                                std::lock_guard guard(ctx.result_mutex);
-                                ctx.new_recurring_results.emplace_back(current_state, current_pass.id, it->second);
-                                ctx.finished_passes++;
-                                m_progress_printer.print_progress((float)ctx.finished_passes / ctx.current_passes.size(),
-                                                                  std::to_string(ctx.finished_passes) + "\\" + std::to_string(ctx.current_passes.size()) + " ("
-                                                                      + std::to_string(ctx.new_unique_groupings.size()) + " new results)");
-                                continue;
-                            }
-
-                            // process work
-                            auto new_state = current_pass.function(current_state);
-
-                            // aggregate result
-                            std::shared_ptr<Grouping> duplicate = nullptr;
-                            for (const auto& other : ctx.result.unique_groupings)
-                            {
-                                if (*new_state == *other)
-                                {
-                                    duplicate = other;
-                                    break;
-                                }
-                            }
-                            {
-                                std::lock_guard guard(ctx.result_mutex);
-                                if (duplicate == nullptr)
-                                {
-                                    ctx.new_unique_groupings.emplace_back(current_state, current_pass.id, new_state);
-                                }
-                                else
-                                {
-                                    ctx.new_recurring_results.emplace_back(current_state, current_pass.id, duplicate);
-                                }
-
-                                ctx.finished_passes++;
-                                m_progress_printer.print_progress((float)ctx.finished_passes / ctx.current_passes.size(),
-                                                                  std::to_string(ctx.finished_passes) + "\\" + std::to_string(ctx.current_passes.size()) + " ("
-                                                                      + std::to_string(ctx.new_unique_groupings.size()) + " new results)");
-                            }
+                            ctx.new_unique_grouping_lookup.emplace(new_state->get_hash(), new_state);
+                            ctx.new_unique_groupings.emplace_back(current_state, current_pass.id, new_state);
+                        }
+                        else
+                        {
+                            ctx.new_recurring_results.emplace_back(current_state, current_pass.id, duplicate);
                         }
+
+                        ctx.finished_passes++;
+                        m_progress_printer.print_progress((float)ctx.finished_passes / ctx.current_passes.size(),
+                                                          std::to_string(ctx.finished_passes) + "\\" + std::to_string(ctx.current_passes.size()) + " ("
+                                                              + std::to_string(ctx.new_unique_groupings.size()) + " new results)");
                     }
                 }
 
@@ -145,7 +115,7 @@ namespace hal
 
             Result run(const Configuration& config, const std::shared_ptr<Grouping>& initial_grouping)
             {
-                log_info("dataflow", "starting pipeline with {} threads", config.num_threads);
+                log_info("dataflow", "starting pipeline with {} threads", config.thread_pool->get_num_threads());
 
                 Context ctx;
                 ctx.num_iterations = 0;
@@ -161,26 +131,12 @@ namespace hal
                     ctx.current_passes = generate_pass_combinations(ctx, (layer == 0) ? initial_grouping : nullptr);
 
                     // preparations
-                    ctx.done            = false;
-                    ctx.pass_counter    = 0;
                     ctx.finished_passes = 0;
 
                     m_progress_printer = progress_printer(30);
 
-                    // spawn threads
-                    std::vector<std::thread> workers;
-                    for (u32 t = 0; t < config.num_threads - 1; ++t)
-                    {
-                        workers.emplace_back([&]() { process_pass_configuration(config, ctx); });
-                    }
-
-                    process_pass_configuration(config, ctx);
-
-                    // wait for threads to finish
-                    for (auto& worker : workers)
-                    {
-                        worker.join();
-                    }
+                    // passes differ a lot in their cost, the pool balances them by work stealing
+                    config.thread_pool->parallel_for(0, ctx.current_passes.size(), [&ctx](u32 current_id) { process_pass_configuration(ctx, current_id); });
 
                     m_progress_printer.clear();
 
@@ -190,35 +146,16 @@ namespace hal
 
                     begin_time = std::chrono::high_resolution_clock::now();
 
-                    // filter same results of different threads
-                    u32 num_unique_filtered = 0;
-                    std::vector<bool> do_not_consider(ctx.new_unique_groupings.size(), false);
-                    for (u32 i = 0; i < ctx.new_unique_groupings.size(); ++i)
+                    // same results of different threads were already merged while processing
+                    u32 num_unique_filtered = ctx.new_unique_groupings.size();
+                    for (const auto& new_result : ctx.new_unique_groupings)
                     {
-                        if (do_not_consider[i])
-                        {
-                            continue;
-                        }
-                        const auto& [start_state_i, pass_i, new_state_i] = ctx.new_unique_groupings[i];
-                        for (u32 j = i + 1; j < ctx.new_unique_groupings.size(); ++j)
-                        {
-                            if (do_not_consider[j])
-                            {
-                                continue;
-                            }
-                            const auto& [start_state_j, pass_j, new_state_j] = ctx.new_unique_groupings[j];
-
-                            // j is a duplicate of i
-                            if (*new_state_i == *new_state_j)
-                            {
-                                do_not_consider[j] = true;
-                                all_new_results.emplace_back(start_state_j, pass_j, new_state_i);
-                            }
-                        }
-                        ctx.result.unique_groupings.push_back(new_state_i);
-                        all_new_results.push_back(ctx.new_unique_groupings[i]);
-                        num_unique_filtered++;
+                        const auto& new_state = std::get<2>(new_result);
+                        ctx.result.unique_groupings.push_back(new_state);
+                        ctx.unique_grouping_lookup.emplace(new_state->get_hash(), new_state);
+                        all_new_results.push_back(new_result);
                     }
+                    ctx.new_unique_grouping_lookup.clear();
                     log_info("dataflow", "  filtered results in {:3.2f}s, got {} new unique results", seconds_since(begin_time), num_unique_filtered);
 
                     begin_time = std::chrono::high_resolution_clock::now();
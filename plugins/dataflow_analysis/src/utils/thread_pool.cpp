@@ -0,0 +1,236 @@
+#include "dataflow_analysis/utils/thread_pool.h"
+
+#include <algorithm>
+
+namespace hal
+{
+    namespace dataflow
+    {
+        namespace utils
+        {
+            namespace
+            {
+                // set while a thread executes iterations of a parallel loop, nested loops are then executed sequentially
+                thread_local bool t_in_job = false;
+            }    // namespace
+
+            thread_pool::~thread_pool()
+            {
+                stop_workers();
+            }
+
+            void thread_pool::set_num_threads(u32 num_threads)
+            {
+                if (num_threads == 0)
+                {
+                    num_threads = std::max(1u, std::thread::hardware_concurrency());
+                }
+
+                std::lock_guard job_lock(m_job_mutex);
+                if (num_threads == m_num_threads && m_workers.size() == num_threads - 1)
+                {
+                    return;
+                }
+
+                stop_workers();
+
+                m_num_threads = num_threads;
+                m_ranges.clear();
+                for (u32 i = 0; i < num_threads; ++i)
+                {
+                    m_ranges.push_back(std::make_unique<work_range>());
+                }
+
+                // index 0 is reserved for the thread calling parallel_for
+                for (u32 thread_idx = 1; thread_idx < num_threads; ++thread_idx)
+                {
+                    m_workers.emplace_back([this, thread_idx]() { worker_loop(thread_idx); });
+                }
+            }
+
+            u32 thread_pool::get_num_threads() const
+            {
+                return m_num_threads;
+            }
+
+            void thread_pool::stop()
+            {
+                std::lock_guard job_lock(m_job_mutex);
+                stop_workers();
+                m_num_threads = 1;
+            }
+
+            void thread_pool::stop_workers()
+            {
+                {
+                    std::lock_guard lock(m_mutex);
+                    m_shutdown = true;
+                }
+                m_job_available.notify_all();
+
+                for (auto& worker : m_workers)
+                {
+                    worker.join();
+                }
+                m_workers.clear();
+
+                std::lock_guard lock(m_mutex);
+                m_shutdown = false;
+            }
+
+            void thread_pool::parallel_for(u32 begin, u32 end, const std::function<void(u32)>& func)
+            {
+                if (begin >= end)
+                {
+                    return;
+                }
+
+                // nested loops and loops without workers are executed by the calling thread, the pool is not blocked meanwhile
+                std::unique_lock job_lock(m_job_mutex, std::defer_lock);
+                if (!t_in_job)
+                {
+                    job_lock.lock();
+                }
+
+                if (t_in_job || m_workers.empty() || end - begin == 1)
+                {
+                    if (job_lock.owns_lock())
+                    {
+                        job_lock.unlock();
+                    }
+                    for (u32 i = begin; i < end; ++i)
+                    {
+                        func(i);
+                    }
+                    return;
+                }
+
+                // initial static distribution, the rest is balanced by stealing
+                u32 count = end - begin;
+                for (u32 t = 0; t < m_num_threads; ++t)
+                {
+                    m_ranges[t]->begin = begin + (u64)count * t / m_num_threads;
+                    m_ranges[t]->end   = begin + (u64)count * (t + 1) / m_num_threads;
+                }
+
+                {
+                    std::lock_guard lock(m_mutex);
+                    m_job      = &func;
+                    m_job_open = true;
+                    m_job_generation++;
+                }
+                m_job_available.notify_all();
+
+                work_on_job(0);
+
+                // no work is left to take, wait for the workers to finish their chunks
+                std::unique_lock lock(m_mutex);
+                m_job_open = false;
+                m_job_finished.wait(lock, [this]() { return m_active_workers == 0; });
+                m_job = nullptr;
+            }
+
+            void thread_pool::worker_loop(u32 thread_idx)
+            {
+                u64 last_generation = 0;
+                while (true)
+                {
+                    {
+                        std::unique_lock lock(m_mutex);
+                        m_job_available.wait(lock, [this, last_generation]() { return m_shutdown || (m_job_open && m_job_generation != last_generation); });
+                        if (m_shutdown)
+                        {
+                            return;
+                        }
+                        last_generation = m_job_generation;
+                        m_active_workers++;
+                    }
+
+                    work_on_job(thread_idx);
+
+                    {
+                        std::lock_guard lock(m_mutex);
+                        m_active_workers--;
+                    }
+                    m_job_finished.notify_all();
+                }
+            }
+
+            void thread_pool::work_on_job(u32 thread_idx)
+            {
+                t_in_job = true;
+
+                u32 chunk_begin;
+                u32 chunk_end;
+                while (take_chunk(thread_idx, chunk_begin, chunk_end))
+                {
+                    for (u32 i = chunk_begin; i < chunk_end; ++i)
+                    {
+                        (*m_job)(i);
+                    }
+                }
+
+                t_in_job = false;
+            }
+
+            bool thread_pool::take_chunk(u32 thread_idx, u32& chunk_begin, u32& chunk_end)
+            {
+                auto& own = *m_ranges[thread_idx];
+                while (true)
+                {
+                    {
+                        std::lock_guard lock(own.mutex);
+                        if (own.begin < own.end)
+                        {
+                            u32 size    = std::max(1u, (own.end - own.begin) / 4);
+                            chunk_begin = own.begin;
+                            chunk_end   = own.begin + size;
+                            own.begin   = chunk_end;
+                            return true;
+                        }
+                    }
+
+                    // steal the back half of the largest remaining range
+                    work_range* victim = nullptr;
+                    u32 victim_size    = 0;
+                    for (const auto& range : m_ranges)
+                    {
+                        if (range.get() == &own)
+                        {
+                            continue;
+                        }
+                        std::lock_guard lock(range->mutex);
+                        if (range->end - range->begin > victim_size)
+                        {
+                            victim      = range.get();
+                            victim_size = range->end - range->begin;
+                        }
+                    }
+                    if (victim == nullptr)
+                    {
+                        return false;
+                    }
+
+                    // the victim is released before the own range is locked, so two threads stealing from each other cannot deadlock
+                    u32 stolen_begin;
+                    u32 stolen_end;
+                    {
+                        std::lock_guard lock(victim->mutex);
+                        if (victim->begin >= victim->end)
+                        {
+                            continue;
+                        }
+                        stolen_end   = victim->end;
+                        stolen_begin = victim->end - (victim->end - victim->begin + 1) / 2;
+                        victim->end  = stolen_begin;
+                    }
+                    {
+                        std::lock_guard lock(own.mutex);
+                        own.begin = stolen_begin;
+                        own.end   = stolen_end;
+                    }
+                }
+            }
+        }    // namespace utils
+    }        // namespace dataflow
+}    // namespace hal
@@ -0,0 +1,512 @@
+#include "dataflow_analysis/common/grouping.h"
+#include "dataflow_analysis/common/netlist_abstraction.h"
+#include "dataflow_analysis/evaluation/configuration.h"
+#include "dataflow_analysis/evaluation/context.h"
+#include "dataflow_analysis/evaluation/evaluation.h"
+#include "dataflow_analysis/pre_processing/pre_processing.h"
+#include "dataflow_analysis/processing/configuration.h"
+#include "dataflow_analysis/processing/processing.h"
+#include "dataflow_analysis/utils/thread_pool.h"
+#include "hal_core/netlist/gate.h"
+#include "hal_core/netlist/gate_library/gate_library.h"
+#include "hal_core/netlist/net.h"
+#include "hal_core/netlist/netlist.h"
+#include "test_utils/include/test_def.h"
+
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace hal
+{
+    class DataflowTest : public ::testing::Test
+    {
+    protected:
+        static const u32 REGISTER_WIDTH = 8;
+
+        std::unique_ptr<GateLibrary> m_gl;
+
+        virtual void SetUp()
+        {
+            m_gl = std::make_unique<GateLibrary>("dataflow_test.hgl", "DATAFLOW_TEST_LIB");
+
+            GateType* inv = m_gl->create_gate_type("INV", {GateTypeProperty::combinational});
+            inv->add_pin("I", PinDirection::input);
+            inv->add_pin("O", PinDirection::output);
+
+            GateType* xor2 = m_gl->create_gate_type("XOR2", {GateTypeProperty::combinational});
+            xor2->add_pins({"I0", "I1"}, PinDirection::input);
+            xor2->add_pin("O", PinDirection::output);
+
+            GateType* dffr = m_gl->create_gate_type("DFFR", {GateTypeProperty::sequential, GateTypeProperty::ff});
+            dffr->add_pin("CLK", PinDirection::input, PinType::clock);
+            dffr->add_pin("D", PinDirection::input, PinType::data);
+            dffr->add_pin("R", PinDirection::input, PinType::reset);
+            dffr->add_pin("Q", PinDirection::output, PinType::state);
+        }
+
+        /*
+         * creates three registers with the same clock and reset
+         * a_i accumulates the inputs, b_i = a_i ^ a_(i+1), and c_i = !b_i
+         * the flip-flops of the registers have consecutive ids starting at 1
+         */
+        std::unique_ptr<Netlist> create_register_netlist()
+        {
+            auto nl = std::make_unique<Netlist>(m_gl.get());
+
+            auto types = m_gl->get_gate_types();
+            Net* clk   = nl->create_net("clk");
+            Net* rst   = nl->create_net("rst");
+            nl->mark_global_input_net(clk);
+            nl->mark_global_input_net(rst);
+
+            std::vector<std::vector<Net*>> register_outputs;
+            for (const std::string& reg : {"a", "b", "c"})
+            {
+                u32 gate_id = 1 + register_outputs.size() * REGISTER_WIDTH;
+                register_outputs.emplace_back();
+                for (u32 i = 0; i < REGISTER_WIDTH; ++i)
+                {
+                    Gate* ff = nl->create_gate(gate_id + i, types.at("DFFR"), reg + "_" + std::to_string(i));
+                    clk->add_destination(ff, "CLK");
+                    rst->add_destination(ff, "R");
+                    Net* q = nl->create_net(reg + "_" + std::to_string(i) + "_q");
+                    q->add_source(ff, "Q");
+                    register_outputs.back().push_back(q);
+                }
+            }
+
+            const auto& a = register_outputs[0];
+            const auto& b = register_outputs[1];
+            const auto& c = register_outputs[2];
+            for (u32 i = 0; i < REGISTER_WIDTH; ++i)
+            {
+                Net* in = nl->create_net("in_" + std::to_string(i));
+                nl->mark_global_input_net(in);
+
+                Gate* acc = nl->create_gate(types.at("XOR2"), "acc_" + std::to_string(i));
+                in->add_destination(acc, "I0");
+                a[i]->add_destination(acc, "I1");
+                Net* acc_out = nl->create_net("acc_" + std::to_string(i) + "_o");
+                acc_out->add_source(acc, "O");
+                acc_out->add_destination(nl->get_gate_by_id(1 + i), "D");
+
+                Gate* mix = nl->create_gate(types.at("XOR2"), "mix_" + std::to_string(i));
+                a[i]->add_destination(mix, "I0");
+                a[(i + 1) % REGISTER_WIDTH]->add_destination(mix, "I1");
+                Net* mix_out = nl->create_net("mix_" + std::to_string(i) + "_o");
+                mix_out->add_source(mix, "O");
+                mix_out->add_destination(nl->get_gate_by_id(1 + REGISTER_WIDTH + i), "D");
+
+                Gate* neg = nl->create_gate(types.at("INV"), "neg_" + std::to_string(i));
+                b[i]->add_destination(neg, "I");
+                Net* neg_out = nl->create_net("neg_" + std::to_string(i) + "_o");
+                neg_out->add_source(neg, "O");
+                neg_out->add_destination(nl->get_gate_by_id(1 + 2 * REGISTER_WIDTH + i), "D");
+
+                nl->mark_global_output_net(c[i]);
+            }
+
+            return nl;
+        }
+
+        /* runs the dataflow pipeline like plugin_dataflow::execute and returns the final groups */
+        std::set<std::set<u32>> run_dataflow(Netlist* nl, u32 num_threads)
+        {
+            dataflow::utils::thread_pool pool;
+            pool.set_num_threads(num_threads);
+
+            auto netlist_abstr    = dataflow::pre_processing::run(nl, pool);
+            auto initial_grouping = netlist_abstr.create_initial_grouping();
+
+            dataflow::processing::Configuration config;
+            config.pass_layers = 2;
+            config.thread_pool = &pool;
+
+            dataflow::evaluation::Context eval_ctx;
+            dataflow::evaluation::Configuration eval_config;
+
+            std::shared_ptr<dataflow::Grouping> final_grouping;
+            while (final_grouping == nullptr)
+            {
+                auto processing_result = dataflow::processing::run(config, initial_grouping);
+                auto eval_result       = dataflow::evaluation::run(eval_config, eval_ctx, initial_grouping, processing_result, pool);
+                if (eval_result.is_final_result)
+                {
+                    final_grouping = eval_result.merged_result;
+                }
+                initial_grouping = eval_result.merged_result;
+            }
+
+            return get_partition(*final_grouping);
+        }
+
+        /* runs a loop of the given length on the pool, where the first iterations are much more expensive than the others, and returns how often each index was executed */
+        static std::vector<u32> count_iterations(dataflow::utils::thread_pool& pool, u32 begin, u32 end)
+        {
+            std::vector<std::atomic<u32>> counts(end);
+            pool.parallel_for(begin, end, [&counts, begin](u32 i) {
+                volatile u64 sum = 0;
+                u32 cost         = (i < begin + 8) ? 200000 : 100;
+                for (u32 j = 0; j < cost; ++j)
+                {
+                    sum = sum + j;
+                }
+                counts[i]++;
+            });
+            return std::vector<u32>(counts.begin(), counts.end());
+        }
+
+        /* returns the partition of a grouping into gate ids, ignoring empty groups and group ids */
+        static std::set<std::set<u32>> get_partition(const dataflow::Grouping& grouping)
+        {
+            std::set<std::set<u32>> groups;
+            for (const auto& [group_id, gates] : grouping.gates_of_group)
+            {
+                if (!gates.empty())
+                {
+                    groups.emplace(gates.begin(), gates.end());
+                }
+            }
+            return groups;
+        }
+    };
+
+    /**
+     * Test that the pipeline recovers the registers of a small netlist, independently of the number of threads.
+     *
+     * Functions: pre_processing::run, processing::run, evaluation::run
+     */
+    TEST_F(DataflowTest, check_registers)
+    {
+        TEST_START
+        {
+            auto nl = create_register_netlist();
+            ASSERT_NE(nl, nullptr);
+
+            std::set<std::set<u32>> expected;
+            for (u32 reg = 0; reg < 3; ++reg)
+            {
+                std::set<u32> gates;
+                for (u32 i = 0; i < REGISTER_WIDTH; ++i)
+                {
+                    gates.insert(1 + reg * REGISTER_WIDTH + i);
+                }
+                expected.insert(gates);
+            }
+
+            EXPECT_EQ(run_dataflow(nl.get(), 1), expected);
+            EXPECT_EQ(run_dataflow(nl.get(), 3), expected);
+        }
+        TEST_END
+    }
+
+    /**
+     * Test that groupings with the same partition hash and compare equal, independently of their group ids.
+     *
+     * Functions: Grouping::get_hash, Grouping::operator==, Grouping::operator!=
+     */
+    TEST_F(DataflowTest, check_grouping_hash)
+    {
+        TEST_START
+        {
+            auto nl = create_register_netlist();
+            dataflow::NetlistAbstraction netlist_abstr(nl.get());
+
+            dataflow::Grouping grouping(netlist_abstr);
+            grouping.gates_of_group[0] = dataflow::GroupGates(std::unordered_set<u32>{1, 2, 3, 4});
+            grouping.gates_of_group[1] = dataflow::GroupGates(std::unordered_set<u32>{5, 6, 7, 8});
+
+            // same partition under different group ids
+            dataflow::Grouping renamed(netlist_abstr);
+            renamed.gates_of_group[7] = dataflow::GroupGates(std::unordered_set<u32>{5, 6, 7, 8});
+            renamed.gates_of_group[3] = dataflow::GroupGates(std::unordered_set<u32>{4, 3, 2, 1});
+            EXPECT_EQ(renamed.get_hash(), grouping.get_hash());
+            EXPECT_TRUE(renamed == grouping);
+            EXPECT_TRUE(grouping == renamed);
+            EXPECT_FALSE(renamed != grouping);
+
+            // same number of groups and gates, but a different partition
+            dataflow::Grouping different(netlist_abstr);
+            different.gates_of_group[0] = dataflow::GroupGates(std::unordered_set<u32>{1, 2, 3, 5});
+            different.gates_of_group[1] = dataflow::GroupGates(std::unordered_set<u32>{4, 6, 7, 8});
+            EXPECT_FALSE(different == grouping);
+            EXPECT_FALSE(grouping == different);
+            EXPECT_TRUE(different != grouping);
+        }
+        TEST_END
+    }
+
+    /**
+     * Test that processing keeps a single result for passes that lead to the same partition.
+     *
+     * Functions: processing::run
+     */
+    TEST_F(DataflowTest, check_processing_deduplication)
+    {
+        TEST_START
+        {
+            auto nl = create_register_netlist();
+
+            dataflow::utils::thread_pool pool;
+            pool.set_num_threads(2);
+
+            auto netlist_abstr    = dataflow::pre_processing::run(nl.get(), pool);
+            auto initial_grouping = netlist_abstr.create_initial_grouping();
+
+            dataflow::processing::Configuration config;
+            config.pass_layers = 2;
+            config.thread_pool = &pool;
+
+            auto result = dataflow::processing::run(config, initial_grouping);
+            ASSERT_FALSE(result.unique_groupings.empty());
+
+            // the unique results have pairwise different partitions
+            std::set<std::set<std::set<u32>>> unique_partitions;
+            for (const auto& grouping : result.unique_groupings)
+            {
+                EXPECT_TRUE(unique_partitions.insert(get_partition(*grouping)).second);
+            }
+
+            // every path leads to the one result kept for its partition
+            std::map<std::set<std::set<u32>>, std::shared_ptr<dataflow::Grouping>> result_of_partition;
+            std::set<std::shared_ptr<dataflow::Grouping>> first_layer_results;
+            u32 first_layer_paths = 0;
+            for (const auto& [path, grouping] : result.groupings)
+            {
+                auto [it, inserted] = result_of_partition.emplace(get_partition(*grouping), grouping);
+                EXPECT_EQ(it->second, grouping);
+                EXPECT_TRUE(unique_partitions.find(it->first) != unique_partitions.end());
+                if (path.size() == 1)
+                {
+                    first_layer_paths++;
+                    first_layer_results.insert(grouping);
+                }
+            }
+
+            // several passes of the same layer produced the same partition, but only one of the results was kept
+            EXPECT_LT(first_layer_results.size(), first_layer_paths);
+        }
+        TEST_END
+    }
+
+    /**
+     * Test that groups share their gates until they are modified.
+     *
+     * Functions: GroupGates::unite, GroupGates::insert, GroupGates::get_hash
+     */
+    TEST_F(DataflowTest, check_group_gates_sharing)
+    {
+        TEST_START
+        {
+            // an empty group takes over the set of the other group
+            dataflow::GroupGates original(std::unordered_set<u32>{1, 2, 3});
+            dataflow::GroupGates shared;
+            shared.unite(original);
+            ASSERT_EQ(shared.size(), 3u);
+            EXPECT_EQ(&*shared.begin(), &*original.begin());
+
+            // modifying a shared set copies it, the original is left untouched
+            shared.insert(4);
+            EXPECT_EQ(shared.size(), 4u);
+            EXPECT_EQ(original.size(), 3u);
+            EXPECT_TRUE(original.find(4) == original.end());
+            EXPECT_NE(&*shared.find(1), &*original.find(1));
+
+            // the original does not modify the set in place either once it was shared
+            dataflow::GroupGates copy = original;
+            original.insert(5);
+            EXPECT_EQ(copy.size(), 3u);
+            EXPECT_TRUE(copy.find(5) == copy.end());
+            EXPECT_EQ(original.size(), 4u);
+        }
+        {
+            // a set that was hashed is copied on modification, so the cached hash stays valid
+            dataflow::GroupGates gates(std::unordered_set<u32>{1, 2});
+            gates.get_hash();
+            const u32* gate_ptr = &*gates.find(1);
+
+            gates.insert(3);
+            EXPECT_NE(&*gates.find(1), gate_ptr);
+            EXPECT_EQ(gates.get_hash(), dataflow::GroupGates(std::unordered_set<u32>{1, 2, 3}).get_hash());
+
+            // an unshared set that was not hashed is modified in place
+            dataflow::GroupGates fresh(std::unordered_set<u32>{1, 2});
+            const u32* fresh_ptr = &*fresh.find(1);
+            fresh.insert(3);
+            EXPECT_EQ(&*fresh.find(1), fresh_ptr);
+            EXPECT_EQ(fresh.get_hash(), gates.get_hash());
+        }
+        TEST_END
+    }
+
+    /**
+     * Test the comparison of groupings with shared and unshared sets.
+     *
+     * Functions: Grouping::operator==, Grouping::operator!=
+     */
+    TEST_F(DataflowTest, check_grouping_comparison)
+    {
+        TEST_START
+        {
+            auto nl = create_register_netlist();
+            dataflow::NetlistAbstraction netlist_abstr(nl.get());
+
+            dataflow::Grouping grouping(netlist_abstr);
+            grouping.gates_of_group[0] = dataflow::GroupGates(std::unordered_set<u32>{1, 2, 3, 4});
+            grouping.gates_of_group[1] = dataflow::GroupGates(std::unordered_set<u32>{5, 6, 7, 8});
+
+            // a copy shares all sets
+            dataflow::Grouping copy(grouping);
+            EXPECT_EQ(&*copy.gates_of_group.at(0).begin(), &*grouping.gates_of_group.at(0).begin());
+            EXPECT_TRUE(copy == grouping);
+
+            // equal sets that are not shared
+            dataflow::Grouping unshared(netlist_abstr);
+            unshared.gates_of_group[0] = dataflow::GroupGates(std::unordered_set<u32>{4, 3, 2, 1});
+            unshared.gates_of_group[1] = dataflow::GroupGates(std::unordered_set<u32>{5, 6, 7, 8});
+            EXPECT_TRUE(unshared == grouping);
+            EXPECT_TRUE(grouping == unshared);
+
+            // one shared and one unshared set
+            dataflow::Grouping mixed(netlist_abstr);
+            mixed.gates_of_group[0].unite(grouping.gates_of_group.at(0));
+            mixed.gates_of_group[1] = dataflow::GroupGates(std::unordered_set<u32>{5, 6, 7, 8});
+            EXPECT_TRUE(mixed == grouping);
+
+            // one shared and one different set
+            dataflow::Grouping different(netlist_abstr);
+            different.gates_of_group[0].unite(grouping.gates_of_group.at(0));
+            different.gates_of_group[1] = dataflow::GroupGates(std::unordered_set<u32>{5, 6, 7, 9});
+            EXPECT_FALSE(different == grouping);
+            EXPECT_TRUE(different != grouping);
+
+            // modifying a copy does not affect the original
+            dataflow::Grouping modified(grouping);
+            modified.gates_of_group.at(1).insert(9);
+            EXPECT_FALSE(modified == grouping);
+            EXPECT_EQ(grouping.gates_of_group.at(1).size(), 4u);
+        }
+        TEST_END
+    }
+    /**
+     * Test that a parallel loop executes every index exactly once, even if the iterations differ a lot in their cost.
+     *
+     * Functions: thread_pool::set_num_threads, thread_pool::parallel_for
+     */
+    TEST_F(DataflowTest, check_thread_pool_parallel_for)
+    {
+        TEST_START
+        {
+            for (u32 num_threads : {1u, 2u, 8u})
+            {
+                dataflow::utils::thread_pool pool;
+                pool.set_num_threads(num_threads);
+                EXPECT_EQ(pool.get_num_threads(), num_threads);
+
+                auto counts = count_iterations(pool, 0, 1000);
+                EXPECT_EQ(counts, std::vector<u32>(1000, 1)) << "with " << num_threads << " threads";
+
+                // a range that does not start at 0
+                counts = count_iterations(pool, 100, 300);
+                std::vector<u32> expected(300, 0);
+                std::fill(expected.begin() + 100, expected.end(), 1);
+                EXPECT_EQ(counts, expected) << "with " << num_threads << " threads";
+            }
+        }
+        {
+            // empty and single-element ranges
+            dataflow::utils::thread_pool pool;
+            pool.set_num_threads(4);
+
+            std::atomic<u32> calls = 0;
+            pool.parallel_for(5, 5, [&calls](u32) { calls++; });
+            pool.parallel_for(6, 5, [&calls](u32) { calls++; });
+            EXPECT_EQ(calls.load(), 0u);
+
+            pool.parallel_for(5, 6, [&calls](u32 i) {
+                EXPECT_EQ(i, 5u);
+                calls++;
+            });
+            EXPECT_EQ(calls.load(), 1u);
+        }
+        TEST_END
+    }
+
+    /**
+     * Test that a parallel loop within a parallel loop is executed sequentially by the calling thread.
+     *
+     * Functions: thread_pool::parallel_for
+     */
+    TEST_F(DataflowTest, check_thread_pool_nested)
+    {
+        TEST_START
+        {
+            dataflow::utils::thread_pool pool;
+            pool.set_num_threads(4);
+
+            std::vector<std::atomic<u32>> counts(16 * 100);
+            std::atomic<u32> foreign_iterations = 0;
+            pool.parallel_for(0, 16, [&](u32 outer) {
+                auto outer_thread = std::this_thread::get_id();
+                pool.parallel_for(0, 100, [&](u32 inner) {
+                    if (std::this_thread::get_id() != outer_thread)
+                    {
+                        foreign_iterations++;
+                    }
+                    counts[outer * 100 + inner]++;
+                });
+            });
+
+            EXPECT_EQ(foreign_iterations.load(), 0u);
+            for (u32 i = 0; i < counts.size(); ++i)
+            {
+                EXPECT_EQ(counts[i].load(), 1u) << "at index " << i;
+            }
+        }
+        TEST_END
+    }
+
+    /**
+     * Test that the number of threads can be changed and that the pool can be used again after it was stopped.
+     *
+     * Functions: thread_pool::set_num_threads, thread_pool::stop, thread_pool::parallel_for
+     */
+    TEST_F(DataflowTest, check_thread_pool_restart)
+    {
+        TEST_START
+        {
+            dataflow::utils::thread_pool pool;
+
+            // without any threads set, loops are executed by the calling thread
+            EXPECT_EQ(count_iterations(pool, 0, 100), std::vector<u32>(100, 1));
+
+            pool.set_num_threads(3);
+            EXPECT_EQ(count_iterations(pool, 0, 100), std::vector<u32>(100, 1));
+
+            pool.set_num_threads(2);
+            EXPECT_EQ(pool.get_num_threads(), 2u);
+            EXPECT_EQ(count_iterations(pool, 0, 100), std::vector<u32>(100, 1));
+
+            // setting the same number again keeps the pool working
+            pool.set_num_threads(2);
+            EXPECT_EQ(count_iterations(pool, 0, 100), std::vector<u32>(100, 1));
+
+            pool.stop();
+            EXPECT_EQ(pool.get_num_threads(), 1u);
+            EXPECT_EQ(count_iterations(pool, 0, 100), std::vector<u32>(100, 1));
+
+            pool.set_num_threads(4);
+            EXPECT_EQ(pool.get_num_threads(), 4u);
+            EXPECT_EQ(count_iterations(pool, 0, 100), std::vector<u32>(100, 1));
+
+            pool.stop();
+            pool.stop();
+        }
+        TEST_END
+    }
+}    // namespace hal
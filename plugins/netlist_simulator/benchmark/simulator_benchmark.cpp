@@ -0,0 +1,536 @@
+#include "hal_core/netlist/gate.h"
+#include "hal_core/netlist/gate_library/gate_library.h"
+#include "hal_core/netlist/gate_library/gate_library_manager.h"
+#include "hal_core/netlist/net.h"
+#include "hal_core/netlist/netlist.h"
+#include "hal_core/netlist/netlist_factory.h"
+#include "hal_core/plugin_system/plugin_manager.h"
+#include "hal_core/utilities/log.h"
+#include "netlist_simulator/event_queue.h"
+#include "netlist_simulator/netlist_simulator.h"
+#include "netlist_simulator/plugin_netlist_simulator.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <string>
+#include <sys/resource.h>
+#include <thread>
+#include <vector>
+
+/*
+ * Simulation throughput benchmark on synthetic designs built from the Nangate Open Cell Library.
+ *
+ * usage: simulator_benchmark [--design <all|ripple_counter|lfsr|adder|aes>] [--mode <all|event_driven|cycle_based|bit_parallel>]
+ *                            [--size <n>] [--rounds <n>] [--cycles <n>] [--threads <n|sweep>] [--window <ps>] [--queue-steps <n>]
+ *
+ * For every design and mode, the simulator runs for a fixed number of clock cycles with profiling enabled.
+ * Reported are the simulated events and gate evaluations per second of wall-clock time as well as the peak memory of the process.
+ * In bit-parallel mode, every lane receives its own stimulus and every event and evaluation covers all lanes at once.
+ * '--threads sweep' runs every configuration with 1, 2, 4, ... threads up to the number of hardware threads and reports the speedup over one thread.
+ * By default, the whole history is recorded, '--window' restricts it via 'set_history_window'.
+ * Unless a single design is selected, the event queue is additionally measured on its own with a simulation-like push and pop pattern.
+ */
+
+namespace hal
+{
+    namespace
+    {
+        const u64 CLOCK_PERIOD = 10000;
+
+        struct Design
+        {
+            std::unique_ptr<Netlist> netlist;
+            Net* clock   = nullptr;
+            Net* reset_n = nullptr;
+            std::vector<Net*> inputs;
+        };
+
+        class DesignBuilder
+        {
+        public:
+            DesignBuilder(GateLibrary* lib, Design& design) : m_types(lib->get_gate_types()), m_design(design)
+            {
+                m_design.netlist = netlist_factory::create_netlist(lib);
+                m_netlist        = m_design.netlist.get();
+
+                m_design.clock   = create_input("clk");
+                m_design.reset_n = create_input("rst_n");
+            }
+
+            Net* create_input(const std::string& name)
+            {
+                Net* net = m_netlist->create_net(name);
+                m_netlist->mark_global_input_net(net);
+                return net;
+            }
+
+            Gate* create_gate(const std::string& type, const std::vector<std::pair<std::string, Net*>>& inputs)
+            {
+                Gate* gate = m_netlist->create_gate(m_types.at(type), type + "_" + std::to_string(m_netlist->get_gates().size()));
+                for (const auto& [pin, net] : inputs)
+                {
+                    net->add_destination(gate, pin);
+                }
+                return gate;
+            }
+
+            Net* output(Gate* gate, const std::string& pin)
+            {
+                Net* net = m_netlist->create_net(gate->get_name() + "_" + pin);
+                net->add_source(gate, pin);
+                return net;
+            }
+
+            Net* gate(const std::string& type, const std::vector<std::pair<std::string, Net*>>& inputs, const std::string& output_pin)
+            {
+                return output(create_gate(type, inputs), output_pin);
+            }
+
+            Net* constant(bool value)
+            {
+                Net*& net = value ? m_one : m_zero;
+                if (net == nullptr)
+                {
+                    net = gate(value ? "LOGIC1_X1" : "LOGIC0_X1", {}, "Z");
+                }
+                return net;
+            }
+
+            // a register with active-low reset, its data input is connected by the caller
+            Gate* reg(Net* clock)
+            {
+                return create_gate("DFFR_X1", {{"CK", clock}, {"RN", m_design.reset_n}});
+            }
+
+            void mark_output(Net* net)
+            {
+                m_netlist->mark_global_output_net(net);
+            }
+
+        private:
+            std::unordered_map<std::string, GateType*> m_types;
+            Design& m_design;
+            Netlist* m_netlist;
+            Net* m_zero = nullptr;
+            Net* m_one  = nullptr;
+        };
+
+        // 'size' asynchronous 16-bit ripple counters, every stage is clocked by the inverted output of the previous one
+        Design create_ripple_counters(GateLibrary* lib, u32 size, u32)
+        {
+            Design design;
+            DesignBuilder builder(lib, design);
+            for (u32 i = 0; i < size; ++i)
+            {
+                Net* clock = design.clock;
+                for (u32 j = 0; j < 16; ++j)
+                {
+                    Gate* ff = builder.reg(clock);
+                    Net* q   = builder.output(ff, "Q");
+                    Net* qn  = builder.output(ff, "QN");
+                    qn->add_destination(ff, "D");
+                    clock = qn;
+                    if (j == 15)
+                    {
+                        builder.mark_output(q);
+                    }
+                }
+            }
+            return design;
+        }
+
+        // 'size' 32-bit Fibonacci LFSRs with XNOR feedback, such that the all-zero reset state is valid
+        Design create_lfsrs(GateLibrary* lib, u32 size, u32)
+        {
+            Design design;
+            DesignBuilder builder(lib, design);
+            for (u32 i = 0; i < size; ++i)
+            {
+                std::vector<Gate*> ffs;
+                std::vector<Net*> state;
+                for (u32 j = 0; j < 32; ++j)
+                {
+                    ffs.push_back(builder.reg(design.clock));
+                    state.push_back(builder.output(ffs.back(), "Q"));
+                }
+                // taps 32, 22, 2, 1
+                Net* feedback = builder.gate("XNOR2_X1", {{"A", state[31]}, {"B", state[21]}}, "ZN");
+                feedback      = builder.gate("XNOR2_X1", {{"A", feedback}, {"B", state[1]}}, "ZN");
+                feedback      = builder.gate("XNOR2_X1", {{"A", feedback}, {"B", state[0]}}, "ZN");
+                feedback->add_destination(ffs[0], "D");
+                for (u32 j = 1; j < 32; ++j)
+                {
+                    state[j - 1]->add_destination(ffs[j], "D");
+                }
+                builder.mark_output(state[31]);
+            }
+            return design;
+        }
+
+        // a (32 * 'size')-bit register pair computing a <- a + b + 1 and b <- a with a ripple-carry adder
+        Design create_adder(GateLibrary* lib, u32 size, u32)
+        {
+            Design design;
+            DesignBuilder builder(lib, design);
+            u32 width = 32 * size;
+            std::vector<Gate*> a_ffs, b_ffs;
+            std::vector<Net*> a, b_values;
+            for (u32 i = 0; i < width; ++i)
+            {
+                a_ffs.push_back(builder.reg(design.clock));
+                a.push_back(builder.output(a_ffs.back(), "Q"));
+                b_ffs.push_back(builder.reg(design.clock));
+                b_values.push_back(builder.output(b_ffs.back(), "Q"));
+            }
+            Net* carry = builder.constant(true);
+            for (u32 i = 0; i < width; ++i)
+            {
+                Gate* fa = builder.create_gate("FA_X1", {{"A", a[i]}, {"B", b_values[i]}, {"CI", carry}});
+                builder.output(fa, "S")->add_destination(a_ffs[i], "D");
+                carry = builder.output(fa, "CO");
+                a[i]->add_destination(b_ffs[i], "D");
+            }
+            builder.mark_output(carry);
+            return design;
+        }
+
+        // 16 * 'size' state bytes passing through 'rounds' unrolled rounds per cycle, each consisting of a chi-like nonlinear layer per byte, a byte rotation, a linear mixing layer, and the addition of a round key taken from the inputs
+        Design create_aes_like(GateLibrary* lib, u32 size, u32 rounds)
+        {
+            Design design;
+            DesignBuilder builder(lib, design);
+            u32 bytes = 16 * size;
+            for (u32 i = 0; i < 8 * bytes; ++i)
+            {
+                design.inputs.push_back(builder.create_input("key_" + std::to_string(i)));
+            }
+
+            std::vector<Gate*> ffs;
+            std::vector<Net*> state;
+            for (u32 i = 0; i < 8 * bytes; ++i)
+            {
+                ffs.push_back(builder.reg(design.clock));
+                state.push_back(builder.output(ffs.back(), "Q"));
+            }
+
+            for (u32 round = 0; round < rounds; ++round)
+            {
+                // nonlinear layer: y_i = x_i ^ (!x_{i+1} & x_{i+2}) within every byte
+                std::vector<Net*> substituted(state.size());
+                for (u32 i = 0; i < bytes; ++i)
+                {
+                    for (u32 j = 0; j < 8; ++j)
+                    {
+                        Net* x0         = state[8 * i + j];
+                        Net* x1         = state[8 * i + (j + 1) % 8];
+                        Net* x2         = state[8 * i + (j + 2) % 8];
+                        Net* inverted   = builder.gate("INV_X1", {{"A", x1}}, "ZN");
+                        Net* product    = builder.gate("AND2_X1", {{"A1", inverted}, {"A2", x2}}, "ZN");
+
+                        substituted[8 * i + j] = builder.gate("XOR2_X1", {{"A", x0}, {"B", product}}, "Z");
+                    }
+                }
+
+                // permutation: rotate byte i of every 4-byte column by i positions, similar to ShiftRows
+                std::vector<Net*> shifted(state.size());
+                for (u32 i = 0; i < bytes; ++i)
+                {
+                    u32 column = i / 4;
+                    u32 row    = i % 4;
+                    u32 source = 4 * ((column + row) % (bytes / 4)) + row;
+                    for (u32 j = 0; j < 8; ++j)
+                    {
+                        shifted[8 * i + j] = substituted[8 * source + j];
+                    }
+                }
+
+                // linear layer and key addition: x_i ^ rotl(x_{i+1}, 1) ^ k_i
+                for (u32 i = 0; i < bytes; ++i)
+                {
+                    u32 next = 4 * (i / 4) + (i + 1) % 4;
+                    for (u32 j = 0; j < 8; ++j)
+                    {
+                        Net* mixed       = builder.gate("XOR2_X1", {{"A", shifted[8 * i + j]}, {"B", shifted[8 * next + (j + 7) % 8]}}, "Z");
+                        state[8 * i + j] = builder.gate("XOR2_X1", {{"A", mixed}, {"B", design.inputs[8 * i + j]}}, "Z");
+                    }
+                }
+            }
+
+            for (u32 i = 0; i < state.size(); ++i)
+            {
+                state[i]->add_destination(ffs[i], "D");
+                builder.mark_output(state[i]);
+            }
+            return design;
+        }
+
+        u64 get_peak_memory_kb()
+        {
+            struct rusage usage;
+            getrusage(RUSAGE_SELF, &usage);
+            return usage.ru_maxrss;
+        }
+
+        double run_benchmark(const NetlistSimulatorPlugin* plugin,
+                             const std::string& design_name,
+                             const Design& design,
+                             SimulationMode mode,
+                             const std::string& mode_name,
+                             u32 cycles,
+                             u32 threads,
+                             u64 window,
+                             double single_thread_seconds)
+        {
+            auto sim = plugin->create_simulator(mode);
+            sim->set_thread_count(threads);
+            sim->set_profiling_enabled(true);
+            sim->set_history_window(window);
+
+            auto gates = design.netlist->get_gates();
+            sim->add_gates(gates);
+            sim->add_clock_period(design.clock, CLOCK_PERIOD);
+
+            std::mt19937_64 rng(0);
+            // in bit-parallel mode, every lane receives its own random stimulus
+            auto apply_inputs = [&]() {
+                for (Net* net : design.inputs)
+                {
+                    if (mode == SimulationMode::bit_parallel)
+                    {
+                        u64 values = rng();
+                        for (u32 lane = 0; lane < NetlistSimulator::LANE_COUNT; ++lane)
+                        {
+                            sim->set_lane_input(net, lane, ((values >> lane) & 1) ? SignalValue::ONE : SignalValue::ZERO);
+                        }
+                    }
+                    else
+                    {
+                        sim->set_input(net, (rng() & 1) ? SignalValue::ONE : SignalValue::ZERO);
+                    }
+                }
+            };
+
+            // hold the design in reset for one cycle, which is not part of the measurement
+            sim->set_input(design.reset_n, SignalValue::ZERO);
+            apply_inputs();
+            sim->simulate(CLOCK_PERIOD);
+            sim->set_input(design.reset_n, SignalValue::ONE);
+            sim->reset_profile();
+
+            auto begin = std::chrono::steady_clock::now();
+            for (u32 i = 0; i < cycles; ++i)
+            {
+                apply_inputs();
+                sim->simulate(CLOCK_PERIOD);
+            }
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+            auto profile = sim->get_profile(0);
+            printf("%-16s %-14s %9zu %8u %7u %9.3f %8.2f %14.0f %14.0f %12.0f %10.1f\n",
+                   design_name.c_str(),
+                   mode_name.c_str(),
+                   gates.size(),
+                   cycles,
+                   sim->get_thread_count(),
+                   seconds,
+                   (single_thread_seconds > 0) ? single_thread_seconds / seconds : 1.0,
+                   profile.events / seconds,
+                   profile.gate_evaluations / seconds,
+                   cycles / seconds,
+                   get_peak_memory_kb() / 1024.0);
+            fflush(stdout);
+            return seconds;
+        }
+
+        void run_event_queue_benchmark(u32 steps)
+        {
+            std::mt19937_64 rng(42);
+            EventQueue queue;
+            std::vector<Event> events;
+            u64 current_time = 0;
+            u64 popped       = 0;
+
+            // most events happen at the current time or shortly after, few of them far in the future
+            auto begin = std::chrono::steady_clock::now();
+            for (u32 step = 0; step < steps; ++step)
+            {
+                u32 to_push = 1 + rng() % 3;
+                for (u32 i = 0; i < to_push; ++i)
+                {
+                    Event e;
+                    e.affected_net = nullptr;
+                    e.new_value    = SignalValue::ZERO;
+                    u64 r          = rng() % 100;
+                    e.time         = current_time + ((r < 60) ? 0 : ((r < 95) ? rng() % 1000 : rng() % 100000));
+                    queue.push(e);
+                }
+                events.clear();
+                queue.pop_next_time(events);
+                current_time = events.front().time;
+                popped += events.size();
+            }
+            while (!queue.empty())
+            {
+                events.clear();
+                queue.pop_next_time(events);
+                popped += events.size();
+            }
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+            printf("event queue: %u steps, %llu events in %.3f s, %.0f events/s\n", steps, (unsigned long long)popped, seconds, popped / seconds);
+            fflush(stdout);
+        }
+
+        void print_usage()
+        {
+            std::cout << "usage: simulator_benchmark [--design <all|ripple_counter|lfsr|adder|aes>] [--mode <all|event_driven|cycle_based|bit_parallel>]" << std::endl;
+            std::cout << "                           [--size <n>] [--rounds <n>] [--cycles <n>] [--threads <n|sweep>] [--window <ps>] [--queue-steps <n>]" << std::endl;
+        }
+    }    // namespace
+}    // namespace hal
+
+using namespace hal;
+
+int main(int argc, const char* argv[])
+{
+    std::string design_filter = "all";
+    std::string mode_filter   = "all";
+    u32 size                  = 16;
+    u32 rounds                = 2;
+    u32 cycles                = 1000;
+    std::vector<u32> thread_counts = {1};
+    u64 window                = 0;
+    u32 queue_steps           = 1000000;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if (arg == "--help" || i + 1 == argc)
+        {
+            print_usage();
+            return (arg == "--help") ? 0 : 1;
+        }
+        std::string value = argv[++i];
+        if (arg == "--design")
+        {
+            design_filter = value;
+        }
+        else if (arg == "--mode")
+        {
+            mode_filter = value;
+        }
+        else if (arg == "--size")
+        {
+            size = std::stoul(value);
+        }
+        else if (arg == "--rounds")
+        {
+            rounds = std::stoul(value);
+        }
+        else if (arg == "--cycles")
+        {
+            cycles = std::stoul(value);
+        }
+        else if (arg == "--threads")
+        {
+            thread_counts.clear();
+            if (value == "sweep")
+            {
+                u32 max_threads = std::max(1u, std::thread::hardware_concurrency());
+                for (u32 threads = 1; threads < max_threads; threads *= 2)
+                {
+                    thread_counts.push_back(threads);
+                }
+                thread_counts.push_back(max_threads);
+            }
+            else
+            {
+                thread_counts.push_back(std::stoul(value));
+            }
+        }
+        else if (arg == "--window")
+        {
+            window = std::stoull(value);
+        }
+        else if (arg == "--queue-steps")
+        {
+            queue_steps = std::stoul(value);
+        }
+        else
+        {
+            print_usage();
+            return 1;
+        }
+    }
+
+    if (size == 0 || rounds == 0)
+    {
+        std::cerr << "size and rounds must be at least 1." << std::endl;
+        return 1;
+    }
+
+    plugin_manager::load_all_plugins();
+    LogManager::get_instance().set_level_of_channel("netlist_simulator", "warn");
+
+    GateLibrary* lib = gate_library_manager::get_gate_library("NangateOpenCellLibrary.hgl");
+    if (lib == nullptr)
+    {
+        std::cerr << "could not load the Nangate Open Cell Library." << std::endl;
+        return 1;
+    }
+    auto plugin = plugin_manager::get_plugin_instance<NetlistSimulatorPlugin>("netlist_simulator");
+    if (plugin == nullptr)
+    {
+        std::cerr << "could not load the netlist simulator plugin." << std::endl;
+        return 1;
+    }
+
+    const std::vector<std::pair<std::string, std::function<Design(GateLibrary*, u32, u32)>>> designs = {
+        {"ripple_counter", create_ripple_counters},
+        {"lfsr", create_lfsrs},
+        {"adder", create_adder},
+        {"aes", create_aes_like},
+    };
+    const std::vector<std::pair<std::string, SimulationMode>> modes = {
+        {"event_driven", SimulationMode::event_driven},
+        {"cycle_based", SimulationMode::cycle_based},
+        {"bit_parallel", SimulationMode::bit_parallel},
+    };
+
+    printf("%-16s %-14s %9s %8s %7s %9s %8s %14s %14s %12s %10s\n", "design", "mode", "gates", "cycles", "threads", "time [s]", "speedup", "events/s", "gates/s", "cycles/s", "peak [MB]");
+    for (const auto& [design_name, create_design] : designs)
+    {
+        if (design_filter != "all" && design_filter != design_name)
+        {
+            continue;
+        }
+        Design design = create_design(lib, size, rounds);
+        for (const auto& [mode_name, mode] : modes)
+        {
+            if (mode_filter != "all" && mode_filter != mode_name)
+            {
+                continue;
+            }
+            double single_thread_seconds = 0;
+            for (u32 threads : thread_counts)
+            {
+                double seconds = run_benchmark(plugin, design_name, design, mode, mode_name, cycles, threads, window, single_thread_seconds);
+                if (threads == 1)
+                {
+                    single_thread_seconds = seconds;
+                }
+            }
+        }
+    }
+
+    if (design_filter == "all" && queue_steps > 0)
+    {
+        run_event_queue_benchmark(queue_steps);
+    }
+
+    return 0;
+}
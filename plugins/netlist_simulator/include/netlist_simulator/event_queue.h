@@ -0,0 +1,123 @@
+//  MIT License
+//
+//  Copyright (c) 2019 Ruhr University Bochum, Chair for Embedded Security. All Rights reserved.
+//  Copyright (c) 2021 Max Planck Institute for Security and Privacy. All Rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+
+
+#pragma once
+
+#include "netlist_simulator/event.h"
+
+#include <map>
+#include <vector>
+
+namespace hal
+{
+    /**
+     * Time-ordered queue of pending simulation events implemented as a timing wheel.
+     *
+     * The wheel has one FIFO bucket per picosecond of a sliding window that starts at the earliest pending event.
+     * Events beyond the window are kept in an overflow map and moved into the wheel once the window reaches them.
+     * Events of the same point in time are returned in the order they were pushed, which preserves the order of delta cycles.
+     * Pushing and popping an event takes amortized constant time.
+     */
+    class EventQueue
+    {
+    public:
+        /**
+         * Construct an empty event queue.
+         */
+        EventQueue();
+
+        /**
+         * Add an event to the queue.
+         * The event is assigned a new unique ID.
+         *
+         * @param[in] event - The event to add.
+         */
+        void push(Event event);
+
+        /**
+         * Move all events of the earliest pending point in time to the end of a vector in the order they were pushed.
+         * Does nothing if the queue is empty.
+         *
+         * @param[inout] events - The vector to which the events are appended.
+         */
+        void pop_next_time(std::vector<Event>& events);
+
+        /**
+         * Get the earliest point in time for which there are pending events.
+         *
+         * @returns The earliest pending point in time or the maximum value of u64 if the queue is empty.
+         */
+        u64 get_next_time() const;
+
+        /**
+         * Check whether the queue is empty.
+         *
+         * @returns True if there are no pending events, false otherwise.
+         */
+        bool empty() const;
+
+        /**
+         * Get the number of pending events.
+         *
+         * @returns The number of pending events.
+         */
+        u64 size() const;
+
+        /**
+         * Get a copy of all pending events in the order they would be popped.
+         *
+         * @returns The pending events.
+         */
+        std::vector<Event> get_events() const;
+
+        /**
+         * Remove all pending events and reset the event IDs.
+         */
+        void clear();
+
+    private:
+        static constexpr u32 WHEEL_BITS = 14;
+        static constexpr u64 WHEEL_SIZE = 1ull << WHEEL_BITS;
+        static constexpr u64 WHEEL_MASK = WHEEL_SIZE - 1;
+
+        // the wheel covers [m_wheel_start, m_wheel_start + WHEEL_SIZE), each slot holds the events of exactly one point in time
+        std::vector<std::vector<Event>> m_slots;
+        std::vector<u64> m_occupied_slots;
+        u64 m_wheel_start       = 0;
+        u64 m_wheel_event_count = 0;
+
+        std::map<u64, std::vector<Event>> m_overflow;
+
+        u64 m_size       = 0;
+        u64 m_id_counter = 0;
+
+        // earliest time in the wheel, cached until the wheel changes
+        mutable u64 m_next_time = ~0ull;
+
+        void push_to_wheel(Event&& event);
+        void fill_wheel();
+        void rebase_wheel(u64 new_start);
+        u64 find_next_wheel_time() const;
+    };
+}    // namespace hal
@@ -0,0 +1,88 @@
+//  MIT License
+//
+//  Copyright (c) 2019 Ruhr University Bochum, Chair for Embedded Security. All Rights reserved.
+//  Copyright (c) 2021 Max Planck Institute for Security and Privacy. All Rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+
+#pragma once
+
+#include "hal_core/defines.h"
+
+namespace hal
+{
+    class Net;
+
+    /**
+     * The kinds of faults supported by the fault simulation.
+     */
+    enum class FaultType
+    {
+        stuck_at_0, /**< The net permanently carries a 0, regardless of its driver. */
+        stuck_at_1, /**< The net permanently carries a 1, regardless of its driver. */
+        bit_flip    /**< The value of the net is inverted once until the net is driven again, e.g., a flipped flip-flop keeps its wrong state until it is clocked. */
+    };
+
+    struct Fault
+    {
+        /**
+         * The kind of fault.
+         */
+        FaultType type;
+
+        /**
+         * The net affected by the fault.
+         */
+        Net* net;
+
+        /**
+         * The time of a bit flip in picoseconds relative to the start of the fault simulation, ignored for stuck-at faults.
+         */
+        u64 time;
+    };
+
+    struct FaultResult
+    {
+        /**
+         * True if the fault changed the value of at least one sampled output net.
+         */
+        bool detected;
+
+        /**
+         * The index of the first cycle in which an output net differed from the fault-free simulation, or the number of cycles if the fault was not detected.
+         */
+        u64 first_detection_cycle;
+
+        /**
+         * The number of cycles in which at least one output net differed from the fault-free simulation.
+         */
+        u64 corrupted_cycles;
+
+        /**
+         * The number of sampled output values that differed from the fault-free simulation.
+         */
+        u64 corrupted_samples;
+
+        /**
+         * The number of flip-flop outputs whose value differed from the fault-free simulation at the end of the last cycle.
+         * A fault that is not detected but corrupted the state is latent.
+         */
+        u64 corrupted_state_nets;
+    };
+}    // namespace hal
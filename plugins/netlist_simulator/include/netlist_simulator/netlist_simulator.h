@@ -26,16 +26,43 @@
 #include "hal_core/netlist/gate.h"
 #include "hal_core/netlist/gate_library/gate_type.h"
 #include "hal_core/netlist/net.h"
+#include "netlist_simulator/event_queue.h"
+#include "netlist_simulator/fault.h"
 #include "netlist_simulator/simulation.h"
+#include "netlist_simulator/simulation_checkpoint.h"
+#include "netlist_simulator/simulation_profile.h"
 
+#include <fstream>
 #include <map>
+#include <memory>
+#include <unordered_map>
 #include <unordered_set>
 
 namespace hal
 {
+    /**
+     * The engine used by the netlist simulator.
+     */
+    enum class SimulationMode
+    {
+        event_driven, /**< Propagate every signal change through an event queue. */
+        cycle_based,  /**< Evaluate the combinational logic in topological order over a dense value array, only clock, input, and flip-flop changes are queued. */
+        bit_parallel  /**< Like cycle_based, but simulate 64 independent stimulus lanes at once using word-wide logic. */
+    };
+
     class NetlistSimulator
     {
     public:
+        /**
+         * The number of independent stimulus lanes simulated in bit-parallel mode.
+         */
+        static constexpr u32 LANE_COUNT = 64;
+
+        /**
+         * Closes a VCD stream that is still open.
+         */
+        ~NetlistSimulator();
+
         /**
          * Add gates to the simulation set.
          * Only elements in the simulation set are considered during simulation.
@@ -46,21 +73,27 @@ namespace hal
 
         /**
          * Specify a net that carries the clock signal and set the clock frequency in hertz.
+         * Only the next edge of every clock is scheduled at any time, so the duration of a simulation does not affect the number of pending events.
          *
          * @param[in] clock_net - The net that carries the clock signal.
          * @param[in] frequency - The clock frequency in hertz.
          * @param[in] start_at_zero - Initial clock state is 0 if true, 1 otherwise.
+         * @param[in] phase - The delay of the clock signal in picoseconds.
+         * @param[in] duty_cycle - The fraction of the period in which the clock signal is 1, must be between 0 and 1 (exclusive).
          */
-        void add_clock_frequency(Net* clock_net, u64 frequency, bool start_at_zero = true);
+        void add_clock_frequency(Net* clock_net, u64 frequency, bool start_at_zero = true, u64 phase = 0, double duty_cycle = 0.5);
 
         /**
          * Specify a net that carries the clock signal and set the clock period in picoseconds.
+         * Only the next edge of every clock is scheduled at any time, so the duration of a simulation does not affect the number of pending events.
          *
          * @param[in] clock_net - The net that carries the clock signal.
          * @param[in] period - The clock period from rising edge to rising edge in picoseconds.
          * @param[in] start_at_zero - Initial clock state is 0 if true, 1 otherwise.
+         * @param[in] phase - The delay of the clock signal in picoseconds.
+         * @param[in] duty_cycle - The fraction of the period in which the clock signal is 1, must be between 0 and 1 (exclusive).
          */
-        void add_clock_period(Net* clock_net, u64 period, bool start_at_zero = true);
+        void add_clock_period(Net* clock_net, u64 period, bool start_at_zero = true, u64 phase = 0, double duty_cycle = 0.5);
 
         /**
          * Get all gates that are in the simulation set.
@@ -91,6 +124,17 @@ namespace hal
          */
         void set_input(Net* net, SignalValue value);
 
+        /**
+         * Set the signal for a specific wire in a single lane of the bit-parallel simulation.
+         * All other lanes keep their current value.
+         * Signal values other than 0 and 1 are treated as X in bit-parallel mode.
+         *
+         * @param[in] net - The net to set a signal value for.
+         * @param[in] lane - The lane to set the signal value in.
+         * @param[in] value - The value to set.
+         */
+        void set_lane_input(Net* net, u32 lane, SignalValue value);
+
         /**
          * Load the specified initial value into the current state of all sequential elements.
          * 
@@ -112,6 +156,38 @@ namespace hal
          */
         void simulate(u64 picoseconds);
 
+        /**
+         * Simulate a sequence of cycles, each of which applies one row of input values and then simulates for a fixed period.
+         * The values of the output nets are sampled at the end of every cycle.
+         * This is equivalent to calling 'set_input' for every input net and 'simulate' once per cycle, but avoids the overhead of the individual calls.
+         * Clocks are not affected by the stimuli, hence the period usually equals the clock period.
+         * In bit-parallel mode, the input values are applied to all lanes and the outputs of lane 0 are sampled.
+         * For long sequences, consider restricting the recorded history via 'set_watched_nets' and 'set_history_window'.
+         *
+         * @param[in] input_nets - The input nets to control.
+         * @param[in] stimuli - The input values of all cycles, one row of values in the order of \p input_nets per cycle.
+         * @param[in] output_nets - The nets to sample.
+         * @param[in] picoseconds - The duration of a single cycle.
+         * @returns The sampled values, one row of values in the order of \p output_nets per cycle, or an empty vector on error.
+         */
+        std::vector<SignalValue> simulate_cycles(const std::vector<Net*>& input_nets, const std::vector<SignalValue>& stimuli, const std::vector<Net*>& output_nets, u64 picoseconds);
+
+        /**
+         * Simulate a sequence of cycles like 'simulate_cycles' once for every fault and compare the sampled output nets to a fault-free simulation.
+         * Requires bit-parallel mode: every lane simulates a different fault, so batches of 64 faults are simulated at once.
+         * The batches are distributed over the threads set via 'set_thread_count', each of which simulates on its own copy of the simulator.
+         * All batches start from the current simulation state, which is not modified.
+         * Memory for the sampled output values of the fault-free simulation grows with the number of cycles.
+         *
+         * @param[in] faults - The faults to simulate.
+         * @param[in] input_nets - The input nets to control.
+         * @param[in] stimuli - The input values of all cycles, one row of values in the order of \p input_nets per cycle.
+         * @param[in] output_nets - The nets to sample.
+         * @param[in] picoseconds - The duration of a single cycle.
+         * @returns The result of every fault in the order of \p faults, or an empty vector on error.
+         */
+        std::vector<FaultResult> simulate_faults(const std::vector<Fault>& faults, const std::vector<Net*>& input_nets, const std::vector<SignalValue>& stimuli, const std::vector<Net*>& output_nets, u64 picoseconds);
+
         /**
          * Reset the simulator state, i.e., treat all signals as unknown.
          * Does not remove gates/nets from the simulation set.
@@ -121,6 +197,7 @@ namespace hal
         /**
          * Set the simulator state, i.e., net signals, to a given state.
          * Does not influence gates/nets added to the simulation set.
+         * In bit-parallel mode, the state is applied to all lanes.
          *
          * @param[in] state - The state to apply.
          */
@@ -128,14 +205,59 @@ namespace hal
 
         /**
          * Get the current simulation state.
+         * In bit-parallel mode, this is the state of lane 0.
          *
          * @returns The current simulation state.
          */
         Simulation get_simulation_state() const;
 
+        /**
+         * Get the current simulation state of a single lane of the bit-parallel simulation.
+         *
+         * @param[in] lane - The lane.
+         * @returns The current simulation state of the lane.
+         */
+        Simulation get_lane_simulation_state(u32 lane) const;
+
+        /**
+         * Create a checkpoint of the current simulation state from which the simulation can be resumed later on.
+         * The checkpoint holds the current value of every net, the pending events, and the next edge of every clock, but not the recorded history.
+         * Hence, it is considerably cheaper to create and restore than the full simulation state.
+         *
+         * @returns The checkpoint.
+         */
+        SimulationCheckpoint create_checkpoint() const;
+
+        /**
+         * Resume the simulation from a checkpoint that was created by this simulator or by a simulator with the same gates, clocks, and simulation mode.
+         * The recorded history is replaced by the value changes stored in the checkpoint and an open VCD stream is closed.
+         *
+         * @param[in] checkpoint - The checkpoint to restore.
+         */
+        void restore_checkpoint(const SimulationCheckpoint& checkpoint);
+
+        /**
+         * Create an independent simulator with the same gates, clocks, and settings that resumes the simulation from a checkpoint.
+         * Useful to branch a simulation into multiple variants that share a common prefix.
+         * An open VCD stream is not transferred to the new simulator.
+         *
+         * @param[in] checkpoint - The checkpoint to resume from.
+         * @returns The new simulator.
+         */
+        std::unique_ptr<NetlistSimulator> fork(const SimulationCheckpoint& checkpoint) const;
+
+        /**
+         * Get all combinational loops among the gates of the simulation set, i.e., the strongly connected components of the graph of combinational gates.
+         * Loops are reported when the simulation is initialized.
+         * In event-driven mode, a loop that does not settle within a bounded number of gate evaluations at a single point in time is resolved by setting all of its nets to X until the point in time advances.
+         *
+         * @returns The gates of every combinational loop sorted by ID.
+         */
+        std::vector<std::vector<Gate*>> get_combinational_loops() const;
+
         /**
          * Set the iteration timeout, i.e., the maximum number of events processed for a single point in time.
-         * Useful to abort in case of infinite loops.
+         * Useful to abort in case of infinite loops that are not caught by the resolution of combinational loops.
          * A value of 0 disables the timeout.
          *
          * @param[in] iterations - The iteration timeout.
@@ -149,6 +271,141 @@ namespace hal
          */
         u64 get_simulation_timeout() const;
 
+        /**
+         * Set the simulation mode.
+         * In cycle-based mode, the combinational logic is levelized once and evaluated in topological order, which is considerably faster for synchronous designs.
+         * It produces the same results as the event-driven mode, except for zero-delay glitches within a single point in time that only the event-driven mode propagates.
+         * Netlists with combinational loops or nets with multiple drivers are always simulated event-driven.
+         * In bit-parallel mode, 64 independent stimulus lanes are simulated at once with the semantics of the cycle-based mode; such netlists are not supported in this mode.
+         *
+         * @param[in] mode - The simulation mode.
+         */
+        void set_simulation_mode(SimulationMode mode);
+
+        /**
+         * Get the simulation mode.
+         *
+         * @returns The simulation mode.
+         */
+        SimulationMode get_simulation_mode() const;
+
+        /**
+         * Set the number of threads used to evaluate the combinational logic.
+         * In cycle-based and bit-parallel mode, every level of the levelized combinational logic is split between the threads.
+         * The results are applied in a fixed order afterwards, hence they are identical to a single-threaded simulation.
+         * The event-driven mode always runs single-threaded.
+         * A value of 0 uses all available hardware threads.
+         *
+         * @param[in] threads - The number of threads.
+         */
+        void set_thread_count(u32 threads);
+
+        /**
+         * Get the number of threads used to evaluate the combinational logic.
+         *
+         * @returns The number of threads.
+         */
+        u32 get_thread_count() const;
+
+        /**
+         * Enable or disable profiling, i.e., collecting statistics on the work done by the simulation.
+         * Profiling only adds a counter increment per evaluated gate and a few clock readings per delta cycle.
+         * The statistics are kept until 'reset_profile' is called or the simulation is initialized again, e.g., after adding gates or calling 'reset'.
+         *
+         * @param[in] enabled - True to enable profiling, false to disable it.
+         */
+        void set_profiling_enabled(bool enabled);
+
+        /**
+         * Check whether profiling is enabled.
+         *
+         * @returns True if profiling is enabled, false otherwise.
+         */
+        bool is_profiling_enabled() const;
+
+        /**
+         * Get the statistics collected while profiling was enabled.
+         *
+         * @param[in] top_count - The maximum number of hot gates and glitching nets to report.
+         * @returns The profile.
+         */
+        SimulationProfile get_profile(u32 top_count = 10) const;
+
+        /**
+         * Discard all statistics collected so far.
+         */
+        void reset_profile();
+
+        /**
+         * Set the nets whose value changes are recorded.
+         * Older value changes of all other nets are dropped while simulating, such that only their current value is kept, and they are not written to a VCD stream.
+         * An empty set records all nets.
+         *
+         * @param[in] nets - The nets to record.
+         */
+        void set_watched_nets(const std::set<Net*>& nets);
+
+        /**
+         * Get the nets whose value changes are recorded.
+         *
+         * @returns The recorded nets, an empty set if all nets are recorded.
+         */
+        std::set<Net*> get_watched_nets() const;
+
+        /**
+         * Set the time window of value changes that is kept in memory.
+         * Older value changes are dropped while simulating, only the last change before the window is kept to retain the value at its start.
+         * A value of 0 keeps the whole history.
+         *
+         * @param[in] picoseconds - The length of the window in picoseconds.
+         */
+        void set_history_window(u64 picoseconds);
+
+        /**
+         * Get the time window of value changes that is kept in memory.
+         *
+         * @returns The length of the window in picoseconds, 0 if the whole history is kept.
+         */
+        u64 get_history_window() const;
+
+        /**
+         * Stream all value changes of the watched nets to a VCD file while simulating.
+         * Changes are written once their point in time has been fully simulated, independently of the history window.
+         * In bit-parallel mode, the changes of lane 0 are written.
+         * The stream is closed by \p stop_vcd_stream or when the simulator is reset.
+         *
+         * @param[in] path - The path to the VCD file.
+         * @returns True if the file could be opened, false otherwise.
+         */
+        bool start_vcd_stream(const std::filesystem::path& path);
+
+        /**
+         * Write all remaining value changes to the VCD stream and close it.
+         */
+        void stop_vcd_stream();
+
+        /**
+         * Read input changes from a VCD file while simulating, e.g., a testbench dumped by an RTL simulation.
+         * The file is read in chunks just ahead of the simulated point in time, so large files are never loaded into memory as a whole.
+         * Signals are mapped to nets via \p nets or, if no mapping is given, to input nets of the same name.
+         * The bits of a vector are mapped by their name followed by the index in brackets or parentheses, e.g., "data[3]" or "data(3)".
+         * Signals without a matching net are ignored.
+         * Time 0 of the file corresponds to the current point in time of the simulation.
+         * In bit-parallel mode, the input changes are applied to all lanes.
+         * The file is closed by \p stop_vcd_stimulus, when the simulator is reset, or when a checkpoint is restored.
+         *
+         * @param[in] path - The path to the VCD file.
+         * @param[in] nets - A mapping from signal names to nets, empty to map signals to input nets of the same name.
+         * @returns True if the file could be opened and its header could be parsed, false otherwise.
+         */
+        bool load_vcd_stimulus(const std::filesystem::path& path, const std::unordered_map<std::string, Net*>& nets = {});
+
+        /**
+         * Stop reading input changes from a VCD file.
+         * Input changes that have already been read are still applied.
+         */
+        void stop_vcd_stimulus();
+
         /**
          * Generates the a VCD file for parts the simulated netlist.
          * 
@@ -160,15 +417,33 @@ namespace hal
          */
         bool generate_vcd(const std::filesystem::path& path, u32 start_time, u32 end_time, std::set<Net*> nets = {}) const;
 
+        /**
+         * Generates the a VCD file for parts the simulated netlist using the results of a single lane of the bit-parallel simulation.
+         *
+         * @param[in] lane - The lane.
+         * @param[in] path - The path to the VCD file.
+         * @param[in] start_time - Start of the timeframe to write to the file (in picoseconds).
+         * @param[in] end_time - End of the timeframe to write to the file (in picoseconds).
+         * @param[in] nets - Nets to include in the VCD file.
+         * @returns True if the file gerneration was successful, false otherwise.
+         */
+        bool generate_lane_vcd(u32 lane, const std::filesystem::path& path, u32 start_time, u32 end_time, std::set<Net*> nets = {}) const;
+
     private:
         friend class NetlistSimulatorPlugin;
         NetlistSimulator();
 
+        // a clock only keeps its next edge in the event queue, the following one is scheduled once it has been processed
         struct Clock
         {
             Net* clock_net;
-            u64 switch_time;
+            u64 period;
+            u64 phase;
+            // durations of the first and second half of a period, the first half is 0 if start_at_zero is set
+            u64 first_duration;
             bool start_at_zero;
+            u64 next_edge;
+            bool scheduled;
         };
 
         std::unordered_set<Gate*> m_simulation_set;
@@ -179,36 +454,98 @@ namespace hal
 
         bool m_needs_initialization = true;
 
+        SimulationMode m_mode = SimulationMode::event_driven;
+
         u64 m_current_time = 0;
-        std::vector<Event> m_event_queue;
+        // clock edges at or after this point in time are not scheduled during the current call to simulate
+        u64 m_clock_timeout = 0;
+        EventQueue m_event_queue;
         Simulation m_simulation;
         u64 m_timeout_iterations = 10000000ul;
-        u64 m_id_counter         = 0;
+
+        // recorded events are written to the VCD stream and trimmed once enough of them have been recorded
+        std::set<Net*> m_watched_nets;
+        u64 m_history_window  = 0;
+        u64 m_recorded_events = 0;
+        u64 m_flush_threshold = ~0ull;
+
+        // scalar statistics of the profile, gate evaluations are counted by the simulation gates
+        bool m_profiling = false;
+        SimulationProfile m_profile;
+        u64 m_profile_time            = ~0ull;
+        u64 m_profile_timestep_events = 0;
+        u64 m_profile_timestep_deltas = 0;
+        std::unordered_map<Net*, u64> m_net_glitches;
+        std::ofstream m_vcd_stream;
+        std::vector<Net*> m_vcd_stream_nets;
+        // all events before this point in time have been written to the VCD stream
+        u64 m_vcd_stream_time = 0;
+
+        // the VCD stimulus is read just ahead of the simulated point in time, all of its changes before m_vcd_stimulus_time have been scheduled
+        struct VcdStimulusSignal
+        {
+            // the nets driven by the bits of the signal, bit 0 is the least significant one
+            std::vector<std::pair<u32, Net*>> bits;
+        };
+        std::ifstream m_vcd_stimulus;
+        std::unordered_map<std::string, VcdStimulusSignal> m_vcd_stimulus_signals;
+        u64 m_vcd_stimulus_offset = 0;
+        // femtoseconds per time unit of the file
+        u64 m_vcd_stimulus_scale = 1000;
+        u64 m_vcd_stimulus_time  = 0;
+
+        // events generated while processing the current delta cycle, only the last value per net and point in time is kept
+        struct NewEventKeyHash
+        {
+            std::size_t operator()(const std::pair<Net*, u64>& key) const
+            {
+                return std::hash<Net*>()(key.first) ^ (std::hash<u64>()(key.second) * 0x9E3779B97F4A7C15ull);
+            }
+        };
+        std::vector<Event> m_new_events;
+        std::unordered_map<std::pair<Net*, u64>, u32, NewEventKeyHash> m_new_event_indices;
+
+        // a Boolean function of a gate whose variables are addressed by input pin index
+        struct SimulationFunction
+        {
+            BooleanFunction function;
+            std::vector<std::string> variables;
+            std::vector<u32> inputs;
+            // lazily filled result per combination of 0/1/X inputs, empty if the function has too many inputs
+            std::vector<u8> truth_table;
+            // the configuration of a LUT restricted to the inputs it depends on, bit i holds the result for the inputs encoded as binary number i, empty for other functions
+            std::vector<u64> lut;
+        };
 
         struct SimulationGate
         {
             Gate* gate;
             std::vector<std::string> input_pins;
             std::vector<Net*> input_nets;
-            std::unordered_map<std::string, BooleanFunction::Value> input_values;
+            std::vector<BooleanFunction::Value> input_values;
             bool is_flip_flop;
+            // index of the combinational loop that contains the gate, ~0 if there is none
+            u32 loop_index;
+            // number of evaluations while profiling
+            u64 evaluations = 0;
 
             virtual ~SimulationGate() = default;
         };
 
         struct SimulationGateCombinational : public SimulationGate
         {
+            // only connected outputs are kept
             std::vector<std::string> output_pins;
             std::vector<Net*> output_nets;
-            std::unordered_map<Net*, BooleanFunction> functions;
+            std::vector<SimulationFunction> functions;
         };
 
         struct SimulationGateFF : public SimulationGate
         {
-            BooleanFunction clock_func;
-            BooleanFunction clear_func;
-            BooleanFunction preset_func;
-            BooleanFunction next_state_func;
+            SimulationFunction clock_func;
+            SimulationFunction clear_func;
+            SimulationFunction preset_func;
+            SimulationFunction next_state_func;
             std::vector<Net*> state_output_nets;
             std::vector<Net*> state_inverted_output_nets;
             std::vector<Net*> clock_nets;
@@ -218,16 +555,222 @@ namespace hal
             SignalValue inv_output;
         };
 
-        std::unordered_map<Net*, std::vector<std::pair<SimulationGate*, std::vector<std::string>>>> m_successors;
         std::vector<std::unique_ptr<SimulationGate>> m_sim_gates;
 
-        bool simulate_gate(SimulationGate* gate, Event& event, std::map<std::pair<Net*, u64>, SignalValue>& new_events);
-        void simulate_ff(SimulationGateFF* gate, std::map<std::pair<Net*, u64>, SignalValue>& new_events);
+        // a combinational loop whose gates are evaluated too often at a single point in time is resolved to X until the point in time advances
+        struct SimulationLoop
+        {
+            std::vector<SimulationGateCombinational*> gates;
+            u64 max_evaluations;
+            // evaluations of the gates at the given point in time
+            u64 time;
+            u64 evaluations;
+            bool resolved;
+            bool reported;
+        };
+        std::vector<SimulationLoop> m_loops;
+
+        // dense indices of all inputs and gate outputs
+        std::unordered_map<Net*, u32> m_net_indices;
+        std::vector<Net*> m_nets;
+        // recorded events of every net, looked up once until the simulation state is replaced
+        std::vector<Waveform*> m_net_records;
+
+        // the gates reading a net, the successors of net i are found at [m_successor_offsets[i], m_successor_offsets[i + 1])
+        struct SimulationSuccessor
+        {
+            SimulationGate* gate;
+            // range of input pin indices in m_successor_pins
+            u32 pins_begin;
+            u32 pins_end;
+        };
+        std::vector<u32> m_successor_offsets;
+        std::vector<SimulationSuccessor> m_successors;
+        std::vector<u32> m_successor_pins;
+
+        // dense representation of the combinational logic used in cycle-based mode
+        struct LevelizedGate
+        {
+            SimulationGateCombinational* gate;
+            u32 level;
+            bool dirty;
+            std::vector<u32> input_nets;
+            std::vector<u32> output_nets;
+            // position of the first output in the result buffers
+            u32 first_result;
+        };
+
+        bool m_levelized = false;
+        u32 m_thread_count = 1;
+        std::vector<SignalValue> m_net_values;
+        std::vector<std::vector<u32>> m_net_comb_successors;
+        std::vector<LevelizedGate> m_levelized_gates;
+        std::vector<std::vector<u32>> m_dirty_gates_per_level;
+        // outputs of all gates of a level are evaluated first, possibly in parallel, and then applied in order
+        std::vector<SignalValue> m_levelized_results;
+
+        // the values of a net in all lanes, a lane is X if neither bit is set
+        struct LaneValues
+        {
+            u64 one;
+            u64 zero;
+        };
+
+        // a Boolean function compiled to a ternary decision diagram that is evaluated for all lanes at once
+        struct LaneFunction
+        {
+            // the first three nodes are the constants 0, 1, and X, every further node selects one of three earlier nodes by the value of an input
+            struct Node
+            {
+                u32 input;
+                u32 if_zero;
+                u32 if_one;
+                u32 if_x;
+            };
+            std::vector<u32> input_nets;
+            std::vector<Node> nodes;
+            u32 result;
+            // functions with too many inputs are evaluated lane by lane
+            const SimulationFunction* function;
+            std::vector<std::string> variables;
+        };
+
+        struct LaneGate
+        {
+            u64 dirty_lanes;
+            std::vector<LaneFunction> functions;
+        };
+
+        struct LaneFF
+        {
+            SimulationGateFF* gate;
+            LaneFunction clock_func;
+            LaneFunction clear_func;
+            LaneFunction preset_func;
+            LaneFunction next_state_func;
+            std::vector<u32> state_output_nets;
+            std::vector<u32> state_inverted_output_nets;
+        };
+
+        struct LaneEvent
+        {
+            u32 net_index;
+            LaneValues values;
+            u64 lanes;
+        };
+
+        struct LaneInput
+        {
+            Net* net;
+            u32 lane;
+            SignalValue value;
+            u64 time;
+        };
+
+        struct LaneFlip
+        {
+            u32 net_index;
+            u64 lanes;
+            u64 time;
+        };
+
+        // the shared settings and the fault-free results of a fault simulation
+        struct FaultCampaign
+        {
+            const std::vector<Net*>* input_nets;
+            const std::vector<SignalValue>* stimuli;
+            std::vector<u32> output_nets;
+            std::vector<u32> state_nets;
+            u64 picoseconds;
+            u64 cycles;
+            // output values at the end of every cycle and flip-flop states at the end of the last cycle
+            std::vector<LaneValues> golden_outputs;
+            std::vector<LaneValues> golden_states;
+        };
+
+        bool m_bit_parallel = false;
+        // lane 0 is recorded in m_simulation
+        std::vector<Simulation> m_lane_simulations;
+        std::vector<LaneInput> m_lane_inputs;
+        std::vector<LaneValues> m_lane_net_values;
+        // last recorded value of every net and the lanes that have a recorded value at all
+        std::vector<LaneValues> m_lane_recorded_values;
+        std::vector<u64> m_lane_recorded_lanes;
+        bool m_lane_records_outdated = true;
+        // recorded events of every net in every lane, indexed by net index * LANE_COUNT + lane
+        std::vector<Waveform*> m_lane_net_records;
+        std::vector<LaneGate> m_lane_gates;
+        std::vector<LaneFF> m_lane_ffs;
+        // flip-flop successors of every net and whether the net is one of their clock nets
+        std::vector<std::vector<std::pair<u32, bool>>> m_net_lane_ff_successors;
+        std::vector<LaneEvent> m_lane_new_events;
+        std::unordered_map<u32, u32> m_lane_new_event_indices;
+        std::vector<LaneValues> m_lane_function_nodes;
+        std::vector<LaneValues> m_lane_results;
+        // injected faults: lanes and values of stuck-at faults per net, empty if there are none, and pending bit flips
+        std::vector<u64> m_lane_stuck_lanes;
+        std::vector<LaneValues> m_lane_stuck_values;
+        std::vector<LaneFlip> m_lane_flips;
+
+        static SimulationFunction compile_function(const BooleanFunction& function, const std::vector<std::string>& input_pins);
+        static bool compile_lut_function(const Gate* gate, const std::vector<std::string>& input_pins, SimulationFunction& function);
+        static BooleanFunction::Value evaluate_function(SimulationFunction& function, const std::vector<BooleanFunction::Value>& input_values);
+        static BooleanFunction::Value evaluate_lut(const std::vector<u64>& lut, u64 index, u64 unknown_inputs);
+        Waveform& get_net_records(u32 net_index);
+
+        bool simulate_gate(SimulationGate* gate, Event& event);
+        void simulate_ff(SimulationGateFF* gate);
+        bool simulate_ff_clear_preset(SimulationGateFF* gate, SignalValue& result, SignalValue& inv_result);
+        void schedule_event(Net* net, SignalValue value, u64 time);
         void compute_input_nets();
         void compute_output_nets();
         void initialize();
-        void prepare_clock_events(u64 nanoseconds);
+        void initialize_loops();
+        bool check_loop_evaluation(u32 loop_index);
+        void load_net_values();
+        Simulation get_checkpoint_state(const Simulation& simulation) const;
+        void prepare_clock_events(u64 picoseconds);
+        void schedule_clock_events();
+        SignalValue get_clock_value(const Clock& clock, u64 time) const;
+        u64 get_next_clock_edge(const Clock& clock, u64 time) const;
         void process_events(u64 timeout);
+        bool record_event(Waveform& waveform, const Event& event);
+        u64 get_profile_clock() const;
+        void profile_delta_cycle(u64 events);
+        void profile_time(u64 start, u64 evaluation);
+        void update_flush_threshold(u64 retained_events);
+        void flush_records(u64 end_time);
+        u64 trim_records(Simulation& simulation, u64 end_time) const;
+        void write_vcd_stream(u64 end_time);
+        void schedule_vcd_stimulus(u64 timeout);
+        void read_vcd_stimulus(u64 timeout);
+
+        bool initialize_levelized();
+        void process_levelized_event(u32 net_index, const Event& event, std::vector<SimulationGateFF*>& ffs);
+        void evaluate_levelized_gate(u32 gate_index);
+        void evaluate_levelized_gates(std::vector<SimulationGateFF*>& ffs);
+
+        bool initialize_bit_parallel();
+        LaneFunction compile_lane_function(const SimulationFunction& function,
+                                           const std::vector<Net*>& input_nets,
+                                           std::unordered_map<std::string, std::pair<std::vector<LaneFunction::Node>, u32>>& cache);
+        LaneValues evaluate_lane_function(const LaneFunction& function, std::vector<LaneValues>& nodes) const;
+        Simulation& get_lane_simulation(u32 lane);
+        const Simulation& get_lane_simulation(u32 lane) const;
+        Waveform& get_lane_records(u32 net_index, u32 lane);
+        void load_lane_records();
+        u64 get_next_lane_event_time() const;
+        void process_lane_events(u64 timeout);
+        void process_lane_event(u32 net_index, LaneValues values, u64 lanes, u64 time, std::vector<std::pair<u32, u64>>& ffs);
+        void evaluate_lane_gate(u32 gate_index, std::vector<LaneValues>& nodes);
+        void evaluate_lane_gates(std::vector<std::pair<u32, u64>>& ffs);
+        void simulate_lane_ff(u32 ff_index, u64 lanes);
+        u64 simulate_lane_ff_clear_preset(const LaneFF& ff, u64 lanes, LaneValues& result, LaneValues& inv_result);
+        void schedule_lane_event(u32 net_index, const LaneValues& values, u64 lanes);
+        void inject_lane_faults(const Fault* faults, u32 count);
+        void simulate_fault_batch(FaultCampaign& campaign, const Fault* faults, u32 count, FaultResult* results);
+
+        bool write_vcd(const Simulation& simulation, const std::filesystem::path& path, u32 start_time, u32 end_time, const std::set<Net*>& nets) const;
 
         SignalValue process_clear_preset_behavior(GateType::ClearPresetBehavior behavior, SignalValue previous_output);
     };
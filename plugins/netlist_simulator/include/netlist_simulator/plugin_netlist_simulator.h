@@ -48,8 +48,9 @@ namespace hal
         /**
          * Create a netlist simulator instance.
          * 
+         * @param[in] mode - The simulation mode, defaults to event-driven simulation.
          * @returns The simulator instance.
          */
-        std::unique_ptr<NetlistSimulator> create_simulator() const;
+        std::unique_ptr<NetlistSimulator> create_simulator(SimulationMode mode = SimulationMode::event_driven) const;
     };
 }    // namespace hal
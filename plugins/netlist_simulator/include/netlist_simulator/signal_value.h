@@ -30,7 +30,7 @@ namespace hal
     /**
      * Represents the logic value that a signal can take.
      */
-    enum SignalValue
+    enum SignalValue : u8
     {
         ZERO = BooleanFunction::ZERO, /**< Represents a logical 0. */
         ONE  = BooleanFunction::ONE,  /**< Represents a logical 1. */
@@ -26,12 +26,46 @@
 #include "netlist_simulator/event.h"
 
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace hal
 {
     class Net;
 
+    /**
+     * The value changes of a single net, stored as arrays of points in time and values that are sorted by time.
+     */
+    struct Waveform
+    {
+        /**
+         * The points in time of the value changes in picoseconds.
+         */
+        std::vector<u64> times;
+
+        /**
+         * The signal values set by the value changes.
+         */
+        std::vector<SignalValue> values;
+
+        /**
+         * Get the signal value at a specific point in time specified in picoseconds.
+         *
+         * @param[in] time - The time in picoseconds.
+         * @returns The signal value.
+         */
+        SignalValue get_value(u64 time) const;
+
+        /**
+         * Get the index range of all value changes within a timeframe.
+         *
+         * @param[in] start_time - Start of the timeframe in picoseconds, inclusive.
+         * @param[in] end_time - End of the timeframe in picoseconds, exclusive.
+         * @returns The first index and the index one past the last value change within the timeframe.
+         */
+        std::pair<u32, u32> get_range(u64 start_time, u64 end_time) const;
+    };
+
     class Simulation
     {
     public:
@@ -39,11 +73,37 @@ namespace hal
          * Get the signal value of a specific net at a specific point in time specified in picoseconds.
          *
          * @param[in] net - The net to inspect.
-         * @param[in] time - The time in   .
+         * @param[in] time - The time in picoseconds.
          * @returns The net's signal value.
          */
         SignalValue get_net_value(Net* net, u64 time) const;
 
+        /**
+         * Get the signal values of a specific net at multiple points in time specified in picoseconds.
+         *
+         * @param[in] net - The net to inspect.
+         * @param[in] times - The times in picoseconds.
+         * @returns The net's signal values in the order of the given times.
+         */
+        std::vector<SignalValue> get_net_values(Net* net, const std::vector<u64>& times) const;
+
+        /**
+         * Get the recorded value changes of a specific net without copying them.
+         * The waveform is invalidated when the simulation is modified.
+         *
+         * @param[in] net - The net to inspect.
+         * @returns The waveform of the net, which is empty if no value changes have been recorded.
+         */
+        const Waveform& get_waveform(Net* net) const;
+
+        /**
+         * Get the recorded value changes of all nets without copying them.
+         * The waveforms are invalidated when the simulation is modified.
+         *
+         * @returns A map from net to its waveform.
+         */
+        const std::unordered_map<Net*, Waveform>& get_waveforms() const;
+
         /**
          * Adds a custom event to the simulation.
          *
@@ -51,8 +111,19 @@ namespace hal
          */
         void add_event(const Event& event);
 
+        /**
+         * Get all events of a specific net within a timeframe.
+         *
+         * @param[in] net - The net to inspect.
+         * @param[in] start_time - Start of the timeframe in picoseconds, inclusive.
+         * @param[in] end_time - End of the timeframe in picoseconds, exclusive.
+         * @returns The events of the net sorted by time.
+         */
+        std::vector<Event> get_net_events(Net* net, u64 start_time, u64 end_time) const;
+
         /**
          * Get all events of the simulation.
+         * The events are assembled from the waveforms, prefer \p get_waveforms to inspect large simulations.
          *
          * @returns A map from net to associated events for that net sorted by time.
          */
@@ -60,7 +131,7 @@ namespace hal
 
     private:
         friend class NetlistSimulator;
-        std::unordered_map<Net*, std::vector<Event>> m_events;
+        std::unordered_map<Net*, Waveform> m_waveforms;
     };
 
 }    // namespace hal
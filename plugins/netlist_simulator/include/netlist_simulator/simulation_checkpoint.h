@@ -0,0 +1,81 @@
+//  MIT License
+//
+//  Copyright (c) 2019 Ruhr University Bochum, Chair for Embedded Security. All Rights reserved.
+//  Copyright (c) 2021 Max Planck Institute for Security and Privacy. All Rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+
+#pragma once
+
+#include "netlist_simulator/event.h"
+#include "netlist_simulator/simulation.h"
+
+#include <utility>
+#include <vector>
+
+namespace hal
+{
+    class Net;
+
+    /**
+     * A snapshot of the state of a netlist simulator at a point in time, from which the simulation can be resumed.
+     * In contrast to a full simulation state, only the current value of every net is stored but not the recorded history of value changes.
+     * Since the state of flip-flops is held by their output nets, it is covered by the net values.
+     */
+    class SimulationCheckpoint
+    {
+    public:
+        /**
+         * Get the point in time at which the checkpoint was created.
+         *
+         * @returns The time in picoseconds.
+         */
+        u64 get_time() const;
+
+        /**
+         * Get the signal value of a specific net at the point in time of the checkpoint.
+         * In bit-parallel mode, this is the value in lane 0.
+         *
+         * @param[in] net - The net to inspect.
+         * @returns The net's signal value.
+         */
+        SignalValue get_net_value(Net* net) const;
+
+        /**
+         * Get the number of events that were pending at the point in time of the checkpoint.
+         *
+         * @returns The number of pending events.
+         */
+        u64 get_pending_event_count() const;
+
+    private:
+        friend class NetlistSimulator;
+
+        u64 m_time         = 0;
+        bool m_initialized = false;
+        // of every net, only the value changes at the point in time of the checkpoint and the last one before are kept
+        Simulation m_state;
+        // states of the lanes 1 to 63 in bit-parallel mode, empty otherwise
+        std::vector<Simulation> m_lane_states;
+        std::vector<Event> m_events;
+        std::vector<std::pair<u32, Event>> m_lane_inputs;
+        // next edge of every clock and whether it is already contained in the pending events
+        std::vector<std::pair<u64, bool>> m_clock_edges;
+    };
+}    // namespace hal
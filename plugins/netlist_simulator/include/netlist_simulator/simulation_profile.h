@@ -0,0 +1,111 @@
+//  MIT License
+//
+//  Copyright (c) 2019 Ruhr University Bochum, Chair for Embedded Security. All Rights reserved.
+//  Copyright (c) 2021 Max Planck Institute for Security and Privacy. All Rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+
+#pragma once
+
+#include "hal_core/defines.h"
+
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace hal
+{
+    class Gate;
+    class Net;
+
+    /**
+     * Statistics on the work done by a netlist simulator, collected while profiling is enabled.
+     * A point in time at which events are processed is a timestep, every round of processing events at the same timestep is a delta cycle.
+     */
+    struct SimulationProfile
+    {
+        /**
+         * The number of timesteps.
+         */
+        u64 timesteps = 0;
+
+        /**
+         * The number of processed events.
+         */
+        u64 events = 0;
+
+        /**
+         * The maximum number of events processed in a single timestep.
+         */
+        u64 max_events_per_timestep = 0;
+
+        /**
+         * The number of delta cycles.
+         */
+        u64 delta_cycles = 0;
+
+        /**
+         * The maximum number of delta cycles in a single timestep.
+         */
+        u64 max_delta_cycles_per_timestep = 0;
+
+        /**
+         * The maximum number of pending events in the event queue.
+         */
+        u64 queue_high_water_mark = 0;
+
+        /**
+         * The number of gate evaluations, in bit-parallel mode a single evaluation covers all lanes.
+         */
+        u64 gate_evaluations = 0;
+
+        /**
+         * The number of gate evaluations per gate type name.
+         */
+        std::map<std::string, u64> gate_evaluations_per_type;
+
+        /**
+         * The time spent on evaluating gates in nanoseconds.
+         */
+        u64 evaluation_time = 0;
+
+        /**
+         * The time spent on everything else, e.g., maintaining the event queue and recording results, in nanoseconds.
+         */
+        u64 scheduling_time = 0;
+
+        /**
+         * The most frequently evaluated gates and their number of evaluations, in descending order.
+         */
+        std::vector<std::pair<Gate*, u64>> hot_gates;
+
+        /**
+         * The nets that most frequently changed their value more than once within a timestep and the number of such glitches, in descending order.
+         */
+        std::vector<std::pair<Net*, u64>> glitching_nets;
+
+        /**
+         * Serialize the profile to JSON.
+         *
+         * @returns The JSON string.
+         */
+        std::string to_json() const;
+    };
+}    // namespace hal
@@ -2,6 +2,7 @@
 
 #include "netlist_simulator/netlist_simulator.h"
 #include "netlist_simulator/plugin_netlist_simulator.h"
+#include "pybind11/numpy.h"
 #include "pybind11/operators.h"
 #include "pybind11/pybind11.h"
 #include "pybind11/stl.h"
@@ -11,6 +12,32 @@ namespace py = pybind11;
 
 namespace hal
 {
+    namespace
+    {
+        /* converts a two-dimensional stimuli array with one column per input net, returns false if it is malformed or contains anything but 0, 1, and 3 */
+        bool convert_stimuli(const py::array_t<u8, py::array::c_style | py::array::forcecast>& stimuli, const std::vector<Net*>& input_nets, std::vector<SignalValue>& values)
+        {
+            if (stimuli.ndim() != 2 || static_cast<size_t>(stimuli.shape(1)) != input_nets.size())
+            {
+                log_error("netlist_simulator", "stimuli must be a two-dimensional array with one column per input net.");
+                return false;
+            }
+
+            const u8* data = stimuli.data();
+            values.reserve(stimuli.size());
+            for (size_t i = 0; i < static_cast<size_t>(stimuli.size()); ++i)
+            {
+                if (data[i] != SignalValue::ZERO && data[i] != SignalValue::ONE && data[i] != SignalValue::X)
+                {
+                    log_error("netlist_simulator", "invalid stimulus {} in row {}, column {}, expected 0, 1, or 3 (X).", static_cast<u32>(data[i]), i / input_nets.size(), i % input_nets.size());
+                    return false;
+                }
+                values.push_back(static_cast<SignalValue>(data[i]));
+            }
+            return true;
+        }
+    }    // namespace
+
 #ifdef PYBIND11_MODULE
     PYBIND11_MODULE(netlist_simulator, m)
     {
@@ -21,6 +48,12 @@ namespace hal
         py::module m("netlist_simulator", "hal NetlistSimulatorPlugin python bindings");
 #endif    // ifdef PYBIND11_MODULE
 
+        py::enum_<SimulationMode>(m, "SimulationMode", R"(The engine used by the netlist simulator.)")
+            .value("event_driven", SimulationMode::event_driven, R"(Propagate every signal change through an event queue.)")
+            .value("cycle_based", SimulationMode::cycle_based, R"(Evaluate the combinational logic in topological order over a dense value array, only clock, input, and flip-flop changes are queued.)")
+            .value("bit_parallel", SimulationMode::bit_parallel, R"(Like cycle_based, but simulate 64 independent stimulus lanes at once using word-wide logic.)")
+            .export_values();
+
         py::class_<NetlistSimulatorPlugin, RawPtrWrapper<NetlistSimulatorPlugin>, BasePluginInterface>(m, "NetlistSimulatorPlugin")
             .def_property_readonly("name", &NetlistSimulatorPlugin::get_name, R"(
                 The name of the plugin.
@@ -48,14 +81,21 @@ namespace hal
                 :rtype: str
             )")
 
-            .def("create_simulator", &NetlistSimulatorPlugin::create_simulator, R"(
+            .def("create_simulator", &NetlistSimulatorPlugin::create_simulator, py::arg("mode") = SimulationMode::event_driven, R"(
                 Create a netlist simulator instance.
 
+                :param netlist_simulator.SimulationMode mode: The simulation mode, defaults to event-driven simulation.
                 :returns: The simulator instance.
                 :rtype: netlist_simulator.NetlistSimulator
             )");
 
         py::class_<NetlistSimulator>(m, "NetlistSimulator")
+            .def_readonly_static("LANE_COUNT", &NetlistSimulator::LANE_COUNT, R"(
+                The number of independent stimulus lanes simulated in bit-parallel mode.
+
+                :type: int
+            )")
+
             .def("add_gates", &NetlistSimulator::add_gates, py::arg("gates"), R"(
                 Add gates to the simulation set.
                 Only elements in the simulation set are considered during simulation.
@@ -63,20 +103,40 @@ namespace hal
                 :param list[hal_py.Gate] gates: The gates to add.
             )")
 
-            .def("add_clock_frequency", &NetlistSimulator::add_clock_frequency, py::arg("clock_net"), py::arg("frequency"), py::arg("start_at_zero") = true, R"(
+            .def("add_clock_frequency",
+                 &NetlistSimulator::add_clock_frequency,
+                 py::arg("clock_net"),
+                 py::arg("frequency"),
+                 py::arg("start_at_zero") = true,
+                 py::arg("phase")         = 0,
+                 py::arg("duty_cycle")    = 0.5,
+                 R"(
                 Specify a net that carries the clock signal and set the clock frequency in hertz.
+                Only the next edge of every clock is scheduled at any time, so the duration of a simulation does not affect the number of pending events.
 
                 :param hal_py.Net clock_net: The net that carries the clock signal.
                 :param int frequency: The clock frequency in hertz.
                 :param bool start_at_zero: Initial clock state is 0 if true, 1 otherwise.
+                :param int phase: The delay of the clock signal in picoseconds.
+                :param float duty_cycle: The fraction of the period in which the clock signal is 1, must be between 0 and 1 (exclusive).
             )")
 
-            .def("add_clock_period", &NetlistSimulator::add_clock_period, py::arg("clock_net"), py::arg("period"), py::arg("start_at_zero") = true, R"(
+            .def("add_clock_period",
+                 &NetlistSimulator::add_clock_period,
+                 py::arg("clock_net"),
+                 py::arg("period"),
+                 py::arg("start_at_zero") = true,
+                 py::arg("phase")         = 0,
+                 py::arg("duty_cycle")    = 0.5,
+                 R"(
                 Specify a net that carries the clock signal and set the clock period in picoseconds.
+                Only the next edge of every clock is scheduled at any time, so the duration of a simulation does not affect the number of pending events.
         
                 :param hal_py.Net clock_net: The net that carries the clock signal.
                 :param int period: The clock period from rising edge to rising edge in picoseconds.
                 :param bool start_at_zero: Initial clock state is 0 if true, 1 otherwise.
+                :param int phase: The delay of the clock signal in picoseconds.
+                :param float duty_cycle: The fraction of the period in which the clock signal is 1, must be between 0 and 1 (exclusive).
             )")
 
             .def("get_gates", &NetlistSimulator::get_gates, R"(
@@ -107,6 +167,16 @@ namespace hal
                 :param netlist_simulator.SignalValue value: The value to set.
             )")
 
+            .def("set_lane_input", &NetlistSimulator::set_lane_input, py::arg("net"), py::arg("lane"), py::arg("value"), R"(
+                Set the signal for a specific wire in a single lane of the bit-parallel simulation.
+                All other lanes keep their current value.
+                Signal values other than 0 and 1 are treated as X in bit-parallel mode.
+
+                :param hal_py.Net net: The net to set a signal value for.
+                :param int lane: The lane to set the signal value in.
+                :param netlist_simulator.SignalValue value: The value to set.
+            )")
+
             .def("load_initial_values", &NetlistSimulator::load_initial_values, py::arg("value"), R"(
                 Load the specified initial value into the current state of all sequential elements.
 
@@ -125,6 +195,95 @@ namespace hal
                 :param int picoseconds: The duration to simulate.
             )")
 
+            .def(
+                "simulate_cycles",
+                [](NetlistSimulator& self, const std::vector<Net*>& input_nets, py::array_t<u8, py::array::c_style | py::array::forcecast> stimuli, const std::vector<Net*>& output_nets, u64 picoseconds)
+                    -> std::optional<py::array_t<u8>> {
+                    std::vector<SignalValue> values;
+                    if (!convert_stimuli(stimuli, input_nets, values))
+                    {
+                        return std::nullopt;
+                    }
+
+                    std::vector<SignalValue> samples;
+                    {
+                        // the simulation does not touch any Python objects
+                        py::gil_scoped_release release;
+                        samples = self.simulate_cycles(input_nets, values, output_nets, picoseconds);
+                    }
+
+                    size_t cycles = stimuli.shape(0);
+                    if (samples.size() != cycles * output_nets.size())
+                    {
+                        return std::nullopt;
+                    }
+
+                    py::array_t<u8> result({cycles, output_nets.size()});
+                    std::copy(samples.begin(), samples.end(), result.mutable_data());
+                    return result;
+                },
+                py::arg("input_nets"),
+                py::arg("stimuli"),
+                py::arg("output_nets"),
+                py::arg("picoseconds"),
+                R"(
+                Simulate a sequence of cycles, each of which applies one row of input values and then simulates for a fixed period.
+                The values of the output nets are sampled at the end of every cycle.
+                All cycles are simulated without returning to Python and without holding the GIL.
+                Clocks are not affected by the stimuli, hence the period usually equals the clock period.
+                In bit-parallel mode, the input values are applied to all lanes and the outputs of lane 0 are sampled.
+                For long sequences, consider restricting the recorded history via set_watched_nets and set_history_window.
+                Signal values are encoded like netlist_simulator.SignalValue, i.e., 0 for ZERO, 1 for ONE, and 3 for X.
+                Stimuli containing any other value are rejected.
+
+                :param list[hal_py.Net] input_nets: The input nets to control.
+                :param numpy.ndarray[numpy.uint8] stimuli: The signal values (0, 1, or 3) of all cycles as a two-dimensional array or buffer with one row per cycle and one column per input net.
+                :param list[hal_py.Net] output_nets: The nets to sample.
+                :param int picoseconds: The duration of a single cycle.
+                :returns: The sampled signal values (0, 1, or 3) as a two-dimensional array with one row per cycle and one column per output net on success, None otherwise.
+                :rtype: numpy.ndarray[numpy.uint8] or None
+            )")
+
+            .def(
+                "simulate_faults",
+                [](NetlistSimulator& self,
+                   const std::vector<Fault>& faults,
+                   const std::vector<Net*>& input_nets,
+                   py::array_t<u8, py::array::c_style | py::array::forcecast> stimuli,
+                   const std::vector<Net*>& output_nets,
+                   u64 picoseconds) -> std::vector<FaultResult> {
+                    std::vector<SignalValue> values;
+                    if (!convert_stimuli(stimuli, input_nets, values))
+                    {
+                        return {};
+                    }
+
+                    // the simulation does not touch any Python objects
+                    py::gil_scoped_release release;
+                    return self.simulate_faults(faults, input_nets, values, output_nets, picoseconds);
+                },
+                py::arg("faults"),
+                py::arg("input_nets"),
+                py::arg("stimuli"),
+                py::arg("output_nets"),
+                py::arg("picoseconds"),
+                R"(
+                Simulate a sequence of cycles like simulate_cycles once for every fault and compare the sampled output nets to a fault-free simulation.
+                Requires bit-parallel mode: every lane simulates a different fault, so batches of 64 faults are simulated at once.
+                The batches are distributed over the threads set via set_thread_count, each of which simulates on its own copy of the simulator.
+                All batches start from the current simulation state, which is not modified.
+                Stimuli are encoded like for simulate_cycles, i.e., 0 for ZERO, 1 for ONE, and 3 for X, any other value is rejected.
+                The sampled output values use the same encoding, so a fault that turns a 0 or 1 into an X also counts as a corrupted sample.
+
+                :param list[netlist_simulator.Fault] faults: The faults to simulate.
+                :param list[hal_py.Net] input_nets: The input nets to control.
+                :param numpy.ndarray[numpy.uint8] stimuli: The signal values (0, 1, or 3) of all cycles as a two-dimensional array or buffer with one row per cycle and one column per input net.
+                :param list[hal_py.Net] output_nets: The nets to sample.
+                :param int picoseconds: The duration of a single cycle.
+                :returns: The result of every fault in the order of the faults, or an empty list on error.
+                :rtype: list[netlist_simulator.FaultResult]
+            )")
+
             .def("reset", &NetlistSimulator::reset, R"(
                 Reset the simulator state, i.e., treat all signals as unknown.
                 Does not remove gates/nets from the simulation set.
@@ -133,20 +292,65 @@ namespace hal
             .def("set_simulation_state", &NetlistSimulator::set_simulation_state, py::arg("state"), R"(
                 Set the simulator state, i.e., net signals, to a given state.
                 Does not influence gates/nets added to the simulation set.
+                In bit-parallel mode, the state is applied to all lanes.
         
                 :param netlist_simulator.Simulation state: The state to apply.
             )")
 
             .def("get_simulation_state", &NetlistSimulator::get_simulation_state, R"(
                 Get the current simulation state.
+                In bit-parallel mode, this is the state of lane 0.
         
                 :returns: The current simulation state.
                 :rtype: libnetlist_simulator.Simulation
             )")
 
+            .def("get_lane_simulation_state", &NetlistSimulator::get_lane_simulation_state, py::arg("lane"), R"(
+                Get the current simulation state of a single lane of the bit-parallel simulation.
+
+                :param int lane: The lane.
+                :returns: The current simulation state of the lane.
+                :rtype: netlist_simulator.Simulation
+            )")
+
+            .def("create_checkpoint", &NetlistSimulator::create_checkpoint, R"(
+                Create a checkpoint of the current simulation state from which the simulation can be resumed later on.
+                The checkpoint holds the current value of every net, the pending events, and the next edge of every clock, but not the recorded history.
+                Hence, it is considerably cheaper to create and restore than the full simulation state.
+
+                :returns: The checkpoint.
+                :rtype: netlist_simulator.SimulationCheckpoint
+            )")
+
+            .def("restore_checkpoint", &NetlistSimulator::restore_checkpoint, py::arg("checkpoint"), R"(
+                Resume the simulation from a checkpoint that was created by this simulator or by a simulator with the same gates, clocks, and simulation mode.
+                The recorded history is replaced by the value changes stored in the checkpoint and an open VCD stream is closed.
+
+                :param netlist_simulator.SimulationCheckpoint checkpoint: The checkpoint to restore.
+            )")
+
+            .def("fork", &NetlistSimulator::fork, py::arg("checkpoint"), R"(
+                Create an independent simulator with the same gates, clocks, and settings that resumes the simulation from a checkpoint.
+                Useful to branch a simulation into multiple variants that share a common prefix.
+                An open VCD stream is not transferred to the new simulator.
+
+                :param netlist_simulator.SimulationCheckpoint checkpoint: The checkpoint to resume from.
+                :returns: The new simulator.
+                :rtype: netlist_simulator.NetlistSimulator
+            )")
+
+            .def("get_combinational_loops", &NetlistSimulator::get_combinational_loops, R"(
+                Get all combinational loops among the gates of the simulation set, i.e., the strongly connected components of the graph of combinational gates.
+                Loops are reported when the simulation is initialized.
+                In event-driven mode, a loop that does not settle within a bounded number of gate evaluations at a single point in time is resolved by setting all of its nets to X until the point in time advances.
+
+                :returns: The gates of every combinational loop sorted by ID.
+                :rtype: list[list[hal_py.Gate]]
+            )")
+
             .def("set_iteration_timeout", &NetlistSimulator::set_iteration_timeout, py::arg("iterations"), R"(
                 Set the iteration timeout, i.e., the maximum number of events processed for a single point in time.
-                Useful to abort in case of infinite loops.
+                Useful to abort in case of infinite loops that are not caught by the resolution of combinational loops.
                 A value of 0 disables the timeout.
         
                 :param int iterations: The iteration timeout.
@@ -159,9 +363,148 @@ namespace hal
                 :rtype: int
             )")
 
+            .def("set_simulation_mode", &NetlistSimulator::set_simulation_mode, py::arg("mode"), R"(
+                Set the simulation mode.
+                In cycle-based mode, the combinational logic is levelized once and evaluated in topological order, which is considerably faster for synchronous designs.
+                It produces the same results as the event-driven mode, except for zero-delay glitches within a single point in time that only the event-driven mode propagates.
+                Netlists with combinational loops or nets with multiple drivers are always simulated event-driven.
+                In bit-parallel mode, 64 independent stimulus lanes are simulated at once with the semantics of the cycle-based mode; such netlists are not supported in this mode.
+
+                :param netlist_simulator.SimulationMode mode: The simulation mode.
+            )")
+
+            .def("get_simulation_mode", &NetlistSimulator::get_simulation_mode, R"(
+                Get the simulation mode.
+
+                :returns: The simulation mode.
+                :rtype: netlist_simulator.SimulationMode
+            )")
+
+            .def("set_thread_count", &NetlistSimulator::set_thread_count, py::arg("threads"), R"(
+                Set the number of threads used to evaluate the combinational logic.
+                In cycle-based and bit-parallel mode, every level of the levelized combinational logic is split between the threads.
+                The results are applied in a fixed order afterwards, hence they are identical to a single-threaded simulation.
+                The event-driven mode always runs single-threaded.
+                A value of 0 uses all available hardware threads.
+
+                :param int threads: The number of threads.
+            )")
+
+            .def("get_thread_count", &NetlistSimulator::get_thread_count, R"(
+                Get the number of threads used to evaluate the combinational logic.
+
+                :returns: The number of threads.
+                :rtype: int
+            )")
+
+            .def("set_profiling_enabled", &NetlistSimulator::set_profiling_enabled, py::arg("enabled"), R"(
+                Enable or disable profiling, i.e., collecting statistics on the work done by the simulation.
+                Profiling only adds a counter increment per evaluated gate and a few clock readings per delta cycle.
+                The statistics are kept until reset_profile is called or the simulation is initialized again, e.g., after adding gates or calling reset.
+
+                :param bool enabled: True to enable profiling, false to disable it.
+            )")
+
+            .def("is_profiling_enabled", &NetlistSimulator::is_profiling_enabled, R"(
+                Check whether profiling is enabled.
+
+                :returns: True if profiling is enabled, false otherwise.
+                :rtype: bool
+            )")
+
+            .def("get_profile", &NetlistSimulator::get_profile, py::arg("top_count") = 10, R"(
+                Get the statistics collected while profiling was enabled.
+
+                :param int top_count: The maximum number of hot gates and glitching nets to report.
+                :returns: The profile.
+                :rtype: netlist_simulator.SimulationProfile
+            )")
+
+            .def("reset_profile", &NetlistSimulator::reset_profile, R"(
+                Discard all statistics collected so far.
+            )")
+
+            .def("set_watched_nets", &NetlistSimulator::set_watched_nets, py::arg("nets"), R"(
+                Set the nets whose value changes are recorded.
+                Older value changes of all other nets are dropped while simulating, such that only their current value is kept, and they are not written to a VCD stream.
+                An empty set records all nets.
+
+                :param set[hal_py.Net] nets: The nets to record.
+            )")
+
+            .def("get_watched_nets", &NetlistSimulator::get_watched_nets, R"(
+                Get the nets whose value changes are recorded.
+
+                :returns: The recorded nets, an empty set if all nets are recorded.
+                :rtype: set[hal_py.Net]
+            )")
+
+            .def("set_history_window", &NetlistSimulator::set_history_window, py::arg("picoseconds"), R"(
+                Set the time window of value changes that is kept in memory.
+                Older value changes are dropped while simulating, only the last change before the window is kept to retain the value at its start.
+                A value of 0 keeps the whole history.
+
+                :param int picoseconds: The length of the window in picoseconds.
+            )")
+
+            .def("get_history_window", &NetlistSimulator::get_history_window, R"(
+                Get the time window of value changes that is kept in memory.
+
+                :returns: The length of the window in picoseconds, 0 if the whole history is kept.
+                :rtype: int
+            )")
+
+            .def("start_vcd_stream", &NetlistSimulator::start_vcd_stream, py::arg("path"), R"(
+                Stream all value changes of the watched nets to a VCD file while simulating.
+                Changes are written once their point in time has been fully simulated, independently of the history window.
+                In bit-parallel mode, the changes of lane 0 are written.
+                The stream is closed by stop_vcd_stream or when the simulator is reset.
+
+                :param hal_py.hal_path path: The path to the VCD file.
+                :returns: True if the file could be opened, false otherwise.
+                :rtype: bool
+            )")
+
+            .def("stop_vcd_stream", &NetlistSimulator::stop_vcd_stream, R"(
+                Write all remaining value changes to the VCD stream and close it.
+            )")
+
+            .def("load_vcd_stimulus", &NetlistSimulator::load_vcd_stimulus, py::arg("path"), py::arg("nets") = std::unordered_map<std::string, Net*>(), R"(
+                Read input changes from a VCD file while simulating, e.g., a testbench dumped by an RTL simulation.
+                The file is read in chunks just ahead of the simulated point in time, so large files are never loaded into memory as a whole.
+                Signals are mapped to nets via nets or, if no mapping is given, to input nets of the same name.
+                The bits of a vector are mapped by their name followed by the index in brackets or parentheses, e.g., 'data[3]' or 'data(3)'.
+                Signals without a matching net are ignored.
+                Time 0 of the file corresponds to the current point in time of the simulation.
+                In bit-parallel mode, the input changes are applied to all lanes.
+                The file is closed by stop_vcd_stimulus, when the simulator is reset, or when a checkpoint is restored.
+
+                :param hal_py.hal_path path: The path to the VCD file.
+                :param dict[str,hal_py.Net] nets: A mapping from signal names to nets, empty to map signals to input nets of the same name.
+                :returns: True if the file could be opened and its header could be parsed, false otherwise.
+                :rtype: bool
+            )")
+
+            .def("stop_vcd_stimulus", &NetlistSimulator::stop_vcd_stimulus, R"(
+                Stop reading input changes from a VCD file.
+                Input changes that have already been read are still applied.
+            )")
+
             .def("generate_vcd", &NetlistSimulator::generate_vcd, py::arg("path"), py::arg("start_time"), py::arg("end_time"), py::arg("nets") = std::set<u32>(), R"(
                 Generates the a VCD file for parts the simulated netlist.
 
+                :param hal_py.hal_path path: The path to the VCD file.
+                :param int start_time: Start of the timeframe to write to the file (in picoseconds).
+                :param int end_time: End of the timeframe to write to the file (in picoseconds).
+                :param set[hal_py.Net] nets: Nets to include in the VCD file.
+                :returns: True if the file gerneration was successful, false otherwise.
+                :rtype: bool
+            )")
+
+            .def("generate_lane_vcd", &NetlistSimulator::generate_lane_vcd, py::arg("lane"), py::arg("path"), py::arg("start_time"), py::arg("end_time"), py::arg("nets") = std::set<u32>(), R"(
+                Generates the a VCD file for parts the simulated netlist using the results of a single lane of the bit-parallel simulation.
+
+                :param int lane: The lane.
                 :param hal_py.hal_path path: The path to the VCD file.
                 :param int start_time: Start of the timeframe to write to the file (in picoseconds).
                 :param int end_time: End of the timeframe to write to the file (in picoseconds).
@@ -170,6 +513,54 @@ namespace hal
                 :rtype: bool
             )");
 
+        py::class_<Waveform>(m, "Waveform", R"(The value changes of a single net, stored as arrays of points in time and values that are sorted by time.)")
+            .def_property_readonly(
+                "times",
+                [](py::object self) {
+                    const auto& waveform = self.cast<const Waveform&>();
+                    py::array_t<u64> times(waveform.times.size(), waveform.times.data(), self);
+                    times.attr("flags").attr("writeable") = false;
+                    return times;
+                },
+                R"(
+                The points in time of the value changes in picoseconds as a read-only numpy array that refers to the recorded data without copying it.
+                The array is invalidated when the simulation is modified.
+
+                :type: numpy.ndarray[numpy.uint64]
+            )")
+
+            .def_property_readonly(
+                "values",
+                [](py::object self) {
+                    const auto& waveform = self.cast<const Waveform&>();
+                    py::array_t<u8> values(waveform.values.size(), reinterpret_cast<const u8*>(waveform.values.data()), self);
+                    values.attr("flags").attr("writeable") = false;
+                    return values;
+                },
+                R"(
+                The signal values set by the value changes as a read-only numpy array that refers to the recorded data without copying it.
+                The array is invalidated when the simulation is modified.
+
+                :type: numpy.ndarray[numpy.uint8]
+            )")
+
+            .def("get_value", &Waveform::get_value, py::arg("time"), R"(
+                Get the signal value at a specific point in time specified in picoseconds.
+
+                :param int time: The time in picoseconds.
+                :returns: The signal value.
+                :rtype: netlist_simulator.SignalValue
+            )")
+
+            .def("get_range", &Waveform::get_range, py::arg("start_time"), py::arg("end_time"), R"(
+                Get the index range of all value changes within a timeframe.
+
+                :param int start_time: Start of the timeframe in picoseconds, inclusive.
+                :param int end_time: End of the timeframe in picoseconds, exclusive.
+                :returns: The first index and the index one past the last value change within the timeframe.
+                :rtype: tuple(int,int)
+            )");
+
         py::class_<Simulation>(m, "Simulation")
             .def(py::init<>())
 
@@ -182,6 +573,34 @@ namespace hal
                 :rtype: netlist_simulator.SignalValue
             )")
 
+            .def("get_net_values", &Simulation::get_net_values, py::arg("net"), py::arg("times"), R"(
+                Get the signal values of a specific net at multiple points in time specified in picoseconds.
+
+                :param hal_py.Net net: The net to inspect.
+                :param list[int] times: The times in picoseconds.
+                :returns: The net's signal values in the order of the given times.
+                :rtype: list[netlist_simulator.SignalValue]
+            )")
+
+            .def("get_waveform", &Simulation::get_waveform, py::arg("net"), py::return_value_policy::reference_internal, R"(
+                Get the recorded value changes of a specific net without copying them.
+                The waveform is invalidated when the simulation is modified.
+
+                :param hal_py.Net net: The net to inspect.
+                :returns: The waveform of the net, which is empty if no value changes have been recorded.
+                :rtype: netlist_simulator.Waveform
+            )")
+
+            .def("get_net_events", &Simulation::get_net_events, py::arg("net"), py::arg("start_time"), py::arg("end_time"), R"(
+                Get all events of a specific net within a timeframe.
+
+                :param hal_py.Net net: The net to inspect.
+                :param int start_time: Start of the timeframe in picoseconds, inclusive.
+                :param int end_time: End of the timeframe in picoseconds, exclusive.
+                :returns: The events of the net sorted by time.
+                :rtype: list[netlist_simulator.Event]
+            )")
+
             .def("add_event", &Simulation::add_event, py::arg("event"), R"(
                 Adds a custom event to the simulation.
          
@@ -190,10 +609,115 @@ namespace hal
 
             .def("get_events", &Simulation::get_events, R"(
                 Get all events of the simulation.
+                The events are assembled from the waveforms, prefer get_waveform to inspect large simulations.
 
                 :returns: A map from net to associated events for that net sorted by time.
             )");
 
+        py::class_<SimulationProfile>(m, "SimulationProfile", R"(Statistics on the work done by a netlist simulator, collected while profiling is enabled.)")
+            .def_readonly("timesteps", &SimulationProfile::timesteps, R"(
+                The number of timesteps.
+
+                :type: int
+            )")
+
+            .def_readonly("events", &SimulationProfile::events, R"(
+                The number of processed events.
+
+                :type: int
+            )")
+
+            .def_readonly("max_events_per_timestep", &SimulationProfile::max_events_per_timestep, R"(
+                The maximum number of events processed in a single timestep.
+
+                :type: int
+            )")
+
+            .def_readonly("delta_cycles", &SimulationProfile::delta_cycles, R"(
+                The number of delta cycles.
+
+                :type: int
+            )")
+
+            .def_readonly("max_delta_cycles_per_timestep", &SimulationProfile::max_delta_cycles_per_timestep, R"(
+                The maximum number of delta cycles in a single timestep.
+
+                :type: int
+            )")
+
+            .def_readonly("queue_high_water_mark", &SimulationProfile::queue_high_water_mark, R"(
+                The maximum number of pending events in the event queue.
+
+                :type: int
+            )")
+
+            .def_readonly("gate_evaluations", &SimulationProfile::gate_evaluations, R"(
+                The number of gate evaluations, in bit-parallel mode a single evaluation covers all lanes.
+
+                :type: int
+            )")
+
+            .def_readonly("gate_evaluations_per_type", &SimulationProfile::gate_evaluations_per_type, R"(
+                The number of gate evaluations per gate type name.
+
+                :type: dict[str,int]
+            )")
+
+            .def_readonly("evaluation_time", &SimulationProfile::evaluation_time, R"(
+                The time spent on evaluating gates in nanoseconds.
+
+                :type: int
+            )")
+
+            .def_readonly("scheduling_time", &SimulationProfile::scheduling_time, R"(
+                The time spent on everything else, e.g., maintaining the event queue and recording results, in nanoseconds.
+
+                :type: int
+            )")
+
+            .def_readonly("hot_gates", &SimulationProfile::hot_gates, R"(
+                The most frequently evaluated gates and their number of evaluations, in descending order.
+
+                :type: list[tuple(hal_py.Gate,int)]
+            )")
+
+            .def_readonly("glitching_nets", &SimulationProfile::glitching_nets, R"(
+                The nets that most frequently changed their value more than once within a timestep and the number of such glitches, in descending order.
+
+                :type: list[tuple(hal_py.Net,int)]
+            )")
+
+            .def("to_json", &SimulationProfile::to_json, R"(
+                Serialize the profile to JSON.
+
+                :returns: The JSON string.
+                :rtype: str
+            )");
+
+        py::class_<SimulationCheckpoint>(m, "SimulationCheckpoint", R"(A snapshot of the state of a netlist simulator at a point in time, from which the simulation can be resumed.)")
+            .def("get_time", &SimulationCheckpoint::get_time, R"(
+                Get the point in time at which the checkpoint was created.
+
+                :returns: The time in picoseconds.
+                :rtype: int
+            )")
+
+            .def("get_net_value", &SimulationCheckpoint::get_net_value, py::arg("net"), R"(
+                Get the signal value of a specific net at the point in time of the checkpoint.
+                In bit-parallel mode, this is the value in lane 0.
+
+                :param hal_py.Net net: The net to inspect.
+                :returns: The net's signal value.
+                :rtype: netlist_simulator.SignalValue
+            )")
+
+            .def("get_pending_event_count", &SimulationCheckpoint::get_pending_event_count, R"(
+                Get the number of events that were pending at the point in time of the checkpoint.
+
+                :returns: The number of pending events.
+                :rtype: int
+            )");
+
         py::enum_<SignalValue>(m, "SignalValue", R"(Represents the logic value that a signal can take.)")
             .value("ZERO", SignalValue::ZERO, R"(Represents a logical 0.)")
             .value("ONE", SignalValue::ONE, R"(Represents a logical 1.)")
@@ -201,6 +725,73 @@ namespace hal
             .value("Z", SignalValue::Z, R"(Represents high impedance (currently not supported by the simulator).)")
             .export_values();
 
+        py::enum_<FaultType>(m, "FaultType", R"(The kinds of faults supported by the fault simulation.)")
+            .value("stuck_at_0", FaultType::stuck_at_0, R"(The net permanently carries a 0, regardless of its driver.)")
+            .value("stuck_at_1", FaultType::stuck_at_1, R"(The net permanently carries a 1, regardless of its driver.)")
+            .value("bit_flip", FaultType::bit_flip, R"(The value of the net is inverted once until the net is driven again, e.g., a flipped flip-flop keeps its wrong state until it is clocked.)")
+            .export_values();
+
+        py::class_<Fault>(m, "Fault")
+            .def(py::init<>(), R"(Construct a new fault.)")
+
+            .def(py::init([](FaultType type, Net* net, u64 time) { return Fault{type, net, time}; }), py::arg("type"), py::arg("net"), py::arg("time") = 0, R"(
+                Construct a new fault.
+
+                :param netlist_simulator.FaultType type: The kind of fault.
+                :param hal_py.Net net: The net affected by the fault.
+                :param int time: The time of a bit flip in picoseconds relative to the start of the fault simulation, ignored for stuck-at faults.
+            )")
+
+            .def_readwrite("type", &Fault::type, R"(
+                The kind of fault.
+
+                :type: netlist_simulator.FaultType
+            )")
+
+            .def_readwrite("net", &Fault::net, R"(
+                The net affected by the fault.
+
+                :type: hal_py.Net
+            )")
+
+            .def_readwrite("time", &Fault::time, R"(
+                The time of a bit flip in picoseconds relative to the start of the fault simulation, ignored for stuck-at faults.
+
+                :type: int
+            )");
+
+        py::class_<FaultResult>(m, "FaultResult")
+            .def_readonly("detected", &FaultResult::detected, R"(
+                True if the fault changed the value of at least one sampled output net.
+
+                :type: bool
+            )")
+
+            .def_readonly("first_detection_cycle", &FaultResult::first_detection_cycle, R"(
+                The index of the first cycle in which an output net differed from the fault-free simulation, or the number of cycles if the fault was not detected.
+
+                :type: int
+            )")
+
+            .def_readonly("corrupted_cycles", &FaultResult::corrupted_cycles, R"(
+                The number of cycles in which at least one output net differed from the fault-free simulation.
+
+                :type: int
+            )")
+
+            .def_readonly("corrupted_samples", &FaultResult::corrupted_samples, R"(
+                The number of sampled output values that differed from the fault-free simulation.
+
+                :type: int
+            )")
+
+            .def_readonly("corrupted_state_nets", &FaultResult::corrupted_state_nets, R"(
+                The number of flip-flop outputs whose value differed from the fault-free simulation at the end of the last cycle.
+                A fault that is not detected but corrupted the state is latent.
+
+                :type: int
+            )");
+
         py::class_<Event>(m, "Event")
             .def(py::init<>(), R"(Construct a new event.)")
 
@@ -0,0 +1,202 @@
+#include "netlist_simulator/event_queue.h"
+
+#include <algorithm>
+
+namespace hal
+{
+    EventQueue::EventQueue() : m_slots(WHEEL_SIZE), m_occupied_slots(WHEEL_SIZE / 64, 0)
+    {
+    }
+
+    void EventQueue::push(Event event)
+    {
+        event.id = m_id_counter++;
+
+        if (m_size++ == 0)
+        {
+            m_wheel_start = event.time;
+        }
+        else if (event.time < m_wheel_start)
+        {
+            rebase_wheel(event.time);
+        }
+
+        if (event.time - m_wheel_start < WHEEL_SIZE)
+        {
+            push_to_wheel(std::move(event));
+        }
+        else
+        {
+            m_overflow[event.time].push_back(std::move(event));
+        }
+    }
+
+    void EventQueue::pop_next_time(std::vector<Event>& events)
+    {
+        if (m_size == 0)
+        {
+            return;
+        }
+
+        if (m_wheel_event_count == 0)
+        {
+            m_wheel_start = m_overflow.begin()->first;
+            fill_wheel();
+        }
+
+        const u64 time = m_next_time;
+        const u64 slot = time & WHEEL_MASK;
+        auto& bucket   = m_slots[slot];
+        const u64 num  = bucket.size();
+
+        if (events.empty())
+        {
+            events.swap(bucket);
+        }
+        else
+        {
+            events.insert(events.end(), std::make_move_iterator(bucket.begin()), std::make_move_iterator(bucket.end()));
+        }
+        bucket.clear();
+        m_occupied_slots[slot >> 6] &= ~(1ull << (slot & 63));
+        m_wheel_event_count -= num;
+        m_size -= num;
+
+        // slide the window forward, events at the popped point in time may still be pushed for subsequent delta cycles
+        m_wheel_start = time;
+        fill_wheel();
+        m_next_time = (m_wheel_event_count == 0) ? ~0ull : find_next_wheel_time();
+    }
+
+    u64 EventQueue::get_next_time() const
+    {
+        if (m_size == 0)
+        {
+            return ~0ull;
+        }
+        if (m_wheel_event_count == 0)
+        {
+            return m_overflow.begin()->first;
+        }
+        return m_next_time;
+    }
+
+    bool EventQueue::empty() const
+    {
+        return m_size == 0;
+    }
+
+    u64 EventQueue::size() const
+    {
+        return m_size;
+    }
+
+    std::vector<Event> EventQueue::get_events() const
+    {
+        std::vector<Event> events;
+        events.reserve(m_size);
+        for (u64 w = 0; w < m_occupied_slots.size(); ++w)
+        {
+            for (u64 bits = m_occupied_slots[w]; bits != 0; bits &= bits - 1)
+            {
+                const auto& bucket = m_slots[(w << 6) | __builtin_ctzll(bits)];
+                events.insert(events.end(), bucket.begin(), bucket.end());
+            }
+        }
+        for (const auto& [time, bucket] : m_overflow)
+        {
+            events.insert(events.end(), bucket.begin(), bucket.end());
+        }
+
+        // the IDs reflect the order in which events of the same point in time were pushed
+        std::sort(events.begin(), events.end());
+        return events;
+    }
+
+    void EventQueue::clear()
+    {
+        for (u64 w = 0; w < m_occupied_slots.size(); ++w)
+        {
+            for (u64 bits = m_occupied_slots[w]; bits != 0; bits &= bits - 1)
+            {
+                m_slots[(w << 6) | __builtin_ctzll(bits)].clear();
+            }
+            m_occupied_slots[w] = 0;
+        }
+        m_overflow.clear();
+        m_wheel_start       = 0;
+        m_wheel_event_count = 0;
+        m_size              = 0;
+        m_id_counter        = 0;
+        m_next_time         = ~0ull;
+    }
+
+    void EventQueue::push_to_wheel(Event&& event)
+    {
+        const u64 slot = event.time & WHEEL_MASK;
+        if (event.time < m_next_time)
+        {
+            m_next_time = event.time;
+        }
+        m_occupied_slots[slot >> 6] |= 1ull << (slot & 63);
+        m_slots[slot].push_back(std::move(event));
+        ++m_wheel_event_count;
+    }
+
+    void EventQueue::fill_wheel()
+    {
+        // the slots of these points in time are guaranteed to be empty, hence whole buckets can be moved
+        while (!m_overflow.empty() && m_overflow.begin()->first - m_wheel_start < WHEEL_SIZE)
+        {
+            auto it        = m_overflow.begin();
+            const u64 slot = it->first & WHEEL_MASK;
+            if (it->first < m_next_time)
+            {
+                m_next_time = it->first;
+            }
+            m_occupied_slots[slot >> 6] |= 1ull << (slot & 63);
+            m_wheel_event_count += it->second.size();
+            m_slots[slot] = std::move(it->second);
+            m_overflow.erase(it);
+        }
+    }
+
+    void EventQueue::rebase_wheel(u64 new_start)
+    {
+        // only happens if an event is scheduled before the earliest pending one, so the wheel is emptied into the overflow map
+        for (u64 w = 0; w < m_occupied_slots.size(); ++w)
+        {
+            for (u64 bits = m_occupied_slots[w]; bits != 0; bits &= bits - 1)
+            {
+                auto& bucket = m_slots[(w << 6) | __builtin_ctzll(bits)];
+                m_overflow.emplace(bucket.front().time, std::move(bucket));
+                bucket.clear();
+            }
+            m_occupied_slots[w] = 0;
+        }
+        m_wheel_event_count = 0;
+        m_next_time         = ~0ull;
+        m_wheel_start       = new_start;
+        fill_wheel();
+    }
+
+    u64 EventQueue::find_next_wheel_time() const
+    {
+        // scan the occupancy bitmap circularly, starting at the slot of the window start
+        const u64 start_slot = m_wheel_start & WHEEL_MASK;
+        const u64 word_count = m_occupied_slots.size();
+        const u64 start_word = start_slot >> 6;
+
+        u64 bits = m_occupied_slots[start_word] & (~0ull << (start_slot & 63));
+        for (u64 i = 0; i <= word_count; ++i)
+        {
+            if (bits != 0)
+            {
+                const u64 slot = (((start_word + i) % word_count) << 6) | __builtin_ctzll(bits);
+                return m_wheel_start + ((slot - start_slot) & WHEEL_MASK);
+            }
+            bits = m_occupied_slots[(start_word + i + 1) % word_count];
+        }
+        return ~0ull;
+    }
+}    // namespace hal
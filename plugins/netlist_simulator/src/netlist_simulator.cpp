@@ -2,13 +2,16 @@
 
 #include "hal_core/netlist/netlist.h"
 #include "hal_core/utilities/log.h"
+#include "hal_core/utilities/utils.h"
 
 #include <algorithm>
 #include <chrono>
 #include <ctime>
 #include <fstream>
+#include <functional>
 #include <iomanip>
-#include <sstream>
+#include <omp.h>
+#include <tuple>
 
 template<typename T>
 static T toggle(T v)
@@ -20,6 +23,19 @@ static T toggle(T v)
     return v;
 }
 
+// parses an unsigned decimal number, returns the position of the first character that is not part of it or 0 on failure
+static size_t parse_unsigned(const std::string& str, size_t pos, u64& value)
+{
+    value      = 0;
+    size_t end = pos;
+    while (end < str.size() && str[end] >= '0' && str[end] <= '9')
+    {
+        value = value * 10 + (str[end] - '0');
+        ++end;
+    }
+    return (end != pos) ? end : 0;
+}
+
 namespace hal
 {
 #define measure_block_time(X)
@@ -29,6 +45,11 @@ namespace hal
         reset();
     }
 
+    NetlistSimulator::~NetlistSimulator()
+    {
+        stop_vcd_stream();
+    }
+
     void NetlistSimulator::add_gates(const std::vector<Gate*>& gates)
     {
         m_simulation_set.insert(gates.begin(), gates.end());
@@ -39,18 +60,47 @@ namespace hal
         m_needs_initialization = true;
     }
 
-    void NetlistSimulator::add_clock_frequency(Net* clock_net, u64 frequency, bool start_at_zero)
+    void NetlistSimulator::add_clock_frequency(Net* clock_net, u64 frequency, bool start_at_zero, u64 phase, double duty_cycle)
     {
+        if (frequency == 0)
+        {
+            log_error("netlist_simulator", "clock frequency must not be 0.");
+            return;
+        }
+
         u64 period = 1'000'000'000'000ul / frequency;
-        add_clock_period(clock_net, period, start_at_zero);
+        add_clock_period(clock_net, period, start_at_zero, phase, duty_cycle);
     }
 
-    void NetlistSimulator::add_clock_period(Net* clock_net, u64 period, bool start_at_zero)
+    void NetlistSimulator::add_clock_period(Net* clock_net, u64 period, bool start_at_zero, u64 phase, double duty_cycle)
     {
+        if (clock_net == nullptr)
+        {
+            log_error("netlist_simulator", "net is a nullptr.");
+            return;
+        }
+
+        if (!(duty_cycle > 0 && duty_cycle < 1))
+        {
+            log_error("netlist_simulator", "duty cycle {} of clock net '{}' is not between 0 and 1.", duty_cycle, clock_net->get_name());
+            return;
+        }
+
+        u64 high_duration = static_cast<u64>(period * duty_cycle);
+        if (high_duration == 0 || high_duration == period)
+        {
+            log_error("netlist_simulator", "clock period of {} ps of clock net '{}' is too short for a duty cycle of {}.", period, clock_net->get_name(), duty_cycle);
+            return;
+        }
+
         Clock c;
-        c.clock_net     = clock_net;
-        c.switch_time   = period / 2;
-        c.start_at_zero = start_at_zero;
+        c.clock_net      = clock_net;
+        c.period         = period;
+        c.phase          = phase % period;
+        c.first_duration = start_at_zero ? period - high_duration : high_duration;
+        c.start_at_zero  = start_at_zero;
+        c.next_edge      = m_current_time;
+        c.scheduled      = false;
         m_clocks.push_back(c);
     }
 
@@ -69,6 +119,121 @@ namespace hal
         return m_output_nets;
     }
 
+    std::vector<std::vector<Gate*>> NetlistSimulator::get_combinational_loops() const
+    {
+        static const u32 UNVISITED = ~0u;
+
+        // gates are visited in order of their IDs to report the loops deterministically
+        std::vector<Gate*> gates;
+        for (Gate* gate : m_simulation_set)
+        {
+            if (!gate->get_type()->has_property(GateTypeProperty::ff) && gate->get_type()->has_property(GateTypeProperty::combinational))
+            {
+                gates.push_back(gate);
+            }
+        }
+        std::sort(gates.begin(), gates.end(), [](Gate* a, Gate* b) { return a->get_id() < b->get_id(); });
+
+        std::unordered_map<Gate*, u32> gate_indices;
+        for (u32 i = 0; i < gates.size(); ++i)
+        {
+            gate_indices.emplace(gates[i], i);
+        }
+
+        std::vector<std::vector<u32>> successors(gates.size());
+        std::vector<bool> self_loops(gates.size(), false);
+        for (u32 i = 0; i < gates.size(); ++i)
+        {
+            for (Net* net : gates[i]->get_fan_out_nets())
+            {
+                for (Endpoint* ep : net->get_destinations())
+                {
+                    if (auto it = gate_indices.find(ep->get_gate()); it != gate_indices.end())
+                    {
+                        successors[i].push_back(it->second);
+                        self_loops[i] = self_loops[i] || (it->second == i);
+                    }
+                }
+            }
+        }
+
+        // iterative version of Tarjan's algorithm, deep combinational logic would overflow the call stack otherwise
+        std::vector<u32> indices(gates.size(), UNVISITED);
+        std::vector<u32> lowlinks(gates.size(), 0);
+        std::vector<bool> on_stack(gates.size(), false);
+        std::vector<u32> stack;
+        std::vector<std::pair<u32, u32>> call_stack;
+        u32 index_counter = 0;
+
+        auto visit = [&](u32 v) {
+            indices[v]  = index_counter;
+            lowlinks[v] = index_counter;
+            index_counter++;
+            stack.push_back(v);
+            on_stack[v] = true;
+            call_stack.emplace_back(v, 0);
+        };
+
+        std::vector<std::vector<Gate*>> loops;
+        for (u32 root = 0; root < gates.size(); ++root)
+        {
+            if (indices[root] != UNVISITED)
+            {
+                continue;
+            }
+
+            visit(root);
+            while (!call_stack.empty())
+            {
+                auto [v, next_successor] = call_stack.back();
+                if (next_successor < successors[v].size())
+                {
+                    call_stack.back().second++;
+                    u32 w = successors[v][next_successor];
+                    if (indices[w] == UNVISITED)
+                    {
+                        visit(w);
+                    }
+                    else if (on_stack[w])
+                    {
+                        lowlinks[v] = std::min(lowlinks[v], indices[w]);
+                    }
+                    continue;
+                }
+
+                call_stack.pop_back();
+                if (!call_stack.empty())
+                {
+                    u32 parent       = call_stack.back().first;
+                    lowlinks[parent] = std::min(lowlinks[parent], lowlinks[v]);
+                }
+
+                if (lowlinks[v] == indices[v])
+                {
+                    std::vector<Gate*> component;
+                    u32 w;
+                    do
+                    {
+                        w = stack.back();
+                        stack.pop_back();
+                        on_stack[w] = false;
+                        component.push_back(gates[w]);
+                    } while (w != v);
+
+                    // a single gate only forms a loop if it drives one of its own inputs
+                    if (component.size() > 1 || self_loops[v])
+                    {
+                        std::sort(component.begin(), component.end(), [](Gate* a, Gate* b) { return a->get_id() < b->get_id(); });
+                        loops.push_back(component);
+                    }
+                }
+            }
+        }
+
+        std::sort(loops.begin(), loops.end(), [](const auto& a, const auto& b) { return a.front()->get_id() < b.front()->get_id(); });
+        return loops;
+    }
+
     void NetlistSimulator::set_input(Net* net, SignalValue value)
     {
         if (net == nullptr)
@@ -77,19 +242,58 @@ namespace hal
             return;
         }
 
-        if (auto it = m_simulation.m_events.find(net); it != m_simulation.m_events.end())
+        // in bit-parallel mode, the event can only be skipped if it does not change any lane
+        u32 lanes = (m_mode == SimulationMode::bit_parallel) ? LANE_COUNT : 1;
+        u32 lane  = 0;
+        for (; lane < lanes; ++lane)
         {
-            if (value == it->second.back().new_value)
+            const auto& waveforms = get_lane_simulation(lane).m_waveforms;
+            if (auto it = waveforms.find(net); it == waveforms.end() || value != it->second.values.back())
             {
-                return;
+                break;
             }
         }
+        if (lane == lanes)
+        {
+            return;
+        }
 
         Event e;
         e.affected_net = net;
         e.time         = m_current_time;
         e.new_value    = value;
-        m_event_queue.push_back(e);
+        m_event_queue.push(e);
+    }
+
+    void NetlistSimulator::set_lane_input(Net* net, u32 lane, SignalValue value)
+    {
+        if (net == nullptr)
+        {
+            log_error("netlist_simulator", "net is a nullptr.");
+            return;
+        }
+
+        if (lane >= LANE_COUNT)
+        {
+            log_error("netlist_simulator", "lane {} does not exist, only {} lanes are simulated.", lane, LANE_COUNT);
+            return;
+        }
+
+        const auto& waveforms = get_lane_simulation(lane).m_waveforms;
+        if (auto it = waveforms.find(net); it != waveforms.end())
+        {
+            if (value == it->second.values.back())
+            {
+                return;
+            }
+        }
+
+        LaneInput input;
+        input.net   = net;
+        input.lane  = lane;
+        input.value = value;
+        input.time  = m_current_time;
+        m_lane_inputs.push_back(input);
     }
 
     void NetlistSimulator::load_initial_values(SignalValue value)
@@ -115,7 +319,7 @@ namespace hal
                         e.affected_net = ep->get_net();
                         e.new_value    = value;
                         e.time         = m_current_time;
-                        m_event_queue.push_back(e);
+                        m_event_queue.push(e);
                     }
                     else if (pin_types.at(ep->get_pin()) == PinType::neg_state)
                     {
@@ -123,7 +327,7 @@ namespace hal
                         e.affected_net = ep->get_net();
                         e.new_value    = inv_value;
                         e.time         = m_current_time;
-                        m_event_queue.push_back(e);
+                        m_event_queue.push(e);
                     }
                 }
             }
@@ -174,7 +378,7 @@ namespace hal
                             e.affected_net = ep->get_net();
                             e.new_value    = value;
                             e.time         = m_current_time;
-                            m_event_queue.push_back(e);
+                            m_event_queue.push(e);
                         }
                         else if (pin_types.at(ep->get_pin()) == PinType::neg_state)
                         {
@@ -182,7 +386,7 @@ namespace hal
                             e.affected_net = ep->get_net();
                             e.new_value    = inv_value;
                             e.time         = m_current_time;
-                            m_event_queue.push_back(e);
+                            m_event_queue.push(e);
                         }
                     }
                 }
@@ -197,449 +401,3054 @@ namespace hal
             initialize();
         }
 
+        if (m_mode == SimulationMode::bit_parallel && !m_bit_parallel)
+        {
+            log_error("netlist_simulator", "cannot simulate the netlist in bit-parallel mode.");
+            return;
+        }
+
         prepare_clock_events(picoseconds);
 
-        process_events(m_current_time + picoseconds);
+        if (m_bit_parallel)
+        {
+            process_lane_events(m_current_time + picoseconds);
+        }
+        else
+        {
+            process_events(m_current_time + picoseconds);
+        }
     }
 
-    void NetlistSimulator::reset()
+    std::vector<SignalValue> NetlistSimulator::simulate_cycles(const std::vector<Net*>& input_nets, const std::vector<SignalValue>& stimuli, const std::vector<Net*>& output_nets, u64 picoseconds)
     {
-        m_current_time = 0;
-        m_id_counter   = 0;
-        m_simulation   = Simulation();
-        m_event_queue.clear();
-        m_needs_initialization = true;
-    }
+        if (input_nets.empty())
+        {
+            log_error("netlist_simulator", "no input nets given.");
+            return {};
+        }
 
-    void NetlistSimulator::set_simulation_state(const Simulation& state)
-    {
-        m_simulation = state;
+        if (stimuli.size() % input_nets.size() != 0)
+        {
+            log_error("netlist_simulator", "number of stimuli ({}) is not a multiple of the number of input nets ({}).", stimuli.size(), input_nets.size());
+            return {};
+        }
+
+        if (std::find(input_nets.begin(), input_nets.end(), nullptr) != input_nets.end() || std::find(output_nets.begin(), output_nets.end(), nullptr) != output_nets.end())
+        {
+            log_error("netlist_simulator", "net is a nullptr.");
+            return {};
+        }
+
+        if (m_needs_initialization)
+        {
+            initialize();
+        }
+
+        if (m_mode == SimulationMode::bit_parallel && !m_bit_parallel)
+        {
+            log_error("netlist_simulator", "cannot simulate the netlist in bit-parallel mode.");
+            return {};
+        }
+
+        u64 cycles = stimuli.size() / input_nets.size();
+
+        std::vector<SignalValue> samples;
+        samples.reserve(cycles * output_nets.size());
+        for (u64 cycle = 0; cycle < cycles; ++cycle)
+        {
+            for (u32 i = 0; i < input_nets.size(); ++i)
+            {
+                set_input(input_nets[i], stimuli[cycle * input_nets.size() + i]);
+            }
+
+            simulate(picoseconds);
+
+            for (Net* net : output_nets)
+            {
+                samples.push_back(m_simulation.get_net_value(net, m_current_time));
+            }
+        }
+        return samples;
     }
 
-    Simulation NetlistSimulator::get_simulation_state() const
+    std::vector<FaultResult> NetlistSimulator::simulate_faults(const std::vector<Fault>& faults, const std::vector<Net*>& input_nets, const std::vector<SignalValue>& stimuli, const std::vector<Net*>& output_nets, u64 picoseconds)
     {
-        return m_simulation;
+        if (m_mode != SimulationMode::bit_parallel)
+        {
+            log_error("netlist_simulator", "fault simulation requires bit-parallel mode.");
+            return {};
+        }
+
+        if (input_nets.empty())
+        {
+            log_error("netlist_simulator", "no input nets given.");
+            return {};
+        }
+
+        if (stimuli.size() % input_nets.size() != 0)
+        {
+            log_error("netlist_simulator", "number of stimuli ({}) is not a multiple of the number of input nets ({}).", stimuli.size(), input_nets.size());
+            return {};
+        }
+
+        if (std::find(input_nets.begin(), input_nets.end(), nullptr) != input_nets.end() || std::find(output_nets.begin(), output_nets.end(), nullptr) != output_nets.end()
+            || std::any_of(faults.begin(), faults.end(), [](const Fault& fault) { return fault.net == nullptr; }))
+        {
+            log_error("netlist_simulator", "net is a nullptr.");
+            return {};
+        }
+
+        if (m_needs_initialization)
+        {
+            initialize();
+        }
+
+        if (!m_bit_parallel)
+        {
+            log_error("netlist_simulator", "cannot simulate the netlist in bit-parallel mode.");
+            return {};
+        }
+
+        FaultCampaign campaign;
+        campaign.input_nets  = &input_nets;
+        campaign.stimuli     = &stimuli;
+        campaign.picoseconds = picoseconds;
+        campaign.cycles      = stimuli.size() / input_nets.size();
+        for (Net* net : output_nets)
+        {
+            auto it = m_net_indices.find(net);
+            if (it == m_net_indices.end())
+            {
+                log_error("netlist_simulator", "output net '{}' (id {}) is not part of the simulation.", net->get_name(), net->get_id());
+                return {};
+            }
+            campaign.output_nets.push_back(it->second);
+        }
+        for (const auto& fault : faults)
+        {
+            if (m_net_indices.find(fault.net) == m_net_indices.end())
+            {
+                log_error("netlist_simulator", "faulty net '{}' (id {}) is not part of the simulation.", fault.net->get_name(), fault.net->get_id());
+                return {};
+            }
+        }
+        for (const auto& ff : m_lane_ffs)
+        {
+            campaign.state_nets.insert(campaign.state_nets.end(), ff.state_output_nets.begin(), ff.state_output_nets.end());
+            campaign.state_nets.insert(campaign.state_nets.end(), ff.state_inverted_output_nets.begin(), ff.state_inverted_output_nets.end());
+        }
+
+        if (faults.empty())
+        {
+            return {};
+        }
+
+        // every thread simulates on its own copy of the simulator, the copies are created up front since initialization is not thread-safe
+        SimulationCheckpoint checkpoint = create_checkpoint();
+        std::set<Net*> watched_nets(output_nets.begin(), output_nets.end());
+        i32 batches = (faults.size() + LANE_COUNT - 1) / LANE_COUNT;
+        u32 threads = std::min<u32>(m_thread_count, batches);
+        std::vector<std::unique_ptr<NetlistSimulator>> simulators;
+        for (u32 i = 0; i < threads; ++i)
+        {
+            auto sim = fork(checkpoint);
+            sim->set_thread_count(1);
+            sim->set_watched_nets(watched_nets);
+            sim->set_history_window(picoseconds);
+            simulators.push_back(std::move(sim));
+        }
+
+        simulators[0]->simulate_fault_batch(campaign, nullptr, 0, nullptr);
+
+        std::vector<FaultResult> results(faults.size());
+#pragma omp parallel for num_threads(threads) schedule(dynamic)
+        for (i32 batch = 0; batch < batches; ++batch)
+        {
+            auto& sim = simulators[omp_get_thread_num()];
+            u32 first = batch * LANE_COUNT;
+            sim->restore_checkpoint(checkpoint);
+            sim->simulate_fault_batch(campaign, faults.data() + first, std::min<u32>(faults.size() - first, LANE_COUNT), results.data() + first);
+        }
+        return results;
     }
 
-    void NetlistSimulator::compute_input_nets()
+    void NetlistSimulator::inject_lane_faults(const Fault* faults, u32 count)
     {
-        m_input_nets.clear();
-        for (auto gate : m_simulation_set)
+        for (u32 lane = 0; lane < count; ++lane)
         {
-            for (auto net : gate->get_fan_in_nets())
+            const Fault& fault = faults[lane];
+            u32 net_index      = m_net_indices.at(fault.net);
+            u64 mask           = 1ull << lane;
+
+            if (fault.type == FaultType::bit_flip)
             {
-                // "input net" is either a global input...
-                if (net->is_global_input_net())
-                {
-                    m_input_nets.push_back(net);
-                }
-                else    // ... or has a source outside of the simulation set
+                // flipping an output of a flip-flop flips its state and hence all of its outputs
+                std::vector<u32> flipped_nets = {net_index};
+                for (const auto& ff : m_lane_ffs)
                 {
-                    for (auto src : net->get_sources())
+                    if (std::find(ff.state_output_nets.begin(), ff.state_output_nets.end(), net_index) != ff.state_output_nets.end()
+                        || std::find(ff.state_inverted_output_nets.begin(), ff.state_inverted_output_nets.end(), net_index) != ff.state_inverted_output_nets.end())
                     {
-                        if (m_simulation_set.find(src->get_gate()) == m_simulation_set.end())
-                        {
-                            m_input_nets.push_back(net);
-                            break;
-                        }
+                        flipped_nets = ff.state_output_nets;
+                        flipped_nets.insert(flipped_nets.end(), ff.state_inverted_output_nets.begin(), ff.state_inverted_output_nets.end());
+                        break;
                     }
                 }
-            }
-        }
-    }
 
-    void NetlistSimulator::compute_output_nets()
-    {
-        m_output_nets.clear();
-        for (auto gate : m_simulation_set)
-        {
-            for (auto net : gate->get_fan_out_nets())
+                for (u32 flipped_net : flipped_nets)
+                {
+                    LaneFlip flip;
+                    flip.net_index = flipped_net;
+                    flip.lanes     = mask;
+                    flip.time      = m_current_time + fault.time;
+                    m_lane_flips.push_back(flip);
+                }
+            }
+            else
             {
-                // "output net" is either a global output...
-                if (net->is_global_output_net())
+                if (m_lane_stuck_lanes.empty())
                 {
-                    m_output_nets.push_back(net);
+                    m_lane_stuck_lanes.assign(m_nets.size(), 0);
+                    m_lane_stuck_values.assign(m_nets.size(), LaneValues{0, 0});
                 }
-                else    // ... or has a destination outside of the simulation set
+
+                SignalValue value = (fault.type == FaultType::stuck_at_1) ? SignalValue::ONE : SignalValue::ZERO;
+                m_lane_stuck_lanes[net_index] |= mask;
+                if (value == SignalValue::ONE)
                 {
-                    for (auto dst : net->get_destinations())
-                    {
-                        if (m_simulation_set.find(dst->get_gate()) == m_simulation_set.end())
-                        {
-                            m_output_nets.push_back(net);
-                            break;
-                        }
-                    }
+                    m_lane_stuck_values[net_index].one |= mask;
+                }
+                else
+                {
+                    m_lane_stuck_values[net_index].zero |= mask;
                 }
+
+                // apply the stuck value right away, from then on it overrides every change
+                LaneInput input;
+                input.net   = fault.net;
+                input.lane  = lane;
+                input.value = value;
+                input.time  = m_current_time;
+                m_lane_inputs.push_back(input);
             }
         }
     }
 
-    void NetlistSimulator::set_iteration_timeout(u64 iterations)
-    {
-        m_timeout_iterations = iterations;
-    }
-
-    u64 NetlistSimulator::get_simulation_timeout() const
+    void NetlistSimulator::simulate_fault_batch(FaultCampaign& campaign, const Fault* faults, u32 count, FaultResult* results)
     {
-        return m_timeout_iterations;
-    }
+        // a batch without faults is the fault-free simulation that all other batches are compared to
+        bool golden = (count == 0);
+        u64 lanes   = (count == LANE_COUNT) ? ~0ull : (1ull << count) - 1;
 
-    /*
-     * This function precomputes all the stuff that shall be cached for simulation.
-     */
-    void NetlistSimulator::initialize()
-    {
-        measure_block_time("NetlistSimulator::initialize()");
-        m_successors.clear();
-        m_sim_gates.clear();
+        for (u32 lane = 0; lane < count; ++lane)
+        {
+            results[lane] = {false, campaign.cycles, 0, 0, 0};
+        }
+        inject_lane_faults(faults, count);
 
-        std::unordered_map<Gate*, SimulationGate*> sim_gates_map;
-        std::unordered_set<Net*> all_nets;
+        const auto& input_nets = *campaign.input_nets;
+        const auto& stimuli    = *campaign.stimuli;
+        u32 output_count       = campaign.output_nets.size();
+        if (golden)
+        {
+            campaign.golden_outputs.reserve(campaign.cycles * output_count);
+        }
 
-        // precompute everything that is gate-related
-        for (auto gate : m_simulation_set)
+        for (u64 cycle = 0; cycle < campaign.cycles; ++cycle)
         {
-            std::vector<std::string> input_pins;
-            std::vector<Net*> input_nets;
+            for (u32 i = 0; i < input_nets.size(); ++i)
+            {
+                set_input(input_nets[i], stimuli[cycle * input_nets.size() + i]);
+            }
+
+            simulate(campaign.picoseconds);
+
+            // compare the lanes of every output to the same lanes of the fault-free simulation
+            u64 corrupted = 0;
+            for (u32 i = 0; i < output_count; ++i)
+            {
+                const LaneValues& values = m_lane_net_values[campaign.output_nets[i]];
+                if (golden)
+                {
+                    campaign.golden_outputs.push_back(values);
+                    continue;
+                }
+
+                const LaneValues& expected = campaign.golden_outputs[cycle * output_count + i];
+                u64 diff                   = lanes & ((values.one ^ expected.one) | (values.zero ^ expected.zero));
+                corrupted |= diff;
+                for (; diff != 0; diff &= diff - 1)
+                {
+                    results[__builtin_ctzll(diff)].corrupted_samples++;
+                }
+            }
+
+            for (; corrupted != 0; corrupted &= corrupted - 1)
+            {
+                FaultResult& result = results[__builtin_ctzll(corrupted)];
+                if (!result.detected)
+                {
+                    result.detected              = true;
+                    result.first_detection_cycle = cycle;
+                }
+                result.corrupted_cycles++;
+            }
+        }
+
+        if (m_lane_records_outdated)
+        {
+            load_lane_records();
+        }
+
+        for (u32 i = 0; i < campaign.state_nets.size(); ++i)
+        {
+            const LaneValues& values = m_lane_net_values[campaign.state_nets[i]];
+            if (golden)
+            {
+                campaign.golden_states.push_back(values);
+                continue;
+            }
+
+            const LaneValues& expected = campaign.golden_states[i];
+            for (u64 diff = lanes & ((values.one ^ expected.one) | (values.zero ^ expected.zero)); diff != 0; diff &= diff - 1)
+            {
+                results[__builtin_ctzll(diff)].corrupted_state_nets++;
+            }
+        }
+    }
+
+    void NetlistSimulator::reset()
+    {
+        stop_vcd_stream();
+        stop_vcd_stimulus();
+
+        for (auto& c : m_clocks)
+        {
+            c.next_edge = 0;
+            c.scheduled = false;
+        }
+
+        m_current_time = 0;
+        m_simulation   = Simulation();
+        m_lane_simulations.assign(LANE_COUNT - 1, Simulation());
+        m_event_queue.clear();
+        m_lane_inputs.clear();
+        m_lane_stuck_lanes.clear();
+        m_lane_stuck_values.clear();
+        m_lane_flips.clear();
+        std::fill(m_net_records.begin(), m_net_records.end(), nullptr);
+        std::fill(m_lane_net_records.begin(), m_lane_net_records.end(), nullptr);
+        m_lane_records_outdated = true;
+        m_needs_initialization  = true;
+    }
+
+    void NetlistSimulator::set_simulation_state(const Simulation& state)
+    {
+        m_simulation = state;
+        std::fill(m_net_records.begin(), m_net_records.end(), nullptr);
+        if (m_mode == SimulationMode::bit_parallel)
+        {
+            m_lane_simulations.assign(LANE_COUNT - 1, state);
+            std::fill(m_lane_net_records.begin(), m_lane_net_records.end(), nullptr);
+            m_lane_records_outdated = true;
+        }
+    }
+
+    Simulation NetlistSimulator::get_simulation_state() const
+    {
+        return m_simulation;
+    }
+
+    Simulation NetlistSimulator::get_lane_simulation_state(u32 lane) const
+    {
+        if (lane >= LANE_COUNT)
+        {
+            log_error("netlist_simulator", "lane {} does not exist, only {} lanes are simulated.", lane, LANE_COUNT);
+            return Simulation();
+        }
+        return get_lane_simulation(lane);
+    }
+
+    Simulation& NetlistSimulator::get_lane_simulation(u32 lane)
+    {
+        return (lane == 0) ? m_simulation : m_lane_simulations[lane - 1];
+    }
+
+    const Simulation& NetlistSimulator::get_lane_simulation(u32 lane) const
+    {
+        return (lane == 0) ? m_simulation : m_lane_simulations[lane - 1];
+    }
+
+    SimulationCheckpoint NetlistSimulator::create_checkpoint() const
+    {
+        SimulationCheckpoint checkpoint;
+        checkpoint.m_time        = m_current_time;
+        checkpoint.m_initialized = !m_needs_initialization;
+        checkpoint.m_state       = get_checkpoint_state(m_simulation);
+        if (m_mode == SimulationMode::bit_parallel)
+        {
+            checkpoint.m_lane_states.reserve(m_lane_simulations.size());
+            for (const auto& simulation : m_lane_simulations)
+            {
+                checkpoint.m_lane_states.push_back(get_checkpoint_state(simulation));
+            }
+        }
+
+        checkpoint.m_events = m_event_queue.get_events();
+        for (const auto& input : m_lane_inputs)
+        {
+            Event e;
+            e.affected_net = input.net;
+            e.new_value    = input.value;
+            e.time         = input.time;
+            e.id           = 0;
+            checkpoint.m_lane_inputs.emplace_back(input.lane, e);
+        }
+        for (const auto& c : m_clocks)
+        {
+            checkpoint.m_clock_edges.emplace_back(c.next_edge, c.scheduled);
+        }
+        return checkpoint;
+    }
+
+    void NetlistSimulator::restore_checkpoint(const SimulationCheckpoint& checkpoint)
+    {
+        if (checkpoint.m_clock_edges.size() != m_clocks.size())
+        {
+            log_error("netlist_simulator", "checkpoint holds {} clocks, but {} clocks are simulated.", checkpoint.m_clock_edges.size(), m_clocks.size());
+            return;
+        }
+
+        if (checkpoint.m_lane_states.empty() == (m_mode == SimulationMode::bit_parallel))
+        {
+            log_error("netlist_simulator", "checkpoint was created in a different simulation mode.");
+            return;
+        }
+
+        stop_vcd_stream();
+        stop_vcd_stimulus();
+
+        m_current_time = checkpoint.m_time;
+        m_simulation   = checkpoint.m_state;
+        std::fill(m_net_records.begin(), m_net_records.end(), nullptr);
+        if (m_mode == SimulationMode::bit_parallel)
+        {
+            m_lane_simulations = checkpoint.m_lane_states;
+            std::fill(m_lane_net_records.begin(), m_lane_net_records.end(), nullptr);
+            m_lane_records_outdated = true;
+        }
+        m_recorded_events = 0;
+
+        for (u32 i = 0; i < m_clocks.size(); ++i)
+        {
+            m_clocks[i].next_edge = checkpoint.m_clock_edges[i].first;
+            m_clocks[i].scheduled = checkpoint.m_clock_edges[i].second;
+        }
+
+        m_lane_inputs.clear();
+        for (const auto& [lane, e] : checkpoint.m_lane_inputs)
+        {
+            LaneInput input;
+            input.net   = e.affected_net;
+            input.lane  = lane;
+            input.value = e.new_value;
+            input.time  = e.time;
+            m_lane_inputs.push_back(input);
+        }
+        m_lane_stuck_lanes.clear();
+        m_lane_stuck_values.clear();
+        m_lane_flips.clear();
+
+        // the one-time events of initialize are already part of the checkpoint unless it was created before the simulation started
+        if (!checkpoint.m_initialized)
+        {
+            m_needs_initialization = true;
+        }
+        else if (m_needs_initialization)
+        {
+            initialize();
+        }
+
+        m_event_queue.clear();
+        for (const auto& e : checkpoint.m_events)
+        {
+            m_event_queue.push(e);
+        }
+
+        if (!m_needs_initialization)
+        {
+            load_net_values();
+        }
+    }
+
+    std::unique_ptr<NetlistSimulator> NetlistSimulator::fork(const SimulationCheckpoint& checkpoint) const
+    {
+        auto sim = std::unique_ptr<NetlistSimulator>(new NetlistSimulator());
+        sim->m_simulation_set     = m_simulation_set;
+        sim->m_clocks             = m_clocks;
+        sim->m_input_nets         = m_input_nets;
+        sim->m_output_nets        = m_output_nets;
+        sim->m_mode               = m_mode;
+        sim->m_timeout_iterations = m_timeout_iterations;
+        sim->m_thread_count       = m_thread_count;
+        sim->m_watched_nets       = m_watched_nets;
+        sim->m_history_window     = m_history_window;
+        sim->update_flush_threshold(0);
+        sim->restore_checkpoint(checkpoint);
+        return sim;
+    }
+
+    Simulation NetlistSimulator::get_checkpoint_state(const Simulation& simulation) const
+    {
+        Simulation state;
+        for (const auto& [net, waveform] : simulation.m_waveforms)
+        {
+            if (waveform.times.empty())
+            {
+                continue;
+            }
+
+            // the last change before the current point in time holds the value, changes at the current point in time may still be reverted
+            u32 first = std::lower_bound(waveform.times.begin(), waveform.times.end(), m_current_time) - waveform.times.begin();
+            first     = (first > 0) ? first - 1 : 0;
+
+            auto& copy = state.m_waveforms[net];
+            copy.times.assign(waveform.times.begin() + first, waveform.times.end());
+            copy.values.assign(waveform.values.begin() + first, waveform.values.end());
+        }
+        return state;
+    }
+
+    void NetlistSimulator::compute_input_nets()
+    {
+        m_input_nets.clear();
+        for (auto gate : m_simulation_set)
+        {
+            for (auto net : gate->get_fan_in_nets())
+            {
+                // "input net" is either a global input...
+                if (net->is_global_input_net())
+                {
+                    m_input_nets.push_back(net);
+                }
+                else    // ... or has a source outside of the simulation set
+                {
+                    for (auto src : net->get_sources())
+                    {
+                        if (m_simulation_set.find(src->get_gate()) == m_simulation_set.end())
+                        {
+                            m_input_nets.push_back(net);
+                            break;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    void NetlistSimulator::compute_output_nets()
+    {
+        m_output_nets.clear();
+        for (auto gate : m_simulation_set)
+        {
+            for (auto net : gate->get_fan_out_nets())
+            {
+                // "output net" is either a global output...
+                if (net->is_global_output_net())
+                {
+                    m_output_nets.push_back(net);
+                }
+                else    // ... or has a destination outside of the simulation set
+                {
+                    for (auto dst : net->get_destinations())
+                    {
+                        if (m_simulation_set.find(dst->get_gate()) == m_simulation_set.end())
+                        {
+                            m_output_nets.push_back(net);
+                            break;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    void NetlistSimulator::set_iteration_timeout(u64 iterations)
+    {
+        m_timeout_iterations = iterations;
+    }
+
+    u64 NetlistSimulator::get_simulation_timeout() const
+    {
+        return m_timeout_iterations;
+    }
+
+    void NetlistSimulator::set_simulation_mode(SimulationMode mode)
+    {
+        if (mode != m_mode)
+        {
+            m_mode                 = mode;
+            m_needs_initialization = true;
+        }
+    }
+
+    SimulationMode NetlistSimulator::get_simulation_mode() const
+    {
+        return m_mode;
+    }
+
+    void NetlistSimulator::set_thread_count(u32 threads)
+    {
+        m_thread_count = (threads == 0) ? std::max(1, omp_get_max_threads()) : threads;
+    }
+
+    u32 NetlistSimulator::get_thread_count() const
+    {
+        return m_thread_count;
+    }
+
+    void NetlistSimulator::set_profiling_enabled(bool enabled)
+    {
+        m_profiling = enabled;
+    }
+
+    bool NetlistSimulator::is_profiling_enabled() const
+    {
+        return m_profiling;
+    }
+
+    SimulationProfile NetlistSimulator::get_profile(u32 top_count) const
+    {
+        SimulationProfile profile = m_profile;
+
+        std::vector<std::pair<Gate*, u64>> gates;
+        for (const auto& sim_gate : m_sim_gates)
+        {
+            if (sim_gate->evaluations != 0)
+            {
+                profile.gate_evaluations += sim_gate->evaluations;
+                profile.gate_evaluations_per_type[sim_gate->gate->get_type()->get_name()] += sim_gate->evaluations;
+                gates.emplace_back(sim_gate->gate, sim_gate->evaluations);
+            }
+        }
+        std::vector<std::pair<Net*, u64>> nets(m_net_glitches.begin(), m_net_glitches.end());
+
+        // most frequent first, ties are broken by ID to get a deterministic order
+        auto take_top = [top_count](auto& entries) {
+            auto compare = [](const auto& a, const auto& b) { return (a.second != b.second) ? a.second > b.second : a.first->get_id() < b.first->get_id(); };
+            u32 count    = std::min<u64>(top_count, entries.size());
+            std::partial_sort(entries.begin(), entries.begin() + count, entries.end(), compare);
+            entries.resize(count);
+        };
+        take_top(gates);
+        take_top(nets);
+        profile.hot_gates      = std::move(gates);
+        profile.glitching_nets = std::move(nets);
+        return profile;
+    }
+
+    void NetlistSimulator::reset_profile()
+    {
+        m_profile                 = SimulationProfile();
+        m_profile_time            = ~0ull;
+        m_profile_timestep_events = 0;
+        m_profile_timestep_deltas = 0;
+        m_net_glitches.clear();
+        for (const auto& sim_gate : m_sim_gates)
+        {
+            sim_gate->evaluations = 0;
+        }
+    }
+
+    u64 NetlistSimulator::get_profile_clock() const
+    {
+        if (!m_profiling)
+        {
+            return 0;
+        }
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    void NetlistSimulator::profile_delta_cycle(u64 events)
+    {
+        if (events == 0)
+        {
+            return;
+        }
+
+        if (m_current_time != m_profile_time)
+        {
+            m_profile_time            = m_current_time;
+            m_profile_timestep_events = 0;
+            m_profile_timestep_deltas = 0;
+            m_profile.timesteps++;
+        }
+        m_profile_timestep_events += events;
+        m_profile_timestep_deltas++;
+
+        m_profile.events += events;
+        m_profile.delta_cycles++;
+        m_profile.max_events_per_timestep       = std::max(m_profile.max_events_per_timestep, m_profile_timestep_events);
+        m_profile.max_delta_cycles_per_timestep = std::max(m_profile.max_delta_cycles_per_timestep, m_profile_timestep_deltas);
+    }
+
+    void NetlistSimulator::profile_time(u64 start, u64 evaluation)
+    {
+        if (m_profiling)
+        {
+            u64 total = get_profile_clock() - start;
+            m_profile.evaluation_time += evaluation;
+            m_profile.scheduling_time += (total > evaluation) ? total - evaluation : 0;
+        }
+    }
+
+    void NetlistSimulator::set_watched_nets(const std::set<Net*>& nets)
+    {
+        m_watched_nets = nets;
+        update_flush_threshold(0);
+    }
+
+    std::set<Net*> NetlistSimulator::get_watched_nets() const
+    {
+        return m_watched_nets;
+    }
+
+    void NetlistSimulator::set_history_window(u64 picoseconds)
+    {
+        m_history_window = picoseconds;
+        update_flush_threshold(0);
+    }
+
+    u64 NetlistSimulator::get_history_window() const
+    {
+        return m_history_window;
+    }
+
+    bool NetlistSimulator::start_vcd_stream(const std::filesystem::path& path)
+    {
+        stop_vcd_stream();
+
+        m_vcd_stream.open(path);
+        if (!m_vcd_stream.is_open())
+        {
+            log_error("netlist_simulator", "could not open file '{}' for writing.", path.string());
+            return false;
+        }
+
+        // the declared nets are fixed for the lifetime of the stream
+        if (!m_watched_nets.empty())
+        {
+            m_vcd_stream_nets.assign(m_watched_nets.begin(), m_watched_nets.end());
+        }
+        else
+        {
+            std::unordered_set<Net*> nets;
+            for (Gate* gate : m_simulation_set)
+            {
+                for (Net* net : gate->get_fan_in_nets())
+                {
+                    nets.insert(net);
+                }
+                for (Net* net : gate->get_fan_out_nets())
+                {
+                    nets.insert(net);
+                }
+            }
+            m_vcd_stream_nets.assign(nets.begin(), nets.end());
+        }
+        std::sort(m_vcd_stream_nets.begin(), m_vcd_stream_nets.end(), [](Net* a, Net* b) { return a->get_id() < b->get_id(); });
+
+        // write header
+        auto t  = std::time(nullptr);
+        auto tm = *std::localtime(&t);
+        m_vcd_stream << "$version Generated by HAL $HAL" << std::endl;
+        m_vcd_stream << "$date " << std::put_time(&tm, "%d-%m-%Y %H-%M-%S") << std::endl;
+        m_vcd_stream << "$timescale 1ps $end" << std::endl;
+        m_vcd_stream << "$scope module TOP $end" << std::endl;
+        for (Net* net : m_vcd_stream_nets)
+        {
+            m_vcd_stream << "$var wire 1 n" << net->get_id() << " " << net->get_name() << " $end" << std::endl;
+        }
+        m_vcd_stream << "$upscope $end" << std::endl;
+        m_vcd_stream << "$enddefinitions $end" << std::endl;
+
+        m_vcd_stream_time = 0;
+        update_flush_threshold(0);
+        return true;
+    }
+
+    void NetlistSimulator::stop_vcd_stream()
+    {
+        if (!m_vcd_stream.is_open())
+        {
+            return;
+        }
+
+        write_vcd_stream(~0ull);
+        m_vcd_stream.close();
+        m_vcd_stream_nets.clear();
+        update_flush_threshold(0);
+    }
+
+    bool NetlistSimulator::load_vcd_stimulus(const std::filesystem::path& path, const std::unordered_map<std::string, Net*>& nets)
+    {
+        stop_vcd_stimulus();
+
+        m_vcd_stimulus.open(path);
+        if (!m_vcd_stimulus.is_open())
+        {
+            log_error("netlist_simulator", "could not open file '{}' for reading.", path.string());
+            return false;
+        }
+
+        // without an explicit mapping, signals are mapped to input nets of the same name
+        std::unordered_map<std::string, Net*> input_nets;
+        if (nets.empty())
+        {
+            for (Net* net : m_input_nets)
+            {
+                if (auto [it, inserted] = input_nets.emplace(net->get_name(), net); !inserted && it->second != net && it->second != nullptr)
+                {
+                    log_warning("netlist_simulator", "multiple input nets are named '{}', provide a mapping to drive them from a VCD file.", net->get_name());
+                    it->second = nullptr;
+                }
+            }
+        }
+        const auto& net_mapping = nets.empty() ? input_nets : nets;
+        auto find_net           = [&net_mapping](const std::string& name) -> Net* {
+            auto it = net_mapping.find(name);
+            return (it != net_mapping.end()) ? it->second : nullptr;
+        };
+
+        // reads all tokens up to the next $end
+        std::string token;
+        auto read_section = [this, &token]() {
+            std::vector<std::string> tokens;
+            while (m_vcd_stimulus >> token && token != "$end")
+            {
+                tokens.push_back(token);
+            }
+            return tokens;
+        };
+
+        m_vcd_stimulus_scale = 1000;
+        u32 signal_count     = 0;
+        bool header_complete = false;
+        while (m_vcd_stimulus >> token)
+        {
+            if (token == "$enddefinitions")
+            {
+                read_section();
+                header_complete = true;
+                break;
+            }
+            else if (token == "$timescale")
+            {
+                static const std::vector<std::pair<std::string, u64>> units = {{"fs", 1}, {"ps", 1000}, {"ns", 1000000}, {"us", 1000000000}, {"ms", 1000000000000}, {"s", 1000000000000000}};
+
+                std::string timescale;
+                for (const auto& part : read_section())
+                {
+                    timescale += part;
+                }
+
+                u64 factor = 0;
+                size_t pos = parse_unsigned(timescale, 0, factor);
+                auto unit  = std::find_if(units.begin(), units.end(), [&](const auto& u) { return pos != 0 && timescale.substr(pos) == u.first; });
+                if (unit == units.end() || factor == 0)
+                {
+                    log_error("netlist_simulator", "unsupported timescale '{}' in VCD file '{}'.", timescale, path.string());
+                    stop_vcd_stimulus();
+                    return false;
+                }
+                m_vcd_stimulus_scale = factor * unit->second;
+            }
+            else if (token == "$var")
+            {
+                // $var <type> <size> <identifier> <reference> [<range>] $end
+                auto var  = read_section();
+                u64 width = 0;
+                if (var.size() < 4 || parse_unsigned(var[1], 0, width) != var[1].size() || width == 0)
+                {
+                    log_error("netlist_simulator", "invalid variable definition in VCD file '{}'.", path.string());
+                    stop_vcd_stimulus();
+                    return false;
+                }
+                signal_count++;
+
+                std::string name  = var[3];
+                std::string range = (var.size() > 4) ? var[4] : "";
+                if (auto bracket = name.find('['); bracket != std::string::npos)
+                {
+                    range = name.substr(bracket);
+                    name  = name.substr(0, bracket);
+                }
+
+                // the range is either [<msb>:<lsb>] or [<index>], vectors without range are indexed from 0
+                u64 msb = width - 1;
+                u64 lsb = 0;
+                if (!range.empty())
+                {
+                    size_t pos = parse_unsigned(range, 1, msb);
+                    lsb        = msb;
+                    if (pos != 0 && pos < range.size() && range[pos] == ':')
+                    {
+                        pos = parse_unsigned(range, pos + 1, lsb);
+                    }
+                    if (pos == 0)
+                    {
+                        msb = width - 1;
+                        lsb = 0;
+                    }
+                }
+
+                auto& signal = m_vcd_stimulus_signals[var[2]];
+                for (u32 bit = 0; bit < width; ++bit)
+                {
+                    Net* net = nullptr;
+                    if (width == 1 && range.empty())
+                    {
+                        net = find_net(name);
+                    }
+                    else
+                    {
+                        std::string index = std::to_string((msb >= lsb) ? lsb + bit : lsb - bit);
+                        net               = find_net(name + "[" + index + "]");
+                        if (net == nullptr)
+                        {
+                            net = find_net(name + "(" + index + ")");
+                        }
+                    }
+
+                    // the same signal may be declared in multiple scopes
+                    if (net != nullptr && std::find(signal.bits.begin(), signal.bits.end(), std::make_pair(bit, net)) == signal.bits.end())
+                    {
+                        signal.bits.emplace_back(bit, net);
+                    }
+                }
+                if (signal.bits.empty())
+                {
+                    m_vcd_stimulus_signals.erase(var[2]);
+                }
+            }
+            else if (token[0] == '$' && token != "$end")
+            {
+                // $scope, $upscope, $date, $version, $comment
+                read_section();
+            }
+        }
+
+        if (!header_complete)
+        {
+            log_error("netlist_simulator", "VCD file '{}' does not contain a complete header.", path.string());
+            stop_vcd_stimulus();
+            return false;
+        }
+
+        if (m_vcd_stimulus_signals.empty())
+        {
+            log_warning("netlist_simulator", "none of the {} signals of VCD file '{}' could be mapped to a net.", signal_count, path.string());
+        }
+        else
+        {
+            log_info("netlist_simulator", "mapped {} of {} signals of VCD file '{}' to nets.", m_vcd_stimulus_signals.size(), signal_count, path.string());
+        }
+
+        m_vcd_stimulus_offset = m_current_time;
+        m_vcd_stimulus_time   = m_current_time;
+        return true;
+    }
+
+    void NetlistSimulator::stop_vcd_stimulus()
+    {
+        m_vcd_stimulus.close();
+        m_vcd_stimulus.clear();
+        m_vcd_stimulus_signals.clear();
+    }
+
+    /*
+     * This function precomputes all the stuff that shall be cached for simulation.
+     */
+    void NetlistSimulator::initialize()
+    {
+        measure_block_time("NetlistSimulator::initialize()");
+        reset_profile();
+        m_sim_gates.clear();
+        m_net_indices.clear();
+        m_nets.clear();
+        m_net_records.clear();
+        m_successor_offsets.clear();
+        m_successors.clear();
+        m_successor_pins.clear();
+        m_levelized    = false;
+        m_bit_parallel = false;
+
+        std::unordered_map<Gate*, SimulationGate*> sim_gates_map;
+
+        // precompute everything that is gate-related
+        for (auto gate : m_simulation_set)
+        {
+            std::vector<std::string> input_pins;
+            std::vector<Net*> input_nets;
 
             // gather input pins + respective nets at same positions of vectors for fast iteration
             for (auto pin : gate->get_input_pins())
             {
-                input_pins.push_back(pin);
-                input_nets.push_back(gate->get_fan_in_net(pin));
+                input_pins.push_back(pin);
+                input_nets.push_back(gate->get_fan_in_net(pin));
+            }
+
+            SimulationGate* sim_gate_base = nullptr;
+
+            if (gate->get_type()->has_property(GateTypeProperty::ff))
+            {
+                auto sim_gate_owner = std::make_unique<SimulationGateFF>();
+                auto sim_gate       = sim_gate_owner.get();
+                sim_gate_base       = sim_gate;
+                m_sim_gates.push_back(std::move(sim_gate_owner));
+                sim_gate->is_flip_flop = true;
+                sim_gate->input_pins   = input_pins;
+                sim_gate->input_nets   = input_nets;
+                sim_gate->input_values.assign(input_pins.size(), BooleanFunction::X);
+
+                auto gate_type            = gate->get_type();
+                sim_gate->clock_func      = compile_function(gate->get_boolean_function("clock"), input_pins);
+                sim_gate->preset_func     = compile_function(gate->get_boolean_function("preset"), input_pins);
+                sim_gate->clear_func      = compile_function(gate->get_boolean_function("clear"), input_pins);
+                sim_gate->next_state_func = compile_function(gate->get_boolean_function("next_state"), input_pins);
+                for (auto pin : gate_type->get_pins_of_type(PinType::state))
+                {
+                    if (Net* net = gate->get_fan_out_net(pin); net != nullptr)
+                    {
+                        sim_gate->state_output_nets.push_back(gate->get_fan_out_net(pin));
+                    }
+                }
+                for (auto pin : gate_type->get_pins_of_type(PinType::neg_state))
+                {
+                    if (Net* net = gate->get_fan_out_net(pin); net != nullptr)
+                    {
+                        sim_gate->state_inverted_output_nets.push_back(gate->get_fan_out_net(pin));
+                    }
+                }
+                for (auto pin : gate_type->get_pins_of_type(PinType::clock))
+                {
+                    sim_gate->clock_nets.push_back(gate->get_fan_in_net(pin));
+                }
+                auto behavior                      = gate_type->get_clear_preset_behavior();
+                sim_gate->sr_behavior_out          = behavior.first;
+                sim_gate->sr_behavior_out_inverted = behavior.second;
+            }
+            else if (gate->get_type()->has_property(GateTypeProperty::combinational))
+            {
+                auto sim_gate_owner = std::make_unique<SimulationGateCombinational>();
+                auto sim_gate       = sim_gate_owner.get();
+                sim_gate_base       = sim_gate;
+                m_sim_gates.push_back(std::move(sim_gate_owner));
+                sim_gate->is_flip_flop = false;
+                sim_gate->input_pins   = input_pins;
+                sim_gate->input_nets   = input_nets;
+                sim_gate->input_values.assign(input_pins.size(), BooleanFunction::X);
+
+                // LUTs are evaluated from their configuration, their Boolean functions are only built if that fails
+                std::unordered_set<std::string> lut_pins;
+                std::unordered_map<std::string, BooleanFunction> all_functions;
+                if (gate->get_type()->has_property(GateTypeProperty::lut))
+                {
+                    lut_pins      = gate->get_type()->get_pins_of_type(PinType::lut);
+                    all_functions = gate->get_type()->get_boolean_functions();
+                    for (const auto& [pin, function] : gate->get_boolean_functions(true))
+                    {
+                        all_functions.emplace(pin, function);
+                    }
+                }
+                else
+                {
+                    all_functions = gate->get_boolean_functions();
+                }
+                auto get_function = [&](const std::string& pin) -> const BooleanFunction& {
+                    if (auto it = all_functions.find(pin); it != all_functions.end())
+                    {
+                        return it->second;
+                    }
+                    return all_functions.emplace(pin, gate->get_boolean_function(pin)).first->second;
+                };
+
+                auto output_pins = gate->get_output_pins();
+
+                for (auto pin : output_pins)
+                {
+                    auto out_net = gate->get_fan_out_net(pin);
+                    if (out_net == nullptr)
+                    {
+                        continue;
+                    }
+                    sim_gate->output_pins.push_back(pin);
+                    sim_gate->output_nets.push_back(out_net);
+
+                    if (lut_pins.find(pin) != lut_pins.end())
+                    {
+                        SimulationFunction lut_function;
+                        if (compile_lut_function(gate, input_pins, lut_function))
+                        {
+                            sim_gate->functions.push_back(std::move(lut_function));
+                            continue;
+                        }
+                    }
+
+                    auto func = get_function(pin);
+
+                    while (true)
+                    {
+                        auto vars = func.get_variables();
+                        bool exit = true;
+                        for (auto other_pin : output_pins)
+                        {
+                            if (std::find(vars.begin(), vars.end(), other_pin) != vars.end())
+                            {
+                                func = func.substitute(other_pin, get_function(other_pin));
+                                exit = false;
+                            }
+                        }
+                        if (exit)
+                        {
+                            break;
+                        }
+                    }
+
+                    sim_gate->functions.push_back(compile_function(func, input_pins));
+                }
+            }
+            else
+            {
+                log_error("netlist_simulator", "no support for gate type {} of gate {}.", gate->get_type()->get_name(), gate->get_name());
+                m_sim_gates.clear();
+                return;
+            }
+
+            sim_gate_base->gate = gate;
+
+            sim_gates_map.emplace(gate, sim_gate_base);
+        }
+
+        // assign dense indices to all inputs and gate outputs
+        auto add_net = [this](Net* net) {
+            if (net != nullptr && m_net_indices.emplace(net, m_nets.size()).second)
+            {
+                m_nets.push_back(net);
+            }
+        };
+        std::for_each(m_input_nets.begin(), m_input_nets.end(), add_net);
+        for (const auto& sim_gate : m_sim_gates)
+        {
+            auto out_nets = sim_gate->gate->get_fan_out_nets();
+            std::for_each(out_nets.begin(), out_nets.end(), add_net);
+        }
+        m_net_records.assign(m_nets.size(), nullptr);
+
+        // find all successors of nets and transform them to their respective simulation gate instance and input pin indices
+        m_successor_offsets.assign(1, 0);
+        for (auto net : m_nets)
+        {
+            std::vector<Gate*> gates;
+            std::unordered_map<Gate*, std::vector<u32>> affected_pins;
+            for (auto ep : net->get_destinations())
+            {
+                auto gate = ep->get_gate();
+                auto it   = sim_gates_map.find(gate);
+                if (it == sim_gates_map.end())
+                {
+                    continue;
+                }
+                const auto& pins = it->second->input_pins;
+                if (affected_pins.find(gate) == affected_pins.end())
+                {
+                    gates.push_back(gate);
+                }
+                affected_pins[gate].push_back(std::distance(pins.begin(), std::find(pins.begin(), pins.end(), ep->get_pin())));
+            }
+
+            for (auto gate : gates)
+            {
+                SimulationSuccessor successor;
+                successor.gate       = sim_gates_map.at(gate);
+                successor.pins_begin = m_successor_pins.size();
+                m_successor_pins.insert(m_successor_pins.end(), affected_pins.at(gate).begin(), affected_pins.at(gate).end());
+                successor.pins_end = m_successor_pins.size();
+                m_successors.push_back(successor);
+            }
+            m_successor_offsets.push_back(m_successors.size());
+        }
+
+        initialize_loops();
+
+        // create one-time events for global gnd and vcc gates
+        for (auto g : m_simulation_set)
+        {
+            if (g->is_gnd_gate())
+            {
+                for (auto n : g->get_fan_out_nets())
+                {
+                    Event e;
+                    e.affected_net = n;
+                    e.new_value    = SignalValue::ZERO;
+                    e.time         = m_current_time;
+                    m_event_queue.push(e);
+                }
+            }
+            else if (g->is_vcc_gate())
+            {
+                for (auto n : g->get_fan_out_nets())
+                {
+                    Event e;
+                    e.affected_net = n;
+                    e.new_value    = SignalValue::ONE;
+                    e.time         = m_current_time;
+                    m_event_queue.push(e);
+                }
+            }
+        }
+
+        if (m_mode == SimulationMode::cycle_based)
+        {
+            m_levelized = initialize_levelized();
+            if (!m_levelized)
+            {
+                log_warning("netlist_simulator", "falling back to event-driven simulation.");
+            }
+        }
+        else if (m_mode == SimulationMode::bit_parallel)
+        {
+            m_bit_parallel = initialize_levelized() && initialize_bit_parallel();
+            if (!m_bit_parallel)
+            {
+                log_error("netlist_simulator", "bit-parallel simulation is not supported for this netlist.");
+            }
+        }
+
+        // set initialization flag only if this point is reached
+        m_needs_initialization = false;
+    }
+
+    void NetlistSimulator::load_net_values()
+    {
+        // gates only observe value changes, so their inputs have to be recovered from the recorded values once the state is replaced
+        for (u32 net_index = 0; net_index < m_nets.size(); ++net_index)
+        {
+            const Waveform& waveform = m_simulation.get_waveform(m_nets[net_index]);
+            SignalValue value        = waveform.values.empty() ? SignalValue::X : waveform.values.back();
+            if (m_levelized)
+            {
+                m_net_values[net_index] = value;
+            }
+
+            auto input_value = static_cast<BooleanFunction::Value>(value);
+            for (u32 i = m_successor_offsets[net_index]; i < m_successor_offsets[net_index + 1]; ++i)
+            {
+                const auto& successor = m_successors[i];
+                for (u32 j = successor.pins_begin; j < successor.pins_end; ++j)
+                {
+                    successor.gate->input_values[m_successor_pins[j]] = input_value;
+                }
+            }
+        }
+    }
+
+    void NetlistSimulator::initialize_loops()
+    {
+        static const u32 MAX_EVALUATIONS_PER_GATE = 64;
+        static const u32 MAX_REPORTED_NAMES       = 10;
+
+        auto join_names = [](const auto& items) {
+            std::vector<std::string> names;
+            for (u32 i = 0; i < items.size() && i < MAX_REPORTED_NAMES; ++i)
+            {
+                names.push_back("'" + items[i]->get_name() + "'");
+            }
+            if (items.size() > MAX_REPORTED_NAMES)
+            {
+                names.push_back("...");
+            }
+            return utils::join(", ", names);
+        };
+
+        m_loops.clear();
+        for (const auto& sim_gate : m_sim_gates)
+        {
+            sim_gate->loop_index = ~0u;
+        }
+
+        std::unordered_map<Gate*, SimulationGate*> sim_gates_map;
+        for (const auto& sim_gate : m_sim_gates)
+        {
+            sim_gates_map.emplace(sim_gate->gate, sim_gate.get());
+        }
+
+        for (const auto& gates : get_combinational_loops())
+        {
+            SimulationLoop loop;
+            loop.max_evaluations = MAX_EVALUATIONS_PER_GATE * gates.size();
+            loop.time            = 0;
+            loop.evaluations     = 0;
+            loop.resolved        = false;
+            loop.reported        = false;
+            for (Gate* gate : gates)
+            {
+                auto sim_gate        = sim_gates_map.at(gate);
+                sim_gate->loop_index = m_loops.size();
+                loop.gates.push_back(static_cast<SimulationGateCombinational*>(sim_gate));
+            }
+
+            // the nets of the loop connect two of its gates
+            std::unordered_set<Gate*> loop_gates(gates.begin(), gates.end());
+            std::vector<Net*> nets;
+            for (const auto sim_gate : loop.gates)
+            {
+                for (Net* net : sim_gate->output_nets)
+                {
+                    auto destinations = net->get_destinations();
+                    if (std::any_of(destinations.begin(), destinations.end(), [&loop_gates](Endpoint* ep) { return loop_gates.find(ep->get_gate()) != loop_gates.end(); }))
+                    {
+                        nets.push_back(net);
+                    }
+                }
+            }
+            std::sort(nets.begin(), nets.end(), [](Net* a, Net* b) { return a->get_id() < b->get_id(); });
+
+            log_warning("netlist_simulator", "found combinational loop of {} gates and {} nets, gates: {}, nets: {}.", gates.size(), nets.size(), join_names(gates), join_names(nets));
+            m_loops.push_back(loop);
+        }
+    }
+
+    bool NetlistSimulator::check_loop_evaluation(u32 loop_index)
+    {
+        auto& loop = m_loops[loop_index];
+        if (loop.time != m_current_time)
+        {
+            loop.time        = m_current_time;
+            loop.evaluations = 0;
+            loop.resolved    = false;
+        }
+        else if (loop.resolved)
+        {
+            return false;
+        }
+
+        if (++loop.evaluations <= loop.max_evaluations)
+        {
+            return true;
+        }
+
+        // the loop did not settle, so all of its nets are set to X and its gates are no longer evaluated at this point in time
+        if (!loop.reported)
+        {
+            log_warning("netlist_simulator",
+                        "combinational loop containing gate '{}' did not settle at {} ps, setting its nets to X.",
+                        loop.gates.front()->gate->get_name(),
+                        m_current_time);
+            loop.reported = true;
+        }
+        for (const auto gate : loop.gates)
+        {
+            for (Net* net : gate->output_nets)
+            {
+                schedule_event(net, SignalValue::X, m_current_time);
+            }
+        }
+        loop.resolved = true;
+        return false;
+    }
+
+    bool NetlistSimulator::initialize_levelized()
+    {
+        measure_block_time("NetlistSimulator::initialize_levelized()");
+        static const u32 INVALID_INDEX = ~0u;
+
+        m_levelized_gates.clear();
+        m_dirty_gates_per_level.clear();
+
+        std::unordered_map<SimulationGate*, u32> levelized_indices;
+        for (const auto& sim_gate : m_sim_gates)
+        {
+            if (!sim_gate->is_flip_flop)
+            {
+                levelized_indices.emplace(sim_gate.get(), m_levelized_gates.size());
+
+                LevelizedGate gate;
+                gate.gate  = static_cast<SimulationGateCombinational*>(sim_gate.get());
+                gate.level = 0;
+                gate.dirty = false;
+                m_levelized_gates.push_back(gate);
+            }
+        }
+
+        m_net_values.assign(m_nets.size(), SignalValue::X);
+        m_net_comb_successors.assign(m_nets.size(), {});
+
+        for (u32 net_index = 0; net_index < m_nets.size(); ++net_index)
+        {
+            for (u32 i = m_successor_offsets[net_index]; i < m_successor_offsets[net_index + 1]; ++i)
+            {
+                if (!m_successors[i].gate->is_flip_flop)
+                {
+                    m_net_comb_successors[net_index].push_back(levelized_indices.at(m_successors[i].gate));
+                }
+            }
+        }
+
+        // translate gates to dense net indices and determine the driving combinational gate of every net
+        std::vector<u32> net_drivers(m_nets.size(), INVALID_INDEX);
+        u32 result_count = 0;
+        for (u32 i = 0; i < m_levelized_gates.size(); ++i)
+        {
+            auto& gate        = m_levelized_gates[i];
+            gate.first_result = result_count;
+            result_count += gate.gate->output_nets.size();
+            for (auto net : gate.gate->input_nets)
+            {
+                auto it = m_net_indices.find(net);
+                gate.input_nets.push_back((it != m_net_indices.end()) ? it->second : INVALID_INDEX);
+            }
+            for (auto net : gate.gate->output_nets)
+            {
+                u32 net_index = m_net_indices.at(net);
+                if (net_drivers[net_index] != INVALID_INDEX)
+                {
+                    log_warning("netlist_simulator", "net '{}' with ID {} has multiple drivers, cannot levelize the netlist.", net->get_name(), net->get_id());
+                    return false;
+                }
+                net_drivers[net_index] = i;
+                gate.output_nets.push_back(net_index);
+            }
+        }
+
+        // levelize the combinational logic, gates at level 0 only depend on inputs or flip-flops
+        std::vector<u32> pending_inputs(m_levelized_gates.size(), 0);
+        for (const auto& gate : m_levelized_gates)
+        {
+            for (u32 net_index : gate.output_nets)
+            {
+                for (u32 successor : m_net_comb_successors[net_index])
+                {
+                    pending_inputs[successor]++;
+                }
+            }
+        }
+
+        std::vector<u32> order;
+        order.reserve(m_levelized_gates.size());
+        for (u32 i = 0; i < m_levelized_gates.size(); ++i)
+        {
+            if (pending_inputs[i] == 0)
+            {
+                order.push_back(i);
+            }
+        }
+
+        u32 max_level = 0;
+        for (u32 i = 0; i < order.size(); ++i)
+        {
+            const auto& gate = m_levelized_gates[order[i]];
+            max_level        = std::max(max_level, gate.level);
+            for (u32 net_index : gate.output_nets)
+            {
+                for (u32 successor : m_net_comb_successors[net_index])
+                {
+                    m_levelized_gates[successor].level = std::max(m_levelized_gates[successor].level, gate.level + 1);
+                    if (--pending_inputs[successor] == 0)
+                    {
+                        order.push_back(successor);
+                    }
+                }
+            }
+        }
+
+        if (order.size() != m_levelized_gates.size())
+        {
+            log_warning("netlist_simulator", "netlist contains combinational loops, cannot levelize the netlist.");
+            return false;
+        }
+
+        m_dirty_gates_per_level.resize(max_level + 1);
+        m_levelized_results.assign(result_count, SignalValue::X);
+
+        return true;
+    }
+
+    void NetlistSimulator::prepare_clock_events(u64 picoseconds)
+    {
+        // only edges before the end of the simulated period are scheduled, the remaining ones follow in the next call
+        m_clock_timeout = m_current_time + picoseconds;
+        schedule_clock_events();
+    }
+
+    void NetlistSimulator::schedule_clock_events()
+    {
+        for (auto& c : m_clocks)
+        {
+            // the pending edge has been processed, advance to the following one
+            if (c.scheduled && c.next_edge <= m_current_time)
+            {
+                c.next_edge = get_next_clock_edge(c, c.next_edge);
+                c.scheduled = false;
+            }
+
+            if (!c.scheduled && c.next_edge < m_clock_timeout)
+            {
+                Event e;
+                e.affected_net = c.clock_net;
+                e.new_value    = get_clock_value(c, c.next_edge);
+                e.time         = c.next_edge;
+                m_event_queue.push(e);
+                c.scheduled = true;
+            }
+        }
+    }
+
+    SignalValue NetlistSimulator::get_clock_value(const Clock& clock, u64 time) const
+    {
+        u64 offset        = (time + clock.period - clock.phase) % clock.period;
+        SignalValue value = clock.start_at_zero ? SignalValue::ZERO : SignalValue::ONE;
+        return (offset < clock.first_duration) ? value : toggle(value);
+    }
+
+    u64 NetlistSimulator::get_next_clock_edge(const Clock& clock, u64 time) const
+    {
+        u64 offset = (time + clock.period - clock.phase) % clock.period;
+        return (offset < clock.first_duration) ? time + clock.first_duration - offset : time + clock.period - offset;
+    }
+
+    void NetlistSimulator::process_events(u64 timeout)
+    {
+        measure_block_time("NetlistSimulator::process_events(" + std::to_string(timeout) + ")");
+
+        // iteration counter to catch infinite loops
+        u64 total_iterations_for_one_timeslot = 0;
+
+        // strategy: propagate all signals at the current time
+        // THEN evaluate all FFs that were clocked by these signals
+        // hence we need to remember FFs that were clocked
+        std::vector<SimulationGateFF*> ffs;
+        bool ffs_processed = false;
+
+        std::vector<Event> current_events;
+
+        // time spent outside of gate evaluation counts as scheduling
+        u64 profile_start   = get_profile_clock();
+        u64 evaluation_time = 0;
+
+        while (!m_event_queue.empty() || !ffs.empty() || m_vcd_stimulus.is_open())
+        {
+            schedule_vcd_stimulus(timeout);
+
+            m_new_events.clear();
+            m_new_event_indices.clear();
+
+            // queue empty or all events of the current point in time processed?
+            if (m_event_queue.empty() || m_current_time != m_event_queue.get_next_time())
+            {
+                // are there FFs that were clocked? process them now!
+                if (!ffs.empty() && !ffs_processed)
+                {
+                    u64 evaluation_start = get_profile_clock();
+                    for (auto ff : ffs)
+                    {
+                        simulate_ff(ff);
+                    }
+                    evaluation_time += get_profile_clock() - evaluation_start;
+                    ffs.clear();
+                    ffs_processed = true;
+                }
+                else if (m_event_queue.empty())
+                {
+                    // no FFs and queue empty -> simulation is done
+                    break;
+                }
+                else    // no FFs but queue is not empty -> advance point in time
+                {
+                    m_current_time                    = m_event_queue.get_next_time();
+                    total_iterations_for_one_timeslot = 0;
+                    ffs_processed                     = false;
+                }
+            }
+
+            // note: at this point not all events are processed necessarily!
+            // but they are processed when simulation is resumed, so no worries
+            if (m_current_time > timeout)
+            {
+                break;
+            }
+
+            // events before the current point in time are final, write them out and drop the ones that are no longer needed
+            if (m_recorded_events >= m_flush_threshold)
+            {
+                flush_records(m_current_time);
+            }
+
+            // process all events of the current point in time
+            if (m_profiling)
+            {
+                m_profile.queue_high_water_mark = std::max(m_profile.queue_high_water_mark, m_event_queue.size());
+            }
+            current_events.clear();
+            while (!m_event_queue.empty() && m_event_queue.get_next_time() <= m_current_time)
+            {
+                m_event_queue.pop_next_time(current_events);
+            }
+            schedule_clock_events();
+
+            u64 evaluation_start = get_profile_clock();
+            if (m_levelized)
+            {
+                // apply all queued events, then settle the combinational logic at once
+                for (const auto& event : current_events)
+                {
+                    if (auto it = m_net_indices.find(event.affected_net); it != m_net_indices.end())
+                    {
+                        process_levelized_event(it->second, event, ffs);
+                    }
+                    else
+                    {
+                        record_event(m_simulation.m_waveforms[event.affected_net], event);
+                    }
+                }
+                evaluate_levelized_gates(ffs);
+            }
+            else
+            {
+                for (auto& event : current_events)
+                {
+                    auto it = m_net_indices.find(event.affected_net);
+                    if (it == m_net_indices.end())
+                    {
+                        record_event(m_simulation.m_waveforms[event.affected_net], event);
+                        continue;
+                    }
+
+                    u32 net_index = it->second;
+                    if (!record_event(get_net_records(net_index), event))
+                    {
+                        continue;
+                    }
+
+                    // simulate affected gates
+                    // record all FFs that have to be clocked
+                    auto value = static_cast<BooleanFunction::Value>(event.new_value);
+                    for (u32 i = m_successor_offsets[net_index]; i < m_successor_offsets[net_index + 1]; ++i)
+                    {
+                        const auto& successor = m_successors[i];
+                        for (u32 j = successor.pins_begin; j < successor.pins_end; ++j)
+                        {
+                            successor.gate->input_values[m_successor_pins[j]] = value;
+                        }
+                        if (successor.gate->loop_index != ~0u && !check_loop_evaluation(successor.gate->loop_index))
+                        {
+                            continue;
+                        }
+                        if (!simulate_gate(successor.gate, event))
+                        {
+                            ffs.push_back(static_cast<SimulationGateFF*>(successor.gate));
+                        }
+                    }
+                }
+            }
+            evaluation_time += get_profile_clock() - evaluation_start;
+            if (m_profiling)
+            {
+                profile_delta_cycle(current_events.size());
+            }
+
+            // check for iteration limit
+            total_iterations_for_one_timeslot += current_events.size();
+            if (m_timeout_iterations > 0 && total_iterations_for_one_timeslot > m_timeout_iterations)
+            {
+                log_error("netlist_simulator", "reached iteration timeout of {} without advancing in time, aborting simulation. Please check for a combinational loop.", m_timeout_iterations);
+                profile_time(profile_start, evaluation_time);
+                return;
+            }
+
+            // add new events
+            for (const auto& e : m_new_events)
+            {
+                m_event_queue.push(e);
+            }
+        }
+
+        profile_time(profile_start, evaluation_time);
+
+        // adjust point in time
+        m_current_time = timeout;
+    }
+
+    NetlistSimulator::SimulationFunction NetlistSimulator::compile_function(const BooleanFunction& function, const std::vector<std::string>& input_pins)
+    {
+        static const u32 MAX_TABLE_INPUTS = 6;
+
+        SimulationFunction result;
+        result.function = function;
+
+        // only input pins are addressed, all other variables evaluate to X
+        auto variables = function.get_variables();
+        for (u32 i = 0; i < input_pins.size(); ++i)
+        {
+            if (std::find(variables.begin(), variables.end(), input_pins[i]) != variables.end())
+            {
+                result.variables.push_back(input_pins[i]);
+                result.inputs.push_back(i);
+            }
+        }
+
+        if (result.inputs.size() <= MAX_TABLE_INPUTS)
+        {
+            u32 table_size = 1;
+            for (u32 i = 0; i < result.inputs.size(); ++i)
+            {
+                table_size *= 3;
+            }
+            result.truth_table.assign(table_size, 0xFF);
+        }
+
+        return result;
+    }
+
+    bool NetlistSimulator::compile_lut_function(const Gate* gate, const std::vector<std::string>& input_pins, SimulationFunction& function)
+    {
+        // the configuration is kept as a bit table, so the number of inputs is only limited by its size
+        static const u32 MAX_LUT_INPUTS = 20;
+
+        const GateType* type   = gate->get_type();
+        std::string config_str = std::get<1>(gate->get_data(type->get_config_data_category(), type->get_config_data_identifier()));
+        if (config_str.size() > 2 && config_str[0] == '0' && (config_str[1] == 'x' || config_str[1] == 'X'))
+        {
+            config_str = config_str.substr(2);
+        }
+
+        if (input_pins.size() > MAX_LUT_INPUTS)
+        {
+            return false;
+        }
+
+        // bit i of the table holds the output for the inputs encoded as binary number i, the first input pin being the least significant bit
+        u64 table_size = 1ull << input_pins.size();
+        std::vector<u64> table((table_size + 63) / 64, 0);
+        for (u64 digit = 0; digit < config_str.size(); ++digit)
+        {
+            char c    = config_str[config_str.size() - 1 - digit];
+            u64 value = 0;
+            if (c >= '0' && c <= '9')
+            {
+                value = c - '0';
+            }
+            else if (c >= 'a' && c <= 'f')
+            {
+                value = c - 'a' + 10;
+            }
+            else if (c >= 'A' && c <= 'F')
+            {
+                value = c - 'A' + 10;
+            }
+            else
+            {
+                // leave the error handling to the Boolean function of the gate
+                return false;
+            }
+
+            for (u64 bit = 4 * digit; value != 0; ++bit, value >>= 1)
+            {
+                if ((value & 1) == 0)
+                {
+                    continue;
+                }
+                if (bit >= table_size)
+                {
+                    return false;
+                }
+                u64 index = type->is_lut_init_ascending() ? table_size - 1 - bit : bit;
+                table[index >> 6] |= 1ull << (index & 63);
+            }
+        }
+
+        auto get_bit = [&table](u64 index) { return (table[index >> 6] >> (index & 63)) & 1; };
+
+        // drop inputs that do not affect the output, e.g., unconnected inputs of a LUT that implements a smaller function
+        std::vector<u32> support;
+        for (u32 input = 0; input < input_pins.size(); ++input)
+        {
+            u64 mask = 1ull << input;
+            for (u64 index = 0; index < table_size; ++index)
+            {
+                if ((index & mask) == 0 && get_bit(index) != get_bit(index | mask))
+                {
+                    support.push_back(input);
+                    break;
+                }
+            }
+        }
+
+        u64 lut_size = 1ull << support.size();
+        function.lut.assign((lut_size + 63) / 64, 0);
+        for (u64 index = 0; index < lut_size; ++index)
+        {
+            u64 table_index = 0;
+            for (u32 i = 0; i < support.size(); ++i)
+            {
+                table_index |= ((index >> i) & 1) << support[i];
+            }
+            function.lut[index >> 6] |= get_bit(table_index) << (index & 63);
+        }
+
+        for (u32 input : support)
+        {
+            function.variables.push_back(input_pins[input]);
+            function.inputs.push_back(input);
+        }
+
+        return true;
+    }
+
+    BooleanFunction::Value NetlistSimulator::evaluate_lut(const std::vector<u64>& lut, u64 index, u64 unknown_inputs)
+    {
+        auto get_bit = [&lut](u64 i) { return (lut[i >> 6] >> (i & 63)) & 1; };
+
+        if (unknown_inputs == 0)
+        {
+            return get_bit(index) ? BooleanFunction::ONE : BooleanFunction::ZERO;
+        }
+
+        // enumerate all cofactors of the unknown inputs, the result is only known if all of them agree
+        u64 first  = get_bit(index);
+        u64 subset = 0;
+        do
+        {
+            subset = (subset - unknown_inputs) & unknown_inputs;
+            if (get_bit(index | subset) != first)
+            {
+                return BooleanFunction::X;
+            }
+        } while (subset != 0);
+
+        return first ? BooleanFunction::ONE : BooleanFunction::ZERO;
+    }
+
+    BooleanFunction::Value NetlistSimulator::evaluate_function(SimulationFunction& function, const std::vector<BooleanFunction::Value>& input_values)
+    {
+        if (!function.lut.empty())
+        {
+            u64 index          = 0;
+            u64 unknown_inputs = 0;
+            for (u32 i = 0; i < function.inputs.size(); ++i)
+            {
+                auto value = input_values[function.inputs[i]];
+                if (value == BooleanFunction::ONE)
+                {
+                    index |= 1ull << i;
+                }
+                else if (value != BooleanFunction::ZERO)
+                {
+                    unknown_inputs |= 1ull << i;
+                }
+            }
+            return evaluate_lut(function.lut, index, unknown_inputs);
+        }
+
+        // encode the inputs as a base-3 number, signals other than 0, 1, and X are evaluated directly
+        u8* entry = nullptr;
+        if (!function.truth_table.empty())
+        {
+            u32 table_index = 0;
+            u32 factor      = 1;
+            bool known      = true;
+            for (u32 input : function.inputs)
+            {
+                auto value = input_values[input];
+                if (value == BooleanFunction::ONE)
+                {
+                    table_index += factor;
+                }
+                else if (value == BooleanFunction::X)
+                {
+                    table_index += 2 * factor;
+                }
+                else if (value != BooleanFunction::ZERO)
+                {
+                    known = false;
+                    break;
+                }
+                factor *= 3;
+            }
+
+            if (known)
+            {
+                entry = &function.truth_table[table_index];
+                if (*entry != 0xFF)
+                {
+                    return static_cast<BooleanFunction::Value>(*entry);
+                }
+            }
+        }
+
+        std::unordered_map<std::string, BooleanFunction::Value> inputs;
+        for (u32 i = 0; i < function.inputs.size(); ++i)
+        {
+            inputs.emplace(function.variables[i], input_values[function.inputs[i]]);
+        }
+        auto result = function.function.evaluate(inputs);
+
+        if (entry != nullptr)
+        {
+            *entry = static_cast<u8>(result);
+        }
+        return result;
+    }
+
+    bool NetlistSimulator::record_event(Waveform& waveform, const Event& event)
+    {
+        auto& times  = waveform.times;
+        auto& values = waveform.values;
+
+        // is there already a value recorded for the net?
+        if (!values.empty())
+        {
+            // if the event does not change anything, skip it
+            if (values.back() == event.new_value)
+            {
+                return false;
+            }
+            // if the event does change something, but there was already an event for this point in time, we simply update the value
+            else if (times.back() == event.time)
+            {
+                if (m_profiling)
+                {
+                    m_net_glitches[event.affected_net]++;
+                }
+                values.back() = event.new_value;
+                if (values.size() > 1 && values[values.size() - 2] == event.new_value)
+                {
+                    times.pop_back();
+                    values.pop_back();
+                }
+                return true;
+            }
+        }
+
+        // no value recorded or new point in time -> new event
+        times.push_back(event.time);
+        values.push_back(event.new_value);
+        m_recorded_events++;
+        return true;
+    }
+
+    void NetlistSimulator::update_flush_threshold(u64 retained_events)
+    {
+        static const u64 MIN_FLUSH_EVENTS = 4096;
+
+        if (m_history_window == 0 && m_watched_nets.empty() && !m_vcd_stream.is_open())
+        {
+            m_flush_threshold = ~0ull;
+        }
+        else
+        {
+            // flushing is linear in the number of retained events, so wait for at least as many new ones
+            m_flush_threshold = std::max(MIN_FLUSH_EVENTS, retained_events);
+        }
+    }
+
+    void NetlistSimulator::flush_records(u64 end_time)
+    {
+        if (m_vcd_stream.is_open())
+        {
+            write_vcd_stream(end_time);
+        }
+
+        u64 retained_events = trim_records(m_simulation, end_time);
+        if (m_bit_parallel)
+        {
+            for (auto& simulation : m_lane_simulations)
+            {
+                retained_events += trim_records(simulation, end_time);
+            }
+        }
+
+        m_recorded_events = 0;
+        update_flush_threshold(retained_events);
+    }
+
+    u64 NetlistSimulator::trim_records(Simulation& simulation, u64 end_time) const
+    {
+        u64 window_start = (m_history_window != 0 && end_time > m_history_window) ? end_time - m_history_window : 0;
+
+        u64 retained_events = 0;
+        for (auto& [net, waveform] : simulation.m_waveforms)
+        {
+            // unwatched nets only keep their value, events from end_time on may still change though
+            u64 keep_from = window_start;
+            if (!m_watched_nets.empty() && m_watched_nets.find(net) == m_watched_nets.end())
+            {
+                keep_from = end_time;
+            }
+
+            // keep the last event before, it holds the value at that point in time
+            if (keep_from != 0)
+            {
+                u32 keep_index = std::lower_bound(waveform.times.begin(), waveform.times.end(), keep_from) - waveform.times.begin();
+                if (keep_index > 1)
+                {
+                    waveform.times.erase(waveform.times.begin(), waveform.times.begin() + keep_index - 1);
+                    waveform.values.erase(waveform.values.begin(), waveform.values.begin() + keep_index - 1);
+                }
+            }
+            retained_events += waveform.times.size();
+        }
+        return retained_events;
+    }
+
+    void NetlistSimulator::write_vcd_stream(u64 end_time)
+    {
+        // gather all changes in [m_vcd_stream_time, end_time) sorted by time and net
+        std::vector<std::tuple<u64, u32, SignalValue>> changes;
+        for (Net* net : m_vcd_stream_nets)
+        {
+            const Waveform& waveform = m_simulation.get_waveform(net);
+            auto [first, last]       = waveform.get_range(m_vcd_stream_time, end_time);
+            for (u32 i = first; i < last; ++i)
+            {
+                changes.emplace_back(waveform.times[i], net->get_id(), waveform.values[i]);
+            }
+        }
+        std::sort(changes.begin(), changes.end());
+
+        u64 last_time = ~0ull;
+        for (const auto& [time, net_id, value] : changes)
+        {
+            if (time != last_time)
+            {
+                m_vcd_stream << "#" << time << "\n";
+                last_time = time;
+            }
+
+            if (value == SignalValue::ZERO)
+            {
+                m_vcd_stream << "0n" << net_id << "\n";
+            }
+            else if (value == SignalValue::ONE)
+            {
+                m_vcd_stream << "1n" << net_id << "\n";
+            }
+            else if (value == SignalValue::Z)
+            {
+                m_vcd_stream << "zn" << net_id << "\n";
+            }
+            else
+            {
+                m_vcd_stream << "xn" << net_id << "\n";
+            }
+        }
+        m_vcd_stream.flush();
+
+        m_vcd_stream_time = end_time;
+    }
+
+    void NetlistSimulator::schedule_vcd_stimulus(u64 timeout)
+    {
+        // changes are read until they cover the next pending event, but at most until the end of the simulated period
+        while (m_vcd_stimulus.is_open() && m_vcd_stimulus_time <= timeout && m_event_queue.get_next_time() >= m_vcd_stimulus_time)
+        {
+            read_vcd_stimulus(timeout);
+        }
+    }
+
+    void NetlistSimulator::read_vcd_stimulus(u64 timeout)
+    {
+        static const u32 CHUNK_EVENTS = 1 << 16;
+
+        auto to_signal_value = [](char c) {
+            if (c == '0')
+            {
+                return SignalValue::ZERO;
+            }
+            else if (c == '1')
+            {
+                return SignalValue::ONE;
+            }
+            else if (c == 'z' || c == 'Z')
+            {
+                return SignalValue::Z;
+            }
+            return SignalValue::X;
+        };
+
+        Event e;
+        e.time = m_vcd_stimulus_time;
+
+        std::string token;
+        std::string identifier;
+        u32 events = 0;
+        while (events < CHUNK_EVENTS && m_vcd_stimulus >> token)
+        {
+            if (token[0] == '#')
+            {
+                u64 time = 0;
+                if (parse_unsigned(token, 1, time) == 0)
+                {
+                    log_error("netlist_simulator", "invalid timestamp '{}' in VCD stimulus.", token);
+                    stop_vcd_stimulus();
+                    return;
+                }
+                m_vcd_stimulus_time = std::max(m_vcd_stimulus_time, m_vcd_stimulus_offset + time * m_vcd_stimulus_scale / 1000);
+                e.time              = m_vcd_stimulus_time;
+
+                // the remaining changes are read during the next call to simulate
+                if (m_vcd_stimulus_time > timeout)
+                {
+                    return;
+                }
+            }
+            else if (token[0] == '$')
+            {
+                // $dumpvars, $dumpall, $dumpon, $dumpoff, and $end do not affect the values
+                if (token == "$comment")
+                {
+                    while (m_vcd_stimulus >> token && token != "$end")
+                    {
+                    }
+                }
+            }
+            else if (token[0] == 'b' || token[0] == 'B' || token[0] == 'r' || token[0] == 'R')
+            {
+                m_vcd_stimulus >> identifier;
+                auto it = m_vcd_stimulus_signals.find(identifier);
+                if (it == m_vcd_stimulus_signals.end() || token[0] == 'r' || token[0] == 'R')
+                {
+                    continue;
+                }
+
+                // shorter vectors are extended by 0, unless their leftmost bit is X or Z
+                u32 length     = token.size() - 1;
+                char extension = (length == 0 || token[1] == '1') ? '0' : token[1];
+                for (const auto& [bit, net] : it->second.bits)
+                {
+                    e.affected_net = net;
+                    e.new_value    = to_signal_value((bit < length) ? token[length - bit] : extension);
+                    m_event_queue.push(e);
+                    events++;
+                }
+            }
+            else if (auto it = m_vcd_stimulus_signals.find(token.substr(1)); it != m_vcd_stimulus_signals.end())
+            {
+                for (const auto& [bit, net] : it->second.bits)
+                {
+                    e.affected_net = net;
+                    e.new_value    = to_signal_value(token[0]);
+                    m_event_queue.push(e);
+                    events++;
+                }
+            }
+        }
+
+        if (events < CHUNK_EVENTS)
+        {
+            // the whole file has been read
+            stop_vcd_stimulus();
+            m_vcd_stimulus_time = ~0ull;
+        }
+    }
+
+    Waveform& NetlistSimulator::get_net_records(u32 net_index)
+    {
+        auto& records = m_net_records[net_index];
+        if (records == nullptr)
+        {
+            records = &m_simulation.m_waveforms[m_nets[net_index]];
+        }
+        return *records;
+    }
+
+    void NetlistSimulator::process_levelized_event(u32 net_index, const Event& event, std::vector<SimulationGateFF*>& ffs)
+    {
+        if (!record_event(get_net_records(net_index), event))
+        {
+            return;
+        }
+
+        m_net_values[net_index] = event.new_value;
+
+        // combinational successors are evaluated later on in topological order
+        for (u32 successor : m_net_comb_successors[net_index])
+        {
+            auto& gate = m_levelized_gates[successor];
+            if (!gate.dirty)
+            {
+                gate.dirty = true;
+                m_dirty_gates_per_level[gate.level].push_back(successor);
             }
+        }
 
-            SimulationGate* sim_gate_base = nullptr;
+        // flip-flops are handled just like in event-driven mode
+        auto value = static_cast<BooleanFunction::Value>(event.new_value);
+        for (u32 i = m_successor_offsets[net_index]; i < m_successor_offsets[net_index + 1]; ++i)
+        {
+            const auto& successor = m_successors[i];
+            if (!successor.gate->is_flip_flop)
+            {
+                continue;
+            }
+            for (u32 j = successor.pins_begin; j < successor.pins_end; ++j)
+            {
+                successor.gate->input_values[m_successor_pins[j]] = value;
+            }
+            Event ff_event = event;
+            if (!simulate_gate(successor.gate, ff_event))
+            {
+                ffs.push_back(static_cast<SimulationGateFF*>(successor.gate));
+            }
+        }
+    }
 
-            if (gate->get_type()->has_property(GateTypeProperty::ff))
+    void NetlistSimulator::evaluate_levelized_gate(u32 gate_index)
+    {
+        static const u32 INVALID_INDEX = ~0u;
+
+        auto& gate = m_levelized_gates[gate_index];
+        if (m_profiling)
+        {
+            gate.gate->evaluations++;
+        }
+
+        auto& input_values = gate.gate->input_values;
+        for (u32 i = 0; i < gate.input_nets.size(); ++i)
+        {
+            SignalValue value = (gate.input_nets[i] != INVALID_INDEX) ? m_net_values[gate.input_nets[i]] : SignalValue::X;
+            input_values[i]   = static_cast<BooleanFunction::Value>(value);
+        }
+
+        for (u32 i = 0; i < gate.output_nets.size(); ++i)
+        {
+            m_levelized_results[gate.first_result + i] = static_cast<SignalValue>(evaluate_function(gate.gate->functions[i], input_values));
+        }
+    }
+
+    void NetlistSimulator::evaluate_levelized_gates(std::vector<SimulationGateFF*>& ffs)
+    {
+        static const i32 MIN_PARALLEL_GATES = 64;
+
+        Event event;
+        event.time = m_current_time;
+        event.id   = 0;
+
+        for (auto& dirty_gates : m_dirty_gates_per_level)
+        {
+            // gates of the same level do not depend on each other, so they can be evaluated in parallel
+            i32 dirty_count = dirty_gates.size();
+            if (m_thread_count > 1 && dirty_count >= MIN_PARALLEL_GATES)
             {
-                auto sim_gate_owner = std::make_unique<SimulationGateFF>();
-                auto sim_gate       = sim_gate_owner.get();
-                sim_gate_base       = sim_gate;
-                m_sim_gates.push_back(std::move(sim_gate_owner));
-                sim_gate->is_flip_flop = true;
-                sim_gate->input_pins   = input_pins;
-                sim_gate->input_nets   = input_nets;
-                for (auto pin : input_pins)
+#pragma omp parallel for num_threads(m_thread_count) schedule(static)
+                for (i32 i = 0; i < dirty_count; ++i)
+                {
+                    evaluate_levelized_gate(dirty_gates[i]);
+                }
+            }
+            else
+            {
+                for (u32 gate_index : dirty_gates)
                 {
-                    sim_gate->input_values[pin] = BooleanFunction::X;
+                    evaluate_levelized_gate(gate_index);
                 }
+            }
 
-                auto gate_type            = gate->get_type();
-                sim_gate->clock_func      = gate->get_boolean_function("clock");
-                sim_gate->preset_func     = gate->get_boolean_function("preset");
-                sim_gate->clear_func      = gate->get_boolean_function("clear");
-                sim_gate->next_state_func = gate->get_boolean_function("next_state");
-                for (auto pin : gate_type->get_pins_of_type(PinType::state))
+            for (u32 gate_index : dirty_gates)
+            {
+                auto& gate = m_levelized_gates[gate_index];
+                gate.dirty = false;
+
+                for (u32 j = 0; j < gate.output_nets.size(); ++j)
                 {
-                    if (Net* net = gate->get_fan_out_net(pin); net != nullptr)
+                    event.new_value    = m_levelized_results[gate.first_result + j];
+                    event.affected_net = m_nets[gate.output_nets[j]];
+                    process_levelized_event(gate.output_nets[j], event, ffs);
+                }
+            }
+            dirty_gates.clear();
+        }
+    }
+
+    bool NetlistSimulator::initialize_bit_parallel()
+    {
+        measure_block_time("NetlistSimulator::initialize_bit_parallel()");
+
+        // truth tables are shared between all gates with the same function and pins
+        std::unordered_map<std::string, std::pair<std::vector<LaneFunction::Node>, u32>> cache;
+
+        m_lane_gates.clear();
+        m_lane_gates.reserve(m_levelized_gates.size());
+        for (const auto& gate : m_levelized_gates)
+        {
+            LaneGate lane_gate;
+            lane_gate.dirty_lanes = 0;
+            for (const auto& function : gate.gate->functions)
+            {
+                lane_gate.functions.push_back(compile_lane_function(function, gate.gate->input_nets, cache));
+            }
+            m_lane_gates.push_back(std::move(lane_gate));
+        }
+
+        m_lane_ffs.clear();
+        m_net_lane_ff_successors.assign(m_nets.size(), {});
+        std::unordered_map<SimulationGateFF*, u32> ff_indices;
+        for (const auto& sim_gate : m_sim_gates)
+        {
+            if (!sim_gate->is_flip_flop)
+            {
+                continue;
+            }
+            auto ff = static_cast<SimulationGateFF*>(sim_gate.get());
+            ff_indices.emplace(ff, m_lane_ffs.size());
+
+            LaneFF lane_ff;
+            lane_ff.gate            = ff;
+            lane_ff.clock_func      = compile_lane_function(ff->clock_func, ff->input_nets, cache);
+            lane_ff.clear_func      = compile_lane_function(ff->clear_func, ff->input_nets, cache);
+            lane_ff.preset_func     = compile_lane_function(ff->preset_func, ff->input_nets, cache);
+            lane_ff.next_state_func = compile_lane_function(ff->next_state_func, ff->input_nets, cache);
+            for (auto net : ff->state_output_nets)
+            {
+                lane_ff.state_output_nets.push_back(m_net_indices.at(net));
+            }
+            for (auto net : ff->state_inverted_output_nets)
+            {
+                lane_ff.state_inverted_output_nets.push_back(m_net_indices.at(net));
+            }
+            m_lane_ffs.push_back(std::move(lane_ff));
+        }
+
+        for (u32 net_index = 0; net_index < m_nets.size(); ++net_index)
+        {
+            for (u32 i = m_successor_offsets[net_index]; i < m_successor_offsets[net_index + 1]; ++i)
+            {
+                if (!m_successors[i].gate->is_flip_flop)
+                {
+                    continue;
+                }
+                auto ff       = static_cast<SimulationGateFF*>(m_successors[i].gate);
+                bool is_clock = std::find(ff->clock_nets.begin(), ff->clock_nets.end(), m_nets[net_index]) != ff->clock_nets.end();
+                m_net_lane_ff_successors[net_index].emplace_back(ff_indices.at(ff), is_clock);
+            }
+        }
+
+        m_lane_results.assign(m_levelized_results.size(), {0, 0});
+        m_lane_net_values.assign(m_nets.size(), {0, 0});
+        m_lane_recorded_values.assign(m_nets.size(), {0, 0});
+        m_lane_recorded_lanes.assign(m_nets.size(), 0);
+        m_lane_net_records.assign(m_nets.size() * LANE_COUNT, nullptr);
+        m_lane_records_outdated = true;
+        m_lane_new_events.clear();
+        m_lane_new_event_indices.clear();
+
+        return true;
+    }
+
+    NetlistSimulator::LaneFunction NetlistSimulator::compile_lane_function(const SimulationFunction& function,
+                                                                           const std::vector<Net*>& input_nets,
+                                                                           std::unordered_map<std::string, std::pair<std::vector<LaneFunction::Node>, u32>>& cache)
+    {
+        static const u32 INVALID_INDEX    = ~0u;
+        static const u32 MAX_TABLE_INPUTS = 6;
+
+        LaneFunction result;
+        result.function  = &function;
+        result.variables = function.variables;
+        result.result    = 2;
+
+        std::string key = function.function.to_string();
+        if (!function.lut.empty())
+        {
+            key = "LUT";
+            for (u64 word : function.lut)
+            {
+                key += ":" + std::to_string(word);
+            }
+        }
+        for (u32 i = 0; i < function.inputs.size(); ++i)
+        {
+            auto it = m_net_indices.find(input_nets[function.inputs[i]]);
+            result.input_nets.push_back((it != m_net_indices.end()) ? it->second : INVALID_INDEX);
+            key += "|" + function.variables[i];
+        }
+
+        if (result.variables.size() > MAX_TABLE_INPUTS)
+        {
+            return result;
+        }
+
+        if (auto it = cache.find(key); it != cache.end())
+        {
+            result.nodes  = it->second.first;
+            result.result = it->second.second;
+            return result;
+        }
+
+        // evaluate the function for all combinations of 0/1/X inputs, the first variable is the least significant base-3 digit
+        u32 table_size = 1;
+        for (u32 i = 0; i < result.variables.size(); ++i)
+        {
+            table_size *= 3;
+        }
+        std::vector<u32> table(table_size);
+        std::unordered_map<std::string, BooleanFunction::Value> inputs;
+        for (u32 index = 0; index < table_size; ++index)
+        {
+            u32 remaining      = index;
+            u64 lut_index      = 0;
+            u64 unknown_inputs = 0;
+            for (u32 i = 0; i < result.variables.size(); ++i)
+            {
+                u32 digit                   = remaining % 3;
+                remaining                   = remaining / 3;
+                inputs[result.variables[i]] = (digit == 2) ? BooleanFunction::X : static_cast<BooleanFunction::Value>(digit);
+                lut_index |= static_cast<u64>(digit == 1) << i;
+                unknown_inputs |= static_cast<u64>(digit == 2) << i;
+            }
+            auto value   = function.lut.empty() ? function.function.evaluate(inputs) : evaluate_lut(function.lut, lut_index, unknown_inputs);
+            table[index] = (value == BooleanFunction::ZERO) ? 0 : ((value == BooleanFunction::ONE) ? 1 : 2);
+        }
+
+        // build the decision diagram bottom-up, sharing identical nodes and skipping nodes that do not depend on their input
+        std::map<std::tuple<u32, u32, u32, u32>, u32> unique_nodes;
+        std::function<u32(u32, u32, u32)> build = [&](u32 variable, u32 offset, u32 stride) -> u32 {
+            if (variable == 0)
+            {
+                return table[offset];
+            }
+            u32 child_stride = stride / 3;
+            u32 if_zero      = build(variable - 1, offset, child_stride);
+            u32 if_one       = build(variable - 1, offset + child_stride, child_stride);
+            u32 if_x         = build(variable - 1, offset + 2 * child_stride, child_stride);
+            if (if_zero == if_one && if_one == if_x)
+            {
+                return if_zero;
+            }
+            auto [it, inserted] = unique_nodes.emplace(std::make_tuple(variable - 1, if_zero, if_one, if_x), 3 + result.nodes.size());
+            if (inserted)
+            {
+                result.nodes.push_back({variable - 1, if_zero, if_one, if_x});
+            }
+            return it->second;
+        };
+        result.result = build(result.variables.size(), 0, table_size);
+
+        cache.emplace(key, std::make_pair(result.nodes, result.result));
+        return result;
+    }
+
+    NetlistSimulator::LaneValues NetlistSimulator::evaluate_lane_function(const LaneFunction& function, std::vector<LaneValues>& nodes) const
+    {
+        static const u32 INVALID_INDEX    = ~0u;
+        static const u32 MAX_TABLE_INPUTS = 6;
+
+        // too many inputs for a truth table, evaluate every lane on its own
+        if (function.variables.size() > MAX_TABLE_INPUTS)
+        {
+            LaneValues result = {0, 0};
+            std::unordered_map<std::string, BooleanFunction::Value> inputs;
+            for (u32 lane = 0; lane < LANE_COUNT; ++lane)
+            {
+                u64 mask = 1ull << lane;
+                BooleanFunction::Value value;
+                if (const auto& lut = function.function->lut; !lut.empty())
+                {
+                    u64 lut_index      = 0;
+                    u64 unknown_inputs = 0;
+                    for (u32 i = 0; i < function.variables.size(); ++i)
                     {
-                        sim_gate->state_output_nets.push_back(gate->get_fan_out_net(pin));
+                        LaneValues values = (function.input_nets[i] != INVALID_INDEX) ? m_lane_net_values[function.input_nets[i]] : LaneValues{0, 0};
+                        lut_index |= static_cast<u64>((values.one & mask) != 0) << i;
+                        unknown_inputs |= static_cast<u64>(((values.one | values.zero) & mask) == 0) << i;
                     }
+                    value = evaluate_lut(lut, lut_index, unknown_inputs);
                 }
-                for (auto pin : gate_type->get_pins_of_type(PinType::neg_state))
+                else
                 {
-                    if (Net* net = gate->get_fan_out_net(pin); net != nullptr)
+                    for (u32 i = 0; i < function.variables.size(); ++i)
                     {
-                        sim_gate->state_inverted_output_nets.push_back(gate->get_fan_out_net(pin));
+                        LaneValues values             = (function.input_nets[i] != INVALID_INDEX) ? m_lane_net_values[function.input_nets[i]] : LaneValues{0, 0};
+                        inputs[function.variables[i]] = (values.one & mask) ? BooleanFunction::ONE : ((values.zero & mask) ? BooleanFunction::ZERO : BooleanFunction::X);
                     }
+                    value = function.function->function.evaluate(inputs);
                 }
-                for (auto pin : gate_type->get_pins_of_type(PinType::clock))
+                if (value == BooleanFunction::ONE)
                 {
-                    sim_gate->clock_nets.push_back(gate->get_fan_in_net(pin));
+                    result.one |= mask;
+                }
+                else if (value == BooleanFunction::ZERO)
+                {
+                    result.zero |= mask;
                 }
-                auto behavior                      = gate_type->get_clear_preset_behavior();
-                sim_gate->sr_behavior_out          = behavior.first;
-                sim_gate->sr_behavior_out_inverted = behavior.second;
             }
-            else if (gate->get_type()->has_property(GateTypeProperty::combinational))
+            return result;
+        }
+
+        nodes.resize(3 + function.nodes.size());
+        nodes[0] = {0, ~0ull};
+        nodes[1] = {~0ull, 0};
+        nodes[2] = {0, 0};
+        for (u32 i = 0; i < function.nodes.size(); ++i)
+        {
+            const auto& node  = function.nodes[i];
+            u32 net_index     = function.input_nets[node.input];
+            LaneValues select = (net_index != INVALID_INDEX) ? m_lane_net_values[net_index] : LaneValues{0, 0};
+            u64 select_x      = ~(select.one | select.zero);
+
+            const auto& if_zero = nodes[node.if_zero];
+            const auto& if_one  = nodes[node.if_one];
+            const auto& if_x    = nodes[node.if_x];
+            nodes[3 + i].one    = (select.zero & if_zero.one) | (select.one & if_one.one) | (select_x & if_x.one);
+            nodes[3 + i].zero   = (select.zero & if_zero.zero) | (select.one & if_one.zero) | (select_x & if_x.zero);
+        }
+        return nodes[function.result];
+    }
+
+    Waveform& NetlistSimulator::get_lane_records(u32 net_index, u32 lane)
+    {
+        auto& records = m_lane_net_records[net_index * LANE_COUNT + lane];
+        if (records == nullptr)
+        {
+            records = &get_lane_simulation(lane).m_waveforms[m_nets[net_index]];
+        }
+        return *records;
+    }
+
+    void NetlistSimulator::load_lane_records()
+    {
+        // the recorded values, which are also the current values of the nets, are recovered from the events of every lane
+        for (u32 net_index = 0; net_index < m_nets.size(); ++net_index)
+        {
+            LaneValues& recorded             = m_lane_recorded_values[net_index];
+            recorded                         = {0, 0};
+            m_lane_recorded_lanes[net_index] = 0;
+            for (u32 lane = 0; lane < LANE_COUNT; ++lane)
             {
-                auto sim_gate_owner = std::make_unique<SimulationGateCombinational>();
-                auto sim_gate       = sim_gate_owner.get();
-                sim_gate_base       = sim_gate;
-                m_sim_gates.push_back(std::move(sim_gate_owner));
-                sim_gate->is_flip_flop = false;
-                sim_gate->input_pins   = input_pins;
-                sim_gate->input_nets   = input_nets;
-                for (auto pin : input_pins)
+                auto& waveforms = get_lane_simulation(lane).m_waveforms;
+                auto it         = waveforms.find(m_nets[net_index]);
+                if (it == waveforms.end() || it->second.values.empty())
                 {
-                    sim_gate->input_values[pin] = BooleanFunction::X;
+                    continue;
                 }
+                m_lane_net_records[net_index * LANE_COUNT + lane] = &it->second;
 
-                auto all_functions = gate->get_boolean_functions();
+                u64 mask = 1ull << lane;
+                m_lane_recorded_lanes[net_index] |= mask;
+                if (it->second.values.back() == SignalValue::ONE)
+                {
+                    recorded.one |= mask;
+                }
+                else if (it->second.values.back() == SignalValue::ZERO)
+                {
+                    recorded.zero |= mask;
+                }
+            }
+            m_lane_net_values[net_index] = recorded;
+        }
+        m_lane_records_outdated = false;
+    }
 
-                sim_gate->output_pins = gate->get_output_pins();
+    u64 NetlistSimulator::get_next_lane_event_time() const
+    {
+        u64 next_time = m_event_queue.empty() ? ~0ull : m_event_queue.get_next_time();
+        for (const auto& input : m_lane_inputs)
+        {
+            next_time = std::min(next_time, input.time);
+        }
+        for (const auto& flip : m_lane_flips)
+        {
+            next_time = std::min(next_time, flip.time);
+        }
+        return next_time;
+    }
 
-                for (auto pin : sim_gate->output_pins)
-                {
-                    auto out_net = gate->get_fan_out_net(pin);
-                    sim_gate->output_nets.push_back(out_net);
+    void NetlistSimulator::process_lane_events(u64 timeout)
+    {
+        measure_block_time("NetlistSimulator::process_lane_events(" + std::to_string(timeout) + ")");
 
-                    auto func = all_functions.at(pin);
+        if (m_lane_records_outdated)
+        {
+            load_lane_records();
+        }
 
-                    while (true)
+        // iteration counter to catch infinite loops
+        u64 total_iterations_for_one_timeslot = 0;
+
+        // same strategy as in process_events, but every lane keeps track of its clocked FFs on its own
+        std::vector<std::pair<u32, u64>> ffs;
+        u64 ffs_processed = 0;
+
+        std::vector<Event> current_events;
+        std::vector<LaneEvent> current_lane_events;
+
+        // time spent outside of gate evaluation counts as scheduling
+        u64 profile_start   = get_profile_clock();
+        u64 evaluation_time = 0;
+
+        while (!m_event_queue.empty() || !m_lane_inputs.empty() || !m_lane_flips.empty() || !m_lane_new_events.empty() || !ffs.empty() || m_vcd_stimulus.is_open())
+        {
+            schedule_vcd_stimulus(timeout);
+
+            // all events of the current point in time processed?
+            u64 next_time = get_next_lane_event_time();
+            if (m_lane_new_events.empty() && m_current_time != next_time)
+            {
+                // are there lanes with FFs that were clocked? process them now!
+                u64 lanes = 0;
+                for (const auto& [ff_index, ff_lanes] : ffs)
+                {
+                    lanes |= ff_lanes;
+                }
+                lanes &= ~ffs_processed;
+
+                if (lanes != 0)
+                {
+                    u64 evaluation_start = get_profile_clock();
+                    for (auto& [ff_index, ff_lanes] : ffs)
                     {
-                        auto vars = func.get_variables();
-                        bool exit = true;
-                        for (auto other_pin : sim_gate->output_pins)
-                        {
-                            if (std::find(vars.begin(), vars.end(), other_pin) != vars.end())
-                            {
-                                func = func.substitute(other_pin, all_functions.at(other_pin));
-                                exit = false;
-                            }
-                        }
-                        if (exit)
+                        if ((ff_lanes & lanes) != 0)
                         {
-                            break;
+                            simulate_lane_ff(ff_index, ff_lanes & lanes);
+                            ff_lanes &= ~lanes;
                         }
                     }
+                    evaluation_time += get_profile_clock() - evaluation_start;
+                    ffs.erase(std::remove_if(ffs.begin(), ffs.end(), [](const auto& ff) { return ff.second == 0; }), ffs.end());
+                    ffs_processed |= lanes;
+                }
+                else if (next_time == ~0ull)
+                {
+                    // no FFs and no pending events -> simulation is done
+                    break;
+                }
+                else    // no FFs but events are pending -> advance point in time
+                {
+                    m_current_time                    = next_time;
+                    total_iterations_for_one_timeslot = 0;
+                    ffs_processed                     = 0;
+                }
+            }
+
+            // note: at this point not all events are processed necessarily!
+            // but they are processed when simulation is resumed, so no worries
+            if (m_current_time > timeout)
+            {
+                break;
+            }
+
+            // events before the current point in time are final, write them out and drop the ones that are no longer needed
+            if (m_recorded_events >= m_flush_threshold)
+            {
+                flush_records(m_current_time);
+            }
+
+            // process all events of the current point in time
+            if (m_profiling)
+            {
+                m_profile.queue_high_water_mark = std::max(m_profile.queue_high_water_mark, m_event_queue.size());
+            }
+            current_events.clear();
+            while (!m_event_queue.empty() && m_event_queue.get_next_time() <= m_current_time)
+            {
+                m_event_queue.pop_next_time(current_events);
+            }
+            schedule_clock_events();
+            current_lane_events.clear();
+            std::swap(current_lane_events, m_lane_new_events);
+            m_lane_new_event_indices.clear();
+
+            u64 processed_inputs = 0;
+            for (const auto& input : m_lane_inputs)
+            {
+                if (input.time > m_current_time)
+                {
+                    continue;
+                }
+                processed_inputs++;
+
+                LaneValues values = {0, 0};
+                if (input.value == SignalValue::ONE)
+                {
+                    values.one = ~0ull;
+                }
+                else if (input.value == SignalValue::ZERO)
+                {
+                    values.zero = ~0ull;
+                }
+
+                if (auto it = m_net_indices.find(input.net); it != m_net_indices.end())
+                {
+                    process_lane_event(it->second, values, 1ull << input.lane, input.time, ffs);
+                }
+                else
+                {
+                    Event event;
+                    event.affected_net = input.net;
+                    event.new_value    = input.value;
+                    event.time         = input.time;
+                    record_event(get_lane_simulation(input.lane).m_waveforms[input.net], event);
+                }
+            }
+            if (processed_inputs != 0)
+            {
+                m_lane_inputs.erase(std::remove_if(m_lane_inputs.begin(), m_lane_inputs.end(), [this](const auto& input) { return input.time <= m_current_time; }), m_lane_inputs.end());
+            }
+
+            // injected bit flips invert the current value in their lanes, X stays X
+            u64 processed_flips = 0;
+            for (const auto& flip : m_lane_flips)
+            {
+                if (flip.time > m_current_time)
+                {
+                    continue;
+                }
+                processed_flips++;
+
+                const LaneValues& current = m_lane_net_values[flip.net_index];
+                process_lane_event(flip.net_index, {current.zero, current.one}, flip.lanes, m_current_time, ffs);
+            }
+            if (processed_flips != 0)
+            {
+                m_lane_flips.erase(std::remove_if(m_lane_flips.begin(), m_lane_flips.end(), [this](const auto& flip) { return flip.time <= m_current_time; }), m_lane_flips.end());
+            }
 
-                    sim_gate->functions.emplace(out_net, func);
+            for (const auto& event : current_events)
+            {
+                if (auto it = m_net_indices.find(event.affected_net); it != m_net_indices.end())
+                {
+                    LaneValues values = {0, 0};
+                    if (event.new_value == SignalValue::ONE)
+                    {
+                        values.one = ~0ull;
+                    }
+                    else if (event.new_value == SignalValue::ZERO)
+                    {
+                        values.zero = ~0ull;
+                    }
+                    process_lane_event(it->second, values, ~0ull, event.time, ffs);
+                }
+                else
+                {
+                    for (u32 lane = 0; lane < LANE_COUNT; ++lane)
+                    {
+                        record_event(get_lane_simulation(lane).m_waveforms[event.affected_net], event);
+                    }
                 }
             }
-            else
+
+            for (const auto& event : current_lane_events)
             {
-                log_error("netlist_simulator", "no support for gate type {} of gate {}.", gate->get_type()->get_name(), gate->get_name());
-                m_successors.clear();
-                m_sim_gates.clear();
+                process_lane_event(event.net_index, event.values, event.lanes, m_current_time, ffs);
+            }
+
+            u64 evaluation_start = get_profile_clock();
+            evaluate_lane_gates(ffs);
+            evaluation_time += get_profile_clock() - evaluation_start;
+            if (m_profiling)
+            {
+                profile_delta_cycle(processed_inputs + processed_flips + current_events.size() + current_lane_events.size());
+            }
+
+            // check for iteration limit
+            total_iterations_for_one_timeslot += processed_inputs + processed_flips + current_events.size() + current_lane_events.size();
+            if (m_timeout_iterations > 0 && total_iterations_for_one_timeslot > m_timeout_iterations)
+            {
+                log_error("netlist_simulator", "reached iteration timeout of {} without advancing in time, aborting simulation. Please check for a combinational loop.", m_timeout_iterations);
+                profile_time(profile_start, evaluation_time);
                 return;
             }
+        }
 
-            sim_gate_base->gate = gate;
+        profile_time(profile_start, evaluation_time);
 
-            sim_gates_map.emplace(gate, sim_gate_base);
+        // adjust point in time
+        m_current_time = timeout;
+    }
 
-            auto out_nets = gate->get_fan_out_nets();
-            all_nets.insert(out_nets.begin(), out_nets.end());
+    void NetlistSimulator::process_lane_event(u32 net_index, LaneValues values, u64 lanes, u64 time, std::vector<std::pair<u32, u64>>& ffs)
+    {
+        // nets with a stuck-at fault keep their value regardless of the driver
+        if (!m_lane_stuck_lanes.empty())
+        {
+            u64 stuck                = m_lane_stuck_lanes[net_index];
+            const LaneValues& forced = m_lane_stuck_values[net_index];
+            values.one               = (values.one & ~stuck) | forced.one;
+            values.zero              = (values.zero & ~stuck) | forced.zero;
         }
 
-        all_nets.insert(m_input_nets.begin(), m_input_nets.end());
+        // only lanes in which the recorded value changes are processed
+        LaneValues& recorded = m_lane_recorded_values[net_index];
+        u64 changed          = lanes & (~m_lane_recorded_lanes[net_index] | (recorded.one ^ values.one) | (recorded.zero ^ values.zero));
+        if (changed == 0)
+        {
+            return;
+        }
 
-        // find all successors of nets and transform them to their respective simulation gate instance
-        for (auto net : all_nets)
+        Event event;
+        event.affected_net = m_nets[net_index];
+        event.time         = time;
+        for (u64 remaining = changed; remaining != 0; remaining &= remaining - 1)
         {
-            if (auto it = m_successors.find(net); it != m_successors.end())
+            u32 lane = __builtin_ctzll(remaining);
+            u64 mask = 1ull << lane;
+            if (values.one & mask)
             {
-                continue;
+                event.new_value = SignalValue::ONE;
             }
-            auto endpoints = net->get_destinations();
-            std::unordered_map<Gate*, std::vector<std::string>> affected_pins;
-            for (auto ep : endpoints)
+            else if (values.zero & mask)
             {
-                auto gate = ep->get_gate();
-                affected_pins[gate].push_back(ep->get_pin());
+                event.new_value = SignalValue::ZERO;
+            }
+            else
+            {
+                event.new_value = SignalValue::X;
             }
+            record_event(get_lane_records(net_index, lane), event);
+        }
+
+        recorded.one  = (recorded.one & ~changed) | (values.one & changed);
+        recorded.zero = (recorded.zero & ~changed) | (values.zero & changed);
+        m_lane_recorded_lanes[net_index] |= changed;
+
+        LaneValues& current = m_lane_net_values[net_index];
+        current.one         = (current.one & ~changed) | (values.one & changed);
+        current.zero        = (current.zero & ~changed) | (values.zero & changed);
 
-            for (auto it : affected_pins)
+        // combinational successors are evaluated later on in topological order, only in the lanes that changed
+        for (u32 successor : m_net_comb_successors[net_index])
+        {
+            auto& gate = m_lane_gates[successor];
+            if (gate.dirty_lanes == 0)
             {
-                auto gate  = it.first;
-                auto& pins = it.second;
-                if (m_simulation_set.find(gate) == m_simulation_set.end())
-                {
-                    continue;
-                }
-                auto sim_gate = sim_gates_map.at(gate);
-                m_successors[net].emplace_back(sim_gate, pins);
+                m_dirty_gates_per_level[m_levelized_gates[successor].level].push_back(successor);
             }
+            gate.dirty_lanes |= changed;
         }
 
-        // create one-time events for global gnd and vcc gates
-        for (auto g : m_simulation_set)
+        for (const auto& [ff_index, is_clock] : m_net_lane_ff_successors[net_index])
         {
-            if (g->is_gnd_gate())
+            const auto& ff = m_lane_ffs[ff_index];
+            if (is_clock)
             {
-                for (auto n : g->get_fan_out_nets())
+                // remember the lanes in which the FF is clocked to process it later
+                u64 clocked = changed & evaluate_lane_function(ff.clock_func, m_lane_function_nodes).one;
+                if (clocked != 0)
                 {
-                    Event e;
-                    e.affected_net = n;
-                    e.new_value    = SignalValue::ZERO;
-                    e.time         = m_current_time;
-                    m_event_queue.push_back(e);
+                    ffs.emplace_back(ff_index, clocked);
                 }
             }
-            else if (g->is_vcc_gate())
+            else    // not a clock pin -> only check for asynchronous signals
             {
-                for (auto n : g->get_fan_out_nets())
+                LaneValues result;
+                LaneValues inv_result;
+                u64 active = simulate_lane_ff_clear_preset(ff, changed, result, inv_result);
+                if (active != 0)
                 {
-                    Event e;
-                    e.affected_net = n;
-                    e.new_value    = SignalValue::ONE;
-                    e.time         = m_current_time;
-                    m_event_queue.push_back(e);
+                    for (u32 out_net : ff.state_output_nets)
+                    {
+                        schedule_lane_event(out_net, result, active);
+                    }
+                    for (u32 out_net : ff.state_inverted_output_nets)
+                    {
+                        schedule_lane_event(out_net, inv_result, active);
+                    }
                 }
             }
         }
-
-        // set initialization flag only if this point is reached
-        m_needs_initialization = false;
     }
 
-    void NetlistSimulator::prepare_clock_events(u64 picoseconds)
+    void NetlistSimulator::evaluate_lane_gate(u32 gate_index, std::vector<LaneValues>& nodes)
     {
-        for (auto& c : m_clocks)
+        const auto& gate      = m_levelized_gates[gate_index];
+        const auto& functions = m_lane_gates[gate_index].functions;
+        if (m_profiling)
         {
-            u64 base_time = m_current_time - (m_current_time % c.switch_time);
-            u64 time      = 0;
+            gate.gate->evaluations++;
+        }
+        for (u32 i = 0; i < gate.output_nets.size(); ++i)
+        {
+            m_lane_results[gate.first_result + i] = evaluate_lane_function(functions[i], nodes);
+        }
+    }
 
-            // determine next signal state
-            // works also if we are in the middle of a cycle
-            SignalValue v = static_cast<SignalValue>(base_time & 1);
-            if (!c.start_at_zero)
+    void NetlistSimulator::evaluate_lane_gates(std::vector<std::pair<u32, u64>>& ffs)
+    {
+        static const i32 MIN_PARALLEL_GATES = 16;
+
+        for (auto& dirty_gates : m_dirty_gates_per_level)
+        {
+            // gates of the same level do not depend on each other, so they can be evaluated in parallel
+            i32 dirty_count = dirty_gates.size();
+            if (m_thread_count > 1 && dirty_count >= MIN_PARALLEL_GATES)
+            {
+#pragma omp parallel num_threads(m_thread_count)
+                {
+                    std::vector<LaneValues> nodes;
+#pragma omp for schedule(static)
+                    for (i32 i = 0; i < dirty_count; ++i)
+                    {
+                        evaluate_lane_gate(dirty_gates[i], nodes);
+                    }
+                }
+            }
+            else
             {
-                v = toggle(v);
+                for (u32 gate_index : dirty_gates)
+                {
+                    evaluate_lane_gate(gate_index, m_lane_function_nodes);
+                }
             }
 
-            // insert the required amount of clock signal switch events
-            while (time < picoseconds)
+            for (u32 gate_index : dirty_gates)
             {
-                Event e;
-                e.affected_net = c.clock_net;
-                e.new_value    = v;
-                e.time         = base_time + time;
-                m_event_queue.push_back(e);
+                const auto& gate = m_levelized_gates[gate_index];
+                auto& lane_gate  = m_lane_gates[gate_index];
+                u64 lanes        = lane_gate.dirty_lanes;
+                lane_gate.dirty_lanes = 0;
 
-                v = toggle(v);
-                time += c.switch_time;
+                for (u32 j = 0; j < gate.output_nets.size(); ++j)
+                {
+                    process_lane_event(gate.output_nets[j], m_lane_results[gate.first_result + j], lanes, m_current_time, ffs);
+                }
             }
+            dirty_gates.clear();
         }
     }
 
-    void NetlistSimulator::process_events(u64 timeout)
+    void NetlistSimulator::simulate_lane_ff(u32 ff_index, u64 lanes)
     {
-        measure_block_time("NetlistSimulator::process_events(" + std::to_string(timeout) + ")");
+        const auto& ff = m_lane_ffs[ff_index];
+        if (m_profiling)
+        {
+            ff.gate->evaluations++;
+        }
 
-        // iteration counter to catch infinite loops
-        u64 total_iterations_for_one_timeslot = 0;
+        // compute output, an active asynchronous set or reset overrides the next state
+        LaneValues result;
+        LaneValues inv_result;
+        u64 synchronous = lanes & ~simulate_lane_ff_clear_preset(ff, lanes, result, inv_result);
+        if (synchronous != 0)
+        {
+            LaneValues next_state = evaluate_lane_function(ff.next_state_func, m_lane_function_nodes);
+            result.one            = (result.one & ~synchronous) | (next_state.one & synchronous);
+            result.zero           = (result.zero & ~synchronous) | (next_state.zero & synchronous);
+            inv_result.one        = (inv_result.one & ~synchronous) | (next_state.zero & synchronous);
+            inv_result.zero       = (inv_result.zero & ~synchronous) | (next_state.one & synchronous);
+        }
 
-        // strategy: propagate all signals at the current time
-        // THEN evaluate all FFs that were clocked by these signals
-        // hence we need to remember FFs that were clocked
-        std::vector<SimulationGateFF*> ffs;
-        bool ffs_processed = false;
+        // generate events
+        for (u32 out_net : ff.state_output_nets)
+        {
+            schedule_lane_event(out_net, result, lanes);
+        }
+        for (u32 out_net : ff.state_inverted_output_nets)
+        {
+            schedule_lane_event(out_net, inv_result, lanes);
+        }
+    }
+
+    u64 NetlistSimulator::simulate_lane_ff_clear_preset(const LaneFF& ff, u64 lanes, LaneValues& result, LaneValues& inv_result)
+    {
+        result     = {0, 0};
+        inv_result = {0, 0};
 
-        while (!m_event_queue.empty() || !ffs.empty())
+        // check whether an asynchronous set or reset ist triggered
+        u64 async_set   = lanes & evaluate_lane_function(ff.preset_func, m_lane_function_nodes).one;
+        u64 async_reset = lanes & evaluate_lane_function(ff.clear_func, m_lane_function_nodes).one;
+        if ((async_set | async_reset) == 0)
         {
-            std::map<std::pair<Net*, u64>, SignalValue> new_events;
+            return 0;
+        }
 
-            // sort events by time
-            std::sort(m_event_queue.begin(), m_event_queue.end());
+        u64 only_set   = async_set & ~async_reset;
+        u64 only_reset = async_reset & ~async_set;
+        result         = {only_set, only_reset};
+        inv_result     = {only_reset, only_set};
 
-            // queue empty or all events of the current point in time processed?
-            if (m_event_queue.empty() || m_current_time != m_event_queue[0].time)
-            {
-                // are there FFs that were clocked? process them now!
-                if (!ffs.empty() && !ffs_processed)
-                {
-                    for (auto ff : ffs)
-                    {
-                        simulate_ff(ff, new_events);
-                    }
-                    ffs.clear();
-                    ffs_processed = true;
-                }
-                else if (m_event_queue.empty())
+        // both signals set? -> evaluate special behavior for each output
+        if (u64 both = async_set & async_reset; both != 0)
+        {
+            auto apply_behavior = [this, both](GateType::ClearPresetBehavior behavior, const std::vector<u32>& out_nets, LaneValues& values) {
+                LaneValues old_output = out_nets.empty() ? LaneValues{0, 0} : m_lane_recorded_values[out_nets[0]];
+                LaneValues behavior_output;
+                if (behavior == GateType::ClearPresetBehavior::N)
                 {
-                    // no FFs and queue empty -> simulation is done
-                    break;
+                    behavior_output = old_output;
                 }
-                else    // no FFs but queue is not empty -> advance point in time
+                else if (behavior == GateType::ClearPresetBehavior::L)
                 {
-                    m_current_time                    = m_event_queue[0].time;
-                    total_iterations_for_one_timeslot = 0;
-                    ffs_processed                     = false;
+                    behavior_output = {0, ~0ull};
                 }
-            }
-
-            // note: at this point not all events are processed necessarily!
-            // but they are processed when simulation is resumed, so no worries
-            if (m_current_time > timeout)
-            {
-                break;
-            }
-
-            // process all events of the current point in time
-            u32 processed = 0;
-            for (; processed < m_event_queue.size() && m_event_queue[processed].time <= m_current_time; ++processed)
-            {
-                auto& event = m_event_queue[processed];
-
-                // is there already a value recorded for the net?
-                if (auto it = m_simulation.m_events.find(event.affected_net); it != m_simulation.m_events.end())
+                else if (behavior == GateType::ClearPresetBehavior::H)
                 {
-                    // if the event does not change anything, skip it
-                    if (it->second.back().new_value == event.new_value)
-                    {
-                        continue;
-                    }
-                    // if the event does change something, but there was already an event for this point in time, we simply update the value
-                    else if (it->second.back().time == event.time)
-                    {
-                        it->second.back().new_value = event.new_value;
-                        if (it->second.size() > 1 && it->second[it->second.size() - 2].new_value == event.new_value)
-                        {
-                            it->second.pop_back();
-                        }
-                    }
-                    else    // new event
-                    {
-                        m_simulation.m_events[event.affected_net].push_back(event);
-                    }
+                    behavior_output = {~0ull, 0};
                 }
-                else    // no value recorded -> new event
+                else if (behavior == GateType::ClearPresetBehavior::T)
                 {
-                    m_simulation.m_events[event.affected_net].push_back(event);
+                    behavior_output = {old_output.zero, old_output.one};
                 }
-
-                // simulate affected gates
-                // record all FFs that have to be clocked
-                if (auto suc_it = m_successors.find(event.affected_net); suc_it != m_successors.end())
+                else
                 {
-                    for (auto& [gate, pins] : suc_it->second)
+                    if (behavior != GateType::ClearPresetBehavior::X)
                     {
-                        for (auto& pin : pins)
-                        {
-                            gate->input_values[pin] = static_cast<BooleanFunction::Value>(event.new_value);
-                        }
-                        if (!simulate_gate(gate, event, new_events))
-                        {
-                            ffs.push_back(static_cast<SimulationGateFF*>(gate));
-                        }
+                        log_error("netlist_simulator", "unsupported set/reset behavior {}.", behavior);
                     }
+                    behavior_output = {0, 0};
                 }
-            }
+                values.one |= behavior_output.one & both;
+                values.zero |= behavior_output.zero & both;
+            };
+            apply_behavior(ff.gate->sr_behavior_out, ff.state_output_nets, result);
+            apply_behavior(ff.gate->sr_behavior_out_inverted, ff.state_inverted_output_nets, inv_result);
+        }
 
-            // check for iteration limit
-            total_iterations_for_one_timeslot += processed;
-            if (m_timeout_iterations > 0 && total_iterations_for_one_timeslot > m_timeout_iterations)
-            {
-                log_error("netlist_simulator", "reached iteration timeout of {} without advancing in time, aborting simulation. Please check for a combinational loop.", m_timeout_iterations);
-                return;
-            }
+        return async_set | async_reset;
+    }
 
-            // remove processed events
-            m_event_queue.erase(m_event_queue.begin(), m_event_queue.begin() + processed);
+    void NetlistSimulator::schedule_lane_event(u32 net_index, const LaneValues& values, u64 lanes)
+    {
+        if (auto it = m_lane_new_event_indices.find(net_index); it != m_lane_new_event_indices.end())
+        {
+            // the last value per lane is kept
+            auto& event       = m_lane_new_events[it->second];
+            event.values.one  = (event.values.one & ~lanes) | (values.one & lanes);
+            event.values.zero = (event.values.zero & ~lanes) | (values.zero & lanes);
+            event.lanes |= lanes;
+            return;
+        }
 
-            // add new events
-            m_event_queue.reserve(m_event_queue.size() + new_events.size());
-            for (const auto& event_it : new_events)
-            {
-                Event e;
-                e.affected_net = event_it.first.first;
-                e.time         = event_it.first.second;
-                e.new_value    = event_it.second;
-                e.id           = m_id_counter++;
-                m_event_queue.push_back(e);
-            }
+        LaneEvent e;
+        e.net_index = net_index;
+        e.values    = values;
+        e.lanes     = lanes;
+        m_lane_new_event_indices.emplace(net_index, m_lane_new_events.size());
+        m_lane_new_events.push_back(e);
+    }
+
+    void NetlistSimulator::schedule_event(Net* net, SignalValue value, u64 time)
+    {
+        if (auto it = m_new_event_indices.find({net, time}); it != m_new_event_indices.end())
+        {
+            m_new_events[it->second].new_value = value;
+            return;
         }
 
-        // adjust point in time
-        m_current_time = timeout;
+        Event e;
+        e.affected_net = net;
+        e.new_value    = value;
+        e.time         = time;
+        m_new_event_indices.emplace(std::make_pair(net, time), m_new_events.size());
+        m_new_events.push_back(e);
     }
 
-    bool NetlistSimulator::simulate_gate(SimulationGate* gate, Event& event, std::map<std::pair<Net*, u64>, SignalValue>& new_events)
+    bool NetlistSimulator::simulate_gate(SimulationGate* gate, Event& event)
     {
+        if (m_profiling)
+        {
+            gate->evaluations++;
+        }
+
         // compute delay, currently just a placeholder
         u64 delay = 0;
 
@@ -654,64 +3463,22 @@ namespace hal
             {
                 // return true if the event was completely handled
                 // -> true if the gate is NOT clocked at this point
-                return (ff->clock_func.evaluate(ff->input_values) != BooleanFunction::ONE);
+                return (evaluate_function(ff->clock_func, ff->input_values) != BooleanFunction::ONE);
             }
             else    // not a clock pin -> only check for asynchronous signals
             {
-                auto async_set   = ff->preset_func.evaluate(ff->input_values);
-                auto async_reset = ff->clear_func.evaluate(ff->input_values);
-
-                // check whether an asynchronous set or reset ist triggered
-                if (async_set == BooleanFunction::ONE || async_reset == BooleanFunction::ONE)
+                SignalValue result;
+                SignalValue inv_result;
+                if (simulate_ff_clear_preset(ff, result, inv_result))
                 {
-                    SignalValue result     = SignalValue::X;
-                    SignalValue inv_result = SignalValue::X;
-
-                    if (async_set == BooleanFunction::ONE && async_reset == BooleanFunction::ONE)
-                    {
-                        // both signals set? -> evaluate special behavior
-                        SignalValue old_output = SignalValue::X;
-                        if (!ff->state_output_nets.empty())
-                        {
-                            auto out_net = ff->state_output_nets[0];
-                            if (auto it = m_simulation.m_events.find(out_net); it != m_simulation.m_events.end())
-                            {
-                                old_output = it->second.back().new_value;
-                            }
-                        }
-                        SignalValue old_output_inv = SignalValue::X;
-                        if (!ff->state_inverted_output_nets.empty())
-                        {
-                            auto out_net = ff->state_inverted_output_nets[0];
-                            if (auto it = m_simulation.m_events.find(out_net); it != m_simulation.m_events.end())
-                            {
-                                old_output_inv = it->second.back().new_value;
-                            }
-                        }
-                        result     = process_clear_preset_behavior(ff->sr_behavior_out, old_output);
-                        inv_result = process_clear_preset_behavior(ff->sr_behavior_out_inverted, old_output_inv);
-                    }
-                    else if (async_set == BooleanFunction::ONE)
-                    {
-                        // only asynch set is 1
-                        result     = SignalValue::ONE;
-                        inv_result = toggle(result);
-                    }
-                    else if (async_reset == BooleanFunction::ONE)
-                    {
-                        // only asynch reset is 1
-                        result     = SignalValue::ZERO;
-                        inv_result = toggle(result);
-                    }
-
                     // generate events
                     for (auto out_net : ff->state_output_nets)
                     {
-                        new_events[std::make_pair(out_net, m_current_time + delay)] = result;
+                        schedule_event(out_net, result, m_current_time + delay);
                     }
                     for (auto out_net : ff->state_inverted_output_nets)
                     {
-                        new_events[std::make_pair(out_net, m_current_time + delay)] = inv_result;
+                        schedule_event(out_net, inv_result, m_current_time + delay);
                     }
                 }
             }
@@ -719,34 +3486,94 @@ namespace hal
         else    // compute output for combinational gate
         {
             auto comb = static_cast<SimulationGateCombinational*>(gate);
-            for (auto out_net : comb->output_nets)
+            for (u32 i = 0; i < comb->output_nets.size(); ++i)
             {
-                auto result = comb->functions[out_net](comb->input_values);
+                auto result = evaluate_function(comb->functions[i], comb->input_values);
 
-                new_events[std::make_pair(out_net, m_current_time + delay)] = static_cast<SignalValue>(result);
+                schedule_event(comb->output_nets[i], static_cast<SignalValue>(result), m_current_time + delay);
             }
         }
         return true;
     }
 
-    void NetlistSimulator::simulate_ff(SimulationGateFF* gate, std::map<std::pair<Net*, u64>, SignalValue>& new_events)
+    void NetlistSimulator::simulate_ff(SimulationGateFF* gate)
     {
+        if (m_profiling)
+        {
+            gate->evaluations++;
+        }
+
         // compute delay, currently just a placeholder
         u64 delay = 0;
 
-        // compute output
-        auto result     = static_cast<SignalValue>(gate->next_state_func.evaluate(gate->input_values));
-        auto inv_result = toggle(result);
+        // compute output, an active asynchronous set or reset overrides the next state
+        SignalValue result;
+        SignalValue inv_result;
+        if (!simulate_ff_clear_preset(gate, result, inv_result))
+        {
+            result     = static_cast<SignalValue>(evaluate_function(gate->next_state_func, gate->input_values));
+            inv_result = toggle(result);
+        }
 
         // generate events
         for (auto out_net : gate->state_output_nets)
         {
-            new_events[std::make_pair(out_net, m_current_time + delay)] = result;
+            schedule_event(out_net, result, m_current_time + delay);
         }
         for (auto out_net : gate->state_inverted_output_nets)
         {
-            new_events[std::make_pair(out_net, m_current_time + delay)] = inv_result;
+            schedule_event(out_net, inv_result, m_current_time + delay);
+        }
+    }
+
+    bool NetlistSimulator::simulate_ff_clear_preset(SimulationGateFF* gate, SignalValue& result, SignalValue& inv_result)
+    {
+        auto async_set   = evaluate_function(gate->preset_func, gate->input_values);
+        auto async_reset = evaluate_function(gate->clear_func, gate->input_values);
+
+        // check whether an asynchronous set or reset ist triggered
+        if (async_set != BooleanFunction::ONE && async_reset != BooleanFunction::ONE)
+        {
+            return false;
+        }
+
+        if (async_set == BooleanFunction::ONE && async_reset == BooleanFunction::ONE)
+        {
+            // both signals set? -> evaluate special behavior
+            SignalValue old_output = SignalValue::X;
+            if (!gate->state_output_nets.empty())
+            {
+                auto out_net = gate->state_output_nets[0];
+                if (auto it = m_simulation.m_waveforms.find(out_net); it != m_simulation.m_waveforms.end())
+                {
+                    old_output = it->second.values.back();
+                }
+            }
+            SignalValue old_output_inv = SignalValue::X;
+            if (!gate->state_inverted_output_nets.empty())
+            {
+                auto out_net = gate->state_inverted_output_nets[0];
+                if (auto it = m_simulation.m_waveforms.find(out_net); it != m_simulation.m_waveforms.end())
+                {
+                    old_output_inv = it->second.values.back();
+                }
+            }
+            result     = process_clear_preset_behavior(gate->sr_behavior_out, old_output);
+            inv_result = process_clear_preset_behavior(gate->sr_behavior_out_inverted, old_output_inv);
+        }
+        else if (async_set == BooleanFunction::ONE)
+        {
+            // only asynch set is 1
+            result     = SignalValue::ONE;
+            inv_result = toggle(result);
+        }
+        else
+        {
+            // only asynch reset is 1
+            result     = SignalValue::ZERO;
+            inv_result = toggle(result);
         }
+        return true;
     }
 
     SignalValue NetlistSimulator::process_clear_preset_behavior(GateType::ClearPresetBehavior behavior, SignalValue previous_output)
@@ -776,6 +3603,22 @@ namespace hal
     }
 
     bool NetlistSimulator::generate_vcd(const std::filesystem::path& path, u32 start_time, u32 end_time, std::set<Net*> nets) const
+    {
+        return write_vcd(m_simulation, path, start_time, end_time, nets);
+    }
+
+    bool NetlistSimulator::generate_lane_vcd(u32 lane, const std::filesystem::path& path, u32 start_time, u32 end_time, std::set<Net*> nets) const
+    {
+        if (lane >= LANE_COUNT)
+        {
+            log_error("netlist_simulator", "lane {} does not exist, only {} lanes are simulated.", lane, LANE_COUNT);
+            return false;
+        }
+
+        return write_vcd(get_lane_simulation(lane), path, start_time, end_time, nets);
+    }
+
+    bool NetlistSimulator::write_vcd(const Simulation& simulation, const std::filesystem::path& path, u32 start_time, u32 end_time, const std::set<Net*>& nets) const
     {
         if (m_simulation_set.empty())
         {
@@ -783,7 +3626,7 @@ namespace hal
             return false;
         }
 
-        if (m_simulation.get_events().empty())
+        if (simulation.m_waveforms.empty())
         {
             log_error("netlist_simulator", "nothing has been simulated, cannot generate VCD.");
             return false;
@@ -795,8 +3638,15 @@ namespace hal
             return false;
         }
 
+        // the file is written directly instead of being assembled in memory first
+        std::ofstream vcd(path);
+        if (!vcd.is_open())
+        {
+            log_error("netlist_simulator", "could not open file '{}' for writing.", path.string());
+            return false;
+        }
+
         // write header
-        std::stringstream vcd;
         auto t  = std::time(nullptr);
         auto tm = *std::localtime(&t);
         vcd << "$version Generated by HAL $HAL" << std::endl;
@@ -806,10 +3656,10 @@ namespace hal
         //declare variables
         vcd << "$scope module TOP $end" << std::endl;
 
-        std::unordered_map<Net*, std::vector<Event>> events = m_simulation.get_events();
+        const auto& waveforms = simulation.m_waveforms;
         std::vector<Net*> simulated_nets;
 
-        for (auto net_changes : events)
+        for (const auto& net_changes : waveforms)
         {
             Net* net = net_changes.first;
             if ((net != nullptr) && (nets.empty() || nets.find(net) != nets.end()))
@@ -830,25 +3680,23 @@ namespace hal
 
         std::map<u32, std::map<Net*, SignalValue>> time_to_changes_map;
 
-        std::unordered_map<Net*, std::vector<Event>> event_tracker = m_simulation.get_events();
-
         for (const auto& simulated_net : simulated_nets)
         {
-            std::vector<Event> net_events = event_tracker.at(simulated_net);
-            SignalValue initial_value     = SignalValue::X;
-            u32 initial_time              = 0;
+            const auto& waveform      = waveforms.at(simulated_net);
+            SignalValue initial_value = SignalValue::X;
+            u32 initial_time          = 0;
 
-            for (const auto& event_it : net_events)
+            for (u32 i = 0; i < waveform.times.size(); ++i)
             {
-                u32 event_time = event_it.time;
+                u32 event_time = waveform.times[i];
                 if (initial_time == event_time || ((event_time > initial_time) && (event_time < start_time)))
                 {
                     initial_time  = event_time;
-                    initial_value = event_it.new_value;
+                    initial_value = waveform.values[i];
                 }
                 if (event_time > start_time && event_time < end_time)
                 {
-                    time_to_changes_map[event_it.time][simulated_net] = event_it.new_value;
+                    time_to_changes_map[waveform.times[i]][simulated_net] = waveform.values[i];
                 }
             }
 
@@ -891,15 +3739,6 @@ namespace hal
         }
         vcd << "#" << traces_count << std::endl;
 
-        std::ofstream ofs(path);
-        if (!ofs.is_open())
-        {
-            log_error("netlist_simulator", "could not open file '{}' for writing.", path.string());
-            return false;
-        }
-
-        ofs << vcd.str();
-
         return true;
     }
 }    // namespace hal
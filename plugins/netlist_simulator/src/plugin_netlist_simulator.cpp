@@ -18,8 +18,10 @@ namespace hal
         return std::string("0.1");
     }
 
-    std::unique_ptr<NetlistSimulator> NetlistSimulatorPlugin::create_simulator() const
+    std::unique_ptr<NetlistSimulator> NetlistSimulatorPlugin::create_simulator(SimulationMode mode) const
     {
-        return std::unique_ptr<NetlistSimulator>(new NetlistSimulator());
+        auto sim = std::unique_ptr<NetlistSimulator>(new NetlistSimulator());
+        sim->set_simulation_mode(mode);
+        return sim;
     }
 }
@@ -2,35 +2,111 @@
 
 #include "hal_core/netlist/net.h"
 
+#include <algorithm>
+
 namespace hal
 {
+    SignalValue Waveform::get_value(u64 time) const
+    {
+        // the value is set by the last change at or before the given time
+        auto it = std::upper_bound(times.begin(), times.end(), time);
+        if (it == times.begin())
+        {
+            return SignalValue::X;
+        }
+        return values[it - times.begin() - 1];
+    }
+
+    std::pair<u32, u32> Waveform::get_range(u64 start_time, u64 end_time) const
+    {
+        if (end_time <= start_time)
+        {
+            return {0, 0};
+        }
+        u32 first = std::lower_bound(times.begin(), times.end(), start_time) - times.begin();
+        u32 last  = std::lower_bound(times.begin() + first, times.end(), end_time) - times.begin();
+        return {first, last};
+    }
+
     SignalValue Simulation::get_net_value(Net* net, u64 time) const
     {
-        auto it = m_events.find(net);
+        return get_waveform(net).get_value(time);
+    }
 
-        SignalValue result = SignalValue::X;
+    std::vector<SignalValue> Simulation::get_net_values(Net* net, const std::vector<u64>& times) const
+    {
+        const Waveform& waveform = get_waveform(net);
 
-        if (it != m_events.end())
+        std::vector<SignalValue> result;
+        result.reserve(times.size());
+        for (u64 time : times)
         {
-            for (auto& e : it->second)
-            {
-                if (e.time > time)
-                {
-                    break;
-                }
-                result = e.new_value;
-            }
+            result.push_back(waveform.get_value(time));
         }
         return result;
     }
 
+    const Waveform& Simulation::get_waveform(Net* net) const
+    {
+        static const Waveform empty;
+
+        if (auto it = m_waveforms.find(net); it != m_waveforms.end())
+        {
+            return it->second;
+        }
+        return empty;
+    }
+
+    const std::unordered_map<Net*, Waveform>& Simulation::get_waveforms() const
+    {
+        return m_waveforms;
+    }
+
     void Simulation::add_event(const Event& event)
     {
-        m_events[event.affected_net].push_back(event);
+        // keep the waveform sorted, events at the same point in time are kept in insertion order
+        auto& waveform = m_waveforms[event.affected_net];
+        u32 index      = std::upper_bound(waveform.times.begin(), waveform.times.end(), event.time) - waveform.times.begin();
+        waveform.times.insert(waveform.times.begin() + index, event.time);
+        waveform.values.insert(waveform.values.begin() + index, event.new_value);
+    }
+
+    std::vector<Event> Simulation::get_net_events(Net* net, u64 start_time, u64 end_time) const
+    {
+        const Waveform& waveform = get_waveform(net);
+        auto [first, last]       = waveform.get_range(start_time, end_time);
+
+        std::vector<Event> result;
+        result.reserve(last - first);
+        for (u32 i = first; i < last; ++i)
+        {
+            Event e;
+            e.affected_net = net;
+            e.new_value    = waveform.values[i];
+            e.time         = waveform.times[i];
+            e.id           = 0;
+            result.push_back(e);
+        }
+        return result;
     }
 
     std::unordered_map<Net*, std::vector<Event>> Simulation::get_events() const
     {
-        return m_events;
+        std::unordered_map<Net*, std::vector<Event>> result;
+        for (const auto& [net, waveform] : m_waveforms)
+        {
+            auto& events = result[net];
+            events.reserve(waveform.times.size());
+            for (u32 i = 0; i < waveform.times.size(); ++i)
+            {
+                Event e;
+                e.affected_net = net;
+                e.new_value    = waveform.values[i];
+                e.time         = waveform.times[i];
+                e.id           = 0;
+                events.push_back(e);
+            }
+        }
+        return result;
     }
 }    // namespace hal
@@ -0,0 +1,19 @@
+#include "netlist_simulator/simulation_checkpoint.h"
+
+namespace hal
+{
+    u64 SimulationCheckpoint::get_time() const
+    {
+        return m_time;
+    }
+
+    SignalValue SimulationCheckpoint::get_net_value(Net* net) const
+    {
+        return m_state.get_net_value(net, m_time);
+    }
+
+    u64 SimulationCheckpoint::get_pending_event_count() const
+    {
+        return m_events.size() + m_lane_inputs.size();
+    }
+}    // namespace hal
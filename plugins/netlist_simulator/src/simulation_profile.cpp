@@ -0,0 +1,84 @@
+#include "netlist_simulator/simulation_profile.h"
+
+#include "hal_core/netlist/gate.h"
+#include "hal_core/netlist/gate_library/gate_type.h"
+#include "hal_core/netlist/net.h"
+#include "rapidjson/stringbuffer.h"
+#include "rapidjson/writer.h"
+
+namespace hal
+{
+    std::string SimulationProfile::to_json() const
+    {
+        rapidjson::StringBuffer strbuf;
+        rapidjson::Writer<rapidjson::StringBuffer> writer(strbuf);
+
+        writer.StartObject();
+        writer.Key("timesteps");
+        writer.Uint64(timesteps);
+        writer.Key("events");
+        writer.Uint64(events);
+        writer.Key("max_events_per_timestep");
+        writer.Uint64(max_events_per_timestep);
+        writer.Key("delta_cycles");
+        writer.Uint64(delta_cycles);
+        writer.Key("max_delta_cycles_per_timestep");
+        writer.Uint64(max_delta_cycles_per_timestep);
+        writer.Key("queue_high_water_mark");
+        writer.Uint64(queue_high_water_mark);
+        writer.Key("gate_evaluations");
+        writer.Uint64(gate_evaluations);
+
+        writer.Key("gate_evaluations_per_type");
+        writer.StartObject();
+        for (const auto& [type, count] : gate_evaluations_per_type)
+        {
+            writer.Key(type.c_str(), type.length(), true);
+            writer.Uint64(count);
+        }
+        writer.EndObject();
+
+        writer.Key("evaluation_time_ns");
+        writer.Uint64(evaluation_time);
+        writer.Key("scheduling_time_ns");
+        writer.Uint64(scheduling_time);
+
+        writer.Key("hot_gates");
+        writer.StartArray();
+        for (const auto& [gate, count] : hot_gates)
+        {
+            const std::string& name      = gate->get_name();
+            const std::string& type_name = gate->get_type()->get_name();
+            writer.StartObject();
+            writer.Key("id");
+            writer.Uint(gate->get_id());
+            writer.Key("name");
+            writer.String(name.c_str(), name.length(), true);
+            writer.Key("type");
+            writer.String(type_name.c_str(), type_name.length(), true);
+            writer.Key("evaluations");
+            writer.Uint64(count);
+            writer.EndObject();
+        }
+        writer.EndArray();
+
+        writer.Key("glitching_nets");
+        writer.StartArray();
+        for (const auto& [net, count] : glitching_nets)
+        {
+            const std::string& name = net->get_name();
+            writer.StartObject();
+            writer.Key("id");
+            writer.Uint(net->get_id());
+            writer.Key("name");
+            writer.String(name.c_str(), name.length(), true);
+            writer.Key("glitches");
+            writer.Uint64(count);
+            writer.EndObject();
+        }
+        writer.EndArray();
+
+        writer.EndObject();
+        return strbuf.GetString();
+    }
+}    // namespace hal
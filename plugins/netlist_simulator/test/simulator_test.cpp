@@ -7,13 +7,19 @@
 #include "hal_core/netlist/persistent/netlist_serializer.h"
 #include "hal_core/plugin_system/plugin_manager.h"
 #include "hal_core/utilities/log.h"
+#include "netlist_simulator/event_queue.h"
 #include "netlist_simulator/plugin_netlist_simulator.h"
 #include "test_utils/include/test_def.h"
 
+#include <algorithm>
+#include <bitset>
 #include <chrono>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <map>
+#include <numeric>
+#include <random>
 #include <string>
 
 namespace hal
@@ -57,6 +63,49 @@ namespace hal
             plugin_manager::unload_all_plugins();
         }
 
+        struct CounterNetlist
+        {
+            std::unique_ptr<Netlist> nl;
+            Net* reset          = nullptr;
+            Net* clock          = nullptr;
+            Net* clock_enable_b = nullptr;
+        };
+
+        /* parses the counter test netlist and retrieves its Reset, Clock, and Clock_enable_B nets, nl is a nullptr on failure */
+        CounterNetlist load_counter_netlist()
+        {
+            CounterNetlist counter;
+
+            std::string path_netlist = utils::get_base_directory().string() + "/bin/hal_plugins/test-files/counter/counternetlist_flattened_by_hal.vhd";
+            if (!utils::file_exists(path_netlist))
+            {
+                ADD_FAILURE() << "netlist for counter-test not found: " << path_netlist;
+                return counter;
+            }
+
+            auto lib = gate_library_manager::get_gate_library_by_name("XILINX_UNISIM");
+            if (lib == nullptr)
+            {
+                ADD_FAILURE() << "XILINX_UNISIM gate library not found";
+                return counter;
+            }
+
+            {
+                NO_COUT_BLOCK;
+                counter.nl = netlist_parser_manager::parse(path_netlist, lib);
+            }
+            if (counter.nl == nullptr)
+            {
+                ADD_FAILURE() << "netlist couldn't be parsed";
+                return counter;
+            }
+
+            counter.reset          = *(counter.nl->get_nets([](auto net) { return net->get_name() == "Reset"; }).begin());
+            counter.clock          = *(counter.nl->get_nets([](auto net) { return net->get_name() == "Clock"; }).begin());
+            counter.clock_enable_b = *(counter.nl->get_nets([](auto net) { return net->get_name() == "Clock_enable_B"; }).begin());
+            return counter;
+        }
+
         bool cmp_sim_data(const Simulation& vcd_sim, const Simulation& hal_sim)
         {
             auto a_events = vcd_sim.get_events();
@@ -411,6 +460,114 @@ namespace hal
         }
     };    // namespace hal
 
+    TEST_F(SimulatorTest, event_queue)
+    {
+        TEST_START
+        // events of the same point in time are returned in the order they were pushed
+        {
+            EventQueue queue;
+            for (u64 i = 0; i < 6; ++i)
+            {
+                Event e;
+                e.affected_net = nullptr;
+                e.new_value    = (SignalValue)(i & 1);
+                e.time         = (i < 3) ? 1000 : 5;
+                queue.push(e);
+            }
+            EXPECT_EQ(queue.size(), 6u);
+            EXPECT_EQ(queue.get_next_time(), 5u);
+
+            std::vector<Event> events;
+            queue.pop_next_time(events);
+            ASSERT_EQ(events.size(), 3u);
+            EXPECT_EQ(events[0].id, 3u);
+            EXPECT_EQ(events[1].id, 4u);
+            EXPECT_EQ(events[2].id, 5u);
+
+            // events in the past and far in the future
+            Event e;
+            e.affected_net = nullptr;
+            e.new_value    = SignalValue::ONE;
+            e.time         = 2;
+            queue.push(e);
+            e.time = 1000000000;
+            queue.push(e);
+            EXPECT_EQ(queue.get_next_time(), 2u);
+
+            events.clear();
+            queue.pop_next_time(events);
+            ASSERT_EQ(events.size(), 1u);
+            EXPECT_EQ(events[0].time, 2u);
+
+            events.clear();
+            queue.pop_next_time(events);
+            ASSERT_EQ(events.size(), 3u);
+            EXPECT_EQ(events[0].id, 0u);
+            EXPECT_EQ(events[2].time, 1000u);
+
+            events.clear();
+            queue.pop_next_time(events);
+            ASSERT_EQ(events.size(), 1u);
+            EXPECT_EQ(events[0].time, 1000000000u);
+            EXPECT_TRUE(queue.empty());
+            EXPECT_EQ(queue.get_next_time(), ~0ull);
+        }
+
+        // compare against an ordered map for a simulation-like access pattern
+        {
+            std::mt19937_64 rng(42);
+            EventQueue queue;
+            std::map<u64, std::vector<u64>> reference;
+            u64 id_counter   = 0;
+            u64 current_time = 0;
+            bool equal       = true;
+
+            std::vector<Event> events;
+            auto pop_and_compare = [&]() {
+                events.clear();
+                queue.pop_next_time(events);
+                auto expected = reference.begin();
+                if (events.size() != expected->second.size())
+                {
+                    equal = false;
+                }
+                else
+                {
+                    for (u32 i = 0; i < events.size(); ++i)
+                    {
+                        equal &= (events[i].time == expected->first && events[i].id == expected->second[i]);
+                    }
+                }
+                current_time = expected->first;
+                reference.erase(expected);
+            };
+
+            for (u32 step = 0; step < 5000; ++step)
+            {
+                u32 to_push = 1 + rng() % 3;
+                for (u32 i = 0; i < to_push; ++i)
+                {
+                    Event e;
+                    e.affected_net = nullptr;
+                    e.new_value    = SignalValue::ZERO;
+                    u64 r          = rng() % 100;
+                    e.time         = current_time + ((r < 60) ? 0 : ((r < 95) ? rng() % 1000 : rng() % 100000));
+                    queue.push(e);
+                    reference[e.time].push_back(id_counter++);
+                }
+                pop_and_compare();
+            }
+            while (!queue.empty())
+            {
+                pop_and_compare();
+            }
+
+            EXPECT_TRUE(equal);
+            EXPECT_TRUE(reference.empty());
+        }
+        TEST_END
+    }
+
     TEST_F(SimulatorTest, half_adder)
     {
         // return;
@@ -567,243 +724,1316 @@ namespace hal
         TEST_END
     }
 
-    TEST_F(SimulatorTest, toycipher)
+    TEST_F(SimulatorTest, counter_streaming)
     {
-        // return;
         TEST_START
 
         auto plugin = plugin_manager::get_plugin_instance<NetlistSimulatorPlugin>("netlist_simulator");
-        auto sim    = plugin->create_simulator();
 
-        //path to netlist
-        std::string path_netlist = utils::get_base_directory().string() + "/bin/hal_plugins/test-files/toycipher/cipher_flat.vhd";
-        if (!utils::file_exists(path_netlist))
-            FAIL() << "netlist for toycipher-test not found: " << path_netlist;
+        auto counter = load_counter_netlist();
+        ASSERT_NE(counter.nl, nullptr);
+        auto& nl            = counter.nl;
+        auto reset          = counter.reset;
+        auto clock          = counter.clock;
+        auto Clock_enable_B = counter.clock_enable_b;
 
-        //create netlist from path
-        auto lib = gate_library_manager::get_gate_library_by_name("XILINX_UNISIM");
-        if (lib == nullptr)
+        std::set<Net*> watched_nets = {clock};
+        for (u32 i = 0; i < 4; ++i)
         {
-            FAIL() << "XILINX_UNISIM gate library not found";
+            std::string name = "Output_" + std::to_string(i);
+            watched_nets.insert(*(nl->get_nets([name](auto net) { return net->get_name() == name; }).begin()));
         }
 
-        std::unique_ptr<Netlist> nl;
+        // the reference keeps the whole history, the other simulator only keeps a window of 100 NS of the watched nets and streams them to a VCD
+        const u64 window     = 100 * 1000;
+        std::string path_vcd = utils::get_binary_directory().string() + "/tmp_stream.vcd";
+
+        auto reference = plugin->create_simulator();
+        auto sim       = plugin->create_simulator();
+        sim->set_watched_nets(watched_nets);
+        sim->set_history_window(window);
+        EXPECT_EQ(sim->get_watched_nets(), watched_nets);
+        EXPECT_EQ(sim->get_history_window(), window);
+        ASSERT_TRUE(sim->start_vcd_stream(path_vcd));
+
+        for (auto s : {reference.get(), sim.get()})
         {
-            NO_COUT_BLOCK;
-            nl = netlist_parser_manager::parse(path_netlist, lib);
-            if (nl == nullptr)
+            s->add_gates(nl->get_gates());
+            s->load_initial_values_from_netlist();
+            s->add_clock_period(clock, 10000);
+
+            // count for 10000 clock cycles
+            s->set_input(Clock_enable_B, SignalValue::ZERO);
+            s->set_input(reset, SignalValue::ONE);
+            s->simulate(20 * 1000);
+            s->set_input(reset, SignalValue::ZERO);
+            for (u32 i = 0; i < 1000; ++i)
             {
-                FAIL() << "netlist couldn't be parsed";
+                s->simulate(100 * 1000);
             }
         }
+        sim->stop_vcd_stream();
 
-        //path to vcd
-        std::string path_vcd = utils::get_base_directory().string() + "/bin/hal_plugins/test-files/toycipher/dump.vcd";
-        if (!utils::file_exists(path_vcd))
-            FAIL() << "dump for toycipher-test not found: " << path_vcd;
-
-        //read vcd and transform to vector of states, clock = 10000 ps = 10 ns
-        Simulation vcd_traces = parse_vcd(nl.get(), path_vcd, true);
-
-        //prepare simulation
-        sim->add_gates(nl->get_gates());
-        sim->load_initial_values_from_netlist();
-
-        // retrieve nets
-        auto clk = *(nl->get_nets([](auto net) { return net->get_name() == "CLK"; }).begin());
-
-        sim->add_clock_period(clk, 10000);
-
-        std::set<Net*> key_set, plaintext_set;
-        auto start = *(nl->get_nets([](auto net) { return net->get_name() == "START"; }).begin());
+        auto reference_events = reference->get_simulation_state().get_events();
+        auto bounded_events   = sim->get_simulation_state().get_events();
 
-        for (int i = 0; i < 16; i++)
+        // the bounded history is a suffix of the full history
+        u64 reference_count = 0;
+        u64 bounded_count   = 0;
+        for (const auto& [net, events] : bounded_events)
         {
-            std::string name = "KEY_" + std::to_string(i);
-            key_set.insert(*(nl->get_nets([name](auto net) { return net->get_name() == name; }).begin()));
+            const auto& full_events = reference_events.at(net);
+            ASSERT_LE(events.size(), full_events.size());
+            EXPECT_TRUE(std::equal(events.begin(), events.end(), full_events.end() - events.size())) << "history of net " << net->get_name() << " differs";
+            reference_count += full_events.size();
+            bounded_count += events.size();
         }
+        EXPECT_LT(bounded_count, reference_count / 4);
+        EXPECT_LT(bounded_events.at(clock).size(), reference_events.at(clock).size() / 100);
 
-        for (int i = 0; i < 16; i++)
+        // values within the window are still available
+        const u64 end_time = 100020 * 1000;
+        for (Net* net : watched_nets)
         {
-            std::string name = "PLAINTEXT_" + std::to_string(i);
-            plaintext_set.insert(*(nl->get_nets([name](auto net) { return net->get_name() == name; }).begin()));
+            for (u64 time = end_time - window; time < end_time; time += 5 * 1000)
+            {
+                EXPECT_EQ(sim->get_simulation_state().get_net_value(net, time), reference->get_simulation_state().get_net_value(net, time));
+            }
         }
 
-        int input_nets_amount = key_set.size() + plaintext_set.size();
-
-        if (clk != nullptr)
-            input_nets_amount++;
-
-        if (start != nullptr)
-            input_nets_amount++;
-
-        if (input_nets_amount != sim->get_input_nets().size())
-            FAIL() << "not all input nets set: actual " << input_nets_amount << " vs. " << sim->get_input_nets().size();
-
-        //start simulation
+        // the stream contains the full history of the watched nets
+        Simulation streamed = parse_vcd(nl.get(), path_vcd, false);
+        auto streamed_events = streamed.get_events();
+        for (Net* net : watched_nets)
         {
-            measure_block_time("simulation");
-            //testbench
-
-            for (auto net : plaintext_set)    //PLAINTEXT <= (OTHERS => '0');
-                sim->set_input(net, SignalValue::ZERO);
-
-            for (auto net : key_set)    //KEY <= (OTHERS => '0');
-                sim->set_input(net, SignalValue::ZERO);
-
-            sim->set_input(start, SignalValue::ZERO);    //START <= '0';
-            sim->simulate(10 * 1000);                    //WAIT FOR 10 NS;
-
-            sim->set_input(start, SignalValue::ONE);    //START <= '1';
-            sim->simulate(10 * 1000);                   //WAIT FOR 10 NS;
-
-            sim->set_input(start, SignalValue::ZERO);    //START <= '0';
-            sim->simulate(100 * 1000);                   //WAIT FOR 100 NS;
-
-            for (auto net : plaintext_set)    //PLAINTEXT <= (OTHERS => '1');
-                sim->set_input(net, SignalValue::ONE);
+            EXPECT_EQ(streamed_events[net], reference_events.at(net)) << "stream of net " << net->get_name() << " differs";
+        }
 
-            for (auto net : key_set)    //KEY <= (OTHERS => '1');
-                sim->set_input(net, SignalValue::ONE);
+        TEST_END
+    }
 
-            sim->set_input(start, SignalValue::ZERO);    //START <= '0';
-            sim->simulate(10 * 1000);                    //WAIT FOR 10 NS;
+    TEST_F(SimulatorTest, counter_clocks)
+    {
+        TEST_START
 
-            sim->set_input(start, SignalValue::ONE);    //START <= '1';
-            sim->simulate(10 * 1000);                   //WAIT FOR 10 NS;
+        auto plugin = plugin_manager::get_plugin_instance<NetlistSimulatorPlugin>("netlist_simulator");
+        auto sim    = plugin->create_simulator();
 
-            sim->set_input(start, SignalValue::ZERO);    //START <= '0';
-            sim->simulate(100 * 1000);                   //WAIT FOR 100 NS;
+        auto counter = load_counter_netlist();
+        ASSERT_NE(counter.nl, nullptr);
+        auto& nl            = counter.nl;
+        auto reset          = counter.reset;
+        auto clock          = counter.clock;
+        auto Clock_enable_B = counter.clock_enable_b;
 
-            for (auto net : plaintext_set)    //PLAINTEXT <= (OTHERS => '0');
-                sim->set_input(net, SignalValue::ZERO);
+        sim->add_gates(nl->get_gates());
 
-            for (auto net : key_set)    //KEY <= (OTHERS => '0');
-                sim->set_input(net, SignalValue::ZERO);
+        // the counter clock starts at 1, and a second clock drives the enable signal with a phase offset and a duty cycle of 25%
+        sim->add_clock_period(clock, 10000, false);
+        sim->add_clock_period(Clock_enable_B, 40000, true, 3000, 0.25);
+        sim->set_input(reset, SignalValue::ZERO);
 
-            sim->set_input(start, SignalValue::ZERO);    //START <= '0';
+        // invalid duty cycles are rejected
+        {
+            NO_COUT_BLOCK;
+            sim->add_clock_period(reset, 10000, true, 0, 0);
+            sim->add_clock_period(reset, 10000, true, 0, 1);
+        }
 
-            sim->simulate(10 * 1000);
-            sim->set_input(start, SignalValue::ONE);    //START <= '1';
+        // simulating in chunks that do not align with the clock periods does not change the clock signals
+        u64 end_time = 0;
+        for (u64 duration : {3000, 7000, 12345, 40000, 1, 99999})
+        {
+            sim->simulate(duration);
+            end_time += duration;
+        }
 
-            sim->simulate(10 * 1000);
-            sim->set_input(start, SignalValue::ZERO);    //START <= '0';
+        auto state = sim->get_simulation_state();
+        for (u64 time = 0; time < end_time; time += 500)
+        {
+            SignalValue expected_clock = ((time % 10000) < 5000) ? SignalValue::ONE : SignalValue::ZERO;
+            EXPECT_EQ(state.get_net_value(clock, time), expected_clock) << "at " << time << " ps";
 
-            sim->simulate(30 * 1000);
+            // low for 30 NS, then high for 10 NS, shifted by 3 NS
+            SignalValue expected_enable = (((time + 40000 - 3000) % 40000) < 30000) ? SignalValue::ZERO : SignalValue::ONE;
+            EXPECT_EQ(state.get_net_value(Clock_enable_B, time), expected_enable) << "at " << time << " ps";
         }
 
-        //Test if maps are equal
-        EXPECT_TRUE(cmp_sim_data(vcd_traces, sim->get_simulation_state()));
+        // every edge is recorded exactly once
+        const Waveform& clock_waveform = state.get_waveform(clock);
+        EXPECT_EQ(clock_waveform.times.size(), (end_time - 1) / 5000 + 1);
+        EXPECT_EQ(state.get_waveform(reset).times.size(), 1u);
+
         TEST_END
     }
 
-    TEST_F(SimulatorTest, sha256)
+    TEST_F(SimulatorTest, counter_waveforms)
     {
-        // return;
         TEST_START
 
         auto plugin = plugin_manager::get_plugin_instance<NetlistSimulatorPlugin>("netlist_simulator");
         auto sim    = plugin->create_simulator();
 
-        //path to netlist
-        std::string path_netlist = utils::get_base_directory().string() + "/bin/hal_plugins/test-files/sha256/sha256_flat.vhd";
-        if (!utils::file_exists(path_netlist))
-            FAIL() << "netlist for sha256 not found: " << path_netlist;
+        auto counter = load_counter_netlist();
+        ASSERT_NE(counter.nl, nullptr);
+        auto& nl            = counter.nl;
+        auto reset          = counter.reset;
+        auto clock          = counter.clock;
+        auto Clock_enable_B = counter.clock_enable_b;
 
-        std::string path_netlist_hal = utils::get_base_directory().string() + "/bin/hal_plugins/test-files/sha256/sha256_flat.hal";
+        sim->add_gates(nl->get_gates());
+        sim->load_initial_values_from_netlist();
+        sim->add_clock_period(clock, 10000);
 
-        //create netlist from path
-        auto lib = gate_library_manager::get_gate_library_by_name("XILINX_UNISIM");
-        if (lib == nullptr)
+        sim->set_input(Clock_enable_B, SignalValue::ZERO);
+        sim->set_input(reset, SignalValue::ONE);
+        sim->simulate(20 * 1000);
+        sim->set_input(reset, SignalValue::ZERO);
+        sim->simulate(2000 * 1000);
+
+        Simulation state = sim->get_simulation_state();
+        auto events      = state.get_events();
+        EXPECT_EQ(state.get_waveforms().size(), events.size());
+
+        std::vector<u64> times;
+        for (u64 time = 0; time < 2020 * 1000; time += 2500)
         {
-            FAIL() << "XILINX_UNISIM gate library not found";
+            times.push_back(time);
         }
 
-        std::unique_ptr<Netlist> nl;
+        for (const auto& [net, net_events] : events)
         {
-            std::cout << "loading netlist: " << path_netlist << "..." << std::endl;
-            if (utils::file_exists(path_netlist_hal))
+            // the waveform holds the same value changes as the events
+            const Waveform& waveform = state.get_waveform(net);
+            ASSERT_EQ(waveform.times.size(), net_events.size());
+            ASSERT_EQ(waveform.values.size(), net_events.size());
+            for (u32 i = 0; i < net_events.size(); ++i)
             {
-                std::cout << ".hal file found for test netlist, loading this one." << std::endl;
-                nl = netlist_serializer::deserialize_from_file(path_netlist_hal);
-            }
-            else
-            {
-                NO_COUT_BLOCK;
-                nl = netlist_parser_manager::parse(path_netlist, lib);
-                netlist_serializer::serialize_to_file(nl.get(), path_netlist_hal);
+                EXPECT_EQ(waveform.times[i], net_events[i].time);
+                EXPECT_EQ(waveform.values[i], net_events[i].new_value);
             }
-            if (nl == nullptr)
+
+            // point queries match a linear scan of the events
+            std::vector<SignalValue> values = state.get_net_values(net, times);
+            ASSERT_EQ(values.size(), times.size());
+            for (u32 i = 0; i < times.size(); ++i)
             {
-                FAIL() << "netlist couldn't be parsed";
+                SignalValue expected = SignalValue::X;
+                for (const auto& e : net_events)
+                {
+                    if (e.time > times[i])
+                    {
+                        break;
+                    }
+                    expected = e.new_value;
+                }
+                EXPECT_EQ(values[i], expected);
+                EXPECT_EQ(state.get_net_value(net, times[i]), expected);
             }
+
+            // range queries return exactly the events within the timeframe
+            std::vector<Event> expected_range;
+            std::copy_if(net_events.begin(), net_events.end(), std::back_inserter(expected_range), [](const Event& e) { return e.time >= 500 * 1000 && e.time < 1000 * 1000; });
+            EXPECT_EQ(state.get_net_events(net, 500 * 1000, 1000 * 1000), expected_range);
+            auto [first, last] = waveform.get_range(500 * 1000, 1000 * 1000);
+            EXPECT_EQ(last - first, expected_range.size());
         }
 
-        //path to vcd
-        std::string path_vcd = utils::get_base_directory().string() + "/bin/hal_plugins/test-files/sha256/dump.vcd";
-        if (!utils::file_exists(path_vcd))
-            FAIL() << "dump for sha256 not found: " << path_vcd;
+        // nets without value changes have an empty waveform
+        Simulation empty;
+        EXPECT_TRUE(empty.get_waveform(clock).times.empty());
+        EXPECT_EQ(empty.get_net_value(clock, 1000), SignalValue::X);
 
-        //read vcd and transform to vector of states, clock = 10000 ps = 10 ns
-        Simulation vcd_traces = parse_vcd(nl.get(), path_vcd, true);
+        // custom events are inserted in time order
+        for (u64 time : {3000, 1000, 2000})
+        {
+            Event e;
+            e.affected_net = clock;
+            e.new_value    = (time == 2000) ? SignalValue::ONE : SignalValue::ZERO;
+            e.time         = time;
+            e.id           = 0;
+            empty.add_event(e);
+        }
+        EXPECT_EQ(empty.get_waveform(clock).times, std::vector<u64>({1000, 2000, 3000}));
+        EXPECT_EQ(empty.get_net_value(clock, 2500), SignalValue::ONE);
+        EXPECT_EQ(empty.get_net_value(clock, 500), SignalValue::X);
+
+        TEST_END
+    }
+
+    TEST_F(SimulatorTest, counter_checkpoint)
+    {
+        TEST_START
+
+        auto plugin = plugin_manager::get_plugin_instance<NetlistSimulatorPlugin>("netlist_simulator");
+        auto sim    = plugin->create_simulator();
+
+        auto counter = load_counter_netlist();
+        ASSERT_NE(counter.nl, nullptr);
+        auto& nl            = counter.nl;
+        auto reset          = counter.reset;
+        auto clock          = counter.clock;
+        auto Clock_enable_B = counter.clock_enable_b;
 
-        //prepare simulation
         sim->add_gates(nl->get_gates());
         sim->load_initial_values_from_netlist();
+        sim->add_clock_period(clock, 10000);
 
-        // retrieve nets
-        auto clk = *(nl->get_nets([](auto net) { return net->get_name() == "clk"; }).begin());
+        // the checkpoint is created in the middle of a clock period
+        sim->set_input(Clock_enable_B, SignalValue::ZERO);
+        sim->set_input(reset, SignalValue::ONE);
+        sim->simulate(20 * 1000);
+        sim->set_input(reset, SignalValue::ZERO);
+        sim->simulate(123456);
 
-        sim->add_clock_period(clk, 10000);
+        SimulationCheckpoint checkpoint = sim->create_checkpoint();
+        u64 checkpoint_time             = checkpoint.get_time();
+        EXPECT_EQ(checkpoint_time, 20 * 1000 + 123456u);
 
-        auto start = *(nl->get_nets([](auto net) { return net->get_name() == "data_ready"; }).begin());
+        sim->simulate(500 * 1000);
+        Simulation reference = sim->get_simulation_state();
 
-        auto rst = *(nl->get_nets([](auto net) { return net->get_name() == "rst"; }).begin());
+        auto get_branch = [&](const Simulation& state) {
+            std::map<u32, std::vector<Event>> events;
+            for (Net* net : nl->get_nets())
+            {
+                Event e;
+                e.affected_net = net;
+                e.new_value    = state.get_net_value(net, checkpoint_time);
+                e.time         = checkpoint_time;
+                events[net->get_id()].push_back(e);
+                auto net_events = state.get_net_events(net, checkpoint_time + 1, ~0ull);
+                events[net->get_id()].insert(events[net->get_id()].end(), net_events.begin(), net_events.end());
+            }
+            return events;
+        };
+        auto expected = get_branch(reference);
 
-        std::vector<Net*> input_bits;
-        for (int i = 0; i < 512; i++)
+        for (Net* net : nl->get_nets())
         {
-            std::string name = "msg_block_in_" + std::to_string(i);
-            input_bits.push_back(*(nl->get_nets([name](auto net) { return net->get_name() == name; }).begin()));
+            EXPECT_EQ(checkpoint.get_net_value(net), reference.get_net_value(net, checkpoint_time)) << "net " << net->get_name();
         }
 
-        int input_nets_amount = input_bits.size();
+        // a different branch stops the counter
+        sim->restore_checkpoint(checkpoint);
+        sim->set_input(Clock_enable_B, SignalValue::ONE);
+        sim->simulate(500 * 1000);
+        EXPECT_NE(get_branch(sim->get_simulation_state()), expected);
 
-        if (clk != nullptr)
-            input_nets_amount++;
+        // returning to the checkpoint and replaying the original stimuli yields the original results
+        sim->restore_checkpoint(checkpoint);
+        sim->simulate(500 * 1000);
+        EXPECT_EQ(get_branch(sim->get_simulation_state()), expected);
 
-        if (rst != nullptr)
-            input_nets_amount++;
+        // so does a fork of the simulator, independently of the original one
+        auto forked = sim->fork(checkpoint);
+        sim->reset();
+        forked->simulate(500 * 1000);
+        EXPECT_EQ(get_branch(forked->get_simulation_state()), expected);
 
-        if (start != nullptr)
-            input_nets_amount++;
+        TEST_END
+    }
 
-        if (input_nets_amount != sim->get_input_nets().size())
-            FAIL() << "not all input nets set: actual " << input_nets_amount << " vs. " << sim->get_input_nets().size();
+    TEST_F(SimulatorTest, counter_vcd_stimulus)
+    {
+        TEST_START
 
-        //start simulation
-        std::cout << "starting simulation" << std::endl;
-        //testbench
+        auto plugin = plugin_manager::get_plugin_instance<NetlistSimulatorPlugin>("netlist_simulator");
 
-        {
-            measure_block_time("simulation");
+        auto counter = load_counter_netlist();
+        ASSERT_NE(counter.nl, nullptr);
+        auto& nl            = counter.nl;
+        auto reset          = counter.reset;
+        auto clock          = counter.clock;
+        auto Clock_enable_B = counter.clock_enable_b;
 
-            // msg <= x"61626380000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000018";
-            std::string hex_input = "61626380000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000018";
-            for (u32 i = 0; i < hex_input.size(); i += 2)
+        // the testbench drives reset and enable through a vector, the clock is declared in two scopes
+        std::string path_vcd = utils::get_binary_directory().string() + "/tmp_stimulus.vcd";
+        {
+            std::ofstream vcd(path_vcd);
+            vcd << "$date today $end\n$timescale 1 ns $end\n";
+            vcd << "$scope module tb $end\n$var wire 1 ! Clock $end\n$var wire 2 \" ctrl [1:0] $end\n$var wire 4 # unused $end\n";
+            vcd << "$scope module uut $end\n$var wire 1 ! Clock $end\n$upscope $end\n$upscope $end\n$enddefinitions $end\n";
+            vcd << "#0\n$dumpvars\n0!\nb1 \"\nbx #\n$end\n";
+            for (u32 t = 5; t < 1000; t += 5)
             {
-                u8 byte = std::stoul(hex_input.substr(i, 2), nullptr, 16);
-                for (u32 j = 0; j < 8; ++j)
+                vcd << "#" << t << "\n" << ((t % 10 == 5) ? "1!" : "0!") << "\n";
+                if (t == 20)
                 {
-                    sim->set_input(input_bits[i * 4 + j], (SignalValue)((byte >> (7 - j)) & 1));
+                    vcd << "$comment release reset $end\nb0 \"\nb1010 #\n";
                 }
             }
+        }
 
-            sim->set_input(rst, SignalValue::ONE);       //RST <= '1';
-            sim->set_input(start, SignalValue::ZERO);    //START <= '0';
-            sim->simulate(10 * 1000);                    //WAIT FOR 10 NS;
+        auto reference = plugin->create_simulator();
+        reference->add_gates(nl->get_gates());
+        reference->load_initial_values_from_netlist();
+        reference->add_clock_period(clock, 10000);
+        reference->set_input(Clock_enable_B, SignalValue::ZERO);
+        reference->set_input(reset, SignalValue::ONE);
+        reference->simulate(20 * 1000);
+        reference->set_input(reset, SignalValue::ZERO);
+        reference->simulate(980 * 1000);
+
+        auto sim = plugin->create_simulator();
+        sim->add_gates(nl->get_gates());
+        sim->load_initial_values_from_netlist();
+        EXPECT_FALSE(sim->load_vcd_stimulus(utils::get_binary_directory().string() + "/tmp_missing.vcd"));
+        ASSERT_TRUE(sim->load_vcd_stimulus(path_vcd, {{"Clock", clock}, {"ctrl[0]", reset}, {"ctrl[1]", Clock_enable_B}}));
 
-            sim->set_input(rst, SignalValue::ZERO);    //RST <= '0';
+        // the simulated periods do not align with the changes in the file
+        for (u32 i = 0; i < 142; ++i)
+        {
+            sim->simulate(7 * 1000);
+        }
+        sim->simulate(6 * 1000);
+
+        for (Net* net : nl->get_nets())
+        {
+            EXPECT_EQ(sim->get_simulation_state().get_net_events(net, 0, ~0ull), reference->get_simulation_state().get_net_events(net, 0, ~0ull)) << "net " << net->get_name();
+        }
+
+        TEST_END
+    }
+
+    TEST_F(SimulatorTest, counter_simulate_cycles)
+    {
+        TEST_START
+
+        auto plugin = plugin_manager::get_plugin_instance<NetlistSimulatorPlugin>("netlist_simulator");
+
+        auto counter = load_counter_netlist();
+        ASSERT_NE(counter.nl, nullptr);
+        auto& nl            = counter.nl;
+        auto reset          = counter.reset;
+        auto clock          = counter.clock;
+        auto Clock_enable_B = counter.clock_enable_b;
+
+        std::vector<Net*> inputs = {reset, Clock_enable_B};
+        std::vector<Net*> outputs;
+        for (u32 i = 0; i < 4; ++i)
+        {
+            outputs.push_back(*(nl->get_nets([i](auto net) { return net->get_name() == "Output_" + std::to_string(i); }).begin()));
+        }
+
+        // reset, count, pause, and reset again
+        std::vector<SignalValue> stimuli;
+        for (u32 cycle = 0; cycle < 50; ++cycle)
+        {
+            stimuli.push_back((cycle < 2 || cycle == 40) ? SignalValue::ONE : SignalValue::ZERO);
+            stimuli.push_back((cycle >= 20 && cycle < 25) ? SignalValue::ONE : SignalValue::ZERO);
+        }
+
+        auto reference = plugin->create_simulator();
+        auto sim       = plugin->create_simulator();
+        for (auto s : {reference.get(), sim.get()})
+        {
+            s->add_gates(nl->get_gates());
+            s->load_initial_values_from_netlist();
+            s->add_clock_period(clock, 10000);
+        }
+
+        std::vector<SignalValue> expected;
+        for (u32 cycle = 0; cycle < 50; ++cycle)
+        {
+            reference->set_input(reset, stimuli[2 * cycle]);
+            reference->set_input(Clock_enable_B, stimuli[2 * cycle + 1]);
+            reference->simulate(10000);
+            for (Net* net : outputs)
+            {
+                expected.push_back(reference->get_simulation_state().get_net_value(net, 10000 * (cycle + 1)));
+            }
+        }
+
+        EXPECT_TRUE(sim->simulate_cycles(inputs, std::vector<SignalValue>(3, SignalValue::ZERO), outputs, 10000).empty());
+        auto samples = sim->simulate_cycles(inputs, stimuli, outputs, 10000);
+        EXPECT_EQ(samples, expected);
+        EXPECT_EQ(sim->get_simulation_state().get_events(), reference->get_simulation_state().get_events());
+
+        // the counter is running after the first reset
+        EXPECT_NE(std::vector<SignalValue>(samples.begin() + 4 * 10, samples.begin() + 4 * 11), std::vector<SignalValue>(samples.begin() + 4 * 11, samples.begin() + 4 * 12));
+
+        TEST_END
+    }
+
+    TEST_F(SimulatorTest, counter_faults)
+    {
+        TEST_START
+
+        auto plugin = plugin_manager::get_plugin_instance<NetlistSimulatorPlugin>("netlist_simulator");
+
+        auto counter = load_counter_netlist();
+        ASSERT_NE(counter.nl, nullptr);
+        auto& nl            = counter.nl;
+        auto reset          = counter.reset;
+        auto clock          = counter.clock;
+        auto Clock_enable_B = counter.clock_enable_b;
+
+        std::vector<Net*> inputs = {reset, Clock_enable_B};
+        std::vector<Net*> outputs;
+        for (u32 i = 0; i < 4; ++i)
+        {
+            outputs.push_back(*(nl->get_nets([i](auto net) { return net->get_name() == "Output_" + std::to_string(i); }).begin()));
+        }
+
+        // reset, count, pause, and reset again
+        std::vector<SignalValue> stimuli;
+        for (u32 cycle = 0; cycle < 50; ++cycle)
+        {
+            stimuli.push_back((cycle < 2 || cycle == 40) ? SignalValue::ONE : SignalValue::ZERO);
+            stimuli.push_back((cycle >= 20 && cycle < 25) ? SignalValue::ONE : SignalValue::ZERO);
+        }
+
+        auto reference = plugin->create_simulator();
+        auto sim       = plugin->create_simulator();
+        for (auto s : {reference.get(), sim.get()})
+        {
+            s->add_gates(nl->get_gates());
+            s->load_initial_values_from_netlist();
+            s->add_clock_period(clock, 10000);
+        }
+        reference->set_simulation_mode(SimulationMode::cycle_based);
+        sim->set_simulation_mode(SimulationMode::bit_parallel);
+        auto golden = reference->simulate_cycles(inputs, stimuli, outputs, 10000);
+
+        // stuck-at faults on all outputs, a bit flip while the counter is paused, and a bit flip after the last cycle
+        std::vector<Fault> faults;
+        for (Net* net : outputs)
+        {
+            faults.push_back({FaultType::stuck_at_0, net, 0});
+            faults.push_back({FaultType::stuck_at_1, net, 0});
+        }
+        faults.push_back({FaultType::bit_flip, outputs[0], 22 * 10000 + 6000});
+        faults.push_back({FaultType::bit_flip, outputs[0], 50 * 10000 + 6000});
+        u32 fault_count = faults.size();
+
+        // more faults than lanes to simulate several batches
+        while (faults.size() <= NetlistSimulator::LANE_COUNT)
+        {
+            faults.insert(faults.end(), faults.begin(), faults.begin() + fault_count);
+        }
+
+        EXPECT_TRUE(reference->simulate_faults(faults, inputs, stimuli, outputs, 10000).empty());
+        EXPECT_TRUE(sim->simulate_faults({{FaultType::stuck_at_0, nullptr, 0}}, inputs, stimuli, outputs, 10000).empty());
+
+        sim->set_thread_count(2);
+        auto events  = sim->get_simulation_state().get_events();
+        auto results = sim->simulate_faults(faults, inputs, stimuli, outputs, 10000);
+        ASSERT_EQ(results.size(), faults.size());
+
+        // the simulation state is not modified
+        EXPECT_EQ(sim->get_simulation_state().get_events(), events);
+
+        for (u32 i = 0; i < outputs.size(); ++i)
+        {
+            for (u32 j = 0; j < 2; ++j)
+            {
+                // the stuck output differs from the fault-free simulation whenever it does not carry the stuck value
+                SignalValue value = (j == 0) ? SignalValue::ZERO : SignalValue::ONE;
+                u64 first         = 50;
+                u64 mismatches    = 0;
+                for (u64 cycle = 0; cycle < 50; ++cycle)
+                {
+                    if (golden[cycle * outputs.size() + i] != value)
+                    {
+                        first = std::min(first, cycle);
+                        mismatches++;
+                    }
+                }
+
+                const auto& result = results[2 * i + j];
+                EXPECT_TRUE(result.detected);
+                EXPECT_LE(result.first_detection_cycle, first);
+                EXPECT_GE(result.corrupted_samples, mismatches);
+                EXPECT_GE(result.corrupted_samples, result.corrupted_cycles);
+            }
+        }
+
+        EXPECT_TRUE(results[fault_count - 2].detected);
+        EXPECT_EQ(results[fault_count - 2].first_detection_cycle, 22u);
+        EXPECT_EQ(results[fault_count - 2].corrupted_state_nets, 0u);
+
+        EXPECT_FALSE(results[fault_count - 1].detected);
+        EXPECT_EQ(results[fault_count - 1].first_detection_cycle, 50u);
+        EXPECT_EQ(results[fault_count - 1].corrupted_cycles, 0u);
+        EXPECT_EQ(results[fault_count - 1].corrupted_state_nets, 0u);
+
+        // the results do not depend on the batch
+        for (u32 i = fault_count; i < faults.size(); ++i)
+        {
+            const auto& a = results[i];
+            const auto& b = results[i % fault_count];
+            EXPECT_EQ(a.detected, b.detected);
+            EXPECT_EQ(a.first_detection_cycle, b.first_detection_cycle);
+            EXPECT_EQ(a.corrupted_cycles, b.corrupted_cycles);
+            EXPECT_EQ(a.corrupted_samples, b.corrupted_samples);
+            EXPECT_EQ(a.corrupted_state_nets, b.corrupted_state_nets);
+        }
+
+        // a stuck-at fault behaves like tying the net to GND or VCC in a copy of the netlist
+        for (u32 i : {0u, 3u})
+        {
+            for (u32 j = 0; j < 2; ++j)
+            {
+                auto faulty = load_counter_netlist();
+                ASSERT_NE(faulty.nl, nullptr);
+
+                std::vector<Net*> faulty_outputs;
+                for (Net* net : outputs)
+                {
+                    faulty_outputs.push_back(*(faulty.nl->get_nets([net](auto n) { return n->get_name() == net->get_name(); }).begin()));
+                }
+
+                // the original drivers keep a net of their own, all destinations see the constant
+                Net* stuck_net = faulty_outputs[i];
+                Net* cut_net   = faulty.nl->create_net(stuck_net->get_name() + "_cut");
+                for (Endpoint* ep : stuck_net->get_sources())
+                {
+                    Gate* driver    = ep->get_gate();
+                    std::string pin = ep->get_pin();
+                    stuck_net->remove_source(ep);
+                    cut_net->add_source(driver, pin);
+                }
+
+                GateType* tie_type = faulty.nl->get_gate_library()->get_gate_type_by_name((j == 0) ? "GND" : "VCC");
+                ASSERT_NE(tie_type, nullptr);
+                Gate* tie = faulty.nl->create_gate(tie_type, "stuck");
+                stuck_net->add_source(tie, tie_type->get_output_pins().front());
+                if (j == 0)
+                {
+                    tie->mark_gnd_gate();
+                }
+                else
+                {
+                    tie->mark_vcc_gate();
+                }
+
+                auto faulty_sim = plugin->create_simulator();
+                faulty_sim->add_gates(faulty.nl->get_gates());
+                faulty_sim->load_initial_values_from_netlist();
+                faulty_sim->add_clock_period(faulty.clock, 10000);
+                faulty_sim->set_simulation_mode(SimulationMode::cycle_based);
+                auto samples = faulty_sim->simulate_cycles({faulty.reset, faulty.clock_enable_b}, stimuli, faulty_outputs, 10000);
+                ASSERT_EQ(samples.size(), golden.size());
+
+                u64 first     = 50;
+                u64 corrupted = 0;
+                for (u64 k = 0; k < samples.size(); ++k)
+                {
+                    if (samples[k] != golden[k])
+                    {
+                        first = std::min(first, k / outputs.size());
+                        corrupted++;
+                    }
+                }
+
+                const auto& result = results[2 * i + j];
+                EXPECT_EQ(result.first_detection_cycle, first) << "stuck-at-" << j << " on " << outputs[i]->get_name();
+                EXPECT_EQ(result.corrupted_samples, corrupted) << "stuck-at-" << j << " on " << outputs[i]->get_name();
+            }
+        }
+
+        TEST_END
+    }
+
+    TEST_F(SimulatorTest, counter_profiling)
+    {
+        TEST_START
+
+        auto plugin = plugin_manager::get_plugin_instance<NetlistSimulatorPlugin>("netlist_simulator");
+
+        auto counter = load_counter_netlist();
+        ASSERT_NE(counter.nl, nullptr);
+        auto& nl            = counter.nl;
+        auto reset          = counter.reset;
+        auto clock          = counter.clock;
+        auto Clock_enable_B = counter.clock_enable_b;
+
+        std::vector<SignalValue> stimuli;
+        for (u32 cycle = 0; cycle < 50; ++cycle)
+        {
+            stimuli.push_back((cycle < 2) ? SignalValue::ONE : SignalValue::ZERO);
+            stimuli.push_back(SignalValue::ZERO);
+        }
+
+        for (auto mode : {SimulationMode::event_driven, SimulationMode::cycle_based, SimulationMode::bit_parallel})
+        {
+            auto sim = plugin->create_simulator();
+            sim->set_simulation_mode(mode);
+            sim->add_gates(nl->get_gates());
+            sim->load_initial_values_from_netlist();
+            sim->add_clock_period(clock, 10000);
+
+            // nothing is collected unless profiling is enabled
+            sim->simulate_cycles({reset, Clock_enable_B}, std::vector<SignalValue>(stimuli.begin(), stimuli.begin() + 4), {}, 10000);
+            EXPECT_FALSE(sim->is_profiling_enabled());
+            EXPECT_EQ(sim->get_profile().events, 0u);
+            EXPECT_EQ(sim->get_profile().gate_evaluations, 0u);
+
+            sim->set_profiling_enabled(true);
+            EXPECT_TRUE(sim->is_profiling_enabled());
+            sim->simulate_cycles({reset, Clock_enable_B}, stimuli, {}, 10000);
+
+            auto profile = sim->get_profile(3);
+            EXPECT_GE(profile.timesteps, 100u);
+            EXPECT_GE(profile.events, profile.timesteps);
+            EXPECT_GE(profile.max_events_per_timestep, 1u);
+            EXPECT_GE(profile.delta_cycles, profile.timesteps);
+            EXPECT_GE(profile.max_delta_cycles_per_timestep, 1u);
+            EXPECT_GE(profile.queue_high_water_mark, 1u);
+
+            u64 evaluations = 0;
+            for (const auto& [type, count] : profile.gate_evaluations_per_type)
+            {
+                evaluations += count;
+            }
+            EXPECT_GT(profile.gate_evaluations, 0u);
+            EXPECT_EQ(profile.gate_evaluations, evaluations);
+
+            ASSERT_EQ(profile.hot_gates.size(), 3u);
+            EXPECT_GE(profile.hot_gates[0].second, profile.hot_gates[1].second);
+            EXPECT_GE(profile.hot_gates[1].second, profile.hot_gates[2].second);
+            EXPECT_LE(profile.glitching_nets.size(), 3u);
+
+            std::string json = profile.to_json();
+            EXPECT_EQ(json.front(), '{');
+            EXPECT_EQ(json.back(), '}');
+            EXPECT_NE(json.find("\"hot_gates\":[{\"id\":" + std::to_string(profile.hot_gates[0].first->get_id())), std::string::npos);
+
+            sim->reset_profile();
+            EXPECT_EQ(sim->get_profile().events, 0u);
+            EXPECT_EQ(sim->get_profile().gate_evaluations, 0u);
+            EXPECT_TRUE(sim->get_profile().hot_gates.empty());
+        }
+
+        TEST_END
+    }
+
+    TEST_F(SimulatorTest, combinational_loops)
+    {
+        TEST_START
+
+        auto plugin = plugin_manager::get_plugin_instance<NetlistSimulatorPlugin>("netlist_simulator");
+        auto sim    = plugin->create_simulator();
+
+        auto lib = gate_library_manager::get_gate_library_by_name("XILINX_UNISIM");
+        if (lib == nullptr)
+        {
+            FAIL() << "XILINX_UNISIM gate library not found";
+        }
+
+        // a ring of three inverters that drives a chain of two inverters
+        auto nl = netlist_factory::create_netlist(lib);
+        std::vector<Gate*> ring;
+        std::vector<Net*> ring_nets;
+        for (u32 i = 0; i < 3; ++i)
+        {
+            ring.push_back(nl->create_gate(lib->get_gate_type_by_name("INV"), "ring_" + std::to_string(i)));
+            ring_nets.push_back(nl->create_net("ring_net_" + std::to_string(i)));
+        }
+        for (u32 i = 0; i < 3; ++i)
+        {
+            ring_nets[i]->add_source(ring[i], "O");
+            ring_nets[i]->add_destination(ring[(i + 1) % 3], "I");
+        }
+        Gate* chain_0    = nl->create_gate(lib->get_gate_type_by_name("INV"), "chain_0");
+        Gate* chain_1    = nl->create_gate(lib->get_gate_type_by_name("INV"), "chain_1");
+        Net* chain_net_0 = nl->create_net("chain_net_0");
+        Net* chain_net_1 = nl->create_net("chain_net_1");
+        ring_nets[2]->add_destination(chain_0, "I");
+        chain_net_0->add_source(chain_0, "O");
+        chain_net_0->add_destination(chain_1, "I");
+        chain_net_1->add_source(chain_1, "O");
+
+        sim->add_gates(nl->get_gates());
+
+        // only the ring is reported
+        auto loops = sim->get_combinational_loops();
+        ASSERT_EQ(loops.size(), 1u);
+        EXPECT_EQ(loops[0], ring);
+
+        // forcing a value onto the ring makes it oscillate, it is resolved to X instead of running into the iteration timeout
+        {
+            NO_COUT_BLOCK;
+            sim->set_input(ring_nets[0], SignalValue::ONE);
+            sim->simulate(1000);
+        }
+        auto state = sim->get_simulation_state();
+        for (Net* net : ring_nets)
+        {
+            EXPECT_EQ(state.get_net_value(net, 500), SignalValue::X);
+            EXPECT_EQ(state.get_waveform(net).times.size(), 1u);
+        }
+        EXPECT_EQ(state.get_net_value(chain_net_1, 500), SignalValue::X);
+
+        TEST_END
+    }
+
+    TEST_F(SimulatorTest, lut_evaluation)
+    {
+        TEST_START
+
+        auto plugin = plugin_manager::get_plugin_instance<NetlistSimulatorPlugin>("netlist_simulator");
+
+        // LUTs with a descending and an ascending configuration, the former with more than six inputs
+        auto lib = std::make_unique<GateLibrary>("imaginary_path", "LUT_LIBRARY");
+        for (u32 inputs : {3u, 8u})
+        {
+            GateType* lut = lib->create_gate_type("LUT" + std::to_string(inputs), {GateTypeProperty::combinational, GateTypeProperty::lut});
+            for (u32 i = 0; i < inputs; ++i)
+            {
+                lut->add_pin("I" + std::to_string(i), PinDirection::input);
+            }
+            lut->add_pin("O", PinDirection::output, PinType::lut);
+            lut->set_config_data_category("generic");
+            lut->set_config_data_identifier("INIT");
+            lut->set_lut_init_ascending(inputs == 3);
+        }
+
+        auto nl = netlist_factory::create_netlist(lib.get());
+        std::vector<Net*> inputs;
+        for (u32 i = 0; i < 8; ++i)
+        {
+            inputs.push_back(nl->create_net("in_" + std::to_string(i)));
+            nl->mark_global_input_net(inputs.back());
+        }
+
+        // the 8-input LUT computes the parity of its inputs
+        Gate* parity = nl->create_gate(lib->get_gate_type_by_name("LUT8"), "parity");
+        std::string parity_init;
+        for (u32 digit = 0; digit < 64; ++digit)
+        {
+            u32 value = 0;
+            for (u32 bit = 0; bit < 4; ++bit)
+            {
+                u32 index = 4 * (63 - digit) + bit;
+                value |= (std::bitset<8>(index).count() % 2) << bit;
+            }
+            parity_init += "0123456789ABCDEF"[value];
+        }
+        parity->set_data("generic", "INIT", "bit_vector", parity_init);
+        for (u32 i = 0; i < 8; ++i)
+        {
+            inputs[i]->add_destination(parity, "I" + std::to_string(i));
+        }
+        Net* parity_out = nl->create_net("parity_out");
+        parity_out->add_source(parity, "O");
+
+        // the 3-input LUT computes I0 & !I1, I2 is left unconnected
+        Gate* select = nl->create_gate(lib->get_gate_type_by_name("LUT3"), "select");
+        select->set_data("generic", "INIT", "bit_vector", "44");
+        inputs[0]->add_destination(select, "I0");
+        inputs[1]->add_destination(select, "I1");
+        Net* select_out = nl->create_net("select_out");
+        select_out->add_source(select, "O");
+
+        auto sim = plugin->create_simulator();
+        sim->add_gates(nl->get_gates());
+
+        u64 time = 0;
+        auto apply = [&](u32 index, SignalValue value_1) {
+            for (u32 i = 0; i < 8; ++i)
+            {
+                sim->set_input(inputs[i], (i == 1) ? value_1 : (((index >> i) & 1) ? SignalValue::ONE : SignalValue::ZERO));
+            }
+            sim->simulate(1000);
+            time += 1000;
+        };
+
+        for (u32 index = 0; index < 256; ++index)
+        {
+            apply(index, ((index >> 1) & 1) ? SignalValue::ONE : SignalValue::ZERO);
+            EXPECT_EQ(sim->get_simulation_state().get_net_value(parity_out, time), (std::bitset<8>(index).count() % 2) ? SignalValue::ONE : SignalValue::ZERO) << "inputs " << index;
+            EXPECT_EQ(sim->get_simulation_state().get_net_value(select_out, time), ((index & 3) == 1) ? SignalValue::ONE : SignalValue::ZERO) << "inputs " << index;
+        }
+
+        // an unknown input only yields X if it affects the result
+        apply(0, SignalValue::X);
+        EXPECT_EQ(sim->get_simulation_state().get_net_value(parity_out, time), SignalValue::X);
+        EXPECT_EQ(sim->get_simulation_state().get_net_value(select_out, time), SignalValue::ZERO);
+        apply(1, SignalValue::X);
+        EXPECT_EQ(sim->get_simulation_state().get_net_value(select_out, time), SignalValue::X);
+
+        TEST_END
+    }
+
+    TEST_F(SimulatorTest, toycipher)
+    {
+        // return;
+        TEST_START
+
+        auto plugin = plugin_manager::get_plugin_instance<NetlistSimulatorPlugin>("netlist_simulator");
+        auto sim    = plugin->create_simulator();
+
+        //path to netlist
+        std::string path_netlist = utils::get_base_directory().string() + "/bin/hal_plugins/test-files/toycipher/cipher_flat.vhd";
+        if (!utils::file_exists(path_netlist))
+            FAIL() << "netlist for toycipher-test not found: " << path_netlist;
+
+        //create netlist from path
+        auto lib = gate_library_manager::get_gate_library_by_name("XILINX_UNISIM");
+        if (lib == nullptr)
+        {
+            FAIL() << "XILINX_UNISIM gate library not found";
+        }
+
+        std::unique_ptr<Netlist> nl;
+        {
+            NO_COUT_BLOCK;
+            nl = netlist_parser_manager::parse(path_netlist, lib);
+            if (nl == nullptr)
+            {
+                FAIL() << "netlist couldn't be parsed";
+            }
+        }
+
+        //path to vcd
+        std::string path_vcd = utils::get_base_directory().string() + "/bin/hal_plugins/test-files/toycipher/dump.vcd";
+        if (!utils::file_exists(path_vcd))
+            FAIL() << "dump for toycipher-test not found: " << path_vcd;
+
+        //read vcd and transform to vector of states, clock = 10000 ps = 10 ns
+        Simulation vcd_traces = parse_vcd(nl.get(), path_vcd, true);
+
+        //prepare simulation
+        sim->add_gates(nl->get_gates());
+        sim->load_initial_values_from_netlist();
+
+        // retrieve nets
+        auto clk = *(nl->get_nets([](auto net) { return net->get_name() == "CLK"; }).begin());
+
+        sim->add_clock_period(clk, 10000);
+
+        std::set<Net*> key_set, plaintext_set;
+        auto start = *(nl->get_nets([](auto net) { return net->get_name() == "START"; }).begin());
+
+        for (int i = 0; i < 16; i++)
+        {
+            std::string name = "KEY_" + std::to_string(i);
+            key_set.insert(*(nl->get_nets([name](auto net) { return net->get_name() == name; }).begin()));
+        }
+
+        for (int i = 0; i < 16; i++)
+        {
+            std::string name = "PLAINTEXT_" + std::to_string(i);
+            plaintext_set.insert(*(nl->get_nets([name](auto net) { return net->get_name() == name; }).begin()));
+        }
+
+        int input_nets_amount = key_set.size() + plaintext_set.size();
+
+        if (clk != nullptr)
+            input_nets_amount++;
+
+        if (start != nullptr)
+            input_nets_amount++;
+
+        if (input_nets_amount != sim->get_input_nets().size())
+            FAIL() << "not all input nets set: actual " << input_nets_amount << " vs. " << sim->get_input_nets().size();
+
+        //start simulation
+        {
+            measure_block_time("simulation");
+            //testbench
+
+            for (auto net : plaintext_set)    //PLAINTEXT <= (OTHERS => '0');
+                sim->set_input(net, SignalValue::ZERO);
+
+            for (auto net : key_set)    //KEY <= (OTHERS => '0');
+                sim->set_input(net, SignalValue::ZERO);
+
+            sim->set_input(start, SignalValue::ZERO);    //START <= '0';
+            sim->simulate(10 * 1000);                    //WAIT FOR 10 NS;
+
+            sim->set_input(start, SignalValue::ONE);    //START <= '1';
+            sim->simulate(10 * 1000);                   //WAIT FOR 10 NS;
+
+            sim->set_input(start, SignalValue::ZERO);    //START <= '0';
+            sim->simulate(100 * 1000);                   //WAIT FOR 100 NS;
+
+            for (auto net : plaintext_set)    //PLAINTEXT <= (OTHERS => '1');
+                sim->set_input(net, SignalValue::ONE);
+
+            for (auto net : key_set)    //KEY <= (OTHERS => '1');
+                sim->set_input(net, SignalValue::ONE);
+
+            sim->set_input(start, SignalValue::ZERO);    //START <= '0';
+            sim->simulate(10 * 1000);                    //WAIT FOR 10 NS;
+
+            sim->set_input(start, SignalValue::ONE);    //START <= '1';
+            sim->simulate(10 * 1000);                   //WAIT FOR 10 NS;
+
+            sim->set_input(start, SignalValue::ZERO);    //START <= '0';
+            sim->simulate(100 * 1000);                   //WAIT FOR 100 NS;
+
+            for (auto net : plaintext_set)    //PLAINTEXT <= (OTHERS => '0');
+                sim->set_input(net, SignalValue::ZERO);
+
+            for (auto net : key_set)    //KEY <= (OTHERS => '0');
+                sim->set_input(net, SignalValue::ZERO);
+
+            sim->set_input(start, SignalValue::ZERO);    //START <= '0';
+
+            sim->simulate(10 * 1000);
+            sim->set_input(start, SignalValue::ONE);    //START <= '1';
+
+            sim->simulate(10 * 1000);
+            sim->set_input(start, SignalValue::ZERO);    //START <= '0';
+
+            sim->simulate(30 * 1000);
+        }
+
+        //Test if maps are equal
+        EXPECT_TRUE(cmp_sim_data(vcd_traces, sim->get_simulation_state()));
+        TEST_END
+    }
+
+    TEST_F(SimulatorTest, toycipher_cycle_based)
+    {
+        TEST_START
+
+        auto plugin = plugin_manager::get_plugin_instance<NetlistSimulatorPlugin>("netlist_simulator");
+
+        //path to netlist
+        std::string path_netlist = utils::get_base_directory().string() + "/bin/hal_plugins/test-files/toycipher/cipher_flat.vhd";
+        if (!utils::file_exists(path_netlist))
+            FAIL() << "netlist for toycipher-test not found: " << path_netlist;
+
+        //create netlist from path
+        auto lib = gate_library_manager::get_gate_library_by_name("XILINX_UNISIM");
+        if (lib == nullptr)
+        {
+            FAIL() << "XILINX_UNISIM gate library not found";
+        }
+
+        std::unique_ptr<Netlist> nl;
+        {
+            NO_COUT_BLOCK;
+            nl = netlist_parser_manager::parse(path_netlist, lib);
+            if (nl == nullptr)
+            {
+                FAIL() << "netlist couldn't be parsed";
+            }
+        }
+
+        //path to vcd
+        std::string path_vcd = utils::get_base_directory().string() + "/bin/hal_plugins/test-files/toycipher/dump.vcd";
+        if (!utils::file_exists(path_vcd))
+            FAIL() << "dump for toycipher-test not found: " << path_vcd;
+
+        //read vcd and transform to vector of states, clock = 10000 ps = 10 ns
+        Simulation vcd_traces = parse_vcd(nl.get(), path_vcd, true);
+
+        // retrieve nets
+        auto clk   = *(nl->get_nets([](auto net) { return net->get_name() == "CLK"; }).begin());
+        auto start = *(nl->get_nets([](auto net) { return net->get_name() == "START"; }).begin());
+
+        std::set<Net*> key_set, plaintext_set;
+        for (int i = 0; i < 16; i++)
+        {
+            std::string name = "KEY_" + std::to_string(i);
+            key_set.insert(*(nl->get_nets([name](auto net) { return net->get_name() == name; }).begin()));
+        }
+
+        for (int i = 0; i < 16; i++)
+        {
+            std::string name = "PLAINTEXT_" + std::to_string(i);
+            plaintext_set.insert(*(nl->get_nets([name](auto net) { return net->get_name() == name; }).begin()));
+        }
+
+        auto run_testbench = [&](NetlistSimulator* sim) {
+            sim->add_gates(nl->get_gates());
+            sim->load_initial_values_from_netlist();
+            sim->add_clock_period(clk, 10000);
+
+            for (u32 round = 0; round < 3; ++round)
+            {
+                SignalValue value = (round == 1) ? SignalValue::ONE : SignalValue::ZERO;
+                for (auto net : plaintext_set)
+                    sim->set_input(net, value);
+
+                for (auto net : key_set)
+                    sim->set_input(net, value);
+
+                sim->set_input(start, SignalValue::ZERO);    //START <= '0';
+                sim->simulate(10 * 1000);                    //WAIT FOR 10 NS;
+
+                sim->set_input(start, SignalValue::ONE);    //START <= '1';
+                sim->simulate(10 * 1000);                   //WAIT FOR 10 NS;
+
+                sim->set_input(start, SignalValue::ZERO);           //START <= '0';
+                sim->simulate(((round == 2) ? 30 : 100) * 1000);    //WAIT FOR 100 NS;
+            }
+        };
+
+        auto event_driven_sim = plugin->create_simulator(SimulationMode::event_driven);
+        {
+            measure_block_time("event-driven simulation");
+            run_testbench(event_driven_sim.get());
+        }
+
+        auto cycle_based_sim = plugin->create_simulator(SimulationMode::cycle_based);
+        EXPECT_EQ(cycle_based_sim->get_simulation_mode(), SimulationMode::cycle_based);
+        {
+            measure_block_time("cycle-based simulation");
+            run_testbench(cycle_based_sim.get());
+        }
+
+        // both modes yield the same events
+        EXPECT_EQ(cycle_based_sim->get_simulation_state().get_events(), event_driven_sim->get_simulation_state().get_events());
+        EXPECT_TRUE(cmp_sim_data(vcd_traces, cycle_based_sim->get_simulation_state()));
+        TEST_END
+    }
+
+    TEST_F(SimulatorTest, toycipher_bit_parallel)
+    {
+        TEST_START
+
+        auto plugin = plugin_manager::get_plugin_instance<NetlistSimulatorPlugin>("netlist_simulator");
+
+        //path to netlist
+        std::string path_netlist = utils::get_base_directory().string() + "/bin/hal_plugins/test-files/toycipher/cipher_flat.vhd";
+        if (!utils::file_exists(path_netlist))
+            FAIL() << "netlist for toycipher-test not found: " << path_netlist;
+
+        //create netlist from path
+        auto lib = gate_library_manager::get_gate_library_by_name("XILINX_UNISIM");
+        if (lib == nullptr)
+        {
+            FAIL() << "XILINX_UNISIM gate library not found";
+        }
+
+        std::unique_ptr<Netlist> nl;
+        {
+            NO_COUT_BLOCK;
+            nl = netlist_parser_manager::parse(path_netlist, lib);
+            if (nl == nullptr)
+            {
+                FAIL() << "netlist couldn't be parsed";
+            }
+        }
+
+        //path to vcd
+        std::string path_vcd = utils::get_base_directory().string() + "/bin/hal_plugins/test-files/toycipher/dump.vcd";
+        if (!utils::file_exists(path_vcd))
+            FAIL() << "dump for toycipher-test not found: " << path_vcd;
+
+        //read vcd and transform to vector of states, clock = 10000 ps = 10 ns
+        Simulation vcd_traces = parse_vcd(nl.get(), path_vcd, true);
+
+        // retrieve nets
+        auto clk   = *(nl->get_nets([](auto net) { return net->get_name() == "CLK"; }).begin());
+        auto start = *(nl->get_nets([](auto net) { return net->get_name() == "START"; }).begin());
+
+        std::vector<Net*> data_nets;
+        for (int i = 0; i < 16; i++)
+        {
+            std::string name = "KEY_" + std::to_string(i);
+            data_nets.push_back(*(nl->get_nets([name](auto net) { return net->get_name() == name; }).begin()));
+        }
+
+        for (int i = 0; i < 16; i++)
+        {
+            std::string name = "PLAINTEXT_" + std::to_string(i);
+            data_nets.push_back(*(nl->get_nets([name](auto net) { return net->get_name() == name; }).begin()));
+        }
+
+        // lane 0 replays the original testbench, all other lanes encrypt random plaintexts under random keys
+        std::mt19937 rng(42);
+        std::vector<std::vector<std::vector<SignalValue>>> stimuli(3, std::vector<std::vector<SignalValue>>(NetlistSimulator::LANE_COUNT));
+        for (u32 round = 0; round < 3; ++round)
+        {
+            for (u32 lane = 0; lane < NetlistSimulator::LANE_COUNT; ++lane)
+            {
+                for (u32 i = 0; i < data_nets.size(); ++i)
+                {
+                    if (lane == 0)
+                    {
+                        stimuli[round][lane].push_back((round == 1) ? SignalValue::ONE : SignalValue::ZERO);
+                    }
+                    else
+                    {
+                        stimuli[round][lane].push_back((rng() & 1) ? SignalValue::ONE : SignalValue::ZERO);
+                    }
+                }
+            }
+        }
+
+        auto run_testbench = [&](NetlistSimulator* sim, const std::vector<u32>& lanes) {
+            sim->add_gates(nl->get_gates());
+            sim->load_initial_values_from_netlist();
+            sim->add_clock_period(clk, 10000);
+
+            for (u32 round = 0; round < 3; ++round)
+            {
+                for (u32 lane : lanes)
+                {
+                    for (u32 i = 0; i < data_nets.size(); ++i)
+                    {
+                        if (sim->get_simulation_mode() == SimulationMode::bit_parallel)
+                        {
+                            sim->set_lane_input(data_nets[i], lane, stimuli[round][lane][i]);
+                        }
+                        else
+                        {
+                            sim->set_input(data_nets[i], stimuli[round][lane][i]);
+                        }
+                    }
+                }
+
+                sim->set_input(start, SignalValue::ZERO);    //START <= '0';
+                sim->simulate(10 * 1000);                    //WAIT FOR 10 NS;
+
+                sim->set_input(start, SignalValue::ONE);    //START <= '1';
+                sim->simulate(10 * 1000);                   //WAIT FOR 10 NS;
+
+                sim->set_input(start, SignalValue::ZERO);           //START <= '0';
+                sim->simulate(((round == 2) ? 30 : 100) * 1000);    //WAIT FOR 100 NS;
+            }
+        };
+
+        std::vector<u32> all_lanes(NetlistSimulator::LANE_COUNT);
+        std::iota(all_lanes.begin(), all_lanes.end(), 0);
+
+        auto bit_parallel_sim = plugin->create_simulator(SimulationMode::bit_parallel);
+        {
+            measure_block_time("bit-parallel simulation of 64 lanes");
+            run_testbench(bit_parallel_sim.get(), all_lanes);
+        }
+
+        // lane 0 matches the reference simulation
+        EXPECT_TRUE(cmp_sim_data(vcd_traces, bit_parallel_sim->get_lane_simulation_state(0)));
+        EXPECT_EQ(bit_parallel_sim->get_lane_simulation_state(0).get_events(), bit_parallel_sim->get_simulation_state().get_events());
+
+        // every lane yields the same events as a separate simulation with the same stimuli
+        for (u32 lane : {0u, 1u, 2u, 31u, 63u})
+        {
+            auto sim = plugin->create_simulator(SimulationMode::cycle_based);
+            {
+                measure_block_time("cycle-based simulation of lane " + std::to_string(lane));
+                run_testbench(sim.get(), {lane});
+            }
+            EXPECT_EQ(bit_parallel_sim->get_lane_simulation_state(lane).get_events(), sim->get_simulation_state().get_events());
+        }
+
+        // different plaintexts lead to different traces
+        EXPECT_NE(bit_parallel_sim->get_lane_simulation_state(1).get_events(), bit_parallel_sim->get_lane_simulation_state(2).get_events());
+
+        // per-lane VCD export
+        std::filesystem::path path_lane_vcd = utils::get_binary_directory().string() + "/tmp_lane.vcd";
+        EXPECT_TRUE(bit_parallel_sim->generate_lane_vcd(1, path_lane_vcd, 0, 200 * 1000));
+        EXPECT_FALSE(bit_parallel_sim->generate_lane_vcd(NetlistSimulator::LANE_COUNT, path_lane_vcd, 0, 200 * 1000));
+        std::filesystem::remove(path_lane_vcd);
+
+        TEST_END
+    }
+
+    TEST_F(SimulatorTest, sha256)
+    {
+        // return;
+        TEST_START
+
+        auto plugin = plugin_manager::get_plugin_instance<NetlistSimulatorPlugin>("netlist_simulator");
+        auto sim    = plugin->create_simulator();
+
+        //path to netlist
+        std::string path_netlist = utils::get_base_directory().string() + "/bin/hal_plugins/test-files/sha256/sha256_flat.vhd";
+        if (!utils::file_exists(path_netlist))
+            FAIL() << "netlist for sha256 not found: " << path_netlist;
+
+        std::string path_netlist_hal = utils::get_base_directory().string() + "/bin/hal_plugins/test-files/sha256/sha256_flat.hal";
+
+        //create netlist from path
+        auto lib = gate_library_manager::get_gate_library_by_name("XILINX_UNISIM");
+        if (lib == nullptr)
+        {
+            FAIL() << "XILINX_UNISIM gate library not found";
+        }
+
+        std::unique_ptr<Netlist> nl;
+        {
+            std::cout << "loading netlist: " << path_netlist << "..." << std::endl;
+            if (utils::file_exists(path_netlist_hal))
+            {
+                std::cout << ".hal file found for test netlist, loading this one." << std::endl;
+                nl = netlist_serializer::deserialize_from_file(path_netlist_hal);
+            }
+            else
+            {
+                NO_COUT_BLOCK;
+                nl = netlist_parser_manager::parse(path_netlist, lib);
+                netlist_serializer::serialize_to_file(nl.get(), path_netlist_hal);
+            }
+            if (nl == nullptr)
+            {
+                FAIL() << "netlist couldn't be parsed";
+            }
+        }
+
+        //path to vcd
+        std::string path_vcd = utils::get_base_directory().string() + "/bin/hal_plugins/test-files/sha256/dump.vcd";
+        if (!utils::file_exists(path_vcd))
+            FAIL() << "dump for sha256 not found: " << path_vcd;
+
+        //read vcd and transform to vector of states, clock = 10000 ps = 10 ns
+        Simulation vcd_traces = parse_vcd(nl.get(), path_vcd, true);
+
+        //prepare simulation
+        sim->add_gates(nl->get_gates());
+        sim->load_initial_values_from_netlist();
+
+        // retrieve nets
+        auto clk = *(nl->get_nets([](auto net) { return net->get_name() == "clk"; }).begin());
+
+        sim->add_clock_period(clk, 10000);
+
+        auto start = *(nl->get_nets([](auto net) { return net->get_name() == "data_ready"; }).begin());
+
+        auto rst = *(nl->get_nets([](auto net) { return net->get_name() == "rst"; }).begin());
+
+        std::vector<Net*> input_bits;
+        for (int i = 0; i < 512; i++)
+        {
+            std::string name = "msg_block_in_" + std::to_string(i);
+            input_bits.push_back(*(nl->get_nets([name](auto net) { return net->get_name() == name; }).begin()));
+        }
+
+        int input_nets_amount = input_bits.size();
+
+        if (clk != nullptr)
+            input_nets_amount++;
+
+        if (rst != nullptr)
+            input_nets_amount++;
+
+        if (start != nullptr)
+            input_nets_amount++;
+
+        if (input_nets_amount != sim->get_input_nets().size())
+            FAIL() << "not all input nets set: actual " << input_nets_amount << " vs. " << sim->get_input_nets().size();
+
+        //start simulation
+        std::cout << "starting simulation" << std::endl;
+        //testbench
+
+        {
+            measure_block_time("simulation");
+
+            // msg <= x"61626380000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000018";
+            std::string hex_input = "61626380000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000018";
+            for (u32 i = 0; i < hex_input.size(); i += 2)
+            {
+                u8 byte = std::stoul(hex_input.substr(i, 2), nullptr, 16);
+                for (u32 j = 0; j < 8; ++j)
+                {
+                    sim->set_input(input_bits[i * 4 + j], (SignalValue)((byte >> (7 - j)) & 1));
+                }
+            }
+
+            sim->set_input(rst, SignalValue::ONE);       //RST <= '1';
+            sim->set_input(start, SignalValue::ZERO);    //START <= '0';
+            sim->simulate(10 * 1000);                    //WAIT FOR 10 NS;
+
+            sim->set_input(rst, SignalValue::ZERO);    //RST <= '0';
             sim->simulate(10 * 1000);                  //WAIT FOR 10 NS;
 
             sim->set_input(start, SignalValue::ONE);    //START <= '1';
@@ -820,4 +2050,113 @@ namespace hal
         EXPECT_TRUE(cmp_sim_data(vcd_traces, sim->get_simulation_state()));
         TEST_END
     }
+    TEST_F(SimulatorTest, sha256_multithreaded)
+    {
+        TEST_START
+
+        auto plugin = plugin_manager::get_plugin_instance<NetlistSimulatorPlugin>("netlist_simulator");
+
+        //path to netlist
+        std::string path_netlist = utils::get_base_directory().string() + "/bin/hal_plugins/test-files/sha256/sha256_flat.vhd";
+        if (!utils::file_exists(path_netlist))
+            FAIL() << "netlist for sha256 not found: " << path_netlist;
+
+        std::string path_netlist_hal = utils::get_base_directory().string() + "/bin/hal_plugins/test-files/sha256/sha256_flat.hal";
+
+        //create netlist from path
+        auto lib = gate_library_manager::get_gate_library_by_name("XILINX_UNISIM");
+        if (lib == nullptr)
+        {
+            FAIL() << "XILINX_UNISIM gate library not found";
+        }
+
+        std::unique_ptr<Netlist> nl;
+        {
+            std::cout << "loading netlist: " << path_netlist << "..." << std::endl;
+            if (utils::file_exists(path_netlist_hal))
+            {
+                std::cout << ".hal file found for test netlist, loading this one." << std::endl;
+                nl = netlist_serializer::deserialize_from_file(path_netlist_hal);
+            }
+            else
+            {
+                NO_COUT_BLOCK;
+                nl = netlist_parser_manager::parse(path_netlist, lib);
+                netlist_serializer::serialize_to_file(nl.get(), path_netlist_hal);
+            }
+            if (nl == nullptr)
+            {
+                FAIL() << "netlist couldn't be parsed";
+            }
+        }
+
+        //path to vcd
+        std::string path_vcd = utils::get_base_directory().string() + "/bin/hal_plugins/test-files/sha256/dump.vcd";
+        if (!utils::file_exists(path_vcd))
+            FAIL() << "dump for sha256 not found: " << path_vcd;
+
+        //read vcd and transform to vector of states, clock = 10000 ps = 10 ns
+        Simulation vcd_traces = parse_vcd(nl.get(), path_vcd, true);
+
+        // retrieve nets
+        auto clk   = *(nl->get_nets([](auto net) { return net->get_name() == "clk"; }).begin());
+        auto start = *(nl->get_nets([](auto net) { return net->get_name() == "data_ready"; }).begin());
+        auto rst   = *(nl->get_nets([](auto net) { return net->get_name() == "rst"; }).begin());
+
+        std::vector<Net*> input_bits;
+        for (int i = 0; i < 512; i++)
+        {
+            std::string name = "msg_block_in_" + std::to_string(i);
+            input_bits.push_back(*(nl->get_nets([name](auto net) { return net->get_name() == name; }).begin()));
+        }
+
+        // runs the testbench of the sha256 test with the given number of threads
+        auto run_testbench = [&](u32 threads) {
+            auto sim = plugin->create_simulator(SimulationMode::cycle_based);
+            sim->set_thread_count(threads);
+            sim->add_gates(nl->get_gates());
+            sim->load_initial_values_from_netlist();
+            sim->add_clock_period(clk, 10000);
+
+            measure_block_time("cycle-based simulation with " + std::to_string(sim->get_thread_count()) + " threads");
+
+            std::string hex_input = "61626380000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000018";
+            for (u32 i = 0; i < hex_input.size(); i += 2)
+            {
+                u8 byte = std::stoul(hex_input.substr(i, 2), nullptr, 16);
+                for (u32 j = 0; j < 8; ++j)
+                {
+                    sim->set_input(input_bits[i * 4 + j], (SignalValue)((byte >> (7 - j)) & 1));
+                }
+            }
+
+            sim->set_input(rst, SignalValue::ONE);
+            sim->set_input(start, SignalValue::ZERO);
+            sim->simulate(10 * 1000);
+
+            sim->set_input(rst, SignalValue::ZERO);
+            sim->simulate(10 * 1000);
+
+            sim->set_input(start, SignalValue::ONE);
+            sim->simulate(10 * 1000);
+
+            sim->set_input(start, SignalValue::ZERO);
+            sim->simulate(10 * 1000);
+
+            sim->simulate(2000 * 1000);
+
+            return sim->get_simulation_state();
+        };
+
+        Simulation reference = run_testbench(1);
+        EXPECT_TRUE(cmp_sim_data(vcd_traces, reference));
+
+        // results must not depend on the number of threads, scaling is measured by the benchmark instead
+        for (u32 threads : {2u, 4u})
+        {
+            Simulation result = run_testbench(threads);
+            EXPECT_EQ(result.get_events(), reference.get_events()) << "results differ for " << threads << " threads";
+        }
+        TEST_END
+    }
 }    // namespace hal
@@ -0,0 +1,958 @@
+#include "hal_core/netlist/aig.h"
+
+#include "hal_core/netlist/endpoint.h"
+#include "hal_core/netlist/gate.h"
+#include "hal_core/netlist/gate_library/gate_type.h"
+#include "hal_core/netlist/net.h"
+#include "hal_core/utilities/log.h"
+
+#include <algorithm>
+#include <queue>
+#include <unordered_set>
+
+namespace hal
+{
+    namespace
+    {
+        // truth tables of up to 6 variables are stored in a single word, bit i holds the value of the function for input assignment i
+        const u64 VARIABLE_MASKS[6] = {0xAAAAAAAAAAAAAAAAull, 0xCCCCCCCCCCCCCCCCull, 0xF0F0F0F0F0F0F0F0ull, 0xFF00FF00FF00FF00ull, 0xFFFF0000FFFF0000ull, 0xFFFFFFFF00000000ull};
+
+        u64 cofactor(u64 truth_table, u32 var, bool value)
+        {
+            u32 shift = 1u << var;
+            if (value)
+            {
+                u64 t = truth_table & VARIABLE_MASKS[var];
+                return t | (t >> shift);
+            }
+            u64 t = truth_table & ~VARIABLE_MASKS[var];
+            return t | (t << shift);
+        }
+
+        struct SOPCube
+        {
+            u8 positive;
+            u8 negative;
+        };
+
+        // computes an irredundant sum-of-products for any function between lower and upper (Minato-Morreale) and returns its truth table
+        u64 compute_isop(u64 lower, u64 upper, u32 num_vars, std::vector<SOPCube>& cubes)
+        {
+            if (lower == 0)
+            {
+                return 0;
+            }
+            if (upper == ~0ull)
+            {
+                cubes.push_back({0, 0});
+                return ~0ull;
+            }
+
+            // since lower <= upper and neither is constant, at least one of them depends on one of the remaining variables
+            u32 var = num_vars - 1;
+            while (cofactor(lower, var, false) == cofactor(lower, var, true) && cofactor(upper, var, false) == cofactor(upper, var, true))
+            {
+                var--;
+            }
+
+            u64 lower_0 = cofactor(lower, var, false);
+            u64 lower_1 = cofactor(lower, var, true);
+            u64 upper_0 = cofactor(upper, var, false);
+            u64 upper_1 = cofactor(upper, var, true);
+
+            u32 begin_0 = cubes.size();
+            u64 result_0 = compute_isop(lower_0 & ~upper_1, upper_0, var, cubes);
+            for (u32 i = begin_0; i < cubes.size(); ++i)
+            {
+                cubes[i].negative |= 1u << var;
+            }
+
+            u32 begin_1 = cubes.size();
+            u64 result_1 = compute_isop(lower_1 & ~upper_0, upper_1, var, cubes);
+            for (u32 i = begin_1; i < cubes.size(); ++i)
+            {
+                cubes[i].positive |= 1u << var;
+            }
+
+            u64 result_2 = compute_isop((lower_0 & ~result_0) | (lower_1 & ~result_1), upper_0 & upper_1, var, cubes);
+
+            return (result_0 & ~VARIABLE_MASKS[var]) | (result_1 & VARIABLE_MASKS[var]) | result_2;
+        }
+
+        // number of two-input AND nodes of a sum-of-products without any sharing
+        u32 get_sop_cost(const std::vector<SOPCube>& cubes)
+        {
+            if (cubes.empty())
+            {
+                return 0;
+            }
+            u32 cost = cubes.size() - 1;
+            for (const auto& cube : cubes)
+            {
+                u32 num_literals = __builtin_popcount(cube.positive) + __builtin_popcount(cube.negative);
+                if (num_literals > 1)
+                {
+                    cost += num_literals - 1;
+                }
+            }
+            return cost;
+        }
+
+        // combines literals by AND nodes, always pairing the two literals of the lowest levels first
+        u32 add_balanced_and(AIG& aig, const std::vector<u32>& literals)
+        {
+            if (literals.empty())
+            {
+                return AIG::get_constant(true);
+            }
+
+            using Entry = std::pair<u32, u32>;
+            std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+            for (u32 literal : literals)
+            {
+                queue.emplace(aig.get_level(AIG::get_node(literal)), literal);
+            }
+            while (queue.size() > 1)
+            {
+                u32 a = queue.top().second;
+                queue.pop();
+                u32 b = queue.top().second;
+                queue.pop();
+                u32 result = aig.add_and(a, b);
+                queue.emplace(aig.get_level(AIG::get_node(result)), result);
+            }
+            return queue.top().second;
+        }
+    }    // namespace
+
+    AIG::AIG()
+    {
+        m_nodes.push_back({INVALID_LITERAL, INVALID_LITERAL, 0});
+    }
+
+    AIG AIG::from_gates(const std::vector<const Gate*>& gates)
+    {
+        if (std::any_of(gates.begin(), gates.end(), [](const Gate* g) { return g == nullptr; }))
+        {
+            log_error("netlist", "set of gates contains a nullptr.");
+            return AIG();
+        }
+
+        // collect all nets whose logic can be represented, i.e., nets that are driven by the Boolean function of a single combinational gate
+        std::unordered_map<const Net*, std::pair<const Gate*, BooleanFunction>> drivers;
+        std::vector<const Net*> driven_nets;
+        for (const Gate* gate : gates)
+        {
+            if (!gate->get_type()->has_property(GateTypeProperty::combinational))
+            {
+                continue;
+            }
+
+            std::vector<std::string> input_pins = gate->get_input_pins();
+            for (const Endpoint* ep : gate->get_fan_out_endpoints())
+            {
+                const Net* net = ep->get_net();
+                if (net->get_num_of_sources() != 1 || drivers.find(net) != drivers.end())
+                {
+                    continue;
+                }
+
+                BooleanFunction function = gate->get_boolean_function(ep->get_pin());
+                if (function.is_empty() || function.contains_undefined_values())
+                {
+                    continue;
+                }
+
+                // functions of internal state cannot be represented
+                std::vector<std::string> variables = function.get_variables();
+                if (std::any_of(variables.begin(), variables.end(), [&input_pins](const std::string& v) { return std::find(input_pins.begin(), input_pins.end(), v) == input_pins.end(); }))
+                {
+                    continue;
+                }
+
+                drivers.emplace(net, std::make_pair(gate, function));
+                driven_nets.push_back(net);
+            }
+        }
+
+        AIG aig;
+        std::unordered_map<const Net*, u32> literals;
+        std::unordered_set<const Net*> expanded;
+
+        // iterative depth-first search, a net is resolved as soon as all nets it depends on are resolved
+        for (const Net* root : driven_nets)
+        {
+            std::vector<const Net*> stack = {root};
+            while (!stack.empty())
+            {
+                const Net* net = stack.back();
+                if (literals.find(net) != literals.end())
+                {
+                    stack.pop_back();
+                    continue;
+                }
+
+                auto it = drivers.find(net);
+                if (it == drivers.end())
+                {
+                    literals.emplace(net, aig.add_input(std::to_string(net->get_id())));
+                    stack.pop_back();
+                    continue;
+                }
+
+                const auto& [gate, function] = it->second;
+                if (expanded.insert(net).second)
+                {
+                    for (const std::string& pin : function.get_variables())
+                    {
+                        const Net* input_net = gate->get_fan_in_net(pin);
+                        if (input_net == nullptr || literals.find(input_net) != literals.end())
+                        {
+                            continue;
+                        }
+
+                        // all expanded but unresolved nets are on the current path
+                        if (expanded.find(input_net) != expanded.end())
+                        {
+                            log_error("netlist", "gates contain a combinational loop through net with ID {}.", input_net->get_id());
+                            return AIG();
+                        }
+                        stack.push_back(input_net);
+                    }
+                }
+                else
+                {
+                    std::unordered_map<std::string, u32> pin_literals;
+                    for (const std::string& pin : function.get_variables())
+                    {
+                        if (const Net* input_net = gate->get_fan_in_net(pin); input_net != nullptr)
+                        {
+                            pin_literals.emplace(pin, literals.at(input_net));
+                        }
+                        else
+                        {
+                            // if no net is connected, the input pin name cannot be replaced
+                            log_warning("netlist", "no net is connected to input pin '{}' of gate with ID {}, using the pin name as input.", pin, gate->get_id());
+                        }
+                    }
+                    literals.emplace(net, aig.add_boolean_function(function, pin_literals));
+                    stack.pop_back();
+                }
+            }
+        }
+
+        for (const Net* net : driven_nets)
+        {
+            aig.add_output(std::to_string(net->get_id()), literals.at(net));
+        }
+
+        return aig;
+    }
+
+    u32 AIG::get_constant(bool value)
+    {
+        return value ? 1 : 0;
+    }
+
+    u32 AIG::negate(u32 literal)
+    {
+        return literal ^ 1;
+    }
+
+    u32 AIG::get_node(u32 literal)
+    {
+        return literal >> 1;
+    }
+
+    bool AIG::is_complemented(u32 literal)
+    {
+        return (literal & 1) != 0;
+    }
+
+    u32 AIG::add_input(const std::string& name)
+    {
+        if (auto it = m_input_literals.find(name); it != m_input_literals.end())
+        {
+            return it->second;
+        }
+
+        u32 literal = m_nodes.size() << 1;
+        m_nodes.push_back({INVALID_LITERAL, (u32)m_input_names.size(), 0});
+        m_input_names.push_back(name);
+        m_input_literals.emplace(name, literal);
+        return literal;
+    }
+
+    u32 AIG::get_input(const std::string& name) const
+    {
+        if (auto it = m_input_literals.find(name); it != m_input_literals.end())
+        {
+            return it->second;
+        }
+        return INVALID_LITERAL;
+    }
+
+    const std::vector<std::string>& AIG::get_input_names() const
+    {
+        return m_input_names;
+    }
+
+    u32 AIG::add_and(u32 a, u32 b)
+    {
+        if (!check_literal(a) || !check_literal(b))
+        {
+            log_error("netlist", "cannot add an AND node for invalid literals.");
+            return INVALID_LITERAL;
+        }
+
+        if (a > b)
+        {
+            std::swap(a, b);
+        }
+
+        // constant propagation and trivial simplifications
+        if (a == get_constant(false))
+        {
+            return a;
+        }
+        if (a == get_constant(true) || a == b)
+        {
+            return b;
+        }
+        if (a == negate(b))
+        {
+            return get_constant(false);
+        }
+
+        // structural hashing
+        u64 key = ((u64)a << 32) | b;
+        if (auto it = m_strash.find(key); it != m_strash.end())
+        {
+            return it->second << 1;
+        }
+
+        u32 node = m_nodes.size();
+        m_nodes.push_back({a, b, std::max(m_nodes[get_node(a)].level, m_nodes[get_node(b)].level) + 1});
+        m_strash.emplace(key, node);
+        return node << 1;
+    }
+
+    u32 AIG::add_or(u32 a, u32 b)
+    {
+        u32 result = add_and(negate(a), negate(b));
+        return (result == INVALID_LITERAL) ? INVALID_LITERAL : negate(result);
+    }
+
+    u32 AIG::add_xor(u32 a, u32 b)
+    {
+        if (!check_literal(a) || !check_literal(b))
+        {
+            log_error("netlist", "cannot add an XOR for invalid literals.");
+            return INVALID_LITERAL;
+        }
+        return add_or(add_and(a, negate(b)), add_and(negate(a), b));
+    }
+
+    u32 AIG::add_mux(u32 select, u32 if_one, u32 if_zero)
+    {
+        if (!check_literal(select) || !check_literal(if_one) || !check_literal(if_zero))
+        {
+            log_error("netlist", "cannot add a multiplexer for invalid literals.");
+            return INVALID_LITERAL;
+        }
+        return add_or(add_and(select, if_one), add_and(negate(select), if_zero));
+    }
+
+    u32 AIG::add_boolean_function(const BooleanFunction& function, const std::unordered_map<std::string, u32>& variable_literals)
+    {
+        if (function.is_empty())
+        {
+            log_error("netlist", "cannot convert an empty Boolean function to an AIG.");
+            return INVALID_LITERAL;
+        }
+        if (function.contains_undefined_values())
+        {
+            log_error("netlist", "cannot convert a Boolean function containing undefined values to an AIG.");
+            return INVALID_LITERAL;
+        }
+        for (const auto& [name, literal] : variable_literals)
+        {
+            if (!check_literal(literal))
+            {
+                log_error("netlist", "invalid literal given for variable '{}'.", name);
+                return INVALID_LITERAL;
+            }
+        }
+
+        return function.to_aig_internal(*this, variable_literals);
+    }
+
+    bool AIG::add_output(const std::string& name, u32 literal)
+    {
+        if (!check_literal(literal))
+        {
+            log_error("netlist", "cannot add output '{}' for an invalid literal.", name);
+            return false;
+        }
+
+        if (auto it = m_output_indices.find(name); it != m_output_indices.end())
+        {
+            m_outputs[it->second].second = literal;
+        }
+        else
+        {
+            m_output_indices.emplace(name, m_outputs.size());
+            m_outputs.emplace_back(name, literal);
+        }
+        return true;
+    }
+
+    u32 AIG::get_output(const std::string& name) const
+    {
+        if (auto it = m_output_indices.find(name); it != m_output_indices.end())
+        {
+            return m_outputs[it->second].second;
+        }
+        return INVALID_LITERAL;
+    }
+
+    const std::vector<std::pair<std::string, u32>>& AIG::get_outputs() const
+    {
+        return m_outputs;
+    }
+
+    u32 AIG::get_node_count() const
+    {
+        return m_nodes.size();
+    }
+
+    u32 AIG::get_and_count() const
+    {
+        return m_nodes.size() - m_input_names.size() - 1;
+    }
+
+    bool AIG::is_and(u32 node) const
+    {
+        return node < m_nodes.size() && m_nodes[node].fan_in_0 != INVALID_LITERAL;
+    }
+
+    bool AIG::is_input(u32 node) const
+    {
+        return node != 0 && node < m_nodes.size() && m_nodes[node].fan_in_0 == INVALID_LITERAL;
+    }
+
+    std::pair<u32, u32> AIG::get_fan_in(u32 node) const
+    {
+        if (!is_and(node))
+        {
+            return {INVALID_LITERAL, INVALID_LITERAL};
+        }
+        return {m_nodes[node].fan_in_0, m_nodes[node].fan_in_1};
+    }
+
+    u32 AIG::get_level(u32 node) const
+    {
+        if (node >= m_nodes.size())
+        {
+            return 0;
+        }
+        return m_nodes[node].level;
+    }
+
+    u32 AIG::get_depth() const
+    {
+        u32 depth = 0;
+        for (const auto& [name, literal] : m_outputs)
+        {
+            depth = std::max(depth, m_nodes[get_node(literal)].level);
+        }
+        return depth;
+    }
+
+    BooleanFunction AIG::to_boolean_function(u32 literal) const
+    {
+        if (!check_literal(literal))
+        {
+            log_error("netlist", "cannot convert an invalid literal to a Boolean function.");
+            return BooleanFunction();
+        }
+
+        std::vector<BooleanFunction> functions(m_nodes.size());
+        std::vector<bool> converted(m_nodes.size(), false);
+
+        auto literal_function = [&](u32 l) {
+            u32 node = get_node(l);
+            if (!is_complemented(l))
+            {
+                return functions[node];
+            }
+            // a negated AND of negated inputs is converted into an OR
+            if (is_and(node) && is_complemented(m_nodes[node].fan_in_0) && is_complemented(m_nodes[node].fan_in_1))
+            {
+                return functions[get_node(m_nodes[node].fan_in_0)] | functions[get_node(m_nodes[node].fan_in_1)];
+            }
+            return ~functions[node];
+        };
+
+        // iterative post-order traversal, fan-in nodes are always converted before the nodes they feed
+        std::vector<u32> stack = {get_node(literal)};
+        while (!stack.empty())
+        {
+            u32 node = stack.back();
+            if (converted[node])
+            {
+                stack.pop_back();
+                continue;
+            }
+
+            if (node == 0)
+            {
+                functions[node] = BooleanFunction(BooleanFunction::ZERO);
+            }
+            else if (is_input(node))
+            {
+                functions[node] = BooleanFunction(m_input_names[m_nodes[node].fan_in_1]);
+            }
+            else
+            {
+                u32 fan_in_0 = get_node(m_nodes[node].fan_in_0);
+                u32 fan_in_1 = get_node(m_nodes[node].fan_in_1);
+                if (!converted[fan_in_0] || !converted[fan_in_1])
+                {
+                    stack.push_back(fan_in_0);
+                    stack.push_back(fan_in_1);
+                    continue;
+                }
+                functions[node] = literal_function(m_nodes[node].fan_in_0) & literal_function(m_nodes[node].fan_in_1);
+            }
+            converted[node] = true;
+            stack.pop_back();
+        }
+
+        return literal_function(literal);
+    }
+
+    z3::expr AIG::to_z3(z3::context& context, u32 literal) const
+    {
+        if (!check_literal(literal))
+        {
+            log_error("netlist", "cannot convert an invalid literal to a z3 expression.");
+            return z3::expr(context);
+        }
+
+        std::vector<z3::expr> exprs(m_nodes.size(), context.bv_val(0, 1));
+        std::vector<bool> converted(m_nodes.size(), false);
+
+        auto literal_expr = [&](u32 l) { return is_complemented(l) ? ~exprs[get_node(l)] : exprs[get_node(l)]; };
+
+        std::vector<u32> stack = {get_node(literal)};
+        while (!stack.empty())
+        {
+            u32 node = stack.back();
+            if (converted[node])
+            {
+                stack.pop_back();
+                continue;
+            }
+
+            if (is_input(node))
+            {
+                exprs[node] = context.bv_const(m_input_names[m_nodes[node].fan_in_1].c_str(), 1);
+            }
+            else if (node != 0)
+            {
+                u32 fan_in_0 = get_node(m_nodes[node].fan_in_0);
+                u32 fan_in_1 = get_node(m_nodes[node].fan_in_1);
+                if (!converted[fan_in_0] || !converted[fan_in_1])
+                {
+                    stack.push_back(fan_in_0);
+                    stack.push_back(fan_in_1);
+                    continue;
+                }
+                exprs[node] = literal_expr(m_nodes[node].fan_in_0) & literal_expr(m_nodes[node].fan_in_1);
+            }
+            converted[node] = true;
+            stack.pop_back();
+        }
+
+        return literal_expr(literal);
+    }
+
+    std::vector<u64> AIG::simulate(const std::unordered_map<std::string, u64>& input_words) const
+    {
+        std::vector<u64> words(m_nodes.size(), 0);
+        for (const auto& [name, word] : input_words)
+        {
+            if (auto it = m_input_literals.find(name); it != m_input_literals.end())
+            {
+                words[get_node(it->second)] = word;
+            }
+        }
+
+        // node indices are a topological order
+        for (u32 node = 1; node < m_nodes.size(); ++node)
+        {
+            if (m_nodes[node].fan_in_0 != INVALID_LITERAL)
+            {
+                words[node] = get_value(words, m_nodes[node].fan_in_0) & get_value(words, m_nodes[node].fan_in_1);
+            }
+        }
+        return words;
+    }
+
+    u64 AIG::get_value(const std::vector<u64>& node_words, u32 literal)
+    {
+        if (get_node(literal) >= node_words.size())
+        {
+            return 0;
+        }
+        return is_complemented(literal) ? ~node_words[get_node(literal)] : node_words[get_node(literal)];
+    }
+
+    AIG AIG::cleanup() const
+    {
+        return propagate_constants({});
+    }
+
+    AIG AIG::propagate_constants(const std::unordered_map<std::string, bool>& input_values) const
+    {
+        AIG result = copy_inputs();
+
+        std::vector<u32> literals(m_nodes.size(), INVALID_LITERAL);
+        literals[0] = get_constant(false);
+        for (const auto& name : m_input_names)
+        {
+            literals[get_node(get_input(name))] = result.get_input(name);
+        }
+        for (const auto& [name, value] : input_values)
+        {
+            if (u32 input = get_input(name); input != INVALID_LITERAL)
+            {
+                literals[get_node(input)] = get_constant(value);
+            }
+            else
+            {
+                log_warning("netlist", "AIG does not contain an input '{}', ignoring its value.", name);
+            }
+        }
+        auto map_literal = [&literals](u32 l) { return literals[get_node(l)] ^ (l & 1); };
+
+        // only nodes that are required by an output are copied
+        std::vector<bool> required(m_nodes.size(), false);
+        for (const auto& [name, literal] : m_outputs)
+        {
+            required[get_node(literal)] = true;
+        }
+        for (u32 node = m_nodes.size() - 1; node > 0; --node)
+        {
+            if (required[node] && is_and(node))
+            {
+                required[get_node(m_nodes[node].fan_in_0)] = true;
+                required[get_node(m_nodes[node].fan_in_1)] = true;
+            }
+        }
+
+        for (u32 node = 1; node < m_nodes.size(); ++node)
+        {
+            if (required[node] && is_and(node))
+            {
+                literals[node] = result.add_and(map_literal(m_nodes[node].fan_in_0), map_literal(m_nodes[node].fan_in_1));
+            }
+        }
+
+        for (const auto& [name, literal] : m_outputs)
+        {
+            result.add_output(name, map_literal(literal));
+        }
+        return result;
+    }
+
+    AIG AIG::balance() const
+    {
+        const AIG source               = cleanup();
+        const std::vector<Node>& nodes = source.m_nodes;
+        std::vector<u32> fan_out_counts = source.get_fan_out_counts();
+
+        // collect the leaves of the maximal AND trees, which end at complemented edges and shared nodes
+        std::vector<std::vector<u32>> leaves(nodes.size());
+        std::vector<bool> required(nodes.size(), false);
+        for (const auto& [name, literal] : source.m_outputs)
+        {
+            required[get_node(literal)] = true;
+        }
+        for (u32 node = nodes.size() - 1; node > 0; --node)
+        {
+            if (!required[node] || !source.is_and(node))
+            {
+                continue;
+            }
+
+            std::vector<u32> stack = {nodes[node].fan_in_0, nodes[node].fan_in_1};
+            while (!stack.empty())
+            {
+                u32 l = stack.back();
+                stack.pop_back();
+                if (!is_complemented(l) && source.is_and(get_node(l)) && fan_out_counts[get_node(l)] == 1)
+                {
+                    stack.push_back(nodes[get_node(l)].fan_in_0);
+                    stack.push_back(nodes[get_node(l)].fan_in_1);
+                }
+                else
+                {
+                    leaves[node].push_back(l);
+                    required[get_node(l)] = true;
+                }
+            }
+        }
+
+        AIG result = source.copy_inputs();
+        std::vector<u32> literals(nodes.size(), INVALID_LITERAL);
+        literals[0] = get_constant(false);
+        for (const auto& name : source.m_input_names)
+        {
+            literals[get_node(source.get_input(name))] = result.get_input(name);
+        }
+        auto map_literal = [&literals](u32 l) { return literals[get_node(l)] ^ (l & 1); };
+
+        for (u32 node = 1; node < nodes.size(); ++node)
+        {
+            if (required[node] && source.is_and(node))
+            {
+                std::vector<u32> mapped;
+                mapped.reserve(leaves[node].size());
+                for (u32 l : leaves[node])
+                {
+                    mapped.push_back(map_literal(l));
+                }
+                literals[node] = add_balanced_and(result, mapped);
+            }
+        }
+
+        for (const auto& [name, literal] : source.m_outputs)
+        {
+            result.add_output(name, map_literal(literal));
+        }
+        return result;
+    }
+
+    AIG AIG::refactor(u32 max_cut_size) const
+    {
+        max_cut_size = std::min(std::max(max_cut_size, 2u), 6u);
+
+        const AIG source               = cleanup();
+        const std::vector<Node>& nodes = source.m_nodes;
+        std::vector<u32> fan_out_counts = source.get_fan_out_counts();
+
+        struct Replacement
+        {
+            std::vector<u32> leaves;
+            std::vector<SOPCube> cubes;
+            bool complement;
+        };
+        std::unordered_map<u32, Replacement> replacements;
+
+        std::vector<bool> required(nodes.size(), false);
+        for (const auto& [name, literal] : source.m_outputs)
+        {
+            required[get_node(literal)] = true;
+        }
+        for (u32 node = nodes.size() - 1; node > 0; --node)
+        {
+            if (!required[node] || !source.is_and(node))
+            {
+                continue;
+            }
+
+            // grow a cut by repeatedly replacing the topmost AND leaf by its fan-in as long as the cut stays small enough
+            std::vector<u32> cut = {get_node(nodes[node].fan_in_0), get_node(nodes[node].fan_in_1)};
+            while (true)
+            {
+                std::sort(cut.begin(), cut.end(), std::greater<u32>());
+                bool expanded = false;
+                for (u32 i = 0; i < cut.size(); ++i)
+                {
+                    if (!source.is_and(cut[i]))
+                    {
+                        continue;
+                    }
+                    std::vector<u32> candidate = cut;
+                    candidate.erase(candidate.begin() + i);
+                    for (u32 l : {nodes[cut[i]].fan_in_0, nodes[cut[i]].fan_in_1})
+                    {
+                        if (std::find(candidate.begin(), candidate.end(), get_node(l)) == candidate.end())
+                        {
+                            candidate.push_back(get_node(l));
+                        }
+                    }
+                    if (candidate.size() <= max_cut_size)
+                    {
+                        cut      = candidate;
+                        expanded = true;
+                        break;
+                    }
+                }
+                if (!expanded)
+                {
+                    break;
+                }
+            }
+
+            // compute the truth table of the node over the cut, the cone consists of all nodes between the node and the cut
+            std::unordered_map<u32, u64> truth_tables;
+            for (u32 i = 0; i < cut.size(); ++i)
+            {
+                truth_tables[cut[i]] = VARIABLE_MASKS[i];
+            }
+            std::vector<u32> cone;
+            std::vector<u32> stack = {node};
+            while (!stack.empty())
+            {
+                u32 n = stack.back();
+                stack.pop_back();
+                if (truth_tables.find(n) != truth_tables.end() || std::find(cone.begin(), cone.end(), n) != cone.end())
+                {
+                    continue;
+                }
+                cone.push_back(n);
+                stack.push_back(get_node(nodes[n].fan_in_0));
+                stack.push_back(get_node(nodes[n].fan_in_1));
+            }
+            std::sort(cone.begin(), cone.end());
+            auto literal_table = [&truth_tables](u32 l) { return is_complemented(l) ? ~truth_tables.at(get_node(l)) : truth_tables.at(get_node(l)); };
+            for (u32 n : cone)
+            {
+                truth_tables[n] = literal_table(nodes[n].fan_in_0) & literal_table(nodes[n].fan_in_1);
+            }
+            u64 function = truth_tables.at(node);
+
+            // count the nodes of the cone that are exclusively used by the node and would hence be removed
+            std::unordered_map<u32, u32> references;
+            u32 exclusive_nodes = 0;
+            stack               = {node};
+            while (!stack.empty())
+            {
+                u32 n = stack.back();
+                stack.pop_back();
+                exclusive_nodes++;
+                for (u32 l : {nodes[n].fan_in_0, nodes[n].fan_in_1})
+                {
+                    u32 fan_in = get_node(l);
+                    if (std::find(cut.begin(), cut.end(), fan_in) != cut.end())
+                    {
+                        continue;
+                    }
+                    auto it = references.emplace(fan_in, fan_out_counts[fan_in]).first;
+                    if (--it->second == 0)
+                    {
+                        stack.push_back(fan_in);
+                    }
+                }
+            }
+
+            std::vector<SOPCube> on_cubes, off_cubes;
+            compute_isop(function, function, cut.size(), on_cubes);
+            compute_isop(~function, ~function, cut.size(), off_cubes);
+            bool complement            = get_sop_cost(off_cubes) < get_sop_cost(on_cubes);
+            std::vector<SOPCube>& best = complement ? off_cubes : on_cubes;
+
+            if (get_sop_cost(best) < exclusive_nodes)
+            {
+                for (u32 leaf : cut)
+                {
+                    required[leaf] = true;
+                }
+                replacements[node] = {cut, std::move(best), complement};
+            }
+            else
+            {
+                required[get_node(nodes[node].fan_in_0)] = true;
+                required[get_node(nodes[node].fan_in_1)] = true;
+            }
+        }
+
+        AIG result = source.copy_inputs();
+        std::vector<u32> literals(nodes.size(), INVALID_LITERAL);
+        literals[0] = get_constant(false);
+        for (const auto& name : source.m_input_names)
+        {
+            literals[get_node(source.get_input(name))] = result.get_input(name);
+        }
+        auto map_literal = [&literals](u32 l) { return literals[get_node(l)] ^ (l & 1); };
+
+        for (u32 node = 1; node < nodes.size(); ++node)
+        {
+            if (!required[node] || !source.is_and(node))
+            {
+                continue;
+            }
+
+            auto it = replacements.find(node);
+            if (it == replacements.end())
+            {
+                literals[node] = result.add_and(map_literal(nodes[node].fan_in_0), map_literal(nodes[node].fan_in_1));
+                continue;
+            }
+
+            // the sum-of-products is built as a negated AND of negated products
+            const Replacement& replacement = it->second;
+            std::vector<u32> negated_products;
+            for (const auto& cube : replacement.cubes)
+            {
+                std::vector<u32> product;
+                for (u32 i = 0; i < replacement.leaves.size(); ++i)
+                {
+                    if (cube.positive & (1u << i))
+                    {
+                        product.push_back(literals[replacement.leaves[i]]);
+                    }
+                    else if (cube.negative & (1u << i))
+                    {
+                        product.push_back(negate(literals[replacement.leaves[i]]));
+                    }
+                }
+                negated_products.push_back(negate(add_balanced_and(result, product)));
+            }
+            u32 sum        = negate(add_balanced_and(result, negated_products));
+            literals[node] = replacement.complement ? negate(sum) : sum;
+        }
+
+        for (const auto& [name, literal] : source.m_outputs)
+        {
+            result.add_output(name, map_literal(literal));
+        }
+        return result.cleanup();
+    }
+
+    bool AIG::check_literal(u32 literal) const
+    {
+        return literal != INVALID_LITERAL && get_node(literal) < m_nodes.size();
+    }
+
+    std::vector<u32> AIG::get_fan_out_counts() const
+    {
+        std::vector<u32> counts(m_nodes.size(), 0);
+        for (const auto& node : m_nodes)
+        {
+            if (node.fan_in_0 != INVALID_LITERAL)
+            {
+                counts[get_node(node.fan_in_0)]++;
+                counts[get_node(node.fan_in_1)]++;
+            }
+        }
+        for (const auto& [name, literal] : m_outputs)
+        {
+            counts[get_node(literal)]++;
+        }
+        return counts;
+    }
+
+    AIG AIG::copy_inputs() const
+    {
+        AIG result;
+        for (const auto& name : m_input_names)
+        {
+            result.add_input(name);
+        }
+        return result;
+    }
+}    // namespace hal
@@ -0,0 +1,1669 @@
+#include "hal_core/netlist/bdd.h"
+
+#include "hal_core/utilities/log.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <unordered_set>
+
+namespace hal
+{
+    namespace
+    {
+        constexpr u32 INITIAL_SUBTABLE_SIZE = 16;
+        constexpr double MAX_SIFTING_GROWTH = 1.2;
+
+        u32 hash_pair(u32 a, u32 b)
+        {
+            u64 h = ((u64)a << 32 | b) * 0x9E3779B97F4A7C15ull;
+            return (u32)(h >> 32);
+        }
+
+        u32 hash_quad(u32 op, u32 f, u32 g, u32 h)
+        {
+            u64 x = ((u64)f << 32 | g) * 0x9E3779B97F4A7C15ull;
+            x ^= ((u64)h << 8 | op) * 0xC2B2AE3D27D4EB4Full;
+            return (u32)(x >> 32);
+        }
+
+        // product term with one entry per variable: 0 = negative literal, 1 = positive literal, 2 = don't care
+        using Cube = std::vector<u8>;
+
+        class SearchBudget
+        {
+        public:
+            explicit SearchBudget(u32 time_budget_ms) : m_unlimited(time_budget_ms == 0), m_deadline(std::chrono::steady_clock::now() + std::chrono::milliseconds(time_budget_ms))
+            {
+            }
+
+            bool exhausted()
+            {
+                // querying the clock is comparatively expensive, so only do it every once in a while
+                if (!m_exhausted && !m_unlimited && (++m_queries & 0xFF) == 0)
+                {
+                    m_exhausted = std::chrono::steady_clock::now() >= m_deadline;
+                }
+                return m_exhausted;
+            }
+
+        private:
+            bool m_unlimited;
+            bool m_exhausted = false;
+            u32 m_queries    = 0;
+            std::chrono::steady_clock::time_point m_deadline;
+        };
+
+        std::vector<BooleanFunction::Value> cube_to_values(const Cube& cube)
+        {
+            std::vector<BooleanFunction::Value> values;
+            values.reserve(cube.size());
+            for (u8 literal : cube)
+            {
+                values.push_back((literal == 0) ? BooleanFunction::ZERO : ((literal == 1) ? BooleanFunction::ONE : BooleanFunction::X));
+            }
+            return values;
+        }
+
+        u32 literal_count(const Cube& cube)
+        {
+            return std::count_if(cube.begin(), cube.end(), [](u8 literal) { return literal != 2; });
+        }
+
+        std::pair<u32, u32> cover_cost(const std::vector<Cube>& cover)
+        {
+            u32 literals = 0;
+            for (const Cube& cube : cover)
+            {
+                literals += literal_count(cube);
+            }
+            return {cover.size(), literals};
+        }
+
+        // checks whether cube a contains cube b
+        bool contains(const Cube& a, const Cube& b)
+        {
+            for (u32 i = 0; i < a.size(); ++i)
+            {
+                if (a[i] != 2 && a[i] != b[i])
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        // recursive tautology check on a list of cubes using unate reduction and Shannon expansion on the most binate variable
+        // a result of false is returned when the budget is exhausted, which is always safe for the callers
+        bool is_tautology(std::vector<Cube> cubes, SearchBudget& budget)
+        {
+            if (budget.exhausted())
+            {
+                return false;
+            }
+
+            while (true)
+            {
+                if (cubes.empty())
+                {
+                    return false;
+                }
+
+                u32 num_variables = cubes.front().size();
+                std::vector<u32> zeros(num_variables, 0);
+                std::vector<u32> ones(num_variables, 0);
+                double covered = 0;
+                for (const Cube& cube : cubes)
+                {
+                    u32 literals = 0;
+                    for (u32 i = 0; i < num_variables; ++i)
+                    {
+                        if (cube[i] == 0)
+                        {
+                            zeros[i]++;
+                            literals++;
+                        }
+                        else if (cube[i] == 1)
+                        {
+                            ones[i]++;
+                            literals++;
+                        }
+                    }
+                    if (literals == 0)
+                    {
+                        return true;
+                    }
+                    covered += std::ldexp(1.0, -(i32)literals);
+                }
+
+                // the cubes cannot cover the whole input space if their sizes do not add up
+                if (covered < 1.0)
+                {
+                    return false;
+                }
+
+                // cubes with a literal in a unate variable can be dropped without changing the result
+                std::vector<bool> unate(num_variables, false);
+                bool any_unate = false;
+                for (u32 i = 0; i < num_variables; ++i)
+                {
+                    if ((zeros[i] == 0) != (ones[i] == 0))
+                    {
+                        unate[i]  = true;
+                        any_unate = true;
+                    }
+                }
+                if (any_unate)
+                {
+                    cubes.erase(std::remove_if(cubes.begin(),
+                                               cubes.end(),
+                                               [&unate](const Cube& cube) {
+                                                   for (u32 i = 0; i < cube.size(); ++i)
+                                                   {
+                                                       if (unate[i] && cube[i] != 2)
+                                                       {
+                                                           return true;
+                                                       }
+                                                   }
+                                                   return false;
+                                               }),
+                                cubes.end());
+                    continue;
+                }
+
+                u32 split = 0;
+                for (u32 i = 1; i < num_variables; ++i)
+                {
+                    if (zeros[i] + ones[i] > zeros[split] + ones[split])
+                    {
+                        split = i;
+                    }
+                }
+
+                for (u8 value : {0, 1})
+                {
+                    std::vector<Cube> cofactor;
+                    for (const Cube& cube : cubes)
+                    {
+                        if (cube[split] == 2 || cube[split] == value)
+                        {
+                            cofactor.push_back(cube);
+                            cofactor.back()[split] = 2;
+                        }
+                    }
+                    if (!is_tautology(std::move(cofactor), budget))
+                    {
+                        return false;
+                    }
+                }
+                return true;
+            }
+        }
+
+        // checks whether a cube is covered by the active cubes of a cover
+        bool is_covered(const Cube& cube, const std::vector<Cube>& cover, const std::vector<bool>& active, SearchBudget& budget)
+        {
+            std::vector<Cube> cofactor;
+            for (u32 j = 0; j < cover.size(); ++j)
+            {
+                if (!active[j])
+                {
+                    continue;
+                }
+
+                const Cube& other = cover[j];
+                bool disjoint     = false;
+                for (u32 i = 0; i < cube.size(); ++i)
+                {
+                    if (cube[i] != 2 && other[i] != 2 && cube[i] != other[i])
+                    {
+                        disjoint = true;
+                        break;
+                    }
+                }
+                if (disjoint)
+                {
+                    continue;
+                }
+
+                cofactor.push_back(other);
+                for (u32 i = 0; i < cube.size(); ++i)
+                {
+                    if (cube[i] != 2)
+                    {
+                        cofactor.back()[i] = 2;
+                    }
+                }
+            }
+            return is_tautology(std::move(cofactor), budget);
+        }
+
+        // expands each cube into a prime implicant and removes all cubes that are contained in it
+        std::vector<Cube> espresso_expand(std::vector<Cube> cover, const std::function<bool(const Cube&)>& implies, SearchBudget& budget)
+        {
+            std::vector<u32> order(cover.size());
+            for (u32 i = 0; i < order.size(); ++i)
+            {
+                order[i] = i;
+            }
+            std::stable_sort(order.begin(), order.end(), [&cover](u32 a, u32 b) { return literal_count(cover[a]) < literal_count(cover[b]); });
+
+            std::vector<bool> removed(cover.size(), false);
+            for (u32 i : order)
+            {
+                if (removed[i])
+                {
+                    continue;
+                }
+
+                Cube& cube = cover[i];
+                if (!budget.exhausted())
+                {
+                    for (u32 k = 0; k < cube.size(); ++k)
+                    {
+                        if (cube[k] == 2)
+                        {
+                            continue;
+                        }
+                        u8 literal = cube[k];
+                        cube[k]    = 2;
+                        if (!implies(cube))
+                        {
+                            cube[k] = literal;
+                        }
+                    }
+                }
+
+                for (u32 j = 0; j < cover.size(); ++j)
+                {
+                    if (j != i && !removed[j] && contains(cube, cover[j]))
+                    {
+                        removed[j] = true;
+                    }
+                }
+            }
+
+            std::vector<Cube> result;
+            for (u32 i = 0; i < cover.size(); ++i)
+            {
+                if (!removed[i])
+                {
+                    result.push_back(std::move(cover[i]));
+                }
+            }
+            return result;
+        }
+
+        // removes cubes that are covered by the remaining ones, starting with the smallest cubes
+        std::vector<Cube> espresso_irredundant(std::vector<Cube> cover, SearchBudget& budget)
+        {
+            std::vector<u32> order(cover.size());
+            for (u32 i = 0; i < order.size(); ++i)
+            {
+                order[i] = i;
+            }
+            std::stable_sort(order.begin(), order.end(), [&cover](u32 a, u32 b) { return literal_count(cover[a]) > literal_count(cover[b]); });
+
+            std::vector<bool> active(cover.size(), true);
+            for (u32 i : order)
+            {
+                active[i] = false;
+                if (!is_covered(cover[i], cover, active, budget))
+                {
+                    active[i] = true;
+                }
+            }
+
+            std::vector<Cube> result;
+            for (u32 i = 0; i < cover.size(); ++i)
+            {
+                if (active[i])
+                {
+                    result.push_back(std::move(cover[i]));
+                }
+            }
+            return result;
+        }
+
+        // shrinks each cube as far as possible while the cover still covers the function, which allows a subsequent expand to find different primes
+        std::vector<Cube> espresso_reduce(std::vector<Cube> cover, SearchBudget& budget)
+        {
+            std::vector<u32> order(cover.size());
+            for (u32 i = 0; i < order.size(); ++i)
+            {
+                order[i] = i;
+            }
+            std::stable_sort(order.begin(), order.end(), [&cover](u32 a, u32 b) { return literal_count(cover[a]) < literal_count(cover[b]); });
+
+            std::vector<bool> active(cover.size(), true);
+            for (u32 i : order)
+            {
+                active[i]  = false;
+                Cube& cube = cover[i];
+                for (u32 k = 0; k < cube.size() && !budget.exhausted(); ++k)
+                {
+                    if (cube[k] != 2)
+                    {
+                        continue;
+                    }
+                    for (u8 value : {0, 1})
+                    {
+                        // if one half of the cube is covered by the other cubes, only the other half is required
+                        cube[k] = value;
+                        if (is_covered(cube, cover, active, budget))
+                        {
+                            cube[k] = 1 - value;
+                            break;
+                        }
+                        cube[k] = 2;
+                    }
+                }
+                active[i] = true;
+            }
+            return cover;
+        }
+    }    // namespace
+
+    /*
+     * BDD handle
+     */
+
+    BDD::BDD() = default;
+
+    BDD::BDD(BDDManager* manager, u32 node) : m_manager(manager), m_node(node)
+    {
+        m_manager->ref(m_node);
+    }
+
+    BDD::BDD(const BDD& other) : m_manager(other.m_manager), m_node(other.m_node)
+    {
+        if (m_manager != nullptr)
+        {
+            m_manager->ref(m_node);
+        }
+    }
+
+    BDD::BDD(BDD&& other) noexcept : m_manager(other.m_manager), m_node(other.m_node)
+    {
+        other.m_manager = nullptr;
+        other.m_node    = 0;
+    }
+
+    BDD& BDD::operator=(const BDD& other)
+    {
+        if (other.m_manager != nullptr)
+        {
+            other.m_manager->ref(other.m_node);
+        }
+        if (m_manager != nullptr)
+        {
+            m_manager->deref(m_node);
+        }
+        m_manager = other.m_manager;
+        m_node    = other.m_node;
+        return *this;
+    }
+
+    BDD& BDD::operator=(BDD&& other) noexcept
+    {
+        if (this != &other)
+        {
+            if (m_manager != nullptr)
+            {
+                m_manager->deref(m_node);
+            }
+            m_manager       = other.m_manager;
+            m_node          = other.m_node;
+            other.m_manager = nullptr;
+            other.m_node    = 0;
+        }
+        return *this;
+    }
+
+    BDD::~BDD()
+    {
+        if (m_manager != nullptr)
+        {
+            m_manager->deref(m_node);
+        }
+    }
+
+    bool BDD::is_valid() const
+    {
+        return m_manager != nullptr;
+    }
+
+    bool BDD::is_constant_zero() const
+    {
+        return m_manager != nullptr && m_node == 0;
+    }
+
+    bool BDD::is_constant_one() const
+    {
+        return m_manager != nullptr && m_node == 1;
+    }
+
+    BDDManager* BDD::get_manager() const
+    {
+        return m_manager;
+    }
+
+    u32 BDD::get_node_count() const
+    {
+        if (m_manager == nullptr)
+        {
+            return 0;
+        }
+
+        std::unordered_set<u32> visited;
+        std::vector<u32> stack = {m_node};
+        while (!stack.empty())
+        {
+            u32 node = stack.back();
+            stack.pop_back();
+            if (!visited.insert(node).second || node < 2)
+            {
+                continue;
+            }
+            stack.push_back(m_manager->m_nodes[node].low);
+            stack.push_back(m_manager->m_nodes[node].high);
+        }
+        return visited.size();
+    }
+
+    bool BDD::operator==(const BDD& other) const
+    {
+        return m_manager == other.m_manager && m_node == other.m_node;
+    }
+
+    bool BDD::operator!=(const BDD& other) const
+    {
+        return !(*this == other);
+    }
+
+    BDD BDD::operator&(const BDD& other) const
+    {
+        if (m_manager == nullptr || m_manager != other.m_manager)
+        {
+            log_error("netlist", "cannot combine BDDs that are invalid or belong to different managers.");
+            return BDD();
+        }
+        m_manager->prepare_operation();
+        return m_manager->finish_operation(m_manager->apply_binary(BDDManager::OP_AND, m_node, other.m_node));
+    }
+
+    BDD BDD::operator|(const BDD& other) const
+    {
+        if (m_manager == nullptr || m_manager != other.m_manager)
+        {
+            log_error("netlist", "cannot combine BDDs that are invalid or belong to different managers.");
+            return BDD();
+        }
+        m_manager->prepare_operation();
+        return m_manager->finish_operation(m_manager->apply_binary(BDDManager::OP_OR, m_node, other.m_node));
+    }
+
+    BDD BDD::operator^(const BDD& other) const
+    {
+        if (m_manager == nullptr || m_manager != other.m_manager)
+        {
+            log_error("netlist", "cannot combine BDDs that are invalid or belong to different managers.");
+            return BDD();
+        }
+        m_manager->prepare_operation();
+        return m_manager->finish_operation(m_manager->apply_binary(BDDManager::OP_XOR, m_node, other.m_node));
+    }
+
+    BDD& BDD::operator&=(const BDD& other)
+    {
+        *this = *this & other;
+        return *this;
+    }
+
+    BDD& BDD::operator|=(const BDD& other)
+    {
+        *this = *this | other;
+        return *this;
+    }
+
+    BDD& BDD::operator^=(const BDD& other)
+    {
+        *this = *this ^ other;
+        return *this;
+    }
+
+    BDD BDD::operator~() const
+    {
+        if (m_manager == nullptr)
+        {
+            log_error("netlist", "cannot negate an invalid BDD.");
+            return BDD();
+        }
+        m_manager->prepare_operation();
+        return m_manager->finish_operation(m_manager->apply_not(m_node));
+    }
+
+    /*
+     * BDD manager
+     */
+
+    BDDManager::BDDManager(u32 computed_table_size)
+    {
+        u32 size = 1;
+        while (size < computed_table_size)
+        {
+            size <<= 1;
+        }
+        m_computed_table.resize(size);
+        m_gc_threshold = std::max(size, (u32)1 << 16);
+
+        // terminal nodes ZERO and ONE
+        m_nodes.push_back({TERMINAL_VAR, 0, 0, 0, INVALID_NODE});
+        m_nodes.push_back({TERMINAL_VAR, 1, 1, 0, INVALID_NODE});
+    }
+
+    BDD BDDManager::get_constant(bool value)
+    {
+        return BDD(this, value ? 1 : 0);
+    }
+
+    BDD BDDManager::get_variable(const std::string& name)
+    {
+        u32 var = find_variable(name);
+        if (var == INVALID_NODE)
+        {
+            var = create_variable(name);
+        }
+        return finish_operation(make_node(var, 0, 1));
+    }
+
+    u32 BDDManager::get_variable_count() const
+    {
+        return m_var_names.size();
+    }
+
+    std::vector<std::string> BDDManager::get_variable_order() const
+    {
+        std::vector<std::string> order;
+        order.reserve(m_level_to_var.size());
+        for (u32 var : m_level_to_var)
+        {
+            order.push_back(m_var_names[var]);
+        }
+        return order;
+    }
+
+    void BDDManager::set_variable_order(const std::vector<std::string>& order)
+    {
+        collect_garbage();
+
+        u32 node_limit = m_node_limit;
+        m_node_limit   = 0;
+
+        u32 target_level = 0;
+        for (const std::string& name : order)
+        {
+            u32 var = find_variable(name);
+            if (var == INVALID_NODE)
+            {
+                var = create_variable(name);
+            }
+            else if (m_var_to_level[var] < target_level)
+            {
+                log_warning("netlist", "variable '{}' is contained multiple times in the requested variable order.", name);
+                continue;
+            }
+
+            while (m_var_to_level[var] > target_level)
+            {
+                swap_adjacent_levels(m_var_to_level[var] - 1);
+            }
+            target_level++;
+        }
+
+        m_node_limit = node_limit;
+    }
+
+    BDD BDDManager::ite(const BDD& f, const BDD& g, const BDD& h)
+    {
+        if (!check_handle(f) || !check_handle(g) || !check_handle(h))
+        {
+            return BDD();
+        }
+        prepare_operation();
+        return finish_operation(apply_ite(f.m_node, g.m_node, h.m_node));
+    }
+
+    BDD BDDManager::get_cofactor(const BDD& f, const std::string& variable, bool value)
+    {
+        if (!check_handle(f))
+        {
+            return BDD();
+        }
+        u32 var = find_variable(variable);
+        if (var == INVALID_NODE)
+        {
+            return f;
+        }
+        prepare_operation();
+        return finish_operation(apply_restrict(f.m_node, var, value));
+    }
+
+    BDD BDDManager::exists(const BDD& f, const std::string& variable)
+    {
+        if (!check_handle(f))
+        {
+            return BDD();
+        }
+        u32 var = find_variable(variable);
+        if (var == INVALID_NODE)
+        {
+            return f;
+        }
+        prepare_operation();
+        u32 low  = apply_restrict(f.m_node, var, false);
+        u32 high = apply_restrict(f.m_node, var, true);
+        return finish_operation(apply_binary(OP_OR, low, high));
+    }
+
+    std::vector<std::string> BDDManager::get_support(const BDD& f) const
+    {
+        if (!check_handle(f))
+        {
+            return {};
+        }
+
+        std::unordered_set<u32> visited;
+        std::vector<bool> in_support(m_var_names.size(), false);
+        std::vector<u32> stack = {f.m_node};
+        while (!stack.empty())
+        {
+            u32 node = stack.back();
+            stack.pop_back();
+            if (node < 2 || !visited.insert(node).second)
+            {
+                continue;
+            }
+            in_support[m_nodes[node].var] = true;
+            stack.push_back(m_nodes[node].low);
+            stack.push_back(m_nodes[node].high);
+        }
+
+        std::vector<std::string> support;
+        for (u32 var : m_level_to_var)
+        {
+            if (in_support[var])
+            {
+                support.push_back(m_var_names[var]);
+            }
+        }
+        return support;
+    }
+
+    double BDDManager::get_sat_count(const BDD& f, u32 num_variables) const
+    {
+        if (!check_handle(f))
+        {
+            return -1;
+        }
+        if (num_variables < get_support(f).size())
+        {
+            log_error("netlist", "the number of variables ({}) is smaller than the support of the BDD.", num_variables);
+            return -1;
+        }
+        return std::ldexp(get_sat_probability(f), num_variables);
+    }
+
+    double BDDManager::get_sat_probability(const BDD& f) const
+    {
+        if (!check_handle(f))
+        {
+            return 0;
+        }
+        std::unordered_map<u32, double> cache;
+        return sat_probability(f.m_node, cache);
+    }
+
+    double BDDManager::get_boolean_influence(const BDD& f, const std::string& variable)
+    {
+        if (!check_handle(f))
+        {
+            return -1;
+        }
+        u32 var = find_variable(variable);
+        if (var == INVALID_NODE)
+        {
+            log_error("netlist", "variable '{}' is unknown to the BDD manager.", variable);
+            return -1;
+        }
+
+        prepare_operation();
+        u32 low        = apply_restrict(f.m_node, var, false);
+        u32 high       = apply_restrict(f.m_node, var, true);
+        BDD difference = finish_operation(apply_binary(OP_XOR, low, high));
+        if (!difference.is_valid())
+        {
+            log_error("netlist", "could not compute the Boolean influence of variable '{}' within the node limit of {}.", variable, m_node_limit);
+            return -1;
+        }
+
+        std::unordered_map<u32, double> cache;
+        return sat_probability(difference.m_node, cache);
+    }
+
+    std::map<std::string, double> BDDManager::get_boolean_influences(const BDD& f)
+    {
+        std::map<std::string, double> influences;
+        for (const std::string& var : get_support(f))
+        {
+            // failed variables are skipped, the error has already been logged
+            if (double influence = get_boolean_influence(f, var); influence >= 0)
+            {
+                influences.emplace(var, influence);
+            }
+        }
+        return influences;
+    }
+
+    std::vector<std::vector<BooleanFunction::Value>> BDDManager::get_cover(const BDD& f, const std::vector<std::string>& variables, u32 max_cubes) const
+    {
+        std::vector<u32> position_of_var;
+        if (!check_handle(f) || !map_variables(f, variables, position_of_var))
+        {
+            return {};
+        }
+
+        std::vector<u8> cube(variables.size(), 2);
+        std::vector<std::vector<u8>> cubes;
+        if (!enumerate_paths(f.m_node, position_of_var, cube, cubes, max_cubes))
+        {
+            return {};
+        }
+
+        std::vector<std::vector<BooleanFunction::Value>> result;
+        result.reserve(cubes.size());
+        for (const auto& c : cubes)
+        {
+            result.push_back(cube_to_values(c));
+        }
+        return result;
+    }
+
+    std::vector<std::vector<BooleanFunction::Value>> BDDManager::get_minimized_cover(const BDD& f,
+                                                                                   const std::vector<std::string>& variables,
+                                                                                   u32 effort,
+                                                                                   u32 max_cubes,
+                                                                                   u32 time_budget_ms,
+                                                                                   const std::vector<std::vector<BooleanFunction::Value>>& initial_cover) const
+    {
+        std::vector<u32> position_of_var;
+        if (!check_handle(f) || !map_variables(f, variables, position_of_var))
+        {
+            return {};
+        }
+
+        std::vector<Cube> cover;
+        if (initial_cover.empty())
+        {
+            std::vector<u8> initial_cube(variables.size(), 2);
+            if (!enumerate_paths(f.m_node, position_of_var, initial_cube, cover, max_cubes))
+            {
+                return {};
+            }
+        }
+        else
+        {
+            if (max_cubes != 0 && initial_cover.size() > max_cubes)
+            {
+                return {};
+            }
+            for (const auto& values : initial_cover)
+            {
+                if (values.size() != variables.size())
+                {
+                    log_error("netlist", "product term of the initial cover has {} values but {} variables were given.", values.size(), variables.size());
+                    return {};
+                }
+                Cube c(values.size(), 2);
+                for (u32 i = 0; i < values.size(); ++i)
+                {
+                    if (values[i] == BooleanFunction::ZERO)
+                    {
+                        c[i] = 0;
+                    }
+                    else if (values[i] == BooleanFunction::ONE)
+                    {
+                        c[i] = 1;
+                    }
+                }
+                cover.push_back(std::move(c));
+            }
+        }
+
+        SearchBudget budget(time_budget_ms);
+
+        // checks whether a cube implies f by walking all paths of the BDD that are compatible with the cube, without creating any nodes
+        std::vector<u32> visited_stamp(m_nodes.size(), 0);
+        std::vector<bool> visited_result(m_nodes.size(), false);
+        u32 stamp = 0;
+        std::function<bool(u32, const Cube&)> implies_rec = [&](u32 node, const Cube& cube) -> bool {
+            if (node < 2)
+            {
+                return node == 1;
+            }
+            if (visited_stamp[node] == stamp)
+            {
+                return visited_result[node];
+            }
+            u8 literal = cube[position_of_var[m_nodes[node].var]];
+            bool result;
+            if (literal == 0)
+            {
+                result = implies_rec(m_nodes[node].low, cube);
+            }
+            else if (literal == 1)
+            {
+                result = implies_rec(m_nodes[node].high, cube);
+            }
+            else
+            {
+                result = implies_rec(m_nodes[node].low, cube) && implies_rec(m_nodes[node].high, cube);
+            }
+            visited_stamp[node]  = stamp;
+            visited_result[node] = result;
+            return result;
+        };
+        auto implies = [&](const Cube& cube) {
+            stamp++;
+            return implies_rec(f.m_node, cube);
+        };
+
+        cover = espresso_expand(cover, implies, budget);
+        cover = espresso_irredundant(cover, budget);
+
+        for (u32 i = 0; i < effort && !budget.exhausted(); ++i)
+        {
+            std::vector<Cube> candidate = espresso_reduce(cover, budget);
+            candidate                   = espresso_expand(candidate, implies, budget);
+            candidate                   = espresso_irredundant(candidate, budget);
+            if (cover_cost(candidate) >= cover_cost(cover))
+            {
+                break;
+            }
+            cover = std::move(candidate);
+        }
+
+        std::sort(cover.begin(), cover.end());
+
+        std::vector<std::vector<BooleanFunction::Value>> result;
+        result.reserve(cover.size());
+        for (const auto& c : cover)
+        {
+            result.push_back(cube_to_values(c));
+        }
+        return result;
+    }
+
+    BooleanFunction BDDManager::to_boolean_function(const BDD& f) const
+    {
+        if (!check_handle(f))
+        {
+            return BooleanFunction();
+        }
+
+        std::unordered_map<u32, BooleanFunction> cache;
+        cache.emplace(0, BooleanFunction(BooleanFunction::ZERO));
+        cache.emplace(1, BooleanFunction(BooleanFunction::ONE));
+
+        // iterative post-order traversal, children are always converted before their parents
+        std::vector<u32> stack = {f.m_node};
+        while (!stack.empty())
+        {
+            u32 node = stack.back();
+            if (cache.find(node) != cache.end())
+            {
+                stack.pop_back();
+                continue;
+            }
+
+            u32 low  = m_nodes[node].low;
+            u32 high = m_nodes[node].high;
+            auto low_it  = cache.find(low);
+            auto high_it = cache.find(high);
+            if (low_it == cache.end() || high_it == cache.end())
+            {
+                if (low_it == cache.end())
+                {
+                    stack.push_back(low);
+                }
+                if (high_it == cache.end())
+                {
+                    stack.push_back(high);
+                }
+                continue;
+            }
+            stack.pop_back();
+
+            BooleanFunction var(m_var_names[m_nodes[node].var]);
+            BooleanFunction result;
+            if (low == 0 && high == 1)
+            {
+                result = var;
+            }
+            else if (low == 1 && high == 0)
+            {
+                result = ~var;
+            }
+            else if (low == 0)
+            {
+                result = var & high_it->second;
+            }
+            else if (high == 0)
+            {
+                result = ~var & low_it->second;
+            }
+            else if (high == 1)
+            {
+                result = var | low_it->second;
+            }
+            else if (low == 1)
+            {
+                result = ~var | high_it->second;
+            }
+            else
+            {
+                result = (var & high_it->second) | (~var & low_it->second);
+            }
+            cache.emplace(node, std::move(result));
+        }
+
+        return cache.at(f.m_node);
+    }
+
+    u32 BDDManager::get_node_count() const
+    {
+        return m_node_count;
+    }
+
+    u32 BDDManager::collect_garbage()
+    {
+        std::vector<u32> stack;
+        for (u32 node = 2; node < m_nodes.size(); ++node)
+        {
+            if (m_nodes[node].var != TERMINAL_VAR && m_nodes[node].ref == 0)
+            {
+                stack.push_back(node);
+            }
+        }
+
+        u32 reclaimed = 0;
+        while (!stack.empty())
+        {
+            u32 node = stack.back();
+            stack.pop_back();
+
+            u32 low  = m_nodes[node].low;
+            u32 high = m_nodes[node].high;
+            unlink_node(node);
+            free_node(node);
+            reclaimed++;
+
+            for (u32 child : {low, high})
+            {
+                if (child >= 2 && --m_nodes[child].ref == 0)
+                {
+                    stack.push_back(child);
+                }
+            }
+        }
+
+        m_dead_count = 0;
+        clear_cache();
+        return reclaimed;
+    }
+
+    u32 BDDManager::reorder()
+    {
+        collect_garbage();
+
+        // swapping levels temporarily creates additional nodes and must never be aborted
+        u32 node_limit = m_node_limit;
+        m_node_limit   = 0;
+
+        std::vector<u32> vars(m_level_to_var);
+        std::stable_sort(vars.begin(), vars.end(), [this](u32 a, u32 b) { return m_subtables[a].size > m_subtables[b].size; });
+        for (u32 var : vars)
+        {
+            sift_variable(var);
+        }
+
+        m_node_limit = node_limit;
+        return m_node_count;
+    }
+
+    void BDDManager::set_auto_reorder(bool enable, u32 threshold)
+    {
+        m_auto_reorder      = enable;
+        m_reorder_threshold = threshold;
+    }
+
+    void BDDManager::set_node_limit(u32 max_nodes)
+    {
+        m_node_limit = max_nodes;
+    }
+
+    /*
+     * reference counting and node management
+     */
+
+    void BDDManager::ref(u32 node)
+    {
+        if (node >= 2 && m_nodes[node].ref++ == 0)
+        {
+            m_dead_count--;
+        }
+    }
+
+    void BDDManager::deref(u32 node)
+    {
+        if (node >= 2 && --m_nodes[node].ref == 0)
+        {
+            m_dead_count++;
+        }
+    }
+
+    void BDDManager::deref_and_free(u32 node)
+    {
+        // only used during reordering, where no dead nodes exist and nodes are reclaimed immediately
+        if (node < 2 || --m_nodes[node].ref != 0)
+        {
+            return;
+        }
+
+        std::vector<u32> stack = {node};
+        while (!stack.empty())
+        {
+            u32 current = stack.back();
+            stack.pop_back();
+
+            u32 low  = m_nodes[current].low;
+            u32 high = m_nodes[current].high;
+            unlink_node(current);
+            free_node(current);
+
+            for (u32 child : {low, high})
+            {
+                if (child >= 2 && --m_nodes[child].ref == 0)
+                {
+                    stack.push_back(child);
+                }
+            }
+        }
+    }
+
+    u32 BDDManager::level_of(u32 node) const
+    {
+        u32 var = m_nodes[node].var;
+        return (var == TERMINAL_VAR) ? TERMINAL_VAR : m_var_to_level[var];
+    }
+
+    u32 BDDManager::make_node(u32 var, u32 low, u32 high)
+    {
+        if (low == high)
+        {
+            return low;
+        }
+
+        const Subtable& table = m_subtables[var];
+        for (u32 node = table.buckets[hash_pair(low, high) & (table.buckets.size() - 1)]; node != INVALID_NODE; node = m_nodes[node].next)
+        {
+            if (m_nodes[node].low == low && m_nodes[node].high == high)
+            {
+                return node;
+            }
+        }
+
+        if (m_node_limit != 0 && m_node_count >= m_node_limit)
+        {
+            m_limit_exceeded = true;
+            return 0;
+        }
+
+        u32 node;
+        if (!m_free_nodes.empty())
+        {
+            node = m_free_nodes.back();
+            m_free_nodes.pop_back();
+        }
+        else
+        {
+            node = m_nodes.size();
+            m_nodes.emplace_back();
+        }
+        m_nodes[node] = {var, low, high, 0, INVALID_NODE};
+        ref(low);
+        ref(high);
+        m_dead_count++;
+        insert_node(node);
+        return node;
+    }
+
+    void BDDManager::insert_node(u32 node)
+    {
+        Subtable& table = m_subtables[m_nodes[node].var];
+        if (table.size >= 2 * table.buckets.size())
+        {
+            std::vector<u32> buckets(2 * table.buckets.size(), INVALID_NODE);
+            for (u32 head : table.buckets)
+            {
+                while (head != INVALID_NODE)
+                {
+                    u32 next          = m_nodes[head].next;
+                    u32 b             = hash_pair(m_nodes[head].low, m_nodes[head].high) & (buckets.size() - 1);
+                    m_nodes[head].next = buckets[b];
+                    buckets[b]         = head;
+                    head               = next;
+                }
+            }
+            table.buckets = std::move(buckets);
+        }
+
+        u32 b              = hash_pair(m_nodes[node].low, m_nodes[node].high) & (table.buckets.size() - 1);
+        m_nodes[node].next = table.buckets[b];
+        table.buckets[b]   = node;
+        table.size++;
+        m_node_count++;
+    }
+
+    void BDDManager::unlink_node(u32 node)
+    {
+        Subtable& table = m_subtables[m_nodes[node].var];
+        u32* link       = &table.buckets[hash_pair(m_nodes[node].low, m_nodes[node].high) & (table.buckets.size() - 1)];
+        while (*link != node)
+        {
+            link = &m_nodes[*link].next;
+        }
+        *link = m_nodes[node].next;
+        table.size--;
+        m_node_count--;
+    }
+
+    void BDDManager::free_node(u32 node)
+    {
+        m_nodes[node].var = TERMINAL_VAR;
+        m_nodes[node].ref = 0;
+        m_free_nodes.push_back(node);
+    }
+
+    bool BDDManager::lookup_cache(u32 op, u32 f, u32 g, u32 h, u32& result) const
+    {
+        const CacheEntry& entry = m_computed_table[hash_quad(op, f, g, h) & (m_computed_table.size() - 1)];
+        if (entry.op == op && entry.f == f && entry.g == g && entry.h == h)
+        {
+            result = entry.result;
+            return true;
+        }
+        return false;
+    }
+
+    void BDDManager::insert_cache(u32 op, u32 f, u32 g, u32 h, u32 result)
+    {
+        if (m_limit_exceeded)
+        {
+            return;
+        }
+        m_computed_table[hash_quad(op, f, g, h) & (m_computed_table.size() - 1)] = {op, f, g, h, result};
+    }
+
+    void BDDManager::clear_cache()
+    {
+        std::fill(m_computed_table.begin(), m_computed_table.end(), CacheEntry());
+    }
+
+    void BDDManager::prepare_operation()
+    {
+        // garbage collection and reordering are only safe in between top-level operations, since intermediate results are not referenced
+        if ((m_dead_count > m_gc_threshold && m_dead_count > m_node_count / 4) || (m_node_limit != 0 && m_node_count >= m_node_limit / 2 && m_dead_count > 0))
+        {
+            collect_garbage();
+        }
+        if (m_auto_reorder && m_node_count - m_dead_count > m_reorder_threshold)
+        {
+            reorder();
+            m_reorder_threshold = std::max(m_reorder_threshold, 2 * m_node_count);
+        }
+    }
+
+    BDD BDDManager::finish_operation(u32 node)
+    {
+        if (m_limit_exceeded)
+        {
+            // the aborted operation only left dead nodes behind, which are reclaimed by the next garbage collection
+            m_limit_exceeded = false;
+            return BDD();
+        }
+        return BDD(this, node);
+    }
+
+    bool BDDManager::check_handle(const BDD& f) const
+    {
+        if (f.m_manager != this)
+        {
+            log_error("netlist", "BDD is invalid or does not belong to this manager.");
+            return false;
+        }
+        return true;
+    }
+
+    u32 BDDManager::find_variable(const std::string& name) const
+    {
+        if (auto it = m_name_to_var.find(name); it != m_name_to_var.end())
+        {
+            return it->second;
+        }
+        return INVALID_NODE;
+    }
+
+    u32 BDDManager::create_variable(const std::string& name)
+    {
+        u32 var = m_var_names.size();
+        m_var_names.push_back(name);
+        m_name_to_var.emplace(name, var);
+        m_var_to_level.push_back(m_level_to_var.size());
+        m_level_to_var.push_back(var);
+        m_subtables.emplace_back();
+        m_subtables.back().buckets.assign(INITIAL_SUBTABLE_SIZE, INVALID_NODE);
+        return var;
+    }
+
+    /*
+     * recursive operations
+     */
+
+    u32 BDDManager::apply_binary(Operation op, u32 f, u32 g)
+    {
+        if (m_limit_exceeded)
+        {
+            return 0;
+        }
+        switch (op)
+        {
+            case OP_AND:
+                if (f == 0 || g == 0)
+                {
+                    return 0;
+                }
+                if (f == 1 || f == g)
+                {
+                    return g;
+                }
+                if (g == 1)
+                {
+                    return f;
+                }
+                break;
+            case OP_OR:
+                if (f == 1 || g == 1)
+                {
+                    return 1;
+                }
+                if (f == 0 || f == g)
+                {
+                    return g;
+                }
+                if (g == 0)
+                {
+                    return f;
+                }
+                break;
+            case OP_XOR:
+                if (f == g)
+                {
+                    return 0;
+                }
+                if (f == 0)
+                {
+                    return g;
+                }
+                if (g == 0)
+                {
+                    return f;
+                }
+                if (f == 1)
+                {
+                    return apply_not(g);
+                }
+                if (g == 1)
+                {
+                    return apply_not(f);
+                }
+                break;
+            default:
+                return INVALID_NODE;
+        }
+
+        // all binary operations are commutative
+        if (f > g)
+        {
+            std::swap(f, g);
+        }
+
+        u32 result;
+        if (lookup_cache(op, f, g, 0, result))
+        {
+            return result;
+        }
+
+        u32 level_f = level_of(f);
+        u32 level_g = level_of(g);
+        u32 var     = (level_f <= level_g) ? m_nodes[f].var : m_nodes[g].var;
+        u32 f0 = f, f1 = f, g0 = g, g1 = g;
+        if (level_f <= level_g)
+        {
+            f0 = m_nodes[f].low;
+            f1 = m_nodes[f].high;
+        }
+        if (level_g <= level_f)
+        {
+            g0 = m_nodes[g].low;
+            g1 = m_nodes[g].high;
+        }
+
+        u32 low  = apply_binary(op, f0, g0);
+        u32 high = apply_binary(op, f1, g1);
+        result   = make_node(var, low, high);
+
+        insert_cache(op, f, g, 0, result);
+        return result;
+    }
+
+    u32 BDDManager::apply_not(u32 f)
+    {
+        if (m_limit_exceeded)
+        {
+            return 0;
+        }
+        if (f < 2)
+        {
+            return 1 - f;
+        }
+
+        u32 result;
+        if (lookup_cache(OP_NOT, f, 0, 0, result))
+        {
+            return result;
+        }
+
+        u32 var  = m_nodes[f].var;
+        u32 low  = apply_not(m_nodes[f].low);
+        u32 high = apply_not(m_nodes[f].high);
+        result   = make_node(var, low, high);
+
+        insert_cache(OP_NOT, f, 0, 0, result);
+        return result;
+    }
+
+    u32 BDDManager::apply_ite(u32 f, u32 g, u32 h)
+    {
+        if (m_limit_exceeded)
+        {
+            return 0;
+        }
+        if (f == 1 || g == h)
+        {
+            return g;
+        }
+        if (f == 0)
+        {
+            return h;
+        }
+        if (g == f)
+        {
+            g = 1;
+        }
+        if (h == f)
+        {
+            h = 0;
+        }
+        if (g == 1 && h == 0)
+        {
+            return f;
+        }
+        if (g == 0 && h == 1)
+        {
+            return apply_not(f);
+        }
+        if (h == 0)
+        {
+            return apply_binary(OP_AND, f, g);
+        }
+        if (g == 1)
+        {
+            return apply_binary(OP_OR, f, h);
+        }
+
+        u32 result;
+        if (lookup_cache(OP_ITE, f, g, h, result))
+        {
+            return result;
+        }
+
+        u32 level = std::min({level_of(f), level_of(g), level_of(h)});
+        u32 var   = m_level_to_var[level];
+        auto cofactors = [this, level](u32 node) -> std::pair<u32, u32> {
+            if (level_of(node) == level)
+            {
+                return {m_nodes[node].low, m_nodes[node].high};
+            }
+            return {node, node};
+        };
+        auto [f0, f1] = cofactors(f);
+        auto [g0, g1] = cofactors(g);
+        auto [h0, h1] = cofactors(h);
+
+        u32 low  = apply_ite(f0, g0, h0);
+        u32 high = apply_ite(f1, g1, h1);
+        result   = make_node(var, low, high);
+
+        insert_cache(OP_ITE, f, g, h, result);
+        return result;
+    }
+
+    u32 BDDManager::apply_restrict(u32 f, u32 var, bool value)
+    {
+        if (m_limit_exceeded)
+        {
+            return 0;
+        }
+        if (level_of(f) > m_var_to_level[var])
+        {
+            return f;
+        }
+        if (m_nodes[f].var == var)
+        {
+            return value ? m_nodes[f].high : m_nodes[f].low;
+        }
+
+        u32 result;
+        if (lookup_cache(OP_RESTRICT, f, var, value, result))
+        {
+            return result;
+        }
+
+        u32 node_var = m_nodes[f].var;
+        u32 low      = apply_restrict(m_nodes[f].low, var, value);
+        u32 high     = apply_restrict(m_nodes[f].high, var, value);
+        result       = make_node(node_var, low, high);
+
+        insert_cache(OP_RESTRICT, f, var, value, result);
+        return result;
+    }
+
+    double BDDManager::sat_probability(u32 node, std::unordered_map<u32, double>& cache) const
+    {
+        if (node < 2)
+        {
+            return node;
+        }
+        if (auto it = cache.find(node); it != cache.end())
+        {
+            return it->second;
+        }
+        double p = (sat_probability(m_nodes[node].low, cache) + sat_probability(m_nodes[node].high, cache)) / 2;
+        cache.emplace(node, p);
+        return p;
+    }
+
+    bool BDDManager::map_variables(const BDD& f, const std::vector<std::string>& variables, std::vector<u32>& position_of_var) const
+    {
+        position_of_var.assign(m_var_names.size(), INVALID_NODE);
+        for (u32 i = 0; i < variables.size(); ++i)
+        {
+            if (u32 var = find_variable(variables[i]); var != INVALID_NODE)
+            {
+                position_of_var[var] = i;
+            }
+        }
+        for (const std::string& var : get_support(f))
+        {
+            if (position_of_var[m_name_to_var.at(var)] == INVALID_NODE)
+            {
+                log_error("netlist", "variable '{}' of the BDD is not contained in the given list of variables.", var);
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool BDDManager::enumerate_paths(u32 node, const std::vector<u32>& position_of_var, std::vector<u8>& cube, std::vector<std::vector<u8>>& cubes, u32 max_cubes) const
+    {
+        if (node == 0)
+        {
+            return true;
+        }
+        if (node == 1)
+        {
+            if (max_cubes != 0 && cubes.size() >= max_cubes)
+            {
+                return false;
+            }
+            cubes.push_back(cube);
+            return true;
+        }
+
+        u32 position   = position_of_var[m_nodes[node].var];
+        cube[position] = 0;
+        bool ok        = enumerate_paths(m_nodes[node].low, position_of_var, cube, cubes, max_cubes);
+        cube[position] = 1;
+        ok             = ok && enumerate_paths(m_nodes[node].high, position_of_var, cube, cubes, max_cubes);
+        cube[position] = 2;
+        return ok;
+    }
+
+    /*
+     * variable reordering
+     */
+
+    void BDDManager::swap_adjacent_levels(u32 level)
+    {
+        u32 x = m_level_to_var[level];
+        u32 y = m_level_to_var[level + 1];
+
+        // nodes labeled x that do not have a child labeled y remain untouched
+        std::vector<u32> affected;
+        for (u32 head : m_subtables[x].buckets)
+        {
+            for (u32 node = head; node != INVALID_NODE; node = m_nodes[node].next)
+            {
+                if (m_nodes[m_nodes[node].low].var == y || m_nodes[m_nodes[node].high].var == y)
+                {
+                    affected.push_back(node);
+                }
+            }
+        }
+        for (u32 node : affected)
+        {
+            unlink_node(node);
+        }
+
+        std::swap(m_level_to_var[level], m_level_to_var[level + 1]);
+        m_var_to_level[x] = level + 1;
+        m_var_to_level[y] = level;
+
+        // every affected node is relabeled in-place so that existing handles stay valid:
+        // x ? (y ? f11 : f10) : (y ? f01 : f00)  =>  y ? (x ? f11 : f01) : (x ? f10 : f00)
+        for (u32 node : affected)
+        {
+            u32 f0 = m_nodes[node].low;
+            u32 f1 = m_nodes[node].high;
+
+            u32 f00 = f0, f01 = f0, f10 = f1, f11 = f1;
+            if (m_nodes[f0].var == y)
+            {
+                f00 = m_nodes[f0].low;
+                f01 = m_nodes[f0].high;
+            }
+            if (m_nodes[f1].var == y)
+            {
+                f10 = m_nodes[f1].low;
+                f11 = m_nodes[f1].high;
+            }
+
+            u32 new_low = make_node(x, f00, f10);
+            ref(new_low);
+            u32 new_high = make_node(x, f01, f11);
+            ref(new_high);
+
+            m_nodes[node].var  = y;
+            m_nodes[node].low  = new_low;
+            m_nodes[node].high = new_high;
+            insert_node(node);
+
+            deref_and_free(f0);
+            deref_and_free(f1);
+        }
+    }
+
+    void BDDManager::sift_variable(u32 var)
+    {
+        u32 num_levels = m_level_to_var.size();
+        u32 best_size  = m_node_count;
+        u32 best_level = m_var_to_level[var];
+
+        auto update = [&]() {
+            if (m_node_count < best_size)
+            {
+                best_size  = m_node_count;
+                best_level = m_var_to_level[var];
+            }
+            return m_node_count <= best_size * MAX_SIFTING_GROWTH;
+        };
+
+        while (m_var_to_level[var] + 1 < num_levels)
+        {
+            swap_adjacent_levels(m_var_to_level[var]);
+            if (!update())
+            {
+                break;
+            }
+        }
+        while (m_var_to_level[var] > 0)
+        {
+            swap_adjacent_levels(m_var_to_level[var] - 1);
+            if (!update())
+            {
+                break;
+            }
+        }
+
+        while (m_var_to_level[var] < best_level)
+        {
+            swap_adjacent_levels(m_var_to_level[var]);
+        }
+        while (m_var_to_level[var] > best_level)
+        {
+            swap_adjacent_levels(m_var_to_level[var] - 1);
+        }
+    }
+}    // namespace hal
@@ -1,10 +1,18 @@
 #include "hal_core/netlist/boolean_function.h"
 
+#include "hal_core/netlist/aig.h"
+#include "hal_core/netlist/bdd.h"
+#include "hal_core/utilities/log.h"
+
 #include "hal_core/utilities/utils.h"
 
 #include <algorithm>
+#include <array>
 #include <bitset>
 #include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
 
 namespace hal
 {
@@ -218,22 +226,56 @@ namespace hal
 
     bool BooleanFunction::is_constant_one() const
     {
-        if (m_content == content_type::CONSTANT)
-        {
-            return m_constant == ONE;
-        }
-        auto tmp = optimize();
-        return tmp.m_content == content_type::CONSTANT && tmp.m_constant == ONE;
+        return is_constant_value(ONE);
     }
 
     bool BooleanFunction::is_constant_zero() const
+    {
+        return is_constant_value(ZERO);
+    }
+
+    bool BooleanFunction::is_constant_value(Value value) const
     {
         if (m_content == content_type::CONSTANT)
         {
-            return m_constant == ZERO;
+            return m_constant == value;
+        }
+        if (m_content == content_type::VARIABLE || is_empty())
+        {
+            return false;
+        }
+        if (contains_undefined_values())
+        {
+            auto tmp = optimize();
+            return tmp.m_content == content_type::CONSTANT && tmp.m_constant == value;
         }
-        auto tmp = optimize();
-        return tmp.m_content == content_type::CONSTANT && tmp.m_constant == ZERO;
+
+        // AND, OR, and XOR of literals over pairwise distinct variables can never be constant
+        if (std::all_of(m_operands.begin(), m_operands.end(), [](const BooleanFunction& operand) { return operand.m_content == content_type::VARIABLE; }))
+        {
+            std::vector<std::string> variables;
+            for (const auto& operand : m_operands)
+            {
+                variables.push_back(operand.m_variable);
+            }
+            std::sort(variables.begin(), variables.end());
+            if (std::adjacent_find(variables.begin(), variables.end()) == variables.end())
+            {
+                return false;
+            }
+        }
+
+        // a BDD is checked directly instead of running a full optimization, since this is called for every subterm during constant propagation.
+        // the manager is reused by all calls of a thread and only replaced once it has accumulated too many variables.
+        static constexpr u32 MAX_CACHED_VARIABLES = 1 << 12;
+        thread_local std::unique_ptr<BDDManager> manager;
+        if (manager == nullptr || manager->get_variable_count() > MAX_CACHED_VARIABLES)
+        {
+            manager = std::make_unique<BDDManager>(1 << 10);
+            manager->set_node_limit(OptimizationSettings().max_bdd_nodes);
+        }
+        BDD bdd = to_bdd_internal(*manager);
+        return (value == ONE) ? bdd.is_constant_one() : bdd.is_constant_zero();
     }
 
     bool BooleanFunction::is_empty() const
@@ -262,278 +304,377 @@ namespace hal
         return {};
     }
 
-    BooleanFunction BooleanFunction::from_string(std::string expression, const std::vector<std::string>& variable_names)
+    namespace
     {
-        auto sorted_variable_names = variable_names;
-        std::sort(sorted_variable_names.begin(), sorted_variable_names.end(), [](const auto& a, const auto& b) { return a.size() > b.size(); });
-
-        for (u32 i = 0; i < sorted_variable_names.size(); ++i)
+        // single-pass tokenizer and Pratt parser for the string representation of Boolean functions
+        class ExpressionParser
         {
-            auto pos = expression.find(sorted_variable_names[i]);
-            while (pos != std::string::npos)
+        public:
+            ExpressionParser(const std::string& expression, const std::vector<std::string>& variable_names) : m_expression(expression), m_variable_names(variable_names)
             {
-                expression.replace(pos, sorted_variable_names[i].size(), "__v_" + std::to_string(i) + " ");
-                pos = expression.find(sorted_variable_names[i], pos + sorted_variable_names[i].size());
-            }
-        }
-
-        return from_string_internal(expression, sorted_variable_names);
-    }
-
-    BooleanFunction BooleanFunction::from_string_internal(std::string expression, const std::vector<std::string>& variable_names)
-    {
-        expression = utils::trim(expression);
-
-        if (expression.empty())
-        {
-            return BooleanFunction();
-        }
-
-        const std::string delimiters = "!~^&|'+* ";
-
-        // check for constants
-        if (expression == "0")
-        {
-            return BooleanFunction(ZERO);
-        }
-        else if (expression == "1")
-        {
-            return BooleanFunction(ONE);
-        }
-        else if (expression == "X")
-        {
-            return BooleanFunction(X);
-        }
-        else if (expression == "Z")
-        {
-            return BooleanFunction(Z);
-        }
-        else
-        {
-            // check for variable
-            bool is_term = false;
-            for (const auto& d : delimiters + "()")
-            {
-                if (expression.find(d) != std::string::npos)
+                for (u32 i = 0; i < m_variable_names.size(); ++i)
                 {
-                    is_term = true;
-                    break;
+                    if (!m_variable_names[i].empty())
+                    {
+                        m_names_by_first_char[static_cast<u8>(m_variable_names[i][0])].push_back(i);
+                    }
+                }
+                // longest names first, so that the longest match wins
+                for (auto& names : m_names_by_first_char)
+                {
+                    std::sort(names.begin(), names.end(), [this](u32 a, u32 b) { return m_variable_names[a].size() > m_variable_names[b].size(); });
                 }
             }
-            if (!is_term)
+
+            bool parse(BooleanFunction& result)
             {
-                if (utils::starts_with(expression, std::string("__v_")))
+                next_token();
+                if (m_token.type == TokenType::END)
                 {
-                    u32 idx    = std::stoul(expression.substr(4));
-                    expression = variable_names[idx];
+                    result = BooleanFunction();
+                    return m_error.empty();
                 }
 
-                return BooleanFunction(expression);
+                result = parse_expression(0);
+                if (m_error.empty() && m_token.type != TokenType::END)
+                {
+                    set_error(m_token.type == TokenType::CLOSE ? "unmatched ')'" : "unexpected token");
+                }
+                if (!m_error.empty())
+                {
+                    log_error("netlist", "cannot parse Boolean function '{}': {} at position {}.", m_expression, m_error, m_error_position);
+                    result = BooleanFunction(BooleanFunction::X);
+                    return false;
+                }
+                return true;
             }
-        }
 
-        // simple bracket check
-        i32 level = 0;
-        for (const auto& c : expression)
-        {
-            if (c == '(')
+        private:
+            enum class TokenType
             {
-                level += 1;
+                END,
+                IDENTIFIER,
+                VARIABLE,
+                NOT,
+                POSTFIX_NOT,
+                AND,
+                OR,
+                XOR,
+                OPEN,
+                CLOSE
+            };
+
+            struct Token
+            {
+                TokenType type;
+                u32 begin;
+                u32 length;
+                u32 variable_index;
+            };
+
+            // binding powers of the binary operators, an operand directly following another one is an implicit AND
+            static constexpr u32 OR_POWER  = 1;
+            static constexpr u32 XOR_POWER = 2;
+            static constexpr u32 AND_POWER = 3;
+
+            static bool is_whitespace(char c)
+            {
+                return c == ' ' || c == '\t' || c == '\n' || c == '\r';
             }
-            else if (c == ')')
+
+            static bool is_delimiter(char c)
             {
-                level -= 1;
-                if (level < 0)
+                switch (c)
                 {
-                    return Value::X;
+                    case '!':
+                    case '~':
+                    case '\'':
+                    case '&':
+                    case '*':
+                    case '|':
+                    case '+':
+                    case '^':
+                    case '(':
+                    case ')':
+                        return true;
+                    default:
+                        return is_whitespace(c);
                 }
             }
-        }
-        if (level != 0)
-        {
-            return Value::X;
-        }
 
-        // parse expression
-        std::vector<std::string> terms;
-        {
-            std::string current_term;
-            u32 bracket_level = 0;
-            for (u32 i = 0; i < expression.size(); i++)
+            // returns the length of the longest known variable name starting at pos, 0 if there is none
+            u32 match_variable_name(u32 pos, u32& index) const
             {
-                if (expression[i] == '(')
+                for (u32 i : m_names_by_first_char[static_cast<u8>(m_expression[pos])])
                 {
-                    // if this is a top-level term, store everything before the bracket
-                    if (bracket_level == 0)
+                    const auto& name = m_variable_names[i];
+                    if (m_expression.compare(pos, name.size(), name) == 0)
                     {
-                        current_term = utils::trim(current_term);
-                        if (!current_term.empty())
-                        {
-                            terms.push_back(current_term);
-                            current_term.clear();
-                        }
+                        index = i;
+                        return name.size();
                     }
-
-                    bracket_level++;
                 }
+                return 0;
+            }
 
-                if (bracket_level == 0 && delimiters.find(expression[i]) != std::string::npos)
+            void next_token()
+            {
+                while (m_pos < m_expression.size() && is_whitespace(m_expression[m_pos]))
                 {
-                    // not in brackets and there was a delimiter -> save term and operation
-                    current_term = utils::trim(current_term);
-                    if (!current_term.empty())
-                    {
-                        terms.push_back(current_term);
-                        current_term.clear();
-                    }
-                    if (expression[i] != ' ')
-                    {
-                        terms.push_back(std::string(1, expression[i]));
-                    }
+                    ++m_pos;
                 }
-                else
+
+                m_token = {TokenType::END, m_pos, 0, 0};
+                if (m_pos >= m_expression.size())
                 {
-                    // no special conditions -> char is term of current term
-                    current_term += expression[i];
+                    return;
                 }
 
-                if (expression[i] == ')')
+                u32 index;
+                if (u32 length = match_variable_name(m_pos, index); length != 0)
                 {
-                    bracket_level--;
+                    m_token = {TokenType::VARIABLE, m_pos, length, index};
+                    m_pos += length;
+                    return;
+                }
 
-                    if (bracket_level == 0)
-                    {
-                        // if we are back at top-level, store everything that was in the brackets
-                        current_term = utils::trim(current_term);
-                        if (!current_term.empty())
+                m_token.length = 1;
+                switch (m_expression[m_pos])
+                {
+                    case '!':
+                    case '~':
+                        m_token.type = TokenType::NOT;
+                        break;
+                    case '\'':
+                        m_token.type = TokenType::POSTFIX_NOT;
+                        break;
+                    case '&':
+                    case '*':
+                        m_token.type = TokenType::AND;
+                        break;
+                    case '|':
+                    case '+':
+                        m_token.type = TokenType::OR;
+                        break;
+                    case '^':
+                        m_token.type = TokenType::XOR;
+                        break;
+                    case '(':
+                        m_token.type = TokenType::OPEN;
+                        break;
+                    case ')':
+                        m_token.type = TokenType::CLOSE;
+                        break;
+                    default: {
+                        // identifiers end at delimiters and at the start of known variable names
+                        u32 end = m_pos + 1;
+                        while (end < m_expression.size() && !is_delimiter(m_expression[end]) && match_variable_name(end, index) == 0)
                         {
-                            terms.push_back(current_term);
-                            current_term.clear();
+                            ++end;
                         }
+                        m_token.type   = TokenType::IDENTIFIER;
+                        m_token.length = end - m_pos;
+                        break;
                     }
                 }
+                m_pos += m_token.length;
             }
-            current_term = utils::trim(current_term);
-            if (!current_term.empty())
-            {
-                terms.push_back(current_term);
-            }
-        }
-
-        // process terms
-        if (terms.size() == 1)
-        {
-            // only a single term but not filtered before?
-            // -> was of the form "(...)" so remove the outer brackets and repeat
-            return from_string_internal(terms[0].substr(1, terms[0].size() - 2), variable_names);
-        }
-
-        // small mutable datastructure for parsing
-        struct op_term
-        {
-            operation op;
-            BooleanFunction term;
-        };
-        std::vector<op_term> parsed_terms;
-
-        bool negate_next  = false;
-        operation next_op = operation::AND;
 
-        {
-            // multiple terms available -> initialize return Value with first term
-            u32 i = 0;
-            while (terms[i] == "!" || terms[i] == "~")
+            void set_error(const std::string& message)
             {
-                negate_next = !negate_next;
-                ++i;
-            }
-            BooleanFunction first_term = from_string_internal(terms[i], variable_names);
-            while (i + 1 < terms.size() && terms[i + 1] == "'")
-            {
-                negate_next = !negate_next;
-                ++i;
+                if (m_error.empty())
+                {
+                    m_error          = message;
+                    m_error_position = m_token.begin;
+                }
             }
-            if (negate_next)
+
+            bool starts_operand() const
             {
-                first_term  = ~first_term;
-                negate_next = false;
+                return m_token.type == TokenType::IDENTIFIER || m_token.type == TokenType::VARIABLE || m_token.type == TokenType::NOT || m_token.type == TokenType::OPEN;
             }
 
-            parsed_terms.push_back({operation::AND, first_term});
-
-            // process the remaining terms
-            while (++i < terms.size())
+            BooleanFunction parse_expression(u32 min_power)
             {
-                if (terms[i] == "!" || terms[i] == "~")
+                BooleanFunction lhs = parse_operand();
+
+                while (m_error.empty())
                 {
-                    negate_next = !negate_next;
+                    u32 power;
+                    TokenType op  = m_token.type;
+                    bool implicit = false;
+                    if (op == TokenType::AND || (implicit = starts_operand()))
+                    {
+                        power = AND_POWER;
+                        op    = TokenType::AND;
+                    }
+                    else if (op == TokenType::XOR)
+                    {
+                        power = XOR_POWER;
+                    }
+                    else if (op == TokenType::OR)
+                    {
+                        power = OR_POWER;
+                    }
+                    else
+                    {
+                        break;
+                    }
+
+                    if (power < min_power)
+                    {
+                        break;
+                    }
+                    if (!implicit)
+                    {
+                        next_token();
+                    }
+
+                    // all operators are left-associative
+                    BooleanFunction rhs = parse_expression(power + 1);
+                    if (op == TokenType::AND)
+                    {
+                        lhs = lhs & rhs;
+                    }
+                    else if (op == TokenType::XOR)
+                    {
+                        lhs = lhs ^ rhs;
+                    }
+                    else
+                    {
+                        lhs = lhs | rhs;
+                    }
                 }
-                else if (terms[i] == "&" || terms[i] == "*")
+
+                return lhs;
+            }
+
+            BooleanFunction parse_operand()
+            {
+                bool negate = false;
+                while (m_token.type == TokenType::NOT)
                 {
-                    next_op = operation::AND;
+                    negate = !negate;
+                    next_token();
                 }
-                else if (terms[i] == "|" || terms[i] == "+")
+
+                BooleanFunction result;
+                if (m_token.type == TokenType::VARIABLE)
                 {
-                    next_op = operation::OR;
+                    result = BooleanFunction(m_variable_names[m_token.variable_index]);
+                    next_token();
                 }
-                else if (terms[i] == "^")
+                else if (m_token.type == TokenType::IDENTIFIER)
                 {
-                    next_op = operation::XOR;
+                    if (m_token.length == 1 && m_expression[m_token.begin] == '0')
+                    {
+                        result = BooleanFunction(BooleanFunction::ZERO);
+                    }
+                    else if (m_token.length == 1 && m_expression[m_token.begin] == '1')
+                    {
+                        result = BooleanFunction(BooleanFunction::ONE);
+                    }
+                    else if (m_token.length == 1 && m_expression[m_token.begin] == 'X')
+                    {
+                        result = BooleanFunction(BooleanFunction::X);
+                    }
+                    else if (m_token.length == 1 && m_expression[m_token.begin] == 'Z')
+                    {
+                        result = BooleanFunction(BooleanFunction::Z);
+                    }
+                    else
+                    {
+                        result = BooleanFunction(m_expression.substr(m_token.begin, m_token.length));
+                    }
+                    next_token();
                 }
-                else
+                else if (m_token.type == TokenType::OPEN)
                 {
-                    auto next_term = from_string_internal(terms[i], variable_names);
-                    while (i + 1 < terms.size() && terms[i + 1] == "'")
+                    next_token();
+                    if (m_token.type == TokenType::CLOSE)
                     {
-                        negate_next = !negate_next;
-                        ++i;
+                        set_error("empty brackets");
+                        return result;
                     }
-                    if (negate_next)
+                    result = parse_expression(0);
+                    if (!m_error.empty())
                     {
-                        next_term = ~next_term;
+                        return result;
                     }
+                    if (m_token.type != TokenType::CLOSE)
+                    {
+                        set_error(m_token.type == TokenType::END ? "missing ')'" : "unexpected token");
+                        return result;
+                    }
+                    next_token();
+                }
+                else
+                {
+                    set_error(m_token.type == TokenType::END ? "unexpected end of expression" : "expected operand");
+                    return result;
+                }
 
-                    parsed_terms.push_back({next_op, next_term});
+                while (m_token.type == TokenType::POSTFIX_NOT)
+                {
+                    negate = !negate;
+                    next_token();
+                }
 
-                    negate_next = false;
-                    next_op     = operation::AND;
+                if (negate)
+                {
+                    result = ~result;
                 }
+                return result;
             }
-        }
 
-        // assemble terms in order of operator precedence
+            const std::string& m_expression;
+            const std::vector<std::string>& m_variable_names;
+            std::array<std::vector<u32>, 256> m_names_by_first_char;
+
+            u32 m_pos = 0;
+            Token m_token{TokenType::END, 0, 0, 0};
+
+            std::string m_error;
+            u32 m_error_position = 0;
+        };
+    }    // namespace
+
+    BooleanFunction BooleanFunction::from_string(const std::string& expression, const std::vector<std::string>& variable_names)
+    {
+        // identical expressions occur many times in gate libraries and netlists, hence parsed functions are cached process-wide
+        static std::mutex cache_mutex;
+        static std::unordered_map<std::string, BooleanFunction> cache;
+        static constexpr u32 max_cache_size = 1 << 16;
 
-        for (u32 i = 1; i < parsed_terms.size(); ++i)
+        std::string key = expression;
+        for (const auto& name : variable_names)
         {
-            if (parsed_terms[i].op == operation::AND)
-            {
-                parsed_terms[i - 1].term = parsed_terms[i - 1].term & parsed_terms[i].term;
-                parsed_terms.erase(parsed_terms.begin() + i);
-                --i;
-            }
+            key += '\0';
+            key += name;
         }
 
-        for (u32 i = 1; i < parsed_terms.size(); ++i)
         {
-            if (parsed_terms[i].op == operation::XOR)
+            std::lock_guard<std::mutex> lock(cache_mutex);
+            if (auto it = cache.find(key); it != cache.end())
             {
-                parsed_terms[i - 1].term = parsed_terms[i - 1].term ^ parsed_terms[i].term;
-                parsed_terms.erase(parsed_terms.begin() + i);
-                --i;
+                return it->second;
             }
         }
 
-        for (u32 i = 1; i < parsed_terms.size(); ++i)
+        BooleanFunction result;
+        if (!ExpressionParser(expression, variable_names).parse(result))
         {
-            if (parsed_terms[i].op == operation::OR)
-            {
-                parsed_terms[i - 1].term = parsed_terms[i - 1].term | parsed_terms[i].term;
-                parsed_terms.erase(parsed_terms.begin() + i);
-                --i;
-            }
+            // erroneous expressions are not cached so that the error is reported every time
+            return result;
         }
 
-        return parsed_terms[0].term;
+        std::lock_guard<std::mutex> lock(cache_mutex);
+        if (cache.size() >= max_cache_size)
+        {
+            cache.clear();
+        }
+        cache.emplace(std::move(key), result);
+        return result;
     }
 
     std::string BooleanFunction::to_string() const
@@ -1149,59 +1290,167 @@ namespace hal
     }
 
     BooleanFunction BooleanFunction::optimize() const
+    {
+        return optimize(OptimizationSettings());
+    }
+
+    BooleanFunction BooleanFunction::optimize(const OptimizationSettings& settings) const
     {
         if (m_content != content_type::TERMS)
         {
             return *this;
         }
 
-        BooleanFunction result = to_dnf().propagate_negations().optimize_constants();
+        std::vector<std::string> vars = get_variables();
 
-        if (result.m_content != content_type::TERMS || result.m_op == operation::AND)
+        // undefined values cannot be represented by a BDD
+        if (contains_undefined_values())
         {
-            return result;
+            if (vars.size() <= settings.exact_variable_limit)
+            {
+                return to_dnf().propagate_negations().optimize_constants();
+            }
+            return optimize_constants();
         }
 
-        // result is an OR-chain of *multiple* AND-chains of *only variables*
-        std::vector<std::vector<Value>> terms;
-        std::vector<std::string> vars = get_variables();
+        BDDManager manager(1 << 14);
+        manager.set_node_limit(settings.max_bdd_nodes);
+        for (const std::string& var : vars)
+        {
+            manager.get_variable(var);
+        }
+
+        BDD bdd = to_bdd_internal(manager);
+        if (!bdd.is_valid())
+        {
+            // a two-level representation would be too large, hence only constants are propagated
+            return optimize_constants();
+        }
+        if (bdd.is_constant_zero())
+        {
+            return BooleanFunction(Value::ZERO);
+        }
+        if (bdd.is_constant_one())
+        {
+            return BooleanFunction(Value::ONE);
+        }
 
-        for (const auto& or_term : result.m_operands)
+        // variables that do not influence the function are dropped
+        std::vector<std::string> support = manager.get_support(bdd);
+        std::sort(support.begin(), support.end());
+
+        std::vector<std::string> term_variables = support;
+        std::vector<std::vector<Value>> terms;
+        if (support.size() <= settings.exact_variable_limit)
         {
-            std::vector<Value> term(vars.size(), Value::X);
-            if (or_term.m_content == content_type::TERMS)
+            // small functions are minimized exactly: all prime implicants are derived from the truth table, the cover is then selected by Quine-McCluskey
+            std::vector<bool> on_set(1u << support.size(), false);
+            for (const auto& cube : manager.get_cover(bdd, support))
             {
-                for (const auto& and_term : or_term.m_operands)
+                std::vector<u32> inputs = {0};
+                for (u32 i = 0; i < support.size(); ++i)
+                {
+                    if (cube[i] == Value::ONE)
+                    {
+                        for (auto& input : inputs)
+                        {
+                            input |= 1u << i;
+                        }
+                    }
+                    else if (cube[i] == Value::X)
+                    {
+                        u32 num_inputs = inputs.size();
+                        for (u32 j = 0; j < num_inputs; ++j)
+                        {
+                            inputs.push_back(inputs[j] | (1u << i));
+                        }
+                    }
+                }
+                for (auto input : inputs)
                 {
-                    int index   = std::distance(vars.begin(), std::find(vars.begin(), vars.end(), and_term.m_variable));
-                    term[index] = and_term.m_invert ? Value::ZERO : Value::ONE;
+                    on_set[input] = true;
+                }
+            }
+            terms = qmc(get_prime_implicants(on_set, support.size()));
+        }
+        else
+        {
+            // an existing sum-of-products representation is a better starting point than the paths of the BDD
+            std::vector<std::vector<Value>> initial_cover;
+            if (is_dnf())
+            {
+                // the clauses may still contain variables outside of the support, hence all variables are used for the cubes
+                term_variables = vars;
+                std::unordered_map<std::string, u32> position;
+                for (u32 i = 0; i < vars.size(); ++i)
+                {
+                    position[vars[i]] = i;
+                }
+                bool usable = true;
+                // constant propagation is cheap on a sum-of-products and removes constant clauses
+                for (const auto& clause : optimize_constants().get_dnf_clauses())
+                {
+                    std::vector<Value> cube(vars.size(), Value::X);
+                    bool contradicting = false;
+                    for (const auto& [name, positive] : clause)
+                    {
+                        auto it = position.find(name);
+                        if (it == position.end())
+                        {
+                            // remaining constants cannot be translated into a cube
+                            usable = false;
+                            break;
+                        }
+                        Value value = positive ? Value::ONE : Value::ZERO;
+                        if (cube[it->second] != Value::X && cube[it->second] != value)
+                        {
+                            contradicting = true;
+                            break;
+                        }
+                        cube[it->second] = value;
+                    }
+                    if (!usable)
+                    {
+                        break;
+                    }
+                    if (!contradicting)
+                    {
+                        initial_cover.push_back(cube);
+                    }
+                }
+                if (!usable)
+                {
+                    initial_cover.clear();
+                    term_variables = support;
                 }
             }
             else
             {
-                int index   = std::distance(vars.begin(), std::find(vars.begin(), vars.end(), or_term.m_variable));
-                term[index] = or_term.m_invert ? Value::ZERO : Value::ONE;
+                // the number of paths strongly depends on the variable order
+                manager.reorder();
             }
-            terms.emplace_back(term);
-        }
-
-        terms = qmc(terms);
 
-        result = BooleanFunction();
+            terms = manager.get_minimized_cover(bdd, term_variables, settings.effort, settings.max_terms, settings.time_budget_ms, initial_cover);
+            if (terms.empty())
+            {
+                // the sum-of-products representation would be too large
+                return optimize_constants();
+            }
+        }
 
-        for (auto it = terms.begin(); it != terms.end(); ++it)
+        BooleanFunction result;
+        for (const auto& term : terms)
         {
-            auto& term = (*it);
             BooleanFunction tmp;
             for (u32 i = 0; i < term.size(); ++i)
             {
                 if (term[i] == Value::ONE)
                 {
-                    tmp &= BooleanFunction(vars[i]);
+                    tmp &= BooleanFunction(term_variables[i]);
                 }
                 else if (term[i] == Value::ZERO)
                 {
-                    tmp &= ~BooleanFunction(vars[i]);
+                    tmp &= ~BooleanFunction(term_variables[i]);
                 }
             }
             if (tmp.is_empty())    // all variables are "dont care"
@@ -1214,6 +1463,71 @@ namespace hal
         return result;
     }
 
+    std::vector<std::vector<BooleanFunction::Value>> BooleanFunction::get_prime_implicants(const std::vector<bool>& on_set, u32 num_variables)
+    {
+        // every cube is identified by a base-3 number whose i-th digit is the value of variable i, with 2 denoting "dont care"
+        std::vector<u32> power_of_three(num_variables + 1, 1);
+        for (u32 i = 0; i < num_variables; ++i)
+        {
+            power_of_three[i + 1] = power_of_three[i] * 3;
+        }
+        u32 num_cubes = power_of_three[num_variables];
+
+        // a cube is an implicant if both of its halves along the first "dont care" digit are implicants, which always have smaller indices
+        std::vector<bool> is_implicant(num_cubes, false);
+        for (u32 index = 0; index < num_cubes; ++index)
+        {
+            u32 rest  = index;
+            u32 input = 0;
+            i32 split = -1;
+            for (u32 i = 0; i < num_variables; ++i, rest /= 3)
+            {
+                u32 digit = rest % 3;
+                if (digit == 2)
+                {
+                    split = i;
+                    break;
+                }
+                input |= digit << i;
+            }
+            if (split < 0)
+            {
+                is_implicant[index] = on_set[input];
+            }
+            else
+            {
+                is_implicant[index] = is_implicant[index - 2 * power_of_three[split]] && is_implicant[index - power_of_three[split]];
+            }
+        }
+
+        // an implicant is prime if none of its literals can be replaced by a "dont care"
+        std::vector<std::vector<Value>> primes;
+        for (u32 index = 0; index < num_cubes; ++index)
+        {
+            if (!is_implicant[index])
+            {
+                continue;
+            }
+            std::vector<Value> cube(num_variables, Value::X);
+            bool is_prime = true;
+            u32 rest      = index;
+            for (u32 i = 0; i < num_variables && is_prime; ++i, rest /= 3)
+            {
+                u32 digit = rest % 3;
+                if (digit != 2)
+                {
+                    cube[i]  = (digit == 0) ? Value::ZERO : Value::ONE;
+                    is_prime = !is_implicant[index + (2 - digit) * power_of_three[i]];
+                }
+            }
+            if (is_prime)
+            {
+                primes.push_back(cube);
+            }
+        }
+        return primes;
+    }
+
     std::vector<std::vector<BooleanFunction::Value>> BooleanFunction::qmc(std::vector<std::vector<Value>> terms)
     {
         if (terms.empty())
@@ -1460,4 +1774,164 @@ namespace hal
 
         return result;
     }
+
+    BDD BooleanFunction::to_bdd(BDDManager& manager) const
+    {
+        if (is_empty())
+        {
+            log_error("netlist", "cannot convert an empty Boolean function to a BDD.");
+            return BDD();
+        }
+        if (contains_undefined_values())
+        {
+            log_error("netlist", "cannot convert a Boolean function containing undefined values to a BDD.");
+            return BDD();
+        }
+
+        // register new variables in a deterministic order
+        for (const std::string& var : get_variables())
+        {
+            manager.get_variable(var);
+        }
+
+        return to_bdd_internal(manager);
+    }
+
+    bool BooleanFunction::contains_undefined_values() const
+    {
+        if (m_content == content_type::CONSTANT)
+        {
+            return m_constant != Value::ZERO && m_constant != Value::ONE;
+        }
+        return std::any_of(m_operands.begin(), m_operands.end(), [](const BooleanFunction& x) { return x.contains_undefined_values(); });
+    }
+
+    BDD BooleanFunction::to_bdd_internal(BDDManager& manager) const
+    {
+        BDD result;
+
+        if (m_content == content_type::VARIABLE)
+        {
+            result = manager.get_variable(m_variable);
+        }
+        else if (m_content == content_type::CONSTANT)
+        {
+            if (m_constant != Value::ZERO && m_constant != Value::ONE)
+            {
+                return BDD();
+            }
+            result = manager.get_constant(m_constant == Value::ONE);
+        }
+        else
+        {
+            for (const BooleanFunction& x : m_operands)
+            {
+                BDD term = x.to_bdd_internal(manager);
+                if (!term.is_valid())
+                {
+                    return BDD();
+                }
+
+                if (&x == &m_operands.front())
+                {
+                    result = std::move(term);
+                }
+                else if (m_op == operation::OR)
+                {
+                    result |= term;
+                }
+                else if (m_op == operation::XOR)
+                {
+                    result ^= term;
+                }
+                else if (m_op == operation::AND)
+                {
+                    result &= term;
+                }
+
+                // the BDD manager aborts operations that exceed its node limit
+                if (!result.is_valid())
+                {
+                    return BDD();
+                }
+            }
+
+            if (!result.is_valid())
+            {
+                return BDD();
+            }
+        }
+
+        if (m_invert)
+        {
+            result = ~result;
+        }
+
+        return result;
+    }
+
+    u32 BooleanFunction::to_aig_internal(AIG& aig, const std::unordered_map<std::string, u32>& variable_literals) const
+    {
+        u32 result = AIG::INVALID_LITERAL;
+
+        if (m_content == content_type::VARIABLE)
+        {
+            if (auto it = variable_literals.find(m_variable); it != variable_literals.end())
+            {
+                result = it->second;
+            }
+            else
+            {
+                result = aig.add_input(m_variable);
+            }
+        }
+        else if (m_content == content_type::CONSTANT)
+        {
+            if (m_constant != Value::ZERO && m_constant != Value::ONE)
+            {
+                return AIG::INVALID_LITERAL;
+            }
+            result = AIG::get_constant(m_constant == Value::ONE);
+        }
+        else
+        {
+            for (const BooleanFunction& x : m_operands)
+            {
+                u32 term = x.to_aig_internal(aig, variable_literals);
+                if (term == AIG::INVALID_LITERAL)
+                {
+                    return AIG::INVALID_LITERAL;
+                }
+
+                if (&x == &m_operands.front())
+                {
+                    result = term;
+                }
+                else if (m_op == operation::OR)
+                {
+                    result = aig.add_or(result, term);
+                }
+                else if (m_op == operation::XOR)
+                {
+                    result = aig.add_xor(result, term);
+                }
+                else if (m_op == operation::AND)
+                {
+                    result = aig.add_and(result, term);
+                }
+            }
+
+            if (result == AIG::INVALID_LITERAL)
+            {
+                return AIG::INVALID_LITERAL;
+            }
+        }
+
+        if (m_invert)
+        {
+            result = AIG::negate(result);
+        }
+
+        return result;
+    }
 }    // namespace hal
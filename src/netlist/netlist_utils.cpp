@@ -44,85 +44,207 @@ namespace hal
                 }
             }
 
-            void subgraph_function_bfs(Net* n, BooleanFunction& result, std::vector<Net*> stack, const std::vector<const Gate*>& subgraph_gates, std::unordered_map<u32, BooleanFunction>& cache)
+            // composes the Boolean functions of subgraph gates bottom-up and memoizes the function of every expanded net, so that shared cones are only computed once
+            class SubgraphFunctionBuilder
             {
-                if (n->get_num_of_sources() > 1)
+            public:
+                SubgraphFunctionBuilder(const std::vector<const Gate*>& subgraph_gates, std::unordered_map<u32, BooleanFunction>& cache)
+                    : m_subgraph_gates(subgraph_gates.begin(), subgraph_gates.end()), m_cache(cache)
                 {
-                    log_error("netlist_utils", "net with ID {} has more than one source, cannot expand Boolean function in this direction.", n->get_id());
-                    return;
-                }
-                else if (n->get_num_of_sources() == 0)
-                {
-                    return;
                 }
 
-                if (auto it = std::find(stack.begin(), stack.end(), n); it != stack.end())
+                BooleanFunction get_function(const Net* net)
                 {
-                    log_error("netlist_utils", "subgraph contains a cycle: {} -> {}", utils::join(" -> ", it, stack.end(), [](auto nlog) { return nlog->get_name(); }), n->get_name());
-                    result = BooleanFunction();
-                    return;
-                }
-
-                stack.push_back(n);
+                    if (auto it = m_net_functions.find(net->get_id()); it != m_net_functions.end())
+                    {
+                        return it->second;
+                    }
 
-                Gate* src_gate = n->get_sources()[0]->get_gate();
+                    const Gate* start_gate = net->get_sources()[0]->get_gate();
+                    const bool start_in_subgraph = m_subgraph_gates.find(start_gate) != m_subgraph_gates.end();
 
-                if (std::find(subgraph_gates.begin(), subgraph_gates.end(), src_gate) != subgraph_gates.end())
-                {
-                    result = result.substitute(std::to_string(n->get_id()), get_function_of_gate(src_gate, cache));
+                    // iterative depth-first search that composes the function of a net once all of its fan-in nets are done, i.e., in reverse topological order
+                    struct Frame
+                    {
+                        const Net* net;
+                        const Gate* gate;
+                        std::vector<Net*> fan_in_nets;
+                        u32 next_index;
+                    };
+                    std::vector<Frame> stack;
+                    std::unordered_set<u32> on_stack;
+
+                    stack.push_back({net, start_gate, start_gate->get_fan_in_nets(), 0});
+                    if (start_in_subgraph)
+                    {
+                        on_stack.insert(net->get_id());
+                    }
 
-                    for (Net* sn : src_gate->get_fan_in_nets())
+                    while (!stack.empty())
                     {
-                        subgraph_function_bfs(sn, result, stack, subgraph_gates, cache);
+                        Frame& frame = stack.back();
+                        if (frame.next_index < frame.fan_in_nets.size())
+                        {
+                            const Net* fan_in_net = frame.fan_in_nets[frame.next_index++];
+                            const u32 fan_in_id   = fan_in_net->get_id();
+
+                            if (m_net_functions.find(fan_in_id) != m_net_functions.end() || m_leaf_nets.find(fan_in_id) != m_leaf_nets.end())
+                            {
+                                continue;
+                            }
+
+                            if (on_stack.find(fan_in_id) != on_stack.end())
+                            {
+                                auto it = std::find_if(stack.begin(), stack.end(), [fan_in_id](const Frame& f) { return f.net->get_id() == fan_in_id; });
+                                log_error("netlist_utils",
+                                          "subgraph contains a cycle: {} -> {}",
+                                          utils::join(" -> ", it, stack.end(), [](const Frame& f) { return f.net->get_name(); }),
+                                          fan_in_net->get_name());
+                                return BooleanFunction();
+                            }
+
+                            if (fan_in_net->get_num_of_sources() > 1)
+                            {
+                                log_error("netlist_utils", "net with ID {} has more than one source, cannot expand Boolean function in this direction.", fan_in_id);
+                                m_leaf_nets.insert(fan_in_id);
+                                continue;
+                            }
+                            else if (fan_in_net->get_num_of_sources() == 0)
+                            {
+                                m_leaf_nets.insert(fan_in_id);
+                                continue;
+                            }
+
+                            const Gate* src_gate = fan_in_net->get_sources()[0]->get_gate();
+                            if (m_subgraph_gates.find(src_gate) == m_subgraph_gates.end())
+                            {
+                                m_leaf_nets.insert(fan_in_id);
+                                continue;
+                            }
+
+                            on_stack.insert(fan_in_id);
+                            stack.push_back({fan_in_net, src_gate, src_gate->get_fan_in_nets(), 0});
+                        }
+                        else
+                        {
+                            // all fan-in nets are done, hence the function of the net only has to be substituted once per input
+                            BooleanFunction bf = get_function_of_gate(frame.gate, m_cache);
+                            for (const Net* fan_in_net : frame.fan_in_nets)
+                            {
+                                if (auto it = m_net_functions.find(fan_in_net->get_id()); it != m_net_functions.end())
+                                {
+                                    bf = bf.substitute(std::to_string(fan_in_net->get_id()), it->second);
+                                }
+                            }
+
+                            if (stack.size() == 1)
+                            {
+                                // the target net is only reused as a subgraph net if its source is part of the subgraph
+                                if (start_in_subgraph)
+                                {
+                                    m_net_functions.emplace(net->get_id(), bf);
+                                }
+                                return bf;
+                            }
+
+                            on_stack.erase(frame.net->get_id());
+                            m_net_functions.emplace(frame.net->get_id(), std::move(bf));
+                            stack.pop_back();
+                        }
                     }
+
+                    return BooleanFunction();
+                }
+
+            private:
+                std::unordered_set<const Gate*> m_subgraph_gates;
+                std::unordered_map<u32, BooleanFunction>& m_cache;
+                std::unordered_map<u32, BooleanFunction> m_net_functions;
+                std::unordered_set<u32> m_leaf_nets;
+            };
+
+            bool check_subgraph_gates(const std::vector<const Gate*>& subgraph_gates)
+            {
+                if (subgraph_gates.empty())
+                {
+                    log_error("netlist_utils", "no gates given to determine the Boolean function of.");
+                    return false;
+                }
+                else if (std::any_of(subgraph_gates.begin(), subgraph_gates.end(), [](const Gate* g) { return g == nullptr; }))
+                {
+                    log_error("netlist_utils", "set of gates contains a nullptr.");
+                    return false;
                 }
+                return true;
+            }
+
+            bool check_target_net(const Net* net)
+            {
+                if (net == nullptr)
+                {
+                    log_error("netlist_utils", "nullptr given for target net.");
+                    return false;
+                }
+                else if (net->get_num_of_sources() > 1)
+                {
+                    log_error("netlist_utils", "target net with ID {} has more than one source.", net->get_id());
+                    return false;
+                }
+                else if (net->get_num_of_sources() == 0)
+                {
+                    log_error("netlist_utils", "target net with ID {} has no sources.", net->get_id());
+                    return false;
+                }
+                return true;
             }
         }    // namespace
 
         BooleanFunction get_subgraph_function(const Net* net, const std::vector<const Gate*>& subgraph_gates, std::unordered_map<u32, BooleanFunction>& cache)
         {
             /* check validity of subgraph_gates */
-            if (subgraph_gates.empty())
-            {
-                log_error("netlist_utils", "no gates given to determine the Boolean function of.");
-                return BooleanFunction();
-            }
-            else if (std::any_of(subgraph_gates.begin(), subgraph_gates.end(), [](const Gate* g) { return g == nullptr; }))
-            {
-                log_error("netlist_utils", "set of gates contains a nullptr.");
-                return BooleanFunction();
-            }
-            else if (net == nullptr)
+            if (!check_subgraph_gates(subgraph_gates) || !check_target_net(net))
             {
-                log_error("netlist_utils", "nullptr given for target net.");
                 return BooleanFunction();
             }
-            else if (net->get_num_of_sources() > 1)
-            {
-                log_error("netlist_utils", "target net with ID {} has more than one source.", net->get_id());
-                return BooleanFunction();
-            }
-            else if (net->get_num_of_sources() == 0)
+
+            return SubgraphFunctionBuilder(subgraph_gates, cache).get_function(net);
+        }
+
+        BooleanFunction get_subgraph_function(const Net* net, const std::vector<const Gate*>& subgraph_gates)
+        {
+            std::unordered_map<u32, BooleanFunction> cache;
+            return get_subgraph_function(net, subgraph_gates, cache);
+        }
+
+        std::vector<BooleanFunction> get_subgraph_functions(const std::vector<const Net*>& nets, const std::vector<const Gate*>& subgraph_gates, std::unordered_map<u32, BooleanFunction>& cache)
+        {
+            if (!check_subgraph_gates(subgraph_gates))
             {
-                log_error("netlist_utils", "target net with ID {} has no sources.", net->get_id());
-                return BooleanFunction();
+                return {};
             }
 
-            const Gate* start_gate = net->get_sources()[0]->get_gate();
-            BooleanFunction result = get_function_of_gate(start_gate, cache);
+            SubgraphFunctionBuilder builder(subgraph_gates, cache);
 
-            for (Net* n : start_gate->get_fan_in_nets())
+            std::vector<BooleanFunction> result;
+            result.reserve(nets.size());
+            for (const Net* net : nets)
             {
-                subgraph_function_bfs(n, result, {}, subgraph_gates, cache);
+                if (check_target_net(net))
+                {
+                    result.push_back(builder.get_function(net));
+                }
+                else
+                {
+                    result.push_back(BooleanFunction());
+                }
             }
-
             return result;
         }
 
-        BooleanFunction get_subgraph_function(const Net* net, const std::vector<const Gate*>& subgraph_gates)
+        std::vector<BooleanFunction> get_subgraph_functions(const std::vector<const Net*>& nets, const std::vector<const Gate*>& subgraph_gates)
         {
             std::unordered_map<u32, BooleanFunction> cache;
-            return get_subgraph_function(net, subgraph_gates, cache);
+            return get_subgraph_functions(nets, subgraph_gates, cache);
         }
 
         std::unique_ptr<Netlist> copy_netlist(const Netlist* nl)
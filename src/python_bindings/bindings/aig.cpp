@@ -0,0 +1,290 @@
+#include "hal_core/python_bindings/python_bindings.h"
+
+namespace hal
+{
+    void aig_init(py::module& m)
+    {
+        py::class_<AIG> py_aig(m, "AIG", R"(
+            And-inverter graph (AIG) that represents combinational logic using only two-input AND nodes and complemented edges.
+            Edges are encoded as literals, i.e., twice the index of the node they point to plus one if the edge is complemented.
+            Literal 0 is constant ``ZERO`` and literal 1 is constant ``ONE``.
+            Structural hashing and constant propagation are applied whenever a node is created.
+        )");
+
+        py_aig.def_readonly_static("INVALID_LITERAL", &AIG::INVALID_LITERAL, R"(
+            Literal that is returned on error.
+
+            :type: int
+        )");
+
+        py_aig.def(py::init<>(), R"(
+            Construct an empty AIG that only contains the constant node.
+        )");
+
+        py_aig.def_static("from_gates", &AIG::from_gates, py::arg("gates"), R"(
+            Build an AIG from the Boolean functions of a set of combinational gates.
+            Every net that is driven by the Boolean function of one of the gates becomes an output of the AIG, all other nets that are read by the gates become inputs.
+            Hence, outputs of sequential gates and of gates with undefined or missing Boolean functions are treated as inputs.
+            All inputs and outputs are named by the ID of their net.
+
+            :param list[hal_py.Gate] gates: The gates.
+            :returns: The AIG or an empty AIG if the gates contain None or a combinational loop.
+            :rtype: hal_py.AIG
+        )");
+
+        py_aig.def_static("get_constant", &AIG::get_constant, py::arg("value"), R"(
+            Get the literal of a constant.
+
+            :param bool value: The constant value.
+            :returns: The literal.
+            :rtype: int
+        )");
+
+        py_aig.def_static("negate", &AIG::negate, py::arg("literal"), R"(
+            Negate a literal.
+
+            :param int literal: The literal.
+            :returns: The negated literal.
+            :rtype: int
+        )");
+
+        py_aig.def_static("get_node", &AIG::get_node, py::arg("literal"), R"(
+            Get the index of the node a literal points to.
+
+            :param int literal: The literal.
+            :returns: The node index.
+            :rtype: int
+        )");
+
+        py_aig.def_static("is_complemented", &AIG::is_complemented, py::arg("literal"), R"(
+            Check whether a literal is complemented.
+
+            :param int literal: The literal.
+            :returns: True if the literal is complemented, false otherwise.
+            :rtype: bool
+        )");
+
+        py_aig.def("add_input", &AIG::add_input, py::arg("name"), R"(
+            Add an input to the AIG.
+            If an input of the same name already exists, its literal is returned.
+
+            :param str name: The name of the input.
+            :returns: The literal of the input.
+            :rtype: int
+        )");
+
+        py_aig.def("get_input", &AIG::get_input, py::arg("name"), R"(
+            Get the literal of an input.
+
+            :param str name: The name of the input.
+            :returns: The literal of the input or ``INVALID_LITERAL`` if there is no such input.
+            :rtype: int
+        )");
+
+        py_aig.def_property_readonly("input_names", &AIG::get_input_names, R"(
+            The names of all inputs in the order they were added.
+
+            :type: list[str]
+        )");
+
+        py_aig.def("get_input_names", &AIG::get_input_names, R"(
+            Get the names of all inputs in the order they were added.
+
+            :returns: The input names.
+            :rtype: list[str]
+        )");
+
+        py_aig.def("add_and", &AIG::add_and, py::arg("a"), py::arg("b"), R"(
+            Add an AND node, unless the result is a constant, one of the inputs, or an existing node with the same inputs.
+
+            :param int a: The literal of the first input.
+            :param int b: The literal of the second input.
+            :returns: The literal of the result or ``INVALID_LITERAL`` on error.
+            :rtype: int
+        )");
+
+        py_aig.def("add_or", &AIG::add_or, py::arg("a"), py::arg("b"), R"(
+            Add an OR, which is represented as a negated AND of the negated inputs.
+
+            :param int a: The literal of the first input.
+            :param int b: The literal of the second input.
+            :returns: The literal of the result or ``INVALID_LITERAL`` on error.
+            :rtype: int
+        )");
+
+        py_aig.def("add_xor", &AIG::add_xor, py::arg("a"), py::arg("b"), R"(
+            Add an XOR, which is represented by three AND nodes.
+
+            :param int a: The literal of the first input.
+            :param int b: The literal of the second input.
+            :returns: The literal of the result or ``INVALID_LITERAL`` on error.
+            :rtype: int
+        )");
+
+        py_aig.def("add_mux", &AIG::add_mux, py::arg("select"), py::arg("if_one"), py::arg("if_zero"), R"(
+            Add a multiplexer, which is represented by three AND nodes.
+
+            :param int select: The literal of the select input.
+            :param int if_one: The literal that is selected if the select input is ``ONE``.
+            :param int if_zero: The literal that is selected if the select input is ``ZERO``.
+            :returns: The literal of the result or ``INVALID_LITERAL`` on error.
+            :rtype: int
+        )");
+
+        py_aig.def("add_boolean_function",
+                   &AIG::add_boolean_function,
+                   py::arg("function"),
+                   py::arg("variable_literals") = std::unordered_map<std::string, u32>(),
+                   R"(
+            Add the logic of a Boolean function.
+            Variables that are contained in the given dict are replaced by the respective literal, all others refer to inputs of the same name, which are created if necessary.
+
+            :param hal_py.BooleanFunction function: The Boolean function.
+            :param dict[str,int] variable_literals: A dict from variable names to literals.
+            :returns: The literal of the result or ``INVALID_LITERAL`` if the function is empty or contains undefined values.
+            :rtype: int
+        )");
+
+        py_aig.def("add_output", &AIG::add_output, py::arg("name"), py::arg("literal"), R"(
+            Add an output to the AIG or redirect an existing output of the same name.
+
+            :param str name: The name of the output.
+            :param int literal: The literal that drives the output.
+            :returns: True on success, false otherwise.
+            :rtype: bool
+        )");
+
+        py_aig.def("get_output", &AIG::get_output, py::arg("name"), R"(
+            Get the literal that drives an output.
+
+            :param str name: The name of the output.
+            :returns: The literal or ``INVALID_LITERAL`` if there is no such output.
+            :rtype: int
+        )");
+
+        py_aig.def_property_readonly("outputs", &AIG::get_outputs, R"(
+            All outputs as pairs of name and literal in the order they were added.
+
+            :type: list[tuple(str,int)]
+        )");
+
+        py_aig.def("get_outputs", &AIG::get_outputs, R"(
+            Get all outputs as pairs of name and literal in the order they were added.
+
+            :returns: The outputs.
+            :rtype: list[tuple(str,int)]
+        )");
+
+        py_aig.def("get_node_count", &AIG::get_node_count, R"(
+            Get the number of nodes including the constant node and all inputs.
+
+            :returns: The number of nodes.
+            :rtype: int
+        )");
+
+        py_aig.def("get_and_count", &AIG::get_and_count, R"(
+            Get the number of AND nodes.
+
+            :returns: The number of AND nodes.
+            :rtype: int
+        )");
+
+        py_aig.def("is_and", &AIG::is_and, py::arg("node"), R"(
+            Check whether a node is an AND node.
+
+            :param int node: The node index.
+            :returns: True if the node is an AND node, false otherwise.
+            :rtype: bool
+        )");
+
+        py_aig.def("is_input", &AIG::is_input, py::arg("node"), R"(
+            Check whether a node is an input.
+
+            :param int node: The node index.
+            :returns: True if the node is an input, false otherwise.
+            :rtype: bool
+        )");
+
+        py_aig.def("get_fan_in", &AIG::get_fan_in, py::arg("node"), R"(
+            Get the literals of both inputs of an AND node.
+
+            :param int node: The node index.
+            :returns: The pair of input literals or a pair of ``INVALID_LITERAL`` if the node is not an AND node.
+            :rtype: tuple(int,int)
+        )");
+
+        py_aig.def("get_level", &AIG::get_level, py::arg("node"), R"(
+            Get the level of a node, i.e., the number of AND nodes on the longest path from any input to the node.
+
+            :param int node: The node index.
+            :returns: The level.
+            :rtype: int
+        )");
+
+        py_aig.def("get_depth", &AIG::get_depth, R"(
+            Get the maximum level of all outputs.
+
+            :returns: The depth of the AIG.
+            :rtype: int
+        )");
+
+        py_aig.def("to_boolean_function", &AIG::to_boolean_function, py::arg("literal"), R"(
+            Convert the logic behind a literal into a Boolean function.
+            Shared nodes are duplicated, hence the size of the result may be exponential in the number of nodes.
+
+            :param int literal: The literal.
+            :returns: The Boolean function or an empty function on error.
+            :rtype: hal_py.BooleanFunction
+        )");
+
+        py_aig.def("simulate", &AIG::simulate, py::arg("input_words"), R"(
+            Simulate 64 input patterns at once.
+            Bit i of each input word belongs to pattern i, inputs without a word are ``ZERO``.
+
+            :param dict[str,int] input_words: A dict from input names to their 64 values.
+            :returns: One word per node, the value of a literal is obtained via ``get_value``.
+            :rtype: list[int]
+        )");
+
+        py_aig.def_static("get_value", &AIG::get_value, py::arg("node_words"), py::arg("literal"), R"(
+            Get the simulated value of a literal.
+
+            :param list[int] node_words: The result of ``simulate``.
+            :param int literal: The literal.
+            :returns: The 64 values of the literal.
+            :rtype: int
+        )");
+
+        py_aig.def("cleanup", &AIG::cleanup, R"(
+            Get a copy of the AIG that only contains the nodes that are required by its outputs.
+            All inputs are kept.
+
+            :returns: The cleaned up AIG.
+            :rtype: hal_py.AIG
+        )");
+
+        py_aig.def("propagate_constants", &AIG::propagate_constants, py::arg("input_values"), R"(
+            Get a copy of the AIG in which the given inputs are fixed to constants, which are then propagated through the graph.
+
+            :param dict[str,bool] input_values: A dict from input names to constant values.
+            :returns: The simplified AIG.
+            :rtype: hal_py.AIG
+        )");
+
+        py_aig.def("balance", &AIG::balance, R"(
+            Get a copy of the AIG in which chains of AND nodes are rebuilt as balanced trees to reduce the depth.
+            Nodes with more than one fan-out are not duplicated.
+
+            :returns: The balanced AIG.
+            :rtype: hal_py.AIG
+        )");
+
+        py_aig.def("refactor", &AIG::refactor, py::arg("max_cut_size") = 6, R"(
+            Get a copy of the AIG in which the logic cone of each node is replaced by an irredundant sum-of-products of its cut whenever this requires fewer AND nodes than the logic that is exclusively used by the node.
+
+            :param int max_cut_size: The maximum number of leaves of each cut, at most 6.
+            :returns: The refactored AIG.
+            :rtype: hal_py.AIG
+        )");
+    }
+}    // namespace hal
@@ -0,0 +1,298 @@
+#include "hal_core/python_bindings/python_bindings.h"
+
+namespace hal
+{
+    void bdd_init(py::module& m)
+    {
+        py::class_<BDD> py_bdd(m, "BDD", R"(
+            Handle to a reduced ordered binary decision diagram (ROBDD) that is owned by a BDDManager.
+            Two handles of the same manager represent equivalent functions if and only if they are equal.
+        )");
+
+        py_bdd.def(py::init<>(), R"(
+            Construct an invalid BDD that does not belong to any manager.
+        )");
+
+        py_bdd.def("is_valid", &BDD::is_valid, R"(
+            Check whether the BDD belongs to a manager.
+
+            :returns: True if the BDD is valid, false otherwise.
+            :rtype: bool
+        )");
+
+        py_bdd.def("is_constant_zero", &BDD::is_constant_zero, R"(
+            Check whether the BDD is the constant ``ZERO``.
+
+            :returns: True if the BDD is constant ``ZERO``, false otherwise.
+            :rtype: bool
+        )");
+
+        py_bdd.def("is_constant_one", &BDD::is_constant_one, R"(
+            Check whether the BDD is the constant ``ONE``.
+
+            :returns: True if the BDD is constant ``ONE``, false otherwise.
+            :rtype: bool
+        )");
+
+        py_bdd.def_property_readonly("node_count", &BDD::get_node_count, R"(
+            The number of nodes of the BDD including the terminal nodes.
+
+            :type: int
+        )");
+
+        py_bdd.def("get_node_count", &BDD::get_node_count, R"(
+            Get the number of nodes of the BDD including the terminal nodes.
+
+            :returns: The number of nodes.
+            :rtype: int
+        )");
+
+        py_bdd.def(py::self == py::self, R"(
+            Check whether two BDDs represent the same function.
+
+            :returns: True if both BDDs are equivalent, false otherwise.
+            :rtype: bool
+        )");
+
+        py_bdd.def(py::self != py::self, R"(
+            Check whether two BDDs represent different functions.
+
+            :returns: True if both BDDs are not equivalent, false otherwise.
+            :rtype: bool
+        )");
+
+        py_bdd.def(py::self & py::self, py::keep_alive<0, 1>(), R"(
+            Combine two BDDs using an AND operator.
+
+            :returns: The combined BDD.
+            :rtype: hal_py.BDD
+        )");
+
+        py_bdd.def(py::self | py::self, py::keep_alive<0, 1>(), R"(
+            Combine two BDDs using an OR operator.
+
+            :returns: The combined BDD.
+            :rtype: hal_py.BDD
+        )");
+
+        py_bdd.def(py::self ^ py::self, py::keep_alive<0, 1>(), R"(
+            Combine two BDDs using an XOR operator.
+
+            :returns: The combined BDD.
+            :rtype: hal_py.BDD
+        )");
+
+        py_bdd.def(~py::self, py::keep_alive<0, 1>(), R"(
+            Negate the BDD.
+
+            :returns: The negated BDD.
+            :rtype: hal_py.BDD
+        )");
+
+        py::class_<BDDManager> py_bdd_manager(m, "BDDManager", R"(
+            Manager for reduced ordered binary decision diagrams (ROBDDs) featuring a unique table, a computed table, garbage collection, and variable reordering by sifting.
+        )");
+
+        py_bdd_manager.def(py::init<u32>(), py::arg("computed_table_size") = 1 << 18, R"(
+            Construct a new BDD manager.
+
+            :param int computed_table_size: The number of entries of the computed table, rounded up to a power of two.
+        )");
+
+        py_bdd_manager.def("get_constant", &BDDManager::get_constant, py::arg("value"), py::keep_alive<0, 1>(), R"(
+            Get the BDD of a constant.
+
+            :param bool value: The constant value.
+            :returns: The constant BDD.
+            :rtype: hal_py.BDD
+        )");
+
+        py_bdd_manager.def("get_variable", &BDDManager::get_variable, py::arg("name"), py::keep_alive<0, 1>(), R"(
+            Get the BDD of a single variable.
+            If the variable is not yet known to the manager, it is appended to the end of the variable order.
+
+            :param str name: The name of the variable.
+            :returns: The BDD of the variable.
+            :rtype: hal_py.BDD
+        )");
+
+        py_bdd_manager.def("from_boolean_function", [](BDDManager& self, const BooleanFunction& function) { return function.to_bdd(self); }, py::arg("function"), py::keep_alive<0, 1>(), R"(
+            Get the BDD of a Boolean function.
+            Returns an invalid BDD if the Boolean function is empty or contains undefined values.
+
+            :param hal_py.BooleanFunction function: The Boolean function.
+            :returns: The BDD representation of the Boolean function.
+            :rtype: hal_py.BDD
+        )");
+
+        py_bdd_manager.def("get_cover", &BDDManager::get_cover, py::arg("f"), py::arg("variables"), py::arg("max_cubes") = 0, R"(
+            Get a disjoint sum-of-products cover of a BDD that contains one product term for each path to the ``ONE`` terminal.
+            Each product term assigns ``ZERO``, ``ONE``, or ``X`` (don't care) to the given variables in order.
+
+            :param hal_py.BDD f: The BDD.
+            :param list[str] variables: The variables of the product terms, which must include the support of the BDD.
+            :param int max_cubes: The maximum number of product terms, 0 for no limit.
+            :returns: The product terms or an empty list if the BDD is constant ``ZERO``, on error, or if the cover exceeds max_cubes.
+            :rtype: list[list[hal_py.BooleanFunction.Value]]
+        )");
+
+        py_bdd_manager.def("get_minimized_cover",
+                           &BDDManager::get_minimized_cover,
+                           py::arg("f"),
+                           py::arg("variables"),
+                           py::arg("effort")         = 2,
+                           py::arg("max_cubes")      = 0,
+                           py::arg("time_budget_ms") = 0,
+                           py::arg("initial_cover")  = std::vector<std::vector<BooleanFunction::Value>>(),
+                           R"(
+            Get a sum-of-products cover of a BDD using an Espresso-style heuristic of expand, irredundant, and reduce steps.
+            Each product term assigns ``ZERO``, ``ONE``, or ``X`` (don't care) to the given variables in order.
+
+            :param hal_py.BDD f: The BDD.
+            :param list[str] variables: The variables of the product terms, which must include the support of the BDD.
+            :param int effort: The maximum number of reduce-expand-irredundant iterations.
+            :param int max_cubes: The maximum number of product terms of the initial cover, 0 for no limit.
+            :param int time_budget_ms: The time in milliseconds after which the current cover is returned without further improvements, 0 for no limit.
+            :param list[list[hal_py.BooleanFunction.Value]] initial_cover: An existing cover of exactly the function of the BDD to start from. If empty, the cover of ``get_cover`` is used.
+            :returns: The product terms or an empty list if the BDD is constant ``ZERO``, on error, or if the initial cover exceeds max_cubes.
+            :rtype: list[list[hal_py.BooleanFunction.Value]]
+        )");
+
+        py_bdd_manager.def("to_boolean_function", &BDDManager::to_boolean_function, py::arg("f"), R"(
+            Convert a BDD into a Boolean function by Shannon expansion at each node.
+
+            :param hal_py.BDD f: The BDD.
+            :returns: The Boolean function.
+            :rtype: hal_py.BooleanFunction
+        )");
+
+        py_bdd_manager.def("get_variable_count", &BDDManager::get_variable_count, R"(
+            Get the number of variables known to the manager.
+
+            :returns: The number of variables.
+            :rtype: int
+        )");
+
+        py_bdd_manager.def("get_variable_order", &BDDManager::get_variable_order, R"(
+            Get the current variable order from the topmost to the bottommost variable.
+
+            :returns: The variable names in order.
+            :rtype: list[str]
+        )");
+
+        py_bdd_manager.def("set_variable_order", &BDDManager::set_variable_order, py::arg("order"), R"(
+            Set the variable order. All existing BDDs remain valid.
+
+            :param list[str] order: The variable names from the topmost to the bottommost variable.
+        )");
+
+        py_bdd_manager.def("ite", &BDDManager::ite, py::arg("f"), py::arg("g"), py::arg("h"), py::keep_alive<0, 1>(), R"(
+            Compute the if-then-else operation ``(f & g) | (~f & h)``.
+
+            :param hal_py.BDD f: The condition.
+            :param hal_py.BDD g: The BDD selected if the condition is ``ONE``.
+            :param hal_py.BDD h: The BDD selected if the condition is ``ZERO``.
+            :returns: The resulting BDD.
+            :rtype: hal_py.BDD
+        )");
+
+        py_bdd_manager.def("get_cofactor", &BDDManager::get_cofactor, py::arg("f"), py::arg("variable"), py::arg("value"), py::keep_alive<0, 1>(), R"(
+            Get the cofactor of a BDD with respect to a single variable.
+
+            :param hal_py.BDD f: The BDD.
+            :param str variable: The name of the variable.
+            :param bool value: The value the variable is fixed to.
+            :returns: The cofactor.
+            :rtype: hal_py.BDD
+        )");
+
+        py_bdd_manager.def("exists", &BDDManager::exists, py::arg("f"), py::arg("variable"), py::keep_alive<0, 1>(), R"(
+            Existentially quantify a variable, i.e., compute the disjunction of both of its cofactors.
+
+            :param hal_py.BDD f: The BDD.
+            :param str variable: The name of the variable.
+            :returns: The quantified BDD.
+            :rtype: hal_py.BDD
+        )");
+
+        py_bdd_manager.def("get_support", &BDDManager::get_support, py::arg("f"), R"(
+            Get the names of all variables a BDD depends on, ordered by the current variable order.
+
+            :param hal_py.BDD f: The BDD.
+            :returns: The support variables.
+            :rtype: list[str]
+        )");
+
+        py_bdd_manager.def("get_sat_count", &BDDManager::get_sat_count, py::arg("f"), py::arg("num_variables"), R"(
+            Get the number of satisfying assignments of a BDD over ``num_variables`` variables.
+
+            :param hal_py.BDD f: The BDD.
+            :param int num_variables: The number of variables of the input space.
+            :returns: The number of satisfying assignments or -1 on error.
+            :rtype: float
+        )");
+
+        py_bdd_manager.def("get_sat_probability", &BDDManager::get_sat_probability, py::arg("f"), R"(
+            Get the fraction of all input assignments that satisfy a BDD.
+
+            :param hal_py.BDD f: The BDD.
+            :returns: The fraction of satisfying assignments.
+            :rtype: float
+        )");
+
+        py_bdd_manager.def("get_boolean_influence", &BDDManager::get_boolean_influence, py::arg("f"), py::arg("variable"), R"(
+            Get the exact Boolean influence of a variable, i.e., the probability that flipping the variable changes the output under a uniformly random input.
+
+            :param hal_py.BDD f: The BDD.
+            :param str variable: The name of the variable.
+            :returns: The Boolean influence within [0, 1] or -1 on error, e.g., for an unknown variable or if the node limit is exceeded.
+            :rtype: float
+        )");
+
+        py_bdd_manager.def("get_boolean_influences", &BDDManager::get_boolean_influences, py::arg("f"), R"(
+            Get the exact Boolean influence of every variable in the support of a BDD.
+            Variables whose influence cannot be computed are left out.
+
+            :param hal_py.BDD f: The BDD.
+            :returns: A dict from variable names to their Boolean influence.
+            :rtype: dict[str,float]
+        )");
+
+        py_bdd_manager.def("get_node_count", &BDDManager::get_node_count, R"(
+            Get the number of nodes that are currently allocated by the manager.
+
+            :returns: The number of allocated nodes.
+            :rtype: int
+        )");
+
+        py_bdd_manager.def("collect_garbage", &BDDManager::collect_garbage, R"(
+            Reclaim all nodes that are no longer referenced by any BDD and clear the computed table.
+
+            :returns: The number of reclaimed nodes.
+            :rtype: int
+        )");
+
+        py_bdd_manager.def("reorder", &BDDManager::reorder, R"(
+            Optimize the variable order using sifting in order to reduce the number of nodes.
+            All existing BDDs remain valid.
+
+            :returns: The number of nodes after reordering.
+            :rtype: int
+        )");
+
+        py_bdd_manager.def("set_node_limit", &BDDManager::set_node_limit, py::arg("max_nodes"), R"(
+            Limit the number of nodes of the manager.
+            Operations that would exceed the limit are aborted and return an invalid BDD.
+
+            :param int max_nodes: The maximum number of nodes, 0 for no limit.
+        )");
+
+        py_bdd_manager.def("set_auto_reorder", &BDDManager::set_auto_reorder, py::arg("enable"), py::arg("threshold") = 4096, R"(
+            Enable or disable automatic reordering.
+            If enabled, sifting is triggered whenever the number of nodes exceeds a threshold, which is doubled after each run.
+
+            :param bool enable: True to enable automatic reordering, false to disable it.
+            :param int threshold: The initial number of nodes that triggers reordering.
+        )");
+    }
+}    // namespace hal
@@ -107,9 +107,13 @@ namespace hal
             Supported operators are  NOT (``!``, ``'``), AND (``&``, ``*``, ``␣``), OR (``|``, ``+``), XOR (``^``) and brackets (``(``, ``)``).
             Operator precedence is ``!`` > ``&`` > ``^`` > ``|``.
 
-            Since, for example, ``(`` is interpreted as a new term, but might also be an intended part of a variable, a vector of known variable names can be supplied, which are extracted before parsing.
+            Operands that directly follow each other are combined using AND.
 
-            If there is an error during bracket matching, ``X`` is returned for that part.
+            Since, for example, ``(`` is interpreted as a new term, but might also be an intended part of a variable, a vector of known variable names can be supplied.
+            Wherever one of them occurs in the expression, the longest matching name is treated as a variable.
+
+            If the expression cannot be parsed, the error and its position are logged and ``X`` is returned.
+            Successfully parsed functions are cached process-wide, hence parsing the same expression again is cheap.
 
             :param str expression: String containing a Boolean function.
             :param list[str] variable_names: List of variable names.
@@ -213,9 +217,59 @@ namespace hal
             :rtype: list[list[tuple(str,bool)]]
         )");
 
-        py_boolean_function.def("optimize", &BooleanFunction::optimize, R"(
-            Optimize the Boolean function by first converting it to disjunctive normal form (DNF) and then applying the Quine-McCluskey algorithm.
+        py::class_<BooleanFunction::OptimizationSettings> py_optimization_settings(py_boolean_function, "OptimizationSettings", R"(
+            Settings that control the effort of optimize().
+        )");
+
+        py_optimization_settings.def(py::init<>(), R"(
+            Construct the default optimization settings.
+        )");
+
+        py_optimization_settings.def_readwrite("exact_variable_limit", &BooleanFunction::OptimizationSettings::exact_variable_limit, R"(
+            Functions that depend on at most this many variables are minimized exactly using the Quine-McCluskey algorithm.
+
+            :type: int
+        )");
+
+        py_optimization_settings.def_readwrite("effort", &BooleanFunction::OptimizationSettings::effort, R"(
+            The maximum number of reduce-expand-irredundant iterations of the heuristic minimization of larger functions.
+
+            :type: int
+        )");
+
+        py_optimization_settings.def_readwrite("max_terms", &BooleanFunction::OptimizationSettings::max_terms, R"(
+            The maximum number of product terms of the sum-of-products representation, 0 for no limit.
+
+            :type: int
+        )");
+
+        py_optimization_settings.def_readwrite("max_bdd_nodes", &BooleanFunction::OptimizationSettings::max_bdd_nodes, R"(
+            The maximum number of BDD nodes used during optimization, 0 for no limit.
 
+            :type: int
+        )");
+
+        py_optimization_settings.def_readwrite("time_budget_ms", &BooleanFunction::OptimizationSettings::time_budget_ms, R"(
+            The time in milliseconds after which the heuristic minimization returns its current result, 0 for no limit.
+
+            :type: int
+        )");
+
+        py_boolean_function.def("optimize", py::overload_cast<>(&BooleanFunction::optimize, py::const_), R"(
+            Optimize the Boolean function into a minimized sum-of-products representation using the default optimization settings.
+            Functions with few variables are minimized exactly using the Quine-McCluskey algorithm, larger functions are minimized by an Espresso-style heuristic on their BDD.
+            If a limit is exceeded, the function is only simplified by removing constants.
+
+            :returns: The optimized Boolean function.
+            :rtype: hal_py.BooleanFunction
+        )");
+
+        py_boolean_function.def("optimize", py::overload_cast<const BooleanFunction::OptimizationSettings&>(&BooleanFunction::optimize, py::const_), py::arg("settings"), R"(
+            Optimize the Boolean function into a minimized sum-of-products representation.
+            Functions with few variables are minimized exactly using the Quine-McCluskey algorithm, larger functions are minimized by an Espresso-style heuristic on their BDD.
+            If a limit is exceeded, the function is only simplified by removing constants.
+
+            :param hal_py.BooleanFunction.OptimizationSettings settings: The optimization settings.
             :returns: The optimized Boolean function.
             :rtype: hal_py.BooleanFunction
         )");
@@ -241,5 +295,14 @@ namespace hal
             :returns: The list of output values.
             :rtype: list[hal_py.BooleanFunction.Value]
         )");
+
+        py_boolean_function.def("to_bdd", &BooleanFunction::to_bdd, py::arg("manager"), py::keep_alive<0, 2>(), R"(
+            Get the reduced ordered binary decision diagram (ROBDD) of the Boolean function.
+            Returns an invalid BDD if the Boolean function is empty or contains undefined values.
+
+            :param hal_py.BDDManager manager: The BDD manager.
+            :returns: The BDD representation of the Boolean function.
+            :rtype: hal_py.BDD
+        )");
     }
 }    // namespace hal
@@ -21,6 +21,21 @@ namespace hal
             :rtype: hal_py.BooleanFunction
         )");
 
+        py_netlist_utils.def("get_subgraph_functions",
+                             py::overload_cast<const std::vector<const Net*>&, const std::vector<const Gate*>&>(&netlist_utils::get_subgraph_functions),
+                             py::arg("nets"),
+                             py::arg("subgraph_gates"),
+                             R"(
+            Get the combined Boolean functions of multiple nets, considering an entire subgraph.<br>
+            Logic that is shared between the nets is only composed once, hence this is much faster than determining the function of each net separately.<br>
+            The variables of the resulting Boolean functions are the net IDs of the nets that influence the outputs.
+
+            :param list[hal_py.Net] nets: The output nets for which to generate the Boolean functions.
+            :param list[hal_py.Gate] subgraph_gates: The gates making up the subgraph.
+            :returns: The combined Boolean functions in the order of the given nets, with an empty function for each net that caused an error.
+            :rtype: list[hal_py.BooleanFunction]
+        )");
+
         py_netlist_utils.def(
             "copy_netlist", [](const Netlist* nl) { return std::shared_ptr<Netlist>(netlist_utils::copy_netlist(nl)); }, py::arg("nl"), R"(
             Get a deep copy of an entire netlist including all of its gates, nets, modules, and groupings.
@@ -53,6 +53,10 @@ namespace hal
 
         boolean_function_init(m);
 
+        bdd_init(m);
+
+        aig_init(m);
+
 #ifndef PYBIND11_MODULE
         return m.ptr();
 #endif    // PYBIND11_MODULE
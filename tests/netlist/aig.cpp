@@ -0,0 +1,269 @@
+#include "netlist_test_utils.h"
+#include "gtest/gtest.h"
+#include "hal_core/netlist/aig.h"
+#include "hal_core/netlist/bdd.h"
+#include "hal_core/netlist/boolean_function.h"
+#include "hal_core/netlist/gate.h"
+#include "hal_core/netlist/gate_library/gate_library.h"
+#include "hal_core/netlist/net.h"
+#include <random>
+
+namespace hal {
+
+    class AIGTest : public ::testing::Test {
+    protected:
+
+        virtual void SetUp() {
+            test_utils::init_log_channels();
+        }
+
+        virtual void TearDown() {
+        }
+
+        // Build a random Boolean function over the given variables
+        BooleanFunction random_function(std::mt19937& gen, const std::vector<std::string>& vars, u32 depth) {
+            std::uniform_int_distribution<u32> dist(0, 5);
+            u32 choice = (depth == 0) ? 0 : dist(gen);
+            switch (choice) {
+                case 0:
+                case 1:
+                    return BooleanFunction(vars[gen() % vars.size()]);
+                case 2:
+                    return random_function(gen, vars, depth - 1) & random_function(gen, vars, depth - 1);
+                case 3:
+                    return random_function(gen, vars, depth - 1) | random_function(gen, vars, depth - 1);
+                case 4:
+                    return random_function(gen, vars, depth - 1) ^ random_function(gen, vars, depth - 1);
+                default:
+                    return ~random_function(gen, vars, depth - 1);
+            }
+        }
+
+        // Check that all outputs of two AIGs are equivalent by comparing their BDDs
+        void expect_equivalent_outputs(const AIG& a, const AIG& b) {
+            BDDManager mgr;
+            ASSERT_EQ(a.get_outputs().size(), b.get_outputs().size());
+            for (const auto& [name, literal] : a.get_outputs()) {
+                EXPECT_EQ(a.to_boolean_function(literal).to_bdd(mgr), b.to_boolean_function(b.get_output(name)).to_bdd(mgr));
+            }
+        }
+    };
+
+    /**
+     * Testing structural hashing and constant propagation during construction.
+     *
+     * Functions: add_input, add_and, add_or, add_xor, add_mux, get_constant, negate
+     */
+    TEST_F(AIGTest, check_construction) {
+        TEST_START
+            AIG aig;
+            u32 a = aig.add_input("A");
+            u32 b = aig.add_input("B");
+            EXPECT_EQ(aig.add_input("A"), a);
+            EXPECT_EQ(aig.get_input("B"), b);
+            EXPECT_EQ(aig.get_input("C"), AIG::INVALID_LITERAL);
+            EXPECT_EQ(aig.get_input_names(), std::vector<std::string>({"A", "B"}));
+
+            // constant propagation and trivial cases do not create nodes
+            EXPECT_EQ(aig.add_and(a, AIG::get_constant(false)), AIG::get_constant(false));
+            EXPECT_EQ(aig.add_and(a, AIG::get_constant(true)), a);
+            EXPECT_EQ(aig.add_and(a, a), a);
+            EXPECT_EQ(aig.add_and(a, AIG::negate(a)), AIG::get_constant(false));
+            EXPECT_EQ(aig.get_and_count(), 0);
+
+            // structural hashing
+            u32 ab = aig.add_and(a, b);
+            EXPECT_EQ(aig.add_and(b, a), ab);
+            EXPECT_EQ(aig.get_and_count(), 1);
+            EXPECT_TRUE(aig.is_and(AIG::get_node(ab)));
+            EXPECT_TRUE(aig.is_input(AIG::get_node(a)));
+            EXPECT_EQ(aig.get_fan_in(AIG::get_node(ab)), std::make_pair(a, b));
+            EXPECT_EQ(aig.get_level(AIG::get_node(ab)), 1);
+
+            EXPECT_EQ(aig.add_or(a, b), AIG::negate(aig.add_and(AIG::negate(a), AIG::negate(b))));
+            aig.add_xor(a, b);
+            aig.add_mux(a, b, AIG::negate(b));
+            EXPECT_EQ(aig.get_and_count(), 6);
+
+            {
+                NO_COUT_TEST_BLOCK;
+                EXPECT_EQ(aig.add_and(a, 1000), AIG::INVALID_LITERAL);
+                EXPECT_EQ(aig.add_boolean_function(BooleanFunction()), AIG::INVALID_LITERAL);
+                EXPECT_EQ(aig.add_boolean_function(BooleanFunction::from_string("A & X")), AIG::INVALID_LITERAL);
+                EXPECT_FALSE(aig.add_output("O", AIG::INVALID_LITERAL));
+            }
+        TEST_END
+    }
+
+    /**
+     * Testing the conversion from and to Boolean functions and z3 expressions as well as simulation.
+     *
+     * Functions: add_boolean_function, to_boolean_function, to_z3, simulate, get_value
+     */
+    TEST_F(AIGTest, check_conversion) {
+        TEST_START
+            std::mt19937 gen(3);
+            std::vector<std::string> vars = {"A", "B", "C", "D", "E", "F"};
+            for (u32 i = 0; i < 50; i++) {
+                BooleanFunction bf = random_function(gen, vars, 6);
+                AIG aig;
+                u32 literal = aig.add_boolean_function(bf);
+                ASSERT_NE(literal, AIG::INVALID_LITERAL);
+
+                BDDManager mgr;
+                EXPECT_EQ(aig.to_boolean_function(literal).to_bdd(mgr), bf.to_bdd(mgr));
+
+                // all 64 assignments of the six variables are simulated at once
+                std::unordered_map<std::string, u64> input_words = {{"A", 0xAAAAAAAAAAAAAAAAull},
+                                                                    {"B", 0xCCCCCCCCCCCCCCCCull},
+                                                                    {"C", 0xF0F0F0F0F0F0F0F0ull},
+                                                                    {"D", 0xFF00FF00FF00FF00ull},
+                                                                    {"E", 0xFFFF0000FFFF0000ull},
+                                                                    {"F", 0xFFFFFFFF00000000ull}};
+                u64 word = AIG::get_value(aig.simulate(input_words), literal);
+                for (u32 j = 0; j < 64; j++) {
+                    std::unordered_map<std::string, BooleanFunction::Value> inputs;
+                    for (u32 k = 0; k < vars.size(); k++) {
+                        inputs[vars[k]] = ((j >> k) & 1) ? BooleanFunction::ONE : BooleanFunction::ZERO;
+                    }
+                    EXPECT_EQ(((word >> j) & 1) ? BooleanFunction::ONE : BooleanFunction::ZERO, bf.evaluate(inputs));
+                }
+
+                // z3 proves the equivalence to the original function
+                z3::context ctx;
+                z3::solver solver(ctx);
+                solver.add(aig.to_z3(ctx, literal) != bf.to_z3(ctx));
+                EXPECT_EQ(solver.check(), z3::unsat);
+            }
+
+            {
+                // variables can be mapped to existing literals
+                AIG aig;
+                u32 x = aig.add_input("X");
+                u32 literal = aig.add_boolean_function(BooleanFunction::from_string("A & B"), {{"A", x}});
+                EXPECT_EQ(aig.get_input_names(), std::vector<std::string>({"X", "B"}));
+                EXPECT_EQ(aig.to_boolean_function(literal).to_string(), "X & B");
+                EXPECT_EQ(aig.to_boolean_function(AIG::negate(literal)).to_string(), "!(X & B)");
+                EXPECT_EQ(aig.to_boolean_function(aig.add_or(x, literal)).to_string(), "X | (X & B)");
+            }
+        TEST_END
+    }
+
+    /**
+     * Testing balancing, refactoring, constant propagation, and cleanup.
+     *
+     * Functions: balance, refactor, propagate_constants, cleanup, get_depth
+     */
+    TEST_F(AIGTest, check_rewriting) {
+        TEST_START
+            {
+                // a chain of 16 AND nodes becomes a balanced tree
+                AIG aig;
+                u32 chain = aig.add_input("I0");
+                for (u32 i = 1; i < 16; i++) {
+                    chain = aig.add_and(chain, aig.add_input("I" + std::to_string(i)));
+                }
+                aig.add_output("O", chain);
+                EXPECT_EQ(aig.get_depth(), 15);
+
+                AIG balanced = aig.balance();
+                EXPECT_EQ(balanced.get_depth(), 4);
+                EXPECT_EQ(balanced.get_and_count(), 15);
+                expect_equivalent_outputs(aig, balanced);
+            }
+            {
+                // (A & B) | (A & !B) | (A & C) is refactored into A
+                AIG aig;
+                u32 literal = aig.add_boolean_function(BooleanFunction::from_string("(A & B) | (A & !B) | (A & C)"));
+                aig.add_output("O", literal);
+                EXPECT_GT(aig.get_and_count(), 0);
+
+                AIG refactored = aig.refactor();
+                EXPECT_EQ(refactored.get_and_count(), 0);
+                EXPECT_EQ(refactored.get_output("O"), refactored.get_input("A"));
+            }
+            {
+                // refactoring never increases the number of nodes and preserves all outputs
+                std::mt19937 gen(11);
+                std::vector<std::string> vars = {"A", "B", "C", "D", "E", "F", "G", "H"};
+                for (u32 i = 0; i < 20; i++) {
+                    AIG aig;
+                    for (u32 j = 0; j < 3; j++) {
+                        aig.add_output("O" + std::to_string(j), aig.add_boolean_function(random_function(gen, vars, 7)));
+                    }
+                    AIG clean = aig.cleanup();
+                    AIG refactored = aig.refactor();
+                    AIG balanced = aig.balance();
+                    EXPECT_LE(refactored.get_and_count(), clean.get_and_count());
+                    EXPECT_LE(balanced.get_depth(), clean.get_depth());
+                    expect_equivalent_outputs(aig, refactored);
+                    expect_equivalent_outputs(aig, balanced);
+                }
+            }
+            {
+                // constant inputs are propagated and dangling nodes are removed
+                AIG aig;
+                aig.add_output("O", aig.add_boolean_function(BooleanFunction::from_string("(A & B) | (C ^ D)")));
+                aig.add_boolean_function(BooleanFunction::from_string("A & C & D"));
+                EXPECT_EQ(aig.cleanup().get_and_count(), 5);
+
+                AIG simplified = aig.propagate_constants({{"C", false}, {"D", false}});
+                EXPECT_EQ(simplified.get_and_count(), 1);
+                EXPECT_EQ(simplified.to_boolean_function(simplified.get_output("O")).to_string(), "A & B");
+                EXPECT_EQ(simplified.get_input_names(), aig.get_input_names());
+            }
+        TEST_END
+    }
+
+    /**
+     * Testing the construction of an AIG from gates.
+     *
+     * Functions: from_gates
+     */
+    TEST_F(AIGTest, check_from_gates) {
+        TEST_START
+            std::unique_ptr<Netlist> nl = test_utils::create_empty_netlist();
+            const GateLibrary* gl = nl->get_gate_library();
+
+            Gate* and_gate = nl->create_gate(gl->get_gate_type_by_name("AND2"), "and");
+            Gate* xor_gate = nl->create_gate(gl->get_gate_type_by_name("XOR2"), "xor");
+            Gate* inv_gate = nl->create_gate(gl->get_gate_type_by_name("INV"), "inv");
+            Gate* ff_gate = nl->create_gate(gl->get_gate_type_by_name("DFFE"), "ff");
+
+            Net* a = test_utils::connect(nl.get(), ff_gate, "Q", and_gate, "I0");
+            Net* b = nl->create_net("b");
+            b->add_destination(and_gate, "I1");
+            b->add_destination(xor_gate, "I1");
+            Net* ab = test_utils::connect(nl.get(), and_gate, "O", xor_gate, "I0");
+            Net* x = test_utils::connect(nl.get(), xor_gate, "O", inv_gate, "I");
+            Net* o = test_utils::connect(nl.get(), inv_gate, "O", ff_gate, "D");
+
+            AIG aig = AIG::from_gates({and_gate, xor_gate, inv_gate, ff_gate});
+            std::string a_name = std::to_string(a->get_id());
+            std::string b_name = std::to_string(b->get_id());
+            EXPECT_EQ(aig.get_input_names().size(), 2);
+            EXPECT_NE(aig.get_input(a_name), AIG::INVALID_LITERAL);
+            EXPECT_NE(aig.get_input(b_name), AIG::INVALID_LITERAL);
+            EXPECT_EQ(aig.get_outputs().size(), 3);
+
+            BDDManager mgr;
+            BooleanFunction expected = ~((BooleanFunction(a_name) & BooleanFunction(b_name)) ^ BooleanFunction(b_name));
+            EXPECT_EQ(aig.to_boolean_function(aig.get_output(std::to_string(o->get_id()))).to_bdd(mgr), expected.to_bdd(mgr));
+            EXPECT_NE(aig.get_output(std::to_string(ab->get_id())), AIG::INVALID_LITERAL);
+            EXPECT_NE(aig.get_output(std::to_string(x->get_id())), AIG::INVALID_LITERAL);
+
+            // NEGATIVE
+            {
+                NO_COUT_TEST_BLOCK;
+                EXPECT_EQ(AIG::from_gates({and_gate, nullptr}).get_node_count(), 1);
+
+                // combinational loop
+                Gate* loop_0 = nl->create_gate(gl->get_gate_type_by_name("INV"), "loop_0");
+                Gate* loop_1 = nl->create_gate(gl->get_gate_type_by_name("INV"), "loop_1");
+                test_utils::connect(nl.get(), loop_0, "O", loop_1, "I");
+                test_utils::connect(nl.get(), loop_1, "O", loop_0, "I");
+                EXPECT_EQ(AIG::from_gates({loop_0, loop_1}).get_node_count(), 1);
+            }
+        TEST_END
+    }
+}    // namespace hal
@@ -0,0 +1,327 @@
+#include "netlist_test_utils.h"
+#include "gtest/gtest.h"
+#include "hal_core/netlist/bdd.h"
+#include "hal_core/netlist/boolean_function.h"
+#include <random>
+
+namespace hal {
+
+    class BDDTest : public ::testing::Test {
+    protected:
+
+        virtual void SetUp() {
+            test_utils::init_log_channels();
+        }
+
+        virtual void TearDown() {
+        }
+
+        // Build a random Boolean function over the given variables
+        BooleanFunction random_function(std::mt19937& gen, const std::vector<std::string>& vars, u32 depth) {
+            std::uniform_int_distribution<u32> dist(0, 5);
+            u32 choice = (depth == 0) ? 0 : dist(gen);
+            switch (choice) {
+                case 0:
+                case 1:
+                    return BooleanFunction(vars[gen() % vars.size()]);
+                case 2:
+                    return random_function(gen, vars, depth - 1) & random_function(gen, vars, depth - 1);
+                case 3:
+                    return random_function(gen, vars, depth - 1) | random_function(gen, vars, depth - 1);
+                case 4:
+                    return random_function(gen, vars, depth - 1) ^ random_function(gen, vars, depth - 1);
+                default:
+                    return ~random_function(gen, vars, depth - 1);
+            }
+        }
+    };
+
+    /**
+     * Testing constants, variables and the basic operators.
+     *
+     * Functions: get_constant, get_variable, operator&, operator|, operator^, operator~, operator==
+     */
+    TEST_F(BDDTest, check_basic_operations) {
+        TEST_START
+            BDDManager mgr;
+            BDD zero = mgr.get_constant(false);
+            BDD one = mgr.get_constant(true);
+            BDD a = mgr.get_variable("A");
+            BDD b = mgr.get_variable("B");
+
+            EXPECT_TRUE(zero.is_constant_zero());
+            EXPECT_TRUE(one.is_constant_one());
+            EXPECT_FALSE(BDD().is_valid());
+            EXPECT_EQ(mgr.get_variable_count(), 2);
+            EXPECT_EQ(a, mgr.get_variable("A"));
+            EXPECT_NE(a, b);
+
+            EXPECT_EQ(a & ~a, zero);
+            EXPECT_EQ(a | ~a, one);
+            EXPECT_EQ(a ^ a, zero);
+            EXPECT_EQ(~~a, a);
+            EXPECT_EQ(~(a & b), ~a | ~b);
+            EXPECT_EQ(a ^ b, (a & ~b) | (~a & b));
+            EXPECT_EQ(mgr.ite(a, b, zero), a & b);
+            EXPECT_EQ(mgr.ite(a, one, b), a | b);
+            EXPECT_EQ(a.get_node_count(), 3);
+            EXPECT_EQ((a ^ b).get_node_count(), 5);
+        TEST_END
+    }
+
+    /**
+     * Testing the conversion from and to Boolean functions and the equivalence check.
+     *
+     * Functions: BooleanFunction::to_bdd, to_boolean_function
+     */
+    TEST_F(BDDTest, check_boolean_function_conversion) {
+        TEST_START
+            {
+                BDDManager mgr;
+                BDD f = BooleanFunction::from_string("A & (B | C)").to_bdd(mgr);
+                BDD g = BooleanFunction::from_string("(A & B) | (A & C)").to_bdd(mgr);
+                BDD h = BooleanFunction::from_string("(A & B) | C").to_bdd(mgr);
+
+                EXPECT_EQ(f, g);
+                EXPECT_NE(f, h);
+                EXPECT_EQ(mgr.get_variable_order(), std::vector<std::string>({"A", "B", "C"}));
+                EXPECT_TRUE(BooleanFunction::from_string("A & !A").to_bdd(mgr).is_constant_zero());
+                EXPECT_TRUE(BooleanFunction::from_string("1").to_bdd(mgr).is_constant_one());
+            }
+            {
+                // undefined values and empty functions cannot be represented
+                BDDManager mgr;
+                NO_COUT_TEST_BLOCK;
+                EXPECT_FALSE(BooleanFunction::from_string("A & X").to_bdd(mgr).is_valid());
+                EXPECT_FALSE(BooleanFunction().to_bdd(mgr).is_valid());
+            }
+            {
+                // random functions are equivalent iff their truth tables match, and survive a round trip
+                BDDManager mgr;
+                std::mt19937 gen(42);
+                std::vector<std::string> vars = {"A", "B", "C", "D"};
+                for (u32 i = 0; i < 50; i++) {
+                    BooleanFunction f = random_function(gen, vars, 4);
+                    BooleanFunction g = random_function(gen, vars, 4);
+                    BDD bdd_f = f.to_bdd(mgr);
+                    BDD bdd_g = g.to_bdd(mgr);
+
+                    EXPECT_EQ(bdd_f == bdd_g, f.get_truth_table(vars) == g.get_truth_table(vars));
+                    EXPECT_EQ(mgr.to_boolean_function(bdd_f).get_truth_table(vars), f.get_truth_table(vars));
+                }
+            }
+        TEST_END
+    }
+
+    /**
+     * Testing cofactors, quantification and support computation.
+     *
+     * Functions: get_cofactor, exists, get_support
+     */
+    TEST_F(BDDTest, check_cofactors) {
+        TEST_START
+            BDDManager mgr;
+            BDD f = BooleanFunction::from_string("(A & B) | (!A & C)").to_bdd(mgr);
+
+            EXPECT_EQ(mgr.get_cofactor(f, "A", true), mgr.get_variable("B"));
+            EXPECT_EQ(mgr.get_cofactor(f, "A", false), mgr.get_variable("C"));
+            EXPECT_EQ(mgr.get_cofactor(f, "D", false), f);
+            EXPECT_EQ(mgr.exists(f, "A"), mgr.get_variable("B") | mgr.get_variable("C"));
+            EXPECT_EQ(mgr.get_support(f), std::vector<std::string>({"A", "B", "C"}));
+            EXPECT_EQ(mgr.get_support(mgr.get_cofactor(f, "A", true)), std::vector<std::string>({"B"}));
+            EXPECT_TRUE(mgr.get_support(mgr.get_constant(true)).empty());
+        TEST_END
+    }
+
+    /**
+     * Testing model counting and exact Boolean influence.
+     *
+     * Functions: get_sat_count, get_sat_probability, get_boolean_influence, get_boolean_influences
+     */
+    TEST_F(BDDTest, check_sat_count_and_influence) {
+        TEST_START
+            BDDManager mgr;
+            BDD f_and = BooleanFunction::from_string("A & B").to_bdd(mgr);
+            BDD f_xor = BooleanFunction::from_string("A ^ B ^ C").to_bdd(mgr);
+            BDD f_maj = BooleanFunction::from_string("(A & B) | (A & C) | (B & C)").to_bdd(mgr);
+
+            EXPECT_DOUBLE_EQ(mgr.get_sat_count(f_and, 2), 1);
+            EXPECT_DOUBLE_EQ(mgr.get_sat_count(f_and, 4), 4);
+            EXPECT_DOUBLE_EQ(mgr.get_sat_count(f_xor, 3), 4);
+            EXPECT_DOUBLE_EQ(mgr.get_sat_count(f_maj, 3), 4);
+            EXPECT_DOUBLE_EQ(mgr.get_sat_probability(f_and), 0.25);
+            {
+                NO_COUT_TEST_BLOCK;
+                EXPECT_DOUBLE_EQ(mgr.get_sat_count(f_xor, 2), -1);
+            }
+
+            EXPECT_DOUBLE_EQ(mgr.get_boolean_influence(f_and, "A"), 0.5);
+            EXPECT_DOUBLE_EQ(mgr.get_boolean_influence(f_and, "C"), 0);
+            {
+                NO_COUT_TEST_BLOCK;
+                EXPECT_DOUBLE_EQ(mgr.get_boolean_influence(f_and, "unknown"), -1);
+                EXPECT_DOUBLE_EQ(mgr.get_boolean_influence(BDD(), "A"), -1);
+            }
+            EXPECT_EQ(mgr.get_boolean_influences(f_xor), (std::map<std::string, double>({{"A", 1.0}, {"B", 1.0}, {"C", 1.0}})));
+            EXPECT_EQ(mgr.get_boolean_influences(f_maj), (std::map<std::string, double>({{"A", 0.5}, {"B", 0.5}, {"C", 0.5}})));
+
+            // counting must not be limited by the number of variables
+            BDD wide = mgr.get_constant(true);
+            for (u32 i = 0; i < 60; i++) {
+                wide &= mgr.get_variable("x" + std::to_string(i));
+            }
+            EXPECT_DOUBLE_EQ(mgr.get_sat_count(wide, 64), 16);
+            EXPECT_DOUBLE_EQ(mgr.get_boolean_influence(wide, "x7"), std::ldexp(1.0, -59));
+        TEST_END
+    }
+
+    /**
+     * Testing the computation of sum-of-products covers.
+     *
+     * Functions: get_cover, get_minimized_cover
+     */
+    TEST_F(BDDTest, check_covers) {
+        TEST_START
+            const BooleanFunction::Value X = BooleanFunction::X;
+            const BooleanFunction::Value ZERO = BooleanFunction::ZERO;
+            const BooleanFunction::Value ONE = BooleanFunction::ONE;
+            std::vector<std::string> vars = {"A", "B", "C"};
+            {
+                BDDManager mgr;
+                BDD f = BooleanFunction::from_string("(A & C) | (B & !C) | (A & B)").to_bdd(mgr);
+
+                // the disjoint cover contains one term per path
+                auto cover = mgr.get_cover(f, vars);
+                EXPECT_EQ(cover.size(), 3);
+                EXPECT_TRUE(mgr.get_cover(f, vars, 2).empty());
+
+                // the consensus term A & B is redundant
+                auto minimized = mgr.get_minimized_cover(f, vars);
+                EXPECT_EQ(minimized, (std::vector<std::vector<BooleanFunction::Value>>({{ONE, X, ONE}, {X, ONE, ZERO}})));
+                EXPECT_EQ(mgr.get_minimized_cover(f, vars, 2, 0, 0, {{ONE, X, ONE}, {X, ONE, ZERO}, {ONE, ONE, X}}), minimized);
+
+                EXPECT_TRUE(mgr.get_cover(mgr.get_constant(false), vars).empty());
+                EXPECT_EQ(mgr.get_minimized_cover(mgr.get_constant(true), vars), (std::vector<std::vector<BooleanFunction::Value>>({{X, X, X}})));
+                {
+                    NO_COUT_TEST_BLOCK;
+                    EXPECT_TRUE(mgr.get_cover(f, {"A", "B"}).empty());
+                }
+            }
+            {
+                // random functions are covered exactly
+                BDDManager mgr;
+                std::mt19937 gen(7);
+                std::vector<std::string> rvars = {"A", "B", "C", "D", "E"};
+                for (u32 i = 0; i < 50; i++) {
+                    BooleanFunction bf = random_function(gen, rvars, 5);
+                    BDD f = bf.to_bdd(mgr);
+                    BDD g = mgr.get_constant(false);
+                    for (const auto& cube : mgr.get_minimized_cover(f, rvars, 3)) {
+                        BDD term = mgr.get_constant(true);
+                        for (u32 j = 0; j < cube.size(); j++) {
+                            if (cube[j] == ONE) {
+                                term &= mgr.get_variable(rvars[j]);
+                            } else if (cube[j] == ZERO) {
+                                term &= ~mgr.get_variable(rvars[j]);
+                            }
+                        }
+                        g |= term;
+                    }
+                    EXPECT_EQ(f, g);
+                }
+            }
+        TEST_END
+    }
+
+    /**
+     * Testing the node limit.
+     *
+     * Functions: set_node_limit
+     */
+    TEST_F(BDDTest, check_node_limit) {
+        TEST_START
+            BDDManager mgr;
+            BDD a = mgr.get_variable("A");
+            BDD b = mgr.get_variable("B");
+            BDD c = mgr.get_variable("C");
+            mgr.set_node_limit(mgr.get_node_count());
+
+            // operations that do not need any new nodes still succeed
+            EXPECT_FALSE((a & b).is_valid());
+            EXPECT_EQ(a & a, a);
+            EXPECT_EQ(a | mgr.get_constant(true), mgr.get_constant(true));
+
+            mgr.set_node_limit(0);
+            EXPECT_TRUE((a & b & c).is_valid());
+
+            // cofactors of f with respect to B need new nodes
+            BDD f = (a & b) | (c & mgr.get_variable("D"));
+            mgr.set_node_limit(mgr.get_node_count());
+            {
+                NO_COUT_TEST_BLOCK;
+                EXPECT_DOUBLE_EQ(mgr.get_boolean_influence(f, "B"), -1);
+                EXPECT_EQ(mgr.get_boolean_influences(f).count("B"), 0u);
+            }
+            mgr.set_node_limit(0);
+            EXPECT_DOUBLE_EQ(mgr.get_boolean_influence(f, "B"), 0.375);
+        TEST_END
+    }
+
+    /**
+     * Testing garbage collection and variable reordering.
+     *
+     * Functions: collect_garbage, reorder, set_variable_order, get_node_count
+     */
+    TEST_F(BDDTest, check_gc_and_reordering) {
+        TEST_START
+            {
+                BDDManager mgr;
+                BDD f = BooleanFunction::from_string("(A & B) | (C & D)").to_bdd(mgr);
+                {
+                    BDD g = f ^ mgr.get_variable("E");
+                }
+                u32 before = mgr.get_node_count();
+                EXPECT_GT(mgr.collect_garbage(), 0);
+                EXPECT_LT(mgr.get_node_count(), before);
+                EXPECT_EQ(f, BooleanFunction::from_string("(A & B) | (C & D)").to_bdd(mgr));
+            }
+            {
+                // (x0 & y0) | (x1 & y1) | ... is exponential for the order x0 x1 ... y0 y1 ... and linear for x0 y0 x1 y1 ...
+                const u32 n = 6;
+                std::vector<std::string> bad_order, good_order;
+                for (u32 i = 0; i < n; i++) {
+                    bad_order.push_back("x" + std::to_string(i));
+                    good_order.push_back("x" + std::to_string(i));
+                    good_order.push_back("y" + std::to_string(i));
+                }
+                for (u32 i = 0; i < n; i++) {
+                    bad_order.push_back("y" + std::to_string(i));
+                }
+
+                BooleanFunction bf(BooleanFunction::ZERO);
+                for (u32 i = 0; i < n; i++) {
+                    bf |= BooleanFunction("x" + std::to_string(i)) & BooleanFunction("y" + std::to_string(i));
+                }
+
+                BDDManager mgr;
+                mgr.set_variable_order(bad_order);
+                BDD f = bf.to_bdd(mgr);
+                mgr.collect_garbage();
+                u32 bad_size = f.get_node_count();
+                EXPECT_EQ(mgr.get_variable_order(), bad_order);
+
+                mgr.reorder();
+                u32 sifted_size = f.get_node_count();
+                EXPECT_LT(sifted_size, bad_size);
+
+                mgr.set_variable_order(good_order);
+                EXPECT_EQ(mgr.get_variable_order(), good_order);
+                EXPECT_EQ(f.get_node_count(), 2 * n + 2);
+
+                // handles stay valid and canonical across reordering
+                EXPECT_EQ(f, bf.to_bdd(mgr));
+                EXPECT_EQ(mgr.to_boolean_function(f).get_truth_table(good_order), bf.get_truth_table(good_order));
+            }
+        TEST_END
+    }
+} //namespace hal
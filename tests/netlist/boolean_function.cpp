@@ -1,5 +1,6 @@
 #include "netlist_test_utils.h"
 #include "gtest/gtest.h"
+#include "hal_core/netlist/bdd.h"
 #include "hal_core/netlist/boolean_function.h"
 #include <iostream>
 #include <type_traits>
@@ -400,6 +401,54 @@ namespace hal {
         TEST_END
     }
 
+    /**
+     * Testing the optimization of functions that are too large for an exact minimization
+     *
+     * Functions: optimize
+     */
+    TEST_F(BooleanFunctionTest, check_optimize_large_functions)
+    {
+        TEST_START
+            {
+                // redundant consensus terms of a 24-variable function are removed by the heuristic minimization
+                BooleanFunction bf(ZERO);
+                BooleanFunction expected(ZERO);
+                for (u32 i = 0; i < 8; i++) {
+                    BooleanFunction a("A" + std::to_string(i)), b("B" + std::to_string(i)), c("C" + std::to_string(i));
+                    bf |= (a & c) | (b & ~c) | (a & b);
+                    expected |= (a & c) | (b & ~c);
+                }
+                BooleanFunction optimized = bf.optimize();
+
+                BDDManager mgr;
+                EXPECT_EQ(optimized.to_bdd(mgr), bf.to_bdd(mgr));
+                EXPECT_EQ(optimized.get_dnf_clauses().size(), 16);
+                EXPECT_EQ(optimized.to_string(), expected.optimize().to_string());
+            }
+            {
+                // the sum-of-products representation of a wide XOR is exponential, hence only constants are removed
+                BooleanFunction bf(ZERO);
+                for (u32 i = 0; i < 32; i++) {
+                    bf ^= BooleanFunction("X" + std::to_string(i));
+                }
+                BooleanFunction optimized = bf.optimize();
+
+                BDDManager mgr;
+                EXPECT_EQ(optimized.to_bdd(mgr), bf.to_bdd(mgr));
+                EXPECT_EQ(optimized.to_string(), bf.optimize_constants().to_string());
+            }
+            {
+                // limits can be tightened
+                BooleanFunction bf = BooleanFunction::from_string("(A & B) | (A & !B) | (C & D & E & F & G & H & I & J)");
+                BooleanFunction::OptimizationSettings settings;
+                settings.exact_variable_limit = 0;
+                EXPECT_EQ(bf.optimize(settings).to_string(), "A | (C & D & E & F & G & H & I & J)");
+                settings.max_bdd_nodes = 2;
+                EXPECT_EQ(bf.optimize(settings).to_string(), bf.optimize_constants().to_string());
+            }
+        TEST_END
+    }
+
 
     /**
      * Testing the integrity of the from_string function
@@ -443,6 +492,35 @@ namespace hal {
                 auto bf = BooleanFunction::from_string("!(A1 | A2)", {"A", "B"});
                 EXPECT_EQ(bf.get_variables(), std::vector<std::string>({"2", "A"}));
             }
+            {
+                // Check operator precedence and postfix negation
+                EXPECT_EQ(BooleanFunction::from_string("A | B ^ C & D").to_string(), "A | (B ^ (C & D))");
+                EXPECT_EQ(BooleanFunction::from_string("(A + B)' * C").to_string(), "!(A | B) & C");
+                EXPECT_EQ(BooleanFunction::from_string("!!A B'").to_string(), "A & !B");
+            }
+            {
+                // Check the longest known variable name is matched
+                auto bf = BooleanFunction::from_string("A(0) & A(10)", {"A(1)", "A(10)", "A(0)"});
+                EXPECT_EQ(bf.get_variables(), std::vector<std::string>({"A(0)", "A(10)"}));
+            }
+            {
+                // Check erroneous expressions
+                NO_COUT_TEST_BLOCK;
+                EXPECT_TRUE(BooleanFunction::from_string("").is_empty());
+                EXPECT_EQ(BooleanFunction::from_string("(A & B"), BooleanFunction(BooleanFunction::X));
+                EXPECT_EQ(BooleanFunction::from_string("A & B)"), BooleanFunction(BooleanFunction::X));
+                EXPECT_EQ(BooleanFunction::from_string("A & | B"), BooleanFunction(BooleanFunction::X));
+                EXPECT_EQ(BooleanFunction::from_string("A & ()"), BooleanFunction(BooleanFunction::X));
+                EXPECT_EQ(BooleanFunction::from_string("A &"), BooleanFunction(BooleanFunction::X));
+            }
+            {
+                // Check that cached results are identical
+                auto bf_1 = BooleanFunction::from_string("I0 & (I1 | !I2)");
+                auto bf_2 = BooleanFunction::from_string("I0 & (I1 | !I2)");
+                EXPECT_EQ(bf_1, bf_2);
+                EXPECT_EQ(bf_1.to_string(), "I0 & (I1 | !I2)");
+                EXPECT_EQ(BooleanFunction::from_string("I0 & (I1 | !I2)", {"I1 | !I2"}).get_variables(), std::vector<std::string>({"I0", "I1 | !I2"}));
+            }
 
         TEST_END
     }
@@ -165,6 +165,78 @@ namespace hal
         TEST_END
     }
 
+    /**
+     * Testing the get_subgraph_functions
+     *
+     * Functions: get_subgraph_functions
+     */
+    TEST_F(NetlistUtilsTest, check_get_subgraph_functions)
+    {
+        TEST_START
+        {
+            // Get the boolean functions of all nets of a long chain of AND gates with one primary input each
+            std::unique_ptr<Netlist> netlist = test_utils::create_empty_netlist();
+            GateType* and_type               = netlist->get_gate_library()->get_gate_type_by_name("AND2");
+            const u32 chain_length           = 500;
+
+            Net* prev_net = netlist->create_net("in_0");
+            std::vector<const Gate*> subgraph_gates;
+            std::vector<const Net*> chain_nets;
+            for (u32 i = 1; i <= chain_length; ++i)
+            {
+                Gate* g      = netlist->create_gate(and_type, "gate_" + std::to_string(i));
+                Net* in_net  = netlist->create_net("in_" + std::to_string(i));
+                Net* out_net = netlist->create_net("out_" + std::to_string(i));
+                prev_net->add_destination(g, "I0");
+                in_net->add_destination(g, "I1");
+                out_net->add_source(g, "O");
+                subgraph_gates.push_back(g);
+                chain_nets.push_back(out_net);
+                prev_net = out_net;
+            }
+
+            std::vector<BooleanFunction> functions = netlist_utils::get_subgraph_functions(chain_nets, subgraph_gates);
+            ASSERT_EQ(functions.size(), chain_length);
+            for (u32 i = 0; i < chain_length; i += 50)
+            {
+                EXPECT_EQ(functions[i].get_variables().size(), i + 2);
+            }
+            EXPECT_EQ(functions.back(), netlist_utils::get_subgraph_function(chain_nets.back(), subgraph_gates));
+        }
+        {
+            // Reconvergent logic is only expanded once and invalid nets yield empty functions
+            std::unique_ptr<Netlist> netlist = test_utils::create_empty_netlist();
+            GateType* and_type               = netlist->get_gate_library()->get_gate_type_by_name("AND2");
+            GateType* inv_type               = netlist->get_gate_library()->get_gate_type_by_name("INV");
+
+            Gate* gate_0 = netlist->create_gate(inv_type, "gate_0");
+            Gate* gate_1 = netlist->create_gate(inv_type, "gate_1");
+            Gate* gate_2 = netlist->create_gate(and_type, "gate_2");
+            Net* in_net  = netlist->create_net("in");
+            in_net->add_destination(gate_0, "I");
+            Net* net_0 = test_utils::connect(netlist.get(), gate_0, "O", gate_1, "I");
+            test_utils::connect(netlist.get(), gate_0, "O", gate_2, "I0");
+            Net* net_1   = test_utils::connect(netlist.get(), gate_1, "O", gate_2, "I1");
+            Net* out_net = netlist->create_net("out");
+            out_net->add_source(gate_2, "O");
+
+            const std::string in_name = std::to_string(in_net->get_id());
+            const std::vector<const Gate*> subgraph_gates({gate_0, gate_1, gate_2});
+
+            NO_COUT_TEST_BLOCK;
+            std::vector<BooleanFunction> functions = netlist_utils::get_subgraph_functions({out_net, net_1, in_net, nullptr, net_0}, subgraph_gates);
+            ASSERT_EQ(functions.size(), 5);
+            EXPECT_EQ(functions[0].to_string(), "!" + in_name + " & " + in_name);
+            EXPECT_EQ(functions[1].to_string(), in_name);
+            EXPECT_TRUE(functions[2].is_empty());
+            EXPECT_TRUE(functions[3].is_empty());
+            EXPECT_EQ(functions[4].to_string(), "!" + in_name);
+
+            EXPECT_TRUE(netlist_utils::get_subgraph_functions({out_net}, {}).empty());
+        }
+        TEST_END
+    }
+
     /**
      * Testing the deep copying of netlists
      *